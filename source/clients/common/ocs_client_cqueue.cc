@@ -62,110 +62,6 @@
 #include "ocs_client_print.h"
 #include "uti/sge.h"
 
-bool cqueue_calculate_summary(const lListElem *cqueue, const lList *exechost_list, const lList *centry_list,
-                              double *load, bool *is_load_available, u_long32 *used, u_long32 *resv, u_long32 *total,
-                              u_long32 *suspend_manual, u_long32 *suspend_threshold, u_long32 *suspend_on_subordinate,
-                              u_long32 *suspend_calendar, u_long32 *unknown, u_long32 *load_alarm,
-                              u_long32 *disabled_manual, u_long32 *disabled_calendar, u_long32 *ambiguous,
-                              u_long32 *orphaned, u_long32 *error, u_long32 *available, u_long32 *temp_disabled,
-                              u_long32 *manual_intervention) {
-   bool ret = true;
-
-   DENTER(TOP_LAYER);
-   if (cqueue != nullptr) {
-      const lList *qinstance_list = lGetList(cqueue, CQ_qinstances);
-      const lListElem *qinstance = nullptr;
-      double host_load_avg = 0.0;
-      u_long32 load_slots = 0;
-      u_long32 used_available = 0;
-      u_long32 used_slots = 0;
-      u_long32 resv_slots = 0;
-
-      *load = 0.0;
-      *is_load_available = false;
-      *used = *total = *resv = 0;
-      *available = *temp_disabled = *manual_intervention = 0;
-      *suspend_manual = *suspend_threshold = *suspend_on_subordinate = 0;
-      *suspend_calendar = *unknown = *load_alarm = 0;
-      *disabled_manual = *disabled_calendar = *ambiguous = 0;
-      *orphaned = *error = 0;
-      for_each_ep(qinstance, qinstance_list) {
-         u_long32 slots = lGetUlong(qinstance, QU_job_slots);
-         bool has_value_from_object;
-
-         used_slots = qinstance_slots_used(qinstance);
-         resv_slots = qinstance_slots_reserved_now(qinstance);
-         (*used) += used_slots;
-         (*resv) += resv_slots;
-         (*total) += slots;
-
-         if (!sge_get_double_qattr(&host_load_avg, LOAD_ATTR_NP_LOAD_AVG, qinstance, exechost_list, centry_list,
-                                   &has_value_from_object)) {
-            if (has_value_from_object) {
-               load_slots += slots;
-               *load += host_load_avg * slots;
-            }
-         }
-
-         /*
-          * manual_intervention: cdsuE
-          * temp_disabled: aoACDS
-          */
-         if (qinstance_state_is_manual_suspended(qinstance) || qinstance_state_is_unknown(qinstance) ||
-             qinstance_state_is_manual_disabled(qinstance) || qinstance_state_is_ambiguous(qinstance) ||
-             qinstance_state_is_error(qinstance)) {
-            *manual_intervention += slots;
-         } else if (qinstance_state_is_alarm(qinstance) || qinstance_state_is_cal_disabled(qinstance) ||
-                    qinstance_state_is_orphaned(qinstance) || qinstance_state_is_susp_on_sub(qinstance) ||
-                    qinstance_state_is_cal_suspended(qinstance) || qinstance_state_is_suspend_alarm(qinstance)) {
-            *temp_disabled += slots;
-         } else {
-            *available += slots;
-            used_available += used_slots;
-         }
-         if (qinstance_state_is_unknown(qinstance)) {
-            *unknown += slots;
-         }
-         if (qinstance_state_is_alarm(qinstance)) {
-            *load_alarm += slots;
-         }
-         if (qinstance_state_is_manual_disabled(qinstance)) {
-            *disabled_manual += slots;
-         }
-         if (qinstance_state_is_cal_disabled(qinstance)) {
-            *disabled_calendar += slots;
-         }
-         if (qinstance_state_is_ambiguous(qinstance)) {
-            *ambiguous += slots;
-         }
-         if (qinstance_state_is_orphaned(qinstance)) {
-            *orphaned += slots;
-         }
-         if (qinstance_state_is_manual_suspended(qinstance)) {
-            *suspend_manual += slots;
-         }
-         if (qinstance_state_is_susp_on_sub(qinstance)) {
-            *suspend_on_subordinate += slots;
-         }
-         if (qinstance_state_is_cal_suspended(qinstance)) {
-            *suspend_calendar += slots;
-         }
-         if (qinstance_state_is_suspend_alarm(qinstance)) {
-            *suspend_threshold += slots;
-         }
-         if (qinstance_state_is_error(qinstance)) {
-            *error += slots;
-         }
-      }
-      if (load_slots > 0) {
-         *is_load_available = true;
-         *load /= load_slots;
-      }
-      *available -= used_available;
-   }
-   DRETURN(ret);
-}
-
 int select_by_qref_list(lList *cqueue_list, const lList *hgrp_list, const lList *qref_list) {
    int ret = 0;
    lList *queueref_list = nullptr;
@@ -674,36 +570,3 @@ bool is_cqueue_selected(lList *queue_list) {
 
    DRETURN(a_cqueue_is_selected);
 }
-
-/****** sge_cqueue_qstat/qinstance_slots_reserved_now() ************************
- *  NAME
- *     qinstance_slots_reserved_now() -- get current reserved slots
- *
- *  SYNOPSIS
- *     int qinstance_slots_reserved_now(const lListElem *this_elem)
- *
- *  FUNCTION
- *     returns the current number of reserved slots
- *
- *  INPUTS
- *     const lListElem *this_elem - queue elem (QU_Type)
- *
- *  RESULT
- *     int - number of currently reserved slots
- *
- *  NOTES
- *     MT-NOTE: qinstance_slots_reserved_now() is MT safe
- *
- *  SEE ALSO
- *     qinstance_slots_reserved()
- *******************************************************************************/
-int qinstance_slots_reserved_now(const lListElem *this_elem) {
-   DENTER(TOP_LAYER);
-   int ret = 0;
-   const lListElem *slots = lGetSubStr(this_elem, RUE_name, SGE_ATTR_SLOTS, QU_resource_utilization);
-   if (slots != nullptr) {
-      u_long64 now = sge_get_gmt64();
-      ret = utilization_max(slots, now, 0, false);
-   }
-   DRETURN(ret);
-}
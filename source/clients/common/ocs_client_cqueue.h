@@ -33,14 +33,6 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
-bool cqueue_calculate_summary(const lListElem *cqueue, const lList *exechost_list, const lList *centry_list,
-                              double *load, bool *is_load_available, u_long32 *used, u_long32 *resv, u_long32 *total,
-                              u_long32 *suspend_manual, u_long32 *suspend_threshold, u_long32 *suspend_on_subordinate,
-                              u_long32 *suspend_calendar, u_long32 *unknown, u_long32 *load_alarm,
-                              u_long32 *disabled_manual, u_long32 *disabled_claendr, u_long32 *ambiguous,
-                              u_long32 *orphaned, u_long32 *error, u_long32 *available, u_long32 *temp_disabled,
-                              u_long32 *manual_intervention);
-
 int select_by_qref_list(lList *cqueue_list, const lList *hgrp_list, const lList *qref_list);
 int select_by_pe_list(lList *queue_list, lList *peref_list, lList *pe_list);
 int select_by_queue_user_list(lList *exechost_list, lList *queue_list, lList *queue_user_list, lList *acl_list,
@@ -50,4 +42,3 @@ int select_by_resource_list(lList *resource_list, lList *exechost_list, lList *q
                             u_long32 empty_qs);
 bool is_cqueue_selected(lList *queue_list);
 
-int qinstance_slots_reserved_now(const lListElem *this_elem);
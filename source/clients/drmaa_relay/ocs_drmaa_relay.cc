@@ -0,0 +1,229 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "uti/sge_component.h"
+#include "uti/sge_log.h"
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_unistd.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/ocs_DataStore.h"
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_event.h"
+#include "sgeobj/sge_job.h"
+
+#include "gdi/ocs_gdi_client.h"
+
+#include "evc/sge_event_client.h"
+
+#include "japi/msg_japi.h"
+#include "japi/ocs_DrmaaRelay.h"
+#include "japi/ocs_DrmaaRelaySessions.h"
+
+#include "sig_handlers.h"
+
+/*
+ * sge_drmaa_relay holds one event client for all DRMAA sessions of the user on
+ * this host and passes the job finish and task start events to the sessions
+ * which submitted the jobs. The sessions use the relay if SGE_DRMAA_RELAY is set
+ * to its socket path, see ocs::DrmaaRelay.
+ */
+
+namespace {
+   // connected DRMAA sessions and the session key of the jobs of the user
+   ocs::DrmaaRelaySessions Sessions;
+
+   void
+   usage() {
+      fprintf(stderr, "%s\n", MSG_JAPI_RELAY_USAGE);
+   }
+
+   void
+   accept_sessions(int listen_fd) {
+      std::vector<int> session_fds;
+      std::vector<struct pollfd> fds;
+
+      while (!shut_me_down) {
+         session_fds.clear();
+         Sessions.get_sockets(session_fds);
+         fds.clear();
+         fds.push_back({listen_fd, POLLIN, 0});
+         for (int fd : session_fds) {
+            fds.push_back({fd, POLLIN, 0});
+         }
+         if (poll(fds.data(), fds.size(), 1000) <= 0) {
+            continue;
+         }
+
+         // sessions send nothing after registering, a readable socket was closed
+         for (size_t i = 1; i < fds.size(); i++) {
+            if (fds[i].revents != 0) {
+               Sessions.close(fds[i].fd);
+            }
+         }
+
+         if ((fds[0].revents & POLLIN) != 0) {
+            int fd = accept(listen_fd, nullptr, nullptr);
+            std::string session;
+
+            if (fd >= 0) {
+               if (ocs::DrmaaRelay::receive_session(fd, session) && ocs::DrmaaRelay::send_events(fd, nullptr)) {
+                  Sessions.add(session, fd);
+               } else {
+                  close(fd);
+               }
+            }
+         }
+      }
+   }
+
+   void
+   subscribe_events(sge_evc_class_t *evc) {
+      const int job_nm[] = {JB_job_number, JB_session, NoName};
+      const int jat_nm[] = {JAT_task_number, JAT_status, NoName};
+
+      // the job list and new jobs tell which session a job belongs to
+      lCondition *where = lWhere("%T(%I==%s)", JB_Type, JB_owner, component_get_username());
+      lEnumeration *what = lIntVector2What(JB_Type, job_nm);
+      lListElem *where_el = lWhereToElem(where);
+      lListElem *what_el = lWhatToElem(what);
+
+      evc->ec_subscribe(evc, sgeE_JOB_LIST);
+      evc->ec_mod_subscription_where(evc, sgeE_JOB_LIST, what_el, where_el);
+      evc->ec_subscribe(evc, sgeE_JOB_ADD);
+      evc->ec_mod_subscription_where(evc, sgeE_JOB_ADD, what_el, where_el);
+      evc->ec_subscribe(evc, sgeE_JOB_DEL);
+      lFreeWhere(&where);
+      lFreeWhat(&what);
+      lFreeElem(&where_el);
+      lFreeElem(&what_el);
+
+      evc->ec_subscribe(evc, sgeE_JOB_FINISH);
+      evc->ec_set_flush(evc, sgeE_JOB_FINISH, true, 0);
+
+      // DRMAA sessions only need to know when a task started
+      where = lWhere("%T(%I==%u || %I==%u)", JAT_Type, JAT_status, JRUNNING, JAT_status, JTRANSFERING);
+      what = lIntVector2What(JAT_Type, jat_nm);
+      where_el = lWhereToElem(where);
+      what_el = lWhatToElem(what);
+      evc->ec_subscribe(evc, sgeE_JATASK_MOD);
+      evc->ec_mod_subscription_where(evc, sgeE_JATASK_MOD, what_el, where_el);
+      evc->ec_set_flush(evc, sgeE_JATASK_MOD, true, 0);
+      lFreeWhere(&where);
+      lFreeWhat(&what);
+      lFreeElem(&where_el);
+      lFreeElem(&what_el);
+
+      evc->ec_subscribe(evc, sgeE_SHUTDOWN);
+      evc->ec_set_flush(evc, sgeE_SHUTDOWN, true, 0);
+   }
+}
+
+int main(int argc, char *argv[]) {
+   const char *path = ocs::DrmaaRelay::get_socket_path();
+   sge_evc_class_t *evc = nullptr;
+   lList *alp = nullptr;
+   int listen_fd;
+
+   DENTER_MAIN(TOP_LAYER, "sge_drmaa_relay");
+
+   if (argc > 2 || (argc == 2 && argv[1][0] == '-')) {
+      usage();
+      sge_exit(strcmp(argv[1], "-help") == 0 ? 0 : 1);
+   }
+   if (argc == 2) {
+      path = argv[1];
+   }
+   if (path == nullptr) {
+      fprintf(stderr, MSG_JAPI_RELAY_NO_SOCKET_S, ocs::DrmaaRelay::SOCKET_ENV);
+      fprintf(stderr, "\n");
+      usage();
+      sge_exit(1);
+   }
+
+   log_state_set_log_gui(1);
+   sge_setup_sig_handlers(DRMAA_RELAY);
+
+   ocs::DataStore::select_active_ds(ocs::DataStore::Id::GLOBAL);
+
+   if (gdi_client_setup_and_enroll(DRMAA_RELAY, MAIN_THREAD, &alp) != AE_OK) {
+      answer_list_output(&alp);
+      sge_exit(1);
+   }
+
+   evc = sge_evc_class_create(EV_ID_ANY, &alp, nullptr);
+   if (evc == nullptr) {
+      answer_list_output(&alp);
+      sge_exit(1);
+   }
+   evc->ec_set_edtime(evc, 30);
+   evc->ec_set_busy_handling(evc, EV_BUSY_UNTIL_ACK);
+   evc->ec_set_flush_delay(evc, 6);
+   subscribe_events(evc);
+   if (!evc->ec_register(evc, false, &alp)) {
+      answer_list_output(&alp);
+      sge_exit(1);
+   }
+
+   listen_fd = ocs::DrmaaRelay::listen(path, &alp);
+   if (listen_fd < 0) {
+      evc->ec_deregister(evc);
+      answer_list_output(&alp);
+      sge_exit(1);
+   }
+   INFO(MSG_JAPI_RELAY_LISTENING_S, path);
+
+   std::thread acceptor(accept_sessions, listen_fd);
+
+   while (!shut_me_down) {
+      lList *event_list = nullptr;
+
+      if (evc->ec_get(evc, &event_list, false)) {
+         if (Sessions.relay_events(event_list)) {
+            shut_me_down = 1;
+         }
+      } else {
+         // qmaster is not reachable, register again
+         evc->ec_mark4registration(evc);
+         for (int i = 0; i < 10 && !shut_me_down; i++) {
+            sleep(1);
+         }
+      }
+      lFreeList(&event_list);
+   }
+
+   acceptor.join();
+   evc->ec_deregister(evc);
+   sge_evc_class_destroy(&evc);
+
+   close(listen_fd);
+   unlink(path);
+   Sessions.close_all();
+
+   DRETURN(0);
+}
@@ -2090,8 +2090,8 @@ qstat_show_job(lList *jid_list, u_long32 isXML, qstat_env_t *qstat_env) {
             JB_hard_wallclock_gmt, JB_override_tickets, JB_version,
             JB_ja_structure, JB_type, JB_binding, JB_ja_task_concurrency, JB_pty,
             JB_grp_list, RN_Type);
-   /* get job list */
-   alp = sge_gdi(SGE_JB_LIST, SGE_GDI_GET, &jlp, where, what);
+   /* get job list, huge job lists are fetched in pages */
+   alp = sge_gdi_get_paged(SGE_JB_LIST, &jlp, where, what);
    lFreeWhere(&where);
    lFreeWhat(&what);
 
@@ -74,6 +74,7 @@
 #include "sched/sge_job_schedd.h"
 #include "sched/sge_select_queue.h"
 #include "sched/sge_complex_schedd.h"
+#include "sched/sge_cqueue_summary.h"
 
 #include "sgeobj/sge_daemonize.h"
 #include "gdi/sge_gdi.h"
@@ -91,7 +92,7 @@ static int qstat_env_get_all_lists(qstat_env_t *qstat_env, bool need_job_list, l
 
 int qstat_env_filter_queues(qstat_env_t *qstat_env, lList** filtered_queue_list, lList **alpp);
 static int filter_jobs(qstat_env_t *qstat_env, lList **alpp);
-static void calc_longest_queue_length(qstat_env_t *qstat_env);
+static void calc_longest_queue_length(qstat_env_t *qstat_env, const lList *queue_list, int name);
 static int qstat_env_prepare(qstat_env_t* qstat_env, bool need_job_list, lList **alpp);
 
 static void remove_tagged_jobs(lList *job_list);
@@ -194,17 +195,107 @@ int qselect(qstat_env_t* qstat_env, qselect_handler_t* handler, lList **alpp) {
    DRETURN(0);
 }
 
+/*
+ * Report the cluster queue summary calculated by sge_qmaster (GDI target SGE_QSTAT).
+ *
+ * Only the summary rows are transferred, the cluster queue, host and job lists are not
+ * fetched. This is only possible if no option was specified that selects queue instances.
+ *
+ * Returns false if the summary is not available (e.g. qmaster does not support the
+ * request) and the caller has to calculate the summary itself. Otherwise *ret contains
+ * the result of the report handler.
+ */
+static bool qstat_cqueue_summary_from_master(qstat_env_t *qstat_env, cqueue_summary_handler_t *handler,
+                                             int *ret, lList **alpp) {
+   lList *summary_list = nullptr;
+   const lListElem *summary_ep = nullptr;
+
+   DENTER(TOP_LAYER);
+
+   if (lGetNumberOfElem(qstat_env->queueref_list) > 0 || lGetNumberOfElem(qstat_env->queue_user_list) > 0 ||
+       lGetNumberOfElem(qstat_env->peref_list) > 0 || lGetNumberOfElem(qstat_env->resource_list) > 0 ||
+       qstat_env->queue_state != U_LONG32_MAX) {
+      DRETURN(false);
+   }
+
+   lList *local_answer_list = sge_gdi(SGE_QSTAT, SGE_GDI_GET, &summary_list, nullptr, nullptr);
+   const lListElem *aep = lFirst(local_answer_list);
+   if (aep == nullptr || answer_get_status(aep) != STATUS_OK) {
+      DPRINTF("cluster queue summary not available from qmaster\n");
+      lFreeList(&local_answer_list);
+      lFreeList(&summary_list);
+      DRETURN(false);
+   }
+   lFreeList(&local_answer_list);
+
+   calc_longest_queue_length(qstat_env, summary_list, CQS_name);
+
+   handler->qstat_env = qstat_env;
+   *ret = 0;
+
+   if (handler->report_started != nullptr) {
+      *ret = handler->report_started(handler, alpp);
+   }
+
+   for_each_ep(summary_ep, summary_list) {
+      cqueue_summary_t summary;
+
+      if (*ret != 0) {
+         break;
+      }
+
+      summary.load = lGetDouble(summary_ep, CQS_load);
+      summary.is_load_available = lGetBool(summary_ep, CQS_is_load_available);
+      summary.used = lGetUlong(summary_ep, CQS_used);
+      summary.resv = lGetUlong(summary_ep, CQS_resv);
+      summary.total = lGetUlong(summary_ep, CQS_total);
+      summary.temp_disabled = lGetUlong(summary_ep, CQS_temp_disabled);
+      summary.available = lGetUlong(summary_ep, CQS_available);
+      summary.manual_intervention = lGetUlong(summary_ep, CQS_manual_intervention);
+      summary.suspend_manual = lGetUlong(summary_ep, CQS_suspend_manual);
+      summary.suspend_threshold = lGetUlong(summary_ep, CQS_suspend_threshold);
+      summary.suspend_on_subordinate = lGetUlong(summary_ep, CQS_suspend_on_subordinate);
+      summary.suspend_calendar = lGetUlong(summary_ep, CQS_suspend_calendar);
+      summary.unknown = lGetUlong(summary_ep, CQS_unknown);
+      summary.load_alarm = lGetUlong(summary_ep, CQS_load_alarm);
+      summary.disabled_manual = lGetUlong(summary_ep, CQS_disabled_manual);
+      summary.disabled_calendar = lGetUlong(summary_ep, CQS_disabled_calendar);
+      summary.ambiguous = lGetUlong(summary_ep, CQS_ambiguous);
+      summary.orphaned = lGetUlong(summary_ep, CQS_orphaned);
+      summary.error = lGetUlong(summary_ep, CQS_error);
+
+      if (handler->report_cqueue != nullptr) {
+         *ret = handler->report_cqueue(handler, lGetString(summary_ep, CQS_name), &summary, alpp);
+      }
+   }
+
+   if (*ret == 0 && handler->report_finished != nullptr) {
+      *ret = handler->report_finished(handler, alpp);
+   }
+   handler->qstat_env = nullptr;
+   lFreeList(&summary_list);
+
+   DRETURN(true);
+}
+
 int qstat_cqueue_summary(qstat_env_t *qstat_env, cqueue_summary_handler_t *handler, lList **alpp) {
  
    int ret = 0;
    const lListElem *cqueue = nullptr;
    
    DENTER(TOP_LAYER);
+
+   if (qstat_cqueue_summary_from_master(qstat_env, handler, &ret, alpp)) {
+      DRETURN(ret);
+   }
    
    if ((ret = qstat_env_prepare(qstat_env, true, alpp)) != 0 ) {
       DPRINTF("qstat_env_prepare failed\n");
       DRETURN(ret);
    }
+
+   /* the alarm states are set while filtering, they are based on scaled load values like in sge_qmaster */
+   correct_capacities(qstat_env->exechost_list, qstat_env->centry_list);
    
    if ((ret = qstat_env_filter_queues(qstat_env, nullptr, alpp)) < 0) {
       DPRINTF("qstat_env_filter_queues failed\n");
@@ -216,9 +307,7 @@ int qstat_cqueue_summary(qstat_env_t *qstat_env, cqueue_summary_handler_t *handl
       DRETURN(ret);
    }
 
-   calc_longest_queue_length(qstat_env);
-   
-   correct_capacities(qstat_env->exechost_list, qstat_env->centry_list);
+   calc_longest_queue_length(qstat_env, qstat_env->queue_list, CQ_name);
    
    handler->qstat_env = qstat_env;
    
@@ -300,7 +389,11 @@ int qstat_no_group(qstat_env_t* qstat_env, qstat_handler_t* handler, lList **alp
       DRETURN(ret);
    }
    
-   calc_longest_queue_length(qstat_env);
+   int name = QU_full_name;
+   if ((qstat_env->group_opt & GROUP_CQ_SUMMARY) != 0) {
+      name = CQ_name;
+   }
+   calc_longest_queue_length(qstat_env, qstat_env->queue_list, name);
 
    correct_capacities(qstat_env->exechost_list, qstat_env->centry_list);
    
@@ -382,21 +475,14 @@ int qstat_no_group(qstat_env_t* qstat_env, qstat_handler_t* handler, lList **alp
 }
 
 
-static void calc_longest_queue_length(qstat_env_t *qstat_env) {
-   u_long32 name;
+static void calc_longest_queue_length(qstat_env_t *qstat_env, const lList *queue_list, int name) {
    char *env;
    const lListElem *qep = nullptr;
    
-   if ((qstat_env->group_opt & GROUP_CQ_SUMMARY) == 0) { 
-      name = QU_full_name;
-   }
-   else {
-      name = CQ_name;
-   }
    if ((env = getenv("SGE_LONG_QNAMES")) != nullptr){
       qstat_env->longest_queue_length = atoi(env);
       if (qstat_env->longest_queue_length == -1) {
-         for_each_ep(qep, qstat_env->queue_list) {
+         for_each_ep(qep, queue_list) {
             int length;
             const char *queue_name =lGetString(qep, name);
             if ((length = strlen(queue_name)) > qstat_env->longest_queue_length){
@@ -55,5 +55,10 @@
 #define MSG_QSUB_INTERRUPTED                 _MESSAGE(210015, _("Interrupted!"))
 #define MSG_QSUB_TERMINATING                 _MESSAGE(210016, _("Please wait while qsub shuts down."))
 #define MSG_QSUB_COULDNOTREADSCRIPT_S        _MESSAGE(210017, _("Unable to read script file because of error: "))
+#define MSG_QSUB_COULDNOTREADBATCHFILE_SS    _MESSAGE(210018, _("Unable to read batch file " SFQ ": " SFN))
+#define MSG_QSUB_BATCHFILENOSCRIPT_SI        _MESSAGE(210019, _("batch file " SFQ ", line %d: no job script or command given"))
+#define MSG_QSUB_BATCHFILEOPTION_S           _MESSAGE(210020, _("option " SFQ " can not be used with -batch-file"))
+#define MSG_QSUB_BATCHFILEEMPTY_S            _MESSAGE(210021, _("batch file " SFQ " contains no jobs"))
+#define MSG_QSUB_BATCHFILEQUOTE_SIC          _MESSAGE(210022, _("batch file " SFQ ", line %d: unmatched quote %c"))
 
 // clang-format on
@@ -31,16 +31,21 @@
  *
  ************************************************************************/
 /*___INFO__MARK_END__*/
+#include <cctype>
 #include <cstring>
 #include <sys/stat.h>
 #include <cerrno>
+#include <vector>
 
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_bootstrap_env.h"
 #include "uti/sge_bootstrap_files.h"
 #include "uti/sge_mtutil.h"
+#include "uti/sge_parse_args.h"
 #include "uti/sge_profiling.h"
 #include "uti/sge_rmon_macros.h"
+#include "uti/sge_stdio.h"
+#include "uti/sge_string.h"
 #include "uti/sge_unistd.h"
 
 #include "sgeobj/cull/sge_all_listsL.h"
@@ -60,6 +65,7 @@
 #include "basis_types.h"
 #include "usage.h"
 #include "parse_job_cull.h"
+#include "parse_qsub.h"
 #include "ocs_client_parse.h"
 #include "ocs_client_job.h"
 #include "msg_clients_common.h"
@@ -77,6 +83,10 @@ static void qsub_terminate();
 static void *sig_thread(void *dummy);
 static int report_exit_status(int stat, const char *jobid);
 static void error_handler(const char *message);
+static int qsub_read_batch_file(u_long32 prog_number, const char *batch_file, const lList *opts_defaults,
+                                const lList *opts_cmdline, lList **job_list);
+static int qsub_submit_batch_file(u_long32 prog_number, const lList *opts_defaults, const lList *opts_cmdline,
+                                  bool has_terse);
 
 /************************************************************************/
 int 
@@ -172,6 +182,14 @@ main(int argc, const char **argv)
       has_terse = true;
    }
 
+   /*
+    * With -batch-file all jobs listed in the batch file are submitted at once
+    */
+   if (opt_list_has_X(opts_cmdline, "-batch-file")) {
+      exit_status = qsub_submit_batch_file(prog_number, opts_defaults, opts_cmdline, has_terse);
+      goto Error;
+   }
+
    /*
     * We will only read commandline options from scripfile if the script
     * itself should not be handled as binary
@@ -494,6 +512,297 @@ Error:
    DRETURN(exit_status);
 }
 
+/****** qsub_read_batch_file() *************************************************
+*  NAME
+*     qsub_read_batch_file() -- Create the jobs listed in a batch file
+*
+*  SYNOPSIS
+*     static int qsub_read_batch_file(u_long32 prog_number, 
+*        const char *batch_file, const lList *opts_defaults, 
+*        const lList *opts_cmdline, lList **job_list)
+*
+*  FUNCTION
+*     Each line of the batch file contains the qsub options, the script 
+*     and the script arguments of one job. Empty lines and lines starting
+*     with '#' are ignored. The arguments are split at whitespace, quoted
+*     arguments are kept together like in a shell command line. The options of the defaults files, of the
+*     script and of the qsub command line are merged like for a single
+*     job, options in the batch file line come after the command line 
+*     options.
+*
+*  INPUTS
+*     u_long32 prog_number       - program number (QSUB)
+*     const char *batch_file     - path of the batch file
+*     const lList *opts_defaults - options from the defaults files
+*     const lList *opts_cmdline  - options from the qsub command line
+*  
+*  OUTPUTS
+*     lList **job_list           - the created jobs (JB_Type)
+*
+*  RESULT
+*     static int - 0 on success or the exit status for qsub
+*******************************************************************************/
+static int qsub_read_batch_file(u_long32 prog_number, const char *batch_file, const lList *opts_defaults,
+                                const lList *opts_cmdline, lList **job_list)
+{
+   FILE *fp;
+   char *line = nullptr;
+   size_t line_size = 0;
+   int line_number = 0;
+   int ret = 0;
+
+   DENTER(TOP_LAYER);
+
+   fp = fopen(batch_file, "r");
+   if (fp == nullptr) {
+      fprintf(stderr, MSG_QSUB_COULDNOTREADBATCHFILE_SS, batch_file, strerror(errno));
+      fprintf(stderr, "\n");
+      DRETURN(1);
+   }
+
+   while (ret == 0 && getline(&line, &line_size, fp) != -1) {
+      lList *opts_line = nullptr;
+      lList *opts_job_defaults = nullptr;
+      lList *opts_job_cmdline = nullptr;
+      lList *opts_scriptfile = nullptr;
+      lList *opts_all = nullptr;
+      lList *alp = nullptr;
+      lListElem *job = nullptr;
+      lListElem *ep;
+      const char *script;
+      sge_sl_list_t *sl_args = nullptr;
+      char **args = nullptr;
+      char *start = line;
+      int quote_error;
+
+      line_number++;
+      while (isspace(*start)) {
+         start++;
+      }
+      if (*start == '#' || *start == '\0') {
+         continue;
+      }
+
+      /* arguments are split like in a shell command line, quoted arguments are kept together */
+      sge_sl_create(&sl_args);
+      quote_error = parse_quoted_command_line(start, sl_args);
+      if (quote_error != 0) {
+         fprintf(stderr, MSG_QSUB_BATCHFILEQUOTE_SIC, batch_file, line_number, quote_error == 1 ? '\"' : '\'');
+         fprintf(stderr, "\n");
+         sge_sl_destroy(&sl_args, nullptr);
+         ret = 1;
+         break;
+      }
+      convert_arg_list_to_vector(sl_args, &args);
+
+      /* the line is parsed like a qsub command line */
+      alp = cull_parse_cmdline(prog_number, (const char **)args, environ, &opts_line, FLG_USE_PSEUDOS);
+      ret = answer_list_print_err_warn(&alp, nullptr, "qsub: ", MSG_QSUB_WARNING_S);
+
+      if (ret == 0) {
+         ep = lGetElemStrRW(opts_line, SPA_switch_val, STR_PSEUDO_SCRIPT);
+         script = (ep != nullptr) ? lGetString(ep, SPA_argval_lStringT) : nullptr;
+         if (script == nullptr || *script == '\0') {
+            fprintf(stderr, MSG_QSUB_BATCHFILENOSCRIPT_SI, batch_file, line_number);
+            fprintf(stderr, "\n");
+            ret = 1;
+         }
+      }
+
+      /* command line options apply to all jobs, the options of the line come last */
+      if (ret == 0) {
+         opts_job_cmdline = lCopyList(nullptr, opts_cmdline);
+         while ((ep = lGetElemStrRW(opts_job_cmdline, SPA_switch_val, "-batch-file"))) {
+            lRemoveElem(opts_job_cmdline, &ep);
+         }
+         if (opts_job_cmdline == nullptr) {
+            opts_job_cmdline = opts_line;
+            opts_line = nullptr;
+         } else {
+            lAddList(opts_job_cmdline, &opts_line);
+         }
+         opts_job_defaults = lCopyList(nullptr, opts_defaults);
+
+         if (opt_list_is_X_true(opts_job_cmdline, "-b") ||
+             (!opt_list_has_X(opts_job_cmdline, "-b") &&
+              opt_list_is_X_true(opts_job_defaults, "-b"))) {
+            DPRINTF("Skipping options from script due to -b option\n");
+         } else {
+            opt_list_append_opts_from_script(prog_number, &opts_scriptfile, &alp, opts_job_cmdline, environ);
+            ret = answer_list_print_err_warn(&alp, nullptr, MSG_QSUB_COULDNOTREADSCRIPT_S, MSG_WARNING);
+         }
+      }
+
+      if (ret == 0) {
+         opt_list_merge_command_lines(&opts_all, &opts_job_defaults, &opts_scriptfile, &opts_job_cmdline);
+         opt_list_verify_scope(opts_all, &alp);
+         ret = answer_list_print_err_warn(&alp, nullptr, nullptr, nullptr);
+      }
+
+      /* jobs of a batch file are not waited for */
+      if (ret == 0) {
+         while ((ep = lGetElemStrRW(opts_all, SPA_switch_val, "-sync"))) {
+            if (lGetInt(ep, SPA_argval_lIntT) == TRUE) {
+               fprintf(stderr, MSG_QSUB_BATCHFILEOPTION_S, "-sync y");
+               fprintf(stderr, "\n");
+               ret = 1;
+            }
+            lRemoveElem(opts_all, &ep);
+         }
+      }
+
+      if (ret == 0) {
+         alp = cull_parse_job_parameter(component_get_uid(), component_get_username(),
+                                        bootstrap_get_cell_root(), component_get_unqualified_hostname(),
+                                        component_get_qualified_hostname(), opts_all, &job);
+         std::vector<const char *> command_line{"qsub"};
+         for (int i = 0; args[i] != nullptr; i++) {
+            command_line.push_back(args[i]);
+         }
+         job_set_command_line(job, (int)command_line.size(), command_line.data());
+         ret = answer_list_print_err_warn(&alp, nullptr, "qsub: ", MSG_WARNING);
+      }
+
+      if (ret == 0 && JOB_TYPE_IS_IMMEDIATE(lGetUlong(job, JB_type))) {
+         fprintf(stderr, MSG_QSUB_BATCHFILEOPTION_S, "-now y");
+         fprintf(stderr, "\n");
+         ret = 1;
+      }
+
+      if (ret == 0 && set_sec_cred(bootstrap_get_sge_root(), gdi_get_act_master_host(false), job, &alp) != 0) {
+         answer_list_output(&alp);
+         ret = 1;
+      }
+
+      if (ret == 0) {
+         if (*job_list == nullptr) {
+            *job_list = lCreateList("batch file jobs", JB_Type);
+         }
+         lAppendElem(*job_list, job);
+         job = nullptr;
+      }
+
+      lFreeElem(&job);
+      lFreeList(&alp);
+      lFreeList(&opts_all);
+      lFreeList(&opts_line);
+      lFreeList(&opts_job_cmdline);
+      lFreeList(&opts_job_defaults);
+      lFreeList(&opts_scriptfile);
+      sge_free(&args);
+      sge_sl_destroy(&sl_args, nullptr);
+   }
+
+   sge_free(&line);
+   FCLOSE_IGNORE_ERROR(fp);
+
+   if (ret == 0 && lGetNumberOfElem(*job_list) == 0) {
+      fprintf(stderr, MSG_QSUB_BATCHFILEEMPTY_S, batch_file);
+      fprintf(stderr, "\n");
+      ret = 1;
+   }
+
+   DRETURN(ret);
+}
+
+/****** qsub_submit_batch_file() ***********************************************
+*  NAME
+*     qsub_submit_batch_file() -- Submit all jobs of a batch file
+*
+*  SYNOPSIS
+*     static int qsub_submit_batch_file(u_long32 prog_number, 
+*        const lList *opts_defaults, const lList *opts_cmdline, 
+*        bool has_terse)
+*
+*  FUNCTION
+*     Submits all jobs listed in the file given with -batch-file with one 
+*     request. qmaster verifies and spools them in one go. For each job 
+*     accepted the job id is printed, jobs which were rejected are
+*     reported on stderr.
+*
+*  INPUTS
+*     u_long32 prog_number       - program number (QSUB)
+*     const lList *opts_defaults - options from the defaults files
+*     const lList *opts_cmdline  - options from the qsub command line
+*     bool has_terse             - print only the job ids
+*
+*  RESULT
+*     static int - the exit status for qsub
+*******************************************************************************/
+static int qsub_submit_batch_file(u_long32 prog_number, const lList *opts_defaults, const lList *opts_cmdline,
+                                  bool has_terse)
+{
+   const lListElem *batch_file = lGetElemStr(opts_cmdline, SPA_switch_val, "-batch-file");
+   lList *job_list = nullptr;
+   drmaa_attr_values_t *jobids = nullptr;
+   dstring diag = DSTRING_INIT;
+   dstring jobid = DSTRING_INIT;
+   const lListElem *job;
+   int drmaa_errno;
+   int exit_status;
+
+   DENTER(TOP_LAYER);
+
+   exit_status = qsub_read_batch_file(prog_number, lGetString(batch_file, SPA_argval_lStringT),
+                                      opts_defaults, opts_cmdline, &job_list);
+   if (exit_status != 0) {
+      lFreeList(&job_list);
+      DRETURN(exit_status);
+   }
+
+   drmaa_errno = japi_run_job_list(&jobids, &job_list, &diag);
+   if (jobids == nullptr) {
+      if (drmaa_errno != DRMAA_ERRNO_NO_ACTIVE_SESSION) {
+         fprintf(stderr, MSG_QSUB_COULDNOTRUNJOB_S, sge_dstring_get_string(&diag));
+         fprintf(stderr, "\n");
+      }
+      lFreeList(&job_list);
+      sge_dstring_free(&diag);
+      DRETURN(drmaa_errno == DRMAA_ERRNO_TRY_LATER ? STATUS_NOTOK_DOAGAIN : 1);
+   }
+
+   /* one job id per job, empty for the jobs which were rejected */
+   job = lFirst(job_list);
+   while (japi_string_vector_get_next(jobids, &jobid) == DRMAA_ERRNO_SUCCESS && job != nullptr) {
+      const char *id = sge_dstring_get_string(&jobid);
+
+      if (id != nullptr && *id != '\0') {
+         char *jobid_string;
+
+         if (job_is_array(job)) {
+            u_long32 start, end, step;
+
+            job_get_submit_task_ids(job, &start, &end, &step);
+            jobid_string = get_bulk_jobid_string(atol(id), start, end, step);
+         } else {
+            jobid_string = strdup(id);
+         }
+         if (has_terse) {
+            printf("%s\n", jobid_string);
+         } else {
+            printf(MSG_QSUB_YOURJOBHASBEENSUBMITTED_SS, jobid_string, lGetString(job, JB_job_name));
+            printf("\n");
+         }
+         sge_free(&jobid_string);
+      }
+      job = lNext(job);
+   }
+
+   exit_status = 0;
+   if (drmaa_errno != DRMAA_ERRNO_SUCCESS) {
+      fprintf(stderr, MSG_QSUB_COULDNOTRUNJOB_S, sge_dstring_get_string(&diag));
+      fprintf(stderr, "\n");
+      exit_status = (drmaa_errno == DRMAA_ERRNO_TRY_LATER) ? STATUS_NOTOK_DOAGAIN : 1;
+   }
+
+   japi_delete_string_vector(jobids);
+   lFreeList(&job_list);
+   sge_dstring_free(&jobid);
+   sge_dstring_free(&diag);
+
+   DRETURN(exit_status);
+}
+
 /****** get_bulk_jobid_string() ************************************************
 *  NAME
 *     get_bulk_jobid_string() -- Turn the job id and parameters into a string
@@ -43,6 +43,7 @@
 #include "sgeobj/parse.h"
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_daemonize.h"
+#include "sgeobj/cull/sge_cqueue_CQS_L.h"
 
 #include "gdi/sge_gdi.h"
 #include "gdi/ocs_gdi_client.h"
@@ -61,6 +62,8 @@ static bool sge_parse_showq_tacc(lList **alpp, lList ** ppcmdline,
 static int showq_show_job_tacc(lList * jid, int full,
                                  const bool binding, lList *, lList *);
 
+static int showq_total_slot_count();
+
 /*-------------------------------------------------------------------------*/
 /*-------------------------------------------------------------------------*/
 /*-------------------------------------------------------------------------*/
@@ -185,6 +188,35 @@ static bool sge_parse_showq_tacc(lList **alpp, lList **ppcmdline, lList **user_l
 }
 
 
+/*
+ * returns the number of configured slots of all cluster queues
+ *
+ * The cluster queue summary is calculated by qmaster (GDI target SGE_QSTAT) so that
+ * the queue and host lists need not to be fetched. If the request fails the error
+ * is printed and 0 is returned.
+ */
+static int showq_total_slot_count()
+{
+   int total_slot_count = 0;
+   lList *summary_list = nullptr;
+   const lListElem *summary = nullptr;
+
+   DENTER(TOP_LAYER);
+
+   lList *alp = sge_gdi(SGE_QSTAT, SGE_GDI_GET, &summary_list, nullptr, nullptr);
+   if (answer_list_has_error(&alp)) {
+      answer_list_output(&alp);
+   } else {
+      for_each_ep(summary, summary_list) {
+         total_slot_count += lGetUlong(summary, CQS_total);
+      }
+   }
+   lFreeList(&alp);
+   lFreeList(&summary_list);
+
+   DRETURN(total_slot_count);
+}
+
 /*
  * * showq_show_job * displays information about a given job * to be extended *
  * 
@@ -227,9 +259,9 @@ static int showq_show_job_tacc(lList * user_list, int full, const bool binding,
       }
    }
 
-   /* get job data */
+   /* get job data, huge job lists are fetched in pages */
    what = lWhat("%T(ALL)", JB_Type);
-   alp = sge_gdi(SGE_JB_LIST, SGE_GDI_GET, &jlp, where, what);
+   alp = sge_gdi_get_paged(SGE_JB_LIST, &jlp, where, what);
    if (alp != nullptr) {
       answer_list_output(&alp);
    }
@@ -277,9 +309,9 @@ static int showq_show_job_tacc(lList * user_list, int full, const bool binding,
    show_active_jobs(active_dj_list, full, binding);
 
    printf("\n");
-   total_slot_count = 82 * 4 * 12 * 16;
+   total_slot_count = showq_total_slot_count();
    printf("%6d active jobs : %4d of %4d hosts (%6.2f %%)\n", active_job_count, (int) ceil(active_slot_count / 16.0), (int) ceil(total_slot_count / 16.0),
-          100 * active_slot_count / (float) total_slot_count);
+          total_slot_count > 0 ? 100 * active_slot_count / (float) total_slot_count : 0.0);
    printf("\n");
 
    printf("WAITING JOBS------------------------\n");
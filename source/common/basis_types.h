@@ -220,3 +220,4 @@ typedef enum {
 #define GRU_HARD_REQUEST_TYPE  0
 #define GRU_SOFT_REQUEST_TYPE  1
 #define GRU_RESOURCE_MAP_TYPE  2
+#define GRU_BINDING_TYPE       3
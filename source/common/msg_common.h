@@ -926,6 +926,9 @@
 #define MSG_GDI_USAGE_dept_OPT_DEPT_NAME                 "[-dept department_name]"
 #define MSG_GDI_UTEXT_dept_OPT_DEPT_NAME                 _MESSAGE(23519, _("set job's department"))
 
+#define MSG_GDI_USAGE_batch_file_OPT_PATH                "[-batch-file file]"
+#define MSG_GDI_UTEXT_batch_file_OPT_PATH                _MESSAGE(23520, _("submit one job per line of file with one request"))
+
 
 
 #define MSG_UNKNOWNREASON                 _MESSAGE(60000, _("<unknown reason>"))
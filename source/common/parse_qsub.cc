@@ -325,6 +325,32 @@ lList *cull_parse_cmdline(
          continue;
       }
 
+/*----------------------------------------------------------------------------*/
+      /* "-batch-file file" */
+
+      if (!is_qalter && !strcmp("-batch-file", *sp)) {
+         if (lGetElemStr(*pcmdline, SPA_switch_val, *sp)) {
+            answer_list_add_sprintf(&answer, STATUS_EEXIST, ANSWER_QUALITY_WARNING,
+                                    MSG_PARSE_XOPTIONALREADYSETOVERWRITINGSETING_S, *sp);
+         }
+
+         /* next field is the batch file */
+         sp++;
+         if (!*sp) {
+             answer_list_add_sprintf(&answer, STATUS_ESEMANTIC, ANSWER_QUALITY_ERROR,
+                                     MSG_PARSE_XOPTIONMUSTHAVEARGUMENT_S, "-batch-file");
+             DRETURN(answer);
+         }
+
+         DPRINTF("\"-batch-file %s\"\n", *sp);
+
+         ep_opt = sge_add_arg(pcmdline, batch_file_OPT, lStringT, *(sp - 1), *sp);
+         lSetString(ep_opt, SPA_argval_lStringT, *sp);
+
+         sp++;
+         continue;
+      }
+
 /*----------------------------------------------------------------------------*/
       /* "-binding [set|env|pe] linear:<amount>[:<socket>,<core>] 
             | striding:<amount>:<stepsize>[:<socket>,<core>] 
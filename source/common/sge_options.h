@@ -296,7 +296,8 @@ enum {
    scel_OPT,/* show ce object list */
 
    stl_OPT, //< show thread list
-   dept_OPT //< set department of job
+   dept_OPT, //< set department of job
+   batch_file_OPT //< submit the jobs of a batch file with one request
 };
 
 /* macros used in parsing */
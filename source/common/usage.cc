@@ -456,6 +456,10 @@ void sge_usage(u_long32 prog_number, FILE *fp) {
       PRINTITD(MSG_GDI_USAGE_b_OPT_YN, MSG_GDI_UTEXT_b_OPT_YN);
    }
    
+   if (VALID_OPT(batch_file_OPT, prog_number)) {
+      PRINTITD(MSG_GDI_USAGE_batch_file_OPT_PATH, MSG_GDI_UTEXT_batch_file_OPT_PATH);
+   }
+
    if (VALID_OPT(binding_OPT, prog_number)) {
       PRINTITD(MSG_GDI_USAGE_binding_OPT_YN, MSG_GDI_UTEXT_binding_OPT_YN);
       MARK(OA_BINDING_EXPLICIT);
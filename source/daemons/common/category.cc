@@ -37,6 +37,8 @@
 #include "uti/sge_log.h"
 #include "uti/sge_rmon_macros.h"
 
+#include "sgeobj/ocs_binding_io.h"
+#include "sgeobj/ocs_TopologyMask.h"
 #include "sgeobj/sge_job.h"
 #include "sgeobj/sge_userprj.h"
 #include "sgeobj/sge_ja_task.h"
@@ -217,6 +219,13 @@ void sge_build_job_category_dstring(dstring *category_str, lListElem *job, const
    // -ar ar_id
    sge_unparse_ulong_option_dstring(category_str, job, lGetPosViaElem(job, JB_ar, SGE_NO_ABORT), "-ar");
 
+   // -binding, the scheduler selects the cores for the binding request
+   if (lGetPosViaElem(job, JB_binding, SGE_NO_ABORT) >= 0 && ocs::TopologyMask::is_binding_requested(job)) {
+      sge_dstring_append(category_str, "-binding ");
+      binding_print_to_string(lFirst(lGetList(job, JB_binding)), category_str);
+      sge_dstring_append_char(category_str, ' ');
+   }
+
    // remove the last white space that the last unparse function has written
    sge_dstring_strip_white_space_at_eol(category_str);
 
@@ -122,9 +122,12 @@ extern char execd_spool_dir[SGE_PATH_MAX];
 
 /* creates string with core binding which is written to job "config" file */
 static bool create_binding_strategy_string_linux(dstring *result,
-                                                 lListElem *jep,
+                                                 lListElem *jep, const lListElem *jatep,
                                                  char **rankfileinput);
 
+/* gets the cores the scheduler selected for this host as explicit request */
+static bool get_granted_binding_request(dstring *request, const lListElem *jatep);
+
 /* generates the config file string (binding elem) for shepherd */
 static bool linear_linux(dstring *result, const lListElem *binding_elem, const bool automatic);
 
@@ -132,7 +135,7 @@ static bool linear_linux(dstring *result, const lListElem *binding_elem, const b
 static bool striding_linux(dstring *result, const lListElem *binding_elem, const bool automatic);
 
 /* generates the config file string (binding elem) for shepherd */
-static bool explicit_linux(dstring *result, const lListElem *binding_elem);
+static bool explicit_linux(dstring *result, const char *request);
 
 #endif
 
@@ -515,7 +518,7 @@ int sge_exec_job(lListElem *jep, lListElem *jatep, lListElem *petep, char *err_s
          in order to fulfill the selected strategy. if strategy is not
          applicable or in case of errors "nullptr" is written to this
          line in the "config" file */
-      create_binding_strategy_string_linux(&core_binding_strategy_string, jep,
+      create_binding_strategy_string_linux(&core_binding_strategy_string, jep, jatep,
                                            &rankfileinput);
  
       if (sge_dstring_get_string(&core_binding_strategy_string) != nullptr
@@ -2122,16 +2125,20 @@ get_nhosts(const lList *gdil_orig) {
 *
 *  SYNOPSIS
 *     static bool create_binding_strategy_string_linux(dstring* result, 
-*     lListElem *jep, char** rankfileinput) 
+*     lListElem *jep, const lListElem *jatep, char** rankfileinput) 
 *
 *  FUNCTION
 *     Creates the core binding strategy string depending on the given request in
 *     the CULL list. This string is written in the config file in order to
 *     tell the shepherd which binding has to be performed.
-*     
+*
+*     When the scheduler already selected the cores for this host they are
+*     bound explicitly. Only if they are not available (any more) the cores
+*     are selected here following the strategy of the request.
 *
 *  INPUTS
 *     lListElem *jep       - CULL list with the core binding request 
+*     const lListElem *jatep - ja task containing the granted resources
 *
 *  OUTPUTS
 *     dstring* result      - Contains the string which is written in config file. 
@@ -2144,12 +2151,13 @@ get_nhosts(const lList *gdil_orig) {
 *     MT-NOTE: create_binding_strategy_string_linux() is not MT safe 
 *
 *******************************************************************************/
-static bool create_binding_strategy_string_linux(dstring *result, lListElem *jep,
+static bool create_binding_strategy_string_linux(dstring *result, lListElem *jep, const lListElem *jatep,
                                                  char **rankfileinput) {
    /* temporary result string with or without "env:" prefix (when environment 
       variable for binding should be set or not) */
    dstring tmp_result = DSTRING_INIT;
-   bool retval;
+   dstring granted_request = DSTRING_INIT;
+   bool retval = false;
 
    /* binding strategy */
    const lListElem *binding_elem = nullptr;
@@ -2174,7 +2182,19 @@ static bool create_binding_strategy_string_linux(dstring *result, lListElem *jep
             sge_dstring_append(result, "pe_");
          }
 
-         if (strcmp(lGetString(binding_elem, BN_strategy), "linear") == 0) {
+         if (get_granted_binding_request(&granted_request, jatep)) {
+            /* bind to the cores the scheduler selected for this host */
+            retval = explicit_linux(&tmp_result, sge_dstring_get_string(&granted_request));
+            if (!retval) {
+               INFO("Core binding: cores %s selected by scheduler are not available",
+                    sge_dstring_get_string(&granted_request));
+               sge_dstring_clear(&tmp_result);
+            }
+         }
+
+         if (retval) {
+            /* already done with the selection of the scheduler */
+         } else if (strcmp(lGetString(binding_elem, BN_strategy), "linear") == 0) {
 
             retval = linear_linux(&tmp_result, binding_elem, false);
 
@@ -2192,7 +2212,7 @@ static bool create_binding_strategy_string_linux(dstring *result, lListElem *jep
 
          } else if (strcmp(lGetString(binding_elem, BN_strategy), "explicit") == 0) {
 
-            retval = explicit_linux(&tmp_result, binding_elem);
+            retval = explicit_linux(&tmp_result, lGetString(binding_elem, BN_parameter_explicit));
 
          } else {
 
@@ -2230,10 +2250,61 @@ static bool create_binding_strategy_string_linux(dstring *result, lListElem *jep
    }
 
    sge_dstring_free(&tmp_result);
+   sge_dstring_free(&granted_request);
 
    DRETURN(retval);
 }
 
+/****** exec_job/get_granted_binding_request() *********************************
+*  NAME
+*     get_granted_binding_request() -- Returns the cores selected by the scheduler
+*
+*  SYNOPSIS
+*     static bool get_granted_binding_request(dstring *request,
+*     const lListElem *jatep)
+*
+*  FUNCTION
+*     The scheduler stores the cores it selected for the core binding of a
+*     job as granted resource of type GRU_BINDING_TYPE per host. The cores
+*     for this host are returned in the format of an explicit binding request.
+*
+*  INPUTS
+*     const lListElem *jatep - ja task containing the granted resources
+*
+*  OUTPUTS
+*     dstring *request       - "explicit:<socket>,<core>:<socket>,<core>..."
+*
+*  RESULT
+*     static bool - true if the scheduler selected cores for this host
+*
+*  NOTES
+*     MT-NOTE: get_granted_binding_request() is MT safe
+*
+*******************************************************************************/
+static bool get_granted_binding_request(dstring *request, const lListElem *jatep) {
+   const char *qualified_hostname = component_get_qualified_hostname();
+   const lListElem *gru;
+   bool ret = false;
+
+   DENTER(TOP_LAYER);
+
+   for_each_ep(gru, lGetList(jatep, JAT_granted_resources_list)) {
+      if (lGetUlong(gru, GRU_type) == GRU_BINDING_TYPE &&
+          sge_hostcmp(lGetHost(gru, GRU_host), qualified_hostname) == 0) {
+         const lListElem *resl;
+
+         sge_dstring_copy_string(request, "explicit");
+         for_each_ep(resl, lGetList(gru, GRU_resource_map_list)) {
+            sge_dstring_sprintf_append(request, ":%s", lGetString(resl, RESL_value));
+            ret = true;
+         }
+         break;
+      }
+   }
+
+   DRETURN(ret);
+}
+
 /****** exec_job/linear_linux() ************************************************
 *  NAME
 *     linear_linux() -- Creates a binding request string from request (CULL list). 
@@ -2473,7 +2544,7 @@ static bool striding_linux(dstring *result, const lListElem *binding_elem, const
 *     explicit_linux() -- Creates a binding request string from request (CULL list).
 *
 *  SYNOPSIS
-*     static bool explicit_linux(dstring* result, lListElem* binding_elem) 
+*     static bool explicit_linux(dstring* result, const char *request) 
 *
 *  FUNCTION
 *     Tries to allocate processor cores according the request in the binding_elem.
@@ -2488,7 +2559,7 @@ static bool striding_linux(dstring *result, const lListElem *binding_elem, const
 *     In case of success the cores were marked internally as beeing bound.
 *
 *  INPUTS
-*     lListElem* binding_elem - List containing the binding request.
+*     const char *request     - The explicit request "explicit:<socket>,<core>:...".
 *
 *  OUTPUTS
 *     dstring* result         - String containing the requested cores if possible.
@@ -2500,9 +2571,7 @@ static bool striding_linux(dstring *result, const lListElem *binding_elem, const
 *     MT-NOTE: explicit_linux() is not MT safe 
 *
 *******************************************************************************/
-static bool explicit_linux(dstring *result, const lListElem *binding_elem) {
-   /* pointer to string which contains the <socket>,<core> pairs */
-   const char *request = nullptr;
+static bool explicit_linux(dstring *result, const char *request) {
 
    /* the topology used by the job */
    char *topo_by_job = nullptr;
@@ -2516,8 +2585,6 @@ static bool explicit_linux(dstring *result, const lListElem *binding_elem) {
 
    DENTER(TOP_LAYER);
 
-   request = (char *) lGetString(binding_elem, BN_parameter_explicit);
-
    /* get the socket and core number lists */ 
    if (!binding_explicit_extract_sockets_cores(request, &socket_list, 
       &socket_list_length, &core_list, &core_list_length)) {
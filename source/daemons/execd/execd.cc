@@ -55,6 +55,7 @@
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_object.h"
 #include "sgeobj/sge_job.h"
+#include "sgeobj/sge_host.h"
 #include "sgeobj/sge_conf.h"
 
 #include "spool/classic/read_write_job.h"
@@ -485,6 +486,7 @@ int sge_execd_register_at_qmaster(bool is_restart) {
       lList *hlp = lCreateList("exechost starting", EH_Type);
       lListElem *hep = lCreateElem(EH_Type);
       lSetUlong(hep, EH_featureset_id, feature_get_active_featureset_id());
+      lSetUlong(hep, EH_capabilities, EH_CAP_JOB_DELIVERY_BATCH);
       lAppendElem(hlp, hep);
 
       /* register at qmaster */
@@ -40,6 +40,8 @@
 #include <unistd.h>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <string>
 
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_bootstrap_env.h"
@@ -64,6 +66,7 @@
 #include "sgeobj/sge_ckpt.h"
 #include "sgeobj/sge_report.h"
 
+#include "gdi/ocs_gdi_execd_delivery.h"
 #include "gdi/sge_security.h"
 
 #include "spool/classic/read_write_job.h"
@@ -82,6 +85,85 @@ extern volatile int jobs_to_start;
 static int handle_job(lListElem *jelem, lListElem *jatep, int slave);
 static int handle_task(lListElem *petrep, char *commproc, char *host, u_short id, sge_pack_buffer *apb);
 
+/* unpacks and starts one job sent by qmaster,
+ * returns 0 if the job is going to be started, 1 if not and -1 if the message cannot be unpacked
+ *
+ * templates holds a copy (without ja_tasks) of the jobs unpacked before from the same message,
+ * task records sent by qmaster for further tasks of these jobs are completed from it,
+ * see pack_job_delivery_task() */
+static int handle_job_delivery(struct_msg_t *aMsg, std::map<std::string, lListElem *> &templates)
+{
+   int ret = 1;
+   lListElem *job, *ja_task;
+   lList *answer_list = nullptr;
+
+   DENTER(TOP_LAYER);
+
+   if (cull_unpack_elem(&(aMsg->buf), &job, nullptr) != PACK_SUCCESS) {
+      ERROR(SFNMAX, MSG_COM_UNPACKJOB);
+      DRETURN(-1);
+   }
+
+   if (job_delivery_is_task(job)) {
+      auto it = templates.find(job_delivery_get_template_key(job));
+      lList *ja_tasks = nullptr;
+
+      if (it == templates.end()) {
+         /* cannot happen, qmaster sends the job before its task records - qmaster will resend the job */
+         ERROR(MSG_EXECD_NOJOBFORTASKRECORD_U, sge_u32c(lGetUlong(job, JB_job_number)));
+         lFreeElem(&job);
+         DRETURN(1);
+      }
+
+      lXchgList(job, JB_ja_tasks, &ja_tasks);
+      lFreeElem(&job);
+      job = lCopyElem(it->second);
+      lSetList(job, JB_ja_tasks, ja_tasks);
+   } else if (!object_verify_cull(job, JB_Type)) {
+      ERROR(SFNMAX, MSG_COM_UNPACKJOB);
+      lFreeElem(&job);
+      DRETURN(-1);
+   } else {
+      std::string key = job_delivery_get_template_key(job);
+
+      if (templates.find(key) == templates.end()) {
+         lList *ja_tasks = nullptr;
+
+         lXchgList(job, JB_ja_tasks, &ja_tasks);
+         templates[key] = lCopyElem(job);
+         lXchgList(job, JB_ja_tasks, &ja_tasks);
+      }
+   }
+
+   if (!job_verify_execd_job(job, &answer_list, component_get_qualified_hostname())) {
+      const char *err_str = lGetString(lFirst(answer_list), AN_text);
+      ja_task = lFirstRW(lGetList(job, JB_ja_tasks));
+
+      /* set the job into error state */
+      execd_job_start_failure(job, ja_task, nullptr, err_str, GFSTATE_JOB);
+
+      /* error output to messages file, cleanup */
+      answer_list_output(&answer_list);
+      ERROR(MSG_EXECD_INVALIDJOBREQUEST_SS, aMsg->snd_name, aMsg->snd_host);
+      lFreeElem(&job);
+      DRETURN(1);
+   }
+
+   /* we expect one jatask to start per job */
+   ja_task = lFirstRW(lGetList(job, JB_ja_tasks));
+   if (ja_task != nullptr) {
+      DPRINTF("new job %ld.%ld\n", (long) lGetUlong(job, JB_job_number), (long) lGetUlong(ja_task, JAT_task_number));
+      ret = handle_job(job, ja_task, 0);
+      if (ret != 0) {
+         lFreeElem(&job);
+      }
+   } else {
+      lFreeElem(&job);
+   }
+
+   DRETURN(ret);
+}
+
 int do_job_exec(struct_msg_t *aMsg, sge_pack_buffer *apb)
 {
    int ret = 1;
@@ -101,42 +183,33 @@ int do_job_exec(struct_msg_t *aMsg, sge_pack_buffer *apb)
     * else it is a request to start a pe task
     */
    if (strcmp(aMsg->snd_name, prognames[QMASTER]) == 0) {
-      lListElem *job, *ja_task;
-      lList *answer_list = nullptr;
-
       if (!sge_security_verify_unique_identifier(true, admin_user, progname, 0,
                                             aMsg->snd_host, aMsg->snd_name, aMsg->snd_id)) {
          DRETURN(0);
       }
-       
-      if (!object_unpack_elem_verify(&answer_list, &(aMsg->buf), &job, JB_Type)) {
-         answer_list_output(&answer_list);
-         ERROR(SFNMAX, MSG_COM_UNPACKJOB);
-         DRETURN(0);
-      }
 
-      if (!job_verify_execd_job(job, &answer_list, component_get_qualified_hostname())) {
-         const char *err_str = lGetString(lFirst(answer_list), AN_text);
-         ja_task = lFirstRW(lGetList(job, JB_ja_tasks));
+      /* qmaster sends all jobs started on this host in one order run as one message,
+       * each one packed with its own featureset */
+      std::map<std::string, lListElem *> templates;
+      while (true) {
+         int job_ret = handle_job_delivery(aMsg, templates);
 
-         /* set the job into error state */
-         execd_job_start_failure(job, ja_task, nullptr, err_str, GFSTATE_JOB);
-
-         /* error output to messages file, cleanup */
-         answer_list_output(&answer_list);
-         ERROR(MSG_EXECD_INVALIDJOBREQUEST_SS, aMsg->snd_name, aMsg->snd_host);
-         lFreeElem(&job);
-         DRETURN(0);
-      }
-
-      /* we expect one jatask to start per request */
-      ja_task = lFirstRW(lGetList(job, JB_ja_tasks));
-      if (ja_task != nullptr) {
-         DPRINTF("new job %ld.%ld\n", (long) lGetUlong(job, JB_job_number), (long) lGetUlong(ja_task, JAT_task_number));
-         ret = handle_job(job, ja_task, 0);
-         if (ret != 0) {
-            lFreeElem(&job);
+         if (job_ret < 0) {
+            break;
+         }
+         if (job_ret == 0) {
+            ret = 0;
          }
+         if (pb_unused(&(aMsg->buf)) <= 0) {
+            break;
+         }
+         if (unpackint(&(aMsg->buf), &feature_set)) {
+            ERROR(SFNMAX, MSG_COM_UNPACKFEATURESET);
+            break;
+         }
+      }
+      for (auto &[key, template_job] : templates) {
+         lFreeElem(&template_job);
       }
    } else {
       /* start a pe task */ 
@@ -206,6 +206,7 @@
 #define MSG_EXECD_CANT_GET_CONFIGURATION_EXIT      _MESSAGE(29186, _("can't get configuration qmaster - terminating"))
 #define MSG_EXECD_REGISTERED_AT_QMASTER_S          _MESSAGE(29187, _("registered at qmaster host " SFQ))
 #define MSG_EXECD_INVALIDJOBREQUEST_SS             _MESSAGE(29188, _("invalid job start order from commproc " SFQ " on host" SFQ))
+#define MSG_EXECD_NOJOBFORTASKRECORD_U              _MESSAGE(29180, _("got task record of job " sge_U32CFormat " without the job - ignoring it"))
 #define MSG_EXECD_INVALIDTASKREQUEST_SS            _MESSAGE(29189, _("invalid pe task start order from commproc " SFQ " on host" SFQ))
 #define MSG_EXECD_ENABLEDELEAYDJOBREPORTING        _MESSAGE(29190,    _("Reconnected to qmaster - enabled delayed job reporting period"))
 #define MSG_EXECD_DISABLEDELEAYDJOBREPORTING       _MESSAGE(29191,    _("Delayed job reporting period finished"))
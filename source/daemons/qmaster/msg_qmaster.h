@@ -163,6 +163,7 @@
 #define MSG_COM_CANT_DELIVER_UNHEARD_SSU  _MESSAGE(33137, _("got max. unheard timeout for target " SFQ " on host " SFQ ", can't deliver job \"" sge_U32CFormat "\""))
 #define MSG_OBJ_UNABLE2FINDCKPT_S     _MESSAGE(33138, _("can't find checkpointing object " SFQ))
 #define MSG_OBJ_UNABLE2CREATECKPT_SU  _MESSAGE(33139, _("can't create checkpointing object " SFQ " for job " sge_U32CFormat))
+#define MSG_COM_SENDJOBSTOHOST_US     _MESSAGE(33140, _("can't send " sge_U32CFormat " job(s) to host " SFQ))
 #define MSG_COM_SENDJOBTOHOST_US      _MESSAGE(33142, _("can't send job \"" sge_U32CFormat"\" to host " SFQ))
 #define MSG_COM_RESENDUNKNOWNJOB_UU   _MESSAGE(33143, _("cannot resend unknown job " sge_U32CFormat "." sge_U32CFormat))
 #define MSG_JOB_UNKNOWNGDIL4TJ_UU     _MESSAGE(33144, _("transfering job " sge_U32CFormat "." sge_U32CFormat " has an invalid gdi list --- deleting"))
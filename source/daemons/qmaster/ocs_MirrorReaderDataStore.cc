@@ -22,14 +22,33 @@
 
 #include "gdi/sge_gdi_packet_internal.h"
 
+#include <sgeobj/ocs_PackCache.h>
 #include <sgeobj/ocs_Session.h>
 
 #include "ocs_MirrorReaderDataStore.h"
 
 #include <sge_tq.h>
 
+/** @brief Removes the objects an event is going to change from the pack cache */
+static sge_callback_result
+pack_cache_invalidate([[maybe_unused]] sge_evc_class_t *evc, sge_object_type type, sge_event_action action,
+                      lListElem *event, [[maybe_unused]] void *clientdata) {
+   // queue instances are packed as part of their cluster queue
+   if (type == SGE_TYPE_QINSTANCE) {
+      type = SGE_TYPE_CQUEUE;
+   }
+   if (ocs::PackCache::is_cacheable(type)) {
+      if (action == SGE_EMA_LIST) {
+         ocs::PackCache::invalidate(type);
+      } else {
+         ocs::PackCache::invalidate(type, lGetString(event, ET_strkey));
+      }
+   }
+   return SGE_EMA_OK;
+}
+
 void ocs::MirrorReaderDataStore::subscribe_events() {
-   sge_mirror_subscribe(evc, SGE_TYPE_ALL, nullptr, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_ALL, pack_cache_invalidate, nullptr, nullptr, nullptr, nullptr);
    evc->ec_set_flush(evc, sgeE_ALL_EVENTS, true, 0);
    evc->ec_set_edtime(evc, 1);
 }
@@ -857,7 +857,10 @@ guess_highest_ar_id() {
 
    /* this function is called during qmaster startup and not while it is running,
       we do not need to monitor this lock */
-   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   sge_lock_set_t lock_set;
+   sge_lock_set_init(&lock_set, false);
+   sge_lock_set_add(&lock_set, LOCK_DOMAIN_JOB, LOCK_READ);
+   SGE_LOCK_SET(&lock_set);
 
    ar = lFirst(master_ar_list);
    if (ar) {
@@ -869,7 +872,7 @@ guess_highest_ar_id() {
       }
    }
 
-   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+   SGE_UNLOCK_SET();
 
    DRETURN(maxid);
 }
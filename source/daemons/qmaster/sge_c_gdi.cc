@@ -35,14 +35,21 @@
 #include <cstring>
 #include <cstdlib>
 #include <cerrno>
+#include <algorithm>
+#include <atomic>
 
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_bootstrap.h"
+#include "uti/sge_lock.h"
 #include "uti/sge_log.h"
+#include "uti/sge_monitor.h"
 #include "uti/sge_rmon_macros.h"
+#include "uti/sge_time.h"
 
 #include "cull/cull.h"
 
 #include "sgeobj/ocs_DataStore.h"
+#include "sgeobj/ocs_PackCache.h"
 #include "sgeobj/cull/sge_all_listsL.h"
 #include "sgeobj/sge_resource_quota.h"
 #include "sgeobj/sge_conf.h"
@@ -60,6 +67,8 @@
 #include "gdi/sge_gdi_packet_pb_cull.h"
 #include "gdi/sge_gdi_packet.h"
 
+#include "sched/sge_cqueue_summary.h"
+
 #include "sge_follow.h"
 #include "sge_advance_reservation_qmaster.h"
 #include "sge_thread_scheduler.h"
@@ -189,11 +198,35 @@ static gdi_object_t gdi_object[] = {
         {SGE_HGRP_LIST,    HGRP_name, HGRP_Type, "host group",              SGE_TYPE_HGROUP,          hgroup_mod,   hgroup_spool,   hgroup_success},
         {SGE_AR_LIST,      AR_id,     AR_Type,   "advance reservation",     SGE_TYPE_AR,              ar_mod,       ar_spool,       ar_success},
         {SGE_DUMMY_LIST,   0,         nullptr,   "general request",         SGE_TYPE_NONE,            nullptr,      nullptr,        nullptr},
+        {SGE_QSTAT,        0,         nullptr,   "cluster queue summary",   SGE_TYPE_NONE,            nullptr,      nullptr,        nullptr},
         {0,                0,         nullptr,   nullptr,                   SGE_TYPE_NONE,            nullptr,      nullptr,        nullptr}
 };
 
 /* *INDENT-ON* */
 
+/*
+ * ids of the latency histograms per GDI operation and object type (stored as id + 1)
+ * the last column is used for unknown object types
+ */
+#define GDI_OBJECT_COUNT (sizeof(gdi_object) / sizeof(gdi_object[0]))
+static std::atomic<int> gdi_latency_ids[SGE_GDI_REPLACE + 1][GDI_OBJECT_COUNT];
+
+static int
+sge_c_gdi_latency_id(int operation, const gdi_object_t *ao, const char *operation_name, const char *target_name) {
+   if (operation < 0 || operation > SGE_GDI_REPLACE) {
+      return -1;
+   }
+
+   size_t object = ao != nullptr ? (size_t) (ao - gdi_object) : GDI_OBJECT_COUNT - 1;
+   int id = gdi_latency_ids[operation][object].load(std::memory_order_relaxed) - 1;
+   if (id < 0) {
+      DSTRING_STATIC(dstr, 128);
+      id = sge_monitor_latency_register(sge_dstring_sprintf(&dstr, "GDI %s %s", operation_name, target_name));
+      gdi_latency_ids[operation][object].store(id + 1, std::memory_order_relaxed);
+   }
+   return id;
+}
+
 void sge_clean_lists() {
    int i = 0;
 
@@ -222,33 +255,36 @@ sge_c_gdi_process_in_listener(sge_gdi_packet_class_t *packet, sge_gdi_task_class
 
    int operation = SGE_GDI_GET_OPERATION(task->command);
    const char *operation_name = sge_gdi_task_get_operation_name(task);
+   SPAN_TRACE_START(gdi_span, "gdi", operation_name, ao != nullptr ? ao->object_name : nullptr);
 
    DPRINTF("GDI %s %s (%s/%s/%d) (%s/%d/%s/%d)\n", operation_name, target_name, packet->host, packet->commproc,
            (int) task->id, packet->user, (int) packet->uid, packet->group, (int) packet->gid);
 
+   u_long64 start_time = sge_get_monotonic_time64();
    sge_pack_buffer *pb = &(packet->pb);
    switch (operation) {
       case SGE_GDI_TRIGGER:
          MONITOR_LIS_GDI_TRIG(monitor);
          sge_c_gdi_trigger_in_listener(packet, task, monitor);
          sge_gdi_packet_pack_task(packet, task, answer_list, pb);
-         DRETURN(true);
+         break;
       case SGE_GDI_PERMCHECK:
          MONITOR_LIS_GDI_PERM(monitor);
          sge_c_gdi_permcheck(packet, task, monitor);
          sge_gdi_packet_pack_task(packet, task, answer_list, pb);
-         DRETURN(true);
+         break;
       case SGE_GDI_GET:
          MONITOR_LIS_GDI_GET(monitor);
          sge_c_gdi_get_in_listener(ao, packet, task, monitor);
          sge_gdi_packet_pack_task(packet, task, answer_list, pb);
-         DRETURN(true);
+         break;
       default:
          // requests that are not handled in listener will be processed in a worker thread
          DRETURN(false);
    }
 
-   DRETURN(false);
+   MONITOR_LATENCY(monitor, sge_c_gdi_latency_id(operation, ao, operation_name, target_name), start_time);
+   DRETURN(true);
 }
 
 bool
@@ -323,6 +359,7 @@ sge_c_gdi_process_in_worker(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t
    int sub_command = SGE_GDI_GET_SUBCOMMAND(task->command);
    int operation = SGE_GDI_GET_OPERATION(task->command);
    const char *operation_name = sge_gdi_task_get_operation_name(task);
+   SPAN_TRACE_START(gdi_span, "gdi", operation_name, ao != nullptr ? ao->object_name : nullptr);
 
 #ifdef OBSERVE
    dstring target_dstr = DSTRING_INIT;
@@ -386,6 +423,7 @@ sge_c_gdi_process_in_worker(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t
            (int) task->id, packet->user, (int) packet->uid, packet->group, (int) packet->gid);
 #endif
 
+   u_long64 start_time = sge_get_monotonic_time64();
    sge_pack_buffer *pb = &(packet->pb);
    switch (operation) {
       case SGE_GDI_GET:
@@ -435,6 +473,207 @@ sge_c_gdi_process_in_worker(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t
          break;
    }
 
+   MONITOR_LATENCY(monitor, sge_c_gdi_latency_id(operation, ao, operation_name, target_name), start_time);
+   DRETURN_VOID;
+}
+
+/****** qmaster/sge_c_gdi/sge_c_gdi_request_latency() *************************
+*  NAME
+*     sge_c_gdi_request_latency() -- store the latency of a handled request
+*
+*  SYNOPSIS
+*     void sge_c_gdi_request_latency(const sge_gdi_packet_class_t *packet,
+*                                    monitoring_t *monitor)
+*
+*  FUNCTION
+*     Stores the time since the packet was created in the
+*     "request GDI", "request report" or "request ACK" latency histogram.
+*     This includes the time the packet waited in the request queue
+*     and for the global lock.
+*
+*  INPUTS
+*     const sge_gdi_packet_class_t *packet - handled packet
+*     monitoring_t *monitor                - monitoring structure of the thread
+*
+*  NOTES
+*     MT-NOTE: sge_c_gdi_request_latency() is MT safe
+*******************************************************************************/
+void
+sge_c_gdi_request_latency(const sge_gdi_packet_class_t *packet, monitoring_t *monitor) {
+   static std::atomic<int> request_latency_ids[PACKET_ACK_REQUEST + 1];
+   static const char *request_latency_names[PACKET_ACK_REQUEST + 1] = {
+      "request GDI", "request report", "request ACK"
+   };
+
+   if (monitor == nullptr || monitor->monitor_time == 0 || packet->request_type > PACKET_ACK_REQUEST) {
+      return;
+   }
+
+   int id = request_latency_ids[packet->request_type].load(std::memory_order_relaxed) - 1;
+   if (id < 0) {
+      id = sge_monitor_latency_register(request_latency_names[packet->request_type]);
+      request_latency_ids[packet->request_type].store(id + 1, std::memory_order_relaxed);
+   }
+   MONITOR_LATENCY(monitor, id, packet->creation_time);
+}
+
+/****** qmaster/sge_c_gdi/sge_c_gdi_lock_domain() *****************************
+*  NAME
+*     sge_c_gdi_lock_domain() -- lock domain of the objects of a GDI target
+*
+*  SYNOPSIS
+*     static sge_locktype_t sge_c_gdi_lock_domain(u_long32 target)
+*
+*  FUNCTION
+*     Returns the domain of the main DS the objects of a GDI target belong to.
+*     Users and projects are part of the job domain because job submission
+*     creates auto users.
+*
+*  INPUTS
+*     u_long32 target - GDI target, e.g. SGE_JB_LIST
+*
+*  RESULT
+*     sge_locktype_t - domain or NUM_OF_LOCK_TYPES for targets without domain
+*
+*  NOTES
+*     MT-NOTE: sge_c_gdi_lock_domain() is MT safe
+*******************************************************************************/
+static sge_locktype_t
+sge_c_gdi_lock_domain(u_long32 target) {
+   switch (target) {
+      case SGE_JB_LIST:
+      case SGE_AR_LIST:
+      case SGE_UU_LIST:
+      case SGE_PR_LIST:
+      case SGE_SME_LIST:
+      case SGE_ZOMBIE_LIST:
+         return LOCK_DOMAIN_JOB;
+      case SGE_AH_LIST:
+      case SGE_SH_LIST:
+      case SGE_EH_LIST:
+      case SGE_CQ_LIST:
+      case SGE_HGRP_LIST:
+      case SGE_QSTAT:
+         return LOCK_DOMAIN_HOST;
+      case SGE_CAL_LIST:
+      case SGE_CE_LIST:
+      case SGE_UM_LIST:
+      case SGE_UO_LIST:
+      case SGE_PE_LIST:
+      case SGE_CONF_LIST:
+      case SGE_SC_LIST:
+      case SGE_US_LIST:
+      case SGE_STN_LIST:
+      case SGE_CK_LIST:
+      case SGE_RQS_LIST:
+         return LOCK_DOMAIN_CONFIG;
+      default:
+         return NUM_OF_LOCK_TYPES;
+   }
+}
+
+/****** qmaster/sge_c_gdi/sge_c_gdi_changes_domain_only() *********************
+*  NAME
+*     sge_c_gdi_changes_domain_only() -- does a task change one domain only?
+*
+*  SYNOPSIS
+*     static bool sge_c_gdi_changes_domain_only(int operation,
+*                                               const sge_gdi_task_class_t *task)
+*
+*  FUNCTION
+*     Declares the GDI operations which only change the objects of the domain
+*     of their target (see sge_c_gdi_lock_domain()) and only read the
+*     objects of other domains.
+*
+*     Job submission changes jobs, auto users and submit users only as long
+*     as the schedulability of the jobs is not verified. The verification
+*     works with the scheduler code on the queues and hosts. A server JSV
+*     which might request the verification re-acquires the locks exclusively
+*     after it was executed (see jsv_do_verify()).
+*
+*  INPUTS
+*     int operation                    - GDI operation, e.g. SGE_GDI_ADD
+*     const sge_gdi_task_class_t *task - task of a GDI packet
+*
+*  RESULT
+*     bool - true if the domain has to be write locked only
+*
+*  NOTES
+*     MT-NOTE: sge_c_gdi_changes_domain_only() is MT safe
+*******************************************************************************/
+static bool
+sge_c_gdi_changes_domain_only(int operation, const sge_gdi_task_class_t *task) {
+   if (operation == SGE_GDI_ADD && task->target == SGE_JB_LIST) {
+      const lListElem *job;
+
+      for_each_ep(job, task->data_list) {
+         if (lGetPosViaElem(job, JB_verify_suitable_queues, SGE_NO_ABORT) < 0 ||
+             lGetUlong(job, JB_verify_suitable_queues) != SKIP_VERIFY) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   return false;
+}
+
+/****** qmaster/sge_c_gdi/sge_c_gdi_get_lock_set() ****************************
+*  NAME
+*     sge_c_gdi_get_lock_set() -- locks needed to handle a request
+*
+*  SYNOPSIS
+*     void sge_c_gdi_get_lock_set(const sge_gdi_packet_class_t *packet,
+*                                 sge_lock_set_t *lock_set)
+*
+*  FUNCTION
+*     Returns the lock set a worker thread has to acquire before it
+*     handles the tasks of a packet.
+*
+*     GET requests read lock the domain of their target, requests of all
+*     other operations declared in sge_c_gdi_changes_domain_only() write lock
+*     it. Independent of the target the host and configuration domains are
+*     read locked because the permission checks of all requests look at
+*     admin and submit hosts, managers, operators and usersets.
+*
+*     Report and ACK requests as well as all other GDI requests need
+*     exclusive access to the main DS.
+*
+*  INPUTS
+*     const sge_gdi_packet_class_t *packet - packet to be handled
+*     sge_lock_set_t *lock_set             - out: locks to acquire
+*
+*  NOTES
+*     MT-NOTE: sge_c_gdi_get_lock_set() is MT safe
+*******************************************************************************/
+void
+sge_c_gdi_get_lock_set(const sge_gdi_packet_class_t *packet, sge_lock_set_t *lock_set) {
+   DENTER(TOP_LAYER);
+
+   if (packet->request_type != PACKET_GDI_REQUEST) {
+      // PACKET_REPORT_REQUEST or PACKET_ACK_REQUEST
+      sge_lock_set_init(lock_set, true);
+      DRETURN_VOID;
+   }
+
+   sge_lock_set_init(lock_set, false);
+   sge_lock_set_add(lock_set, LOCK_DOMAIN_HOST, LOCK_READ);
+   sge_lock_set_add(lock_set, LOCK_DOMAIN_CONFIG, LOCK_READ);
+
+   for (const sge_gdi_task_class_t *task = packet->first_task; task != nullptr; task = task->next) {
+      int operation = SGE_GDI_GET_OPERATION(task->command);
+      sge_locktype_t domain = sge_c_gdi_lock_domain(task->target);
+
+      if (operation == SGE_GDI_GET) {
+         sge_lock_set_add(lock_set, domain != NUM_OF_LOCK_TYPES ? domain : LOCK_DOMAIN_JOB, LOCK_READ);
+      } else if (domain != NUM_OF_LOCK_TYPES && sge_c_gdi_changes_domain_only(operation, task)) {
+         sge_lock_set_add(lock_set, domain, LOCK_WRITE);
+      } else {
+         sge_lock_set_init(lock_set, true);
+         break;
+      }
+   }
+
    DRETURN_VOID;
 }
 
@@ -474,7 +713,14 @@ static void
 sge_c_gdi_get_in_worker(gdi_object_t *ao, sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task, monitoring_t *monitor) {
    DENTER(TOP_LAYER);
 
-   /* Whatever client sent with this get request - we don't need it */
+   /* Except for the position of a paged request whatever client sent with this get request - we don't need it */
+   u_long32 page_limit = 0;
+   u_long32 page_cursor = 0;
+   const lListElem *page = lFirst(task->data_list);
+   if (page != nullptr && lGetPosViaElem(page, PG_limit, SGE_NO_ABORT) >= 0) {
+      page_limit = std::min(lGetUlong(page, PG_limit), (u_long32) SGE_GDI_PAGE_MAX);
+      page_cursor = lGetUlong(page, PG_cursor);
+   }
    lFreeList(&(task->data_list));
 
    switch (task->target) {
@@ -497,6 +743,23 @@ sge_c_gdi_get_in_worker(gdi_object_t *ao, sge_gdi_packet_class_t *packet, sge_gd
          lFreeList(&conf);
       }
          DRETURN_VOID;
+      case SGE_QSTAT:
+      {
+         // the summary is calculated from the lists of the data store the request is executed with
+         // (usually the READER DS) so that clients like "qstat -g c" need not to fetch all lists
+         const lList *master_cqueue_list = *ocs::DataStore::get_master_list(SGE_TYPE_CQUEUE);
+         const lList *master_exechost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
+         const lList *master_centry_list = *ocs::DataStore::get_master_list(SGE_TYPE_CENTRY);
+         lList *summary_list = cqueue_list_calculate_summary(master_cqueue_list, master_exechost_list,
+                                                             master_centry_list);
+
+         task->data_list = lSelectHashPack("", summary_list, task->condition, task->enumeration, false, nullptr);
+         task->do_select_pack_simultaneous = false;
+         snprintf(SGE_EVENT, SGE_EVENT_SIZE, SFNMAX, MSG_GDI_OKNL);
+         answer_list_add(&(task->answer_list), SGE_EVENT, STATUS_OK, ANSWER_QUALITY_END);
+         lFreeList(&summary_list);
+      }
+         DRETURN_VOID;
       default:
 
          /*
@@ -528,11 +791,27 @@ sge_c_gdi_get_in_worker(gdi_object_t *ao, sge_gdi_packet_class_t *packet, sge_gd
                snprintf(SGE_EVENT, SGE_EVENT_SIZE, SFNMAX, MSG_GDI_OKNL);
                answer_list_add(&(task->answer_list), SGE_EVENT, STATUS_OK, ANSWER_QUALITY_END);
 
+            } else if (page_limit > 0 && sge_gdi_page_key(task->target) != NoName) {
+               /*
+                * paged request: only one page is selected and packed, this limits the size
+                * of the pack buffer and the time the data store is locked for huge lists
+                */
+               task->data_list = lSelectPage("", data_source, task->condition, task->enumeration,
+                                             sge_gdi_page_key(task->target), page_cursor, page_limit);
+               task->do_select_pack_simultaneous = false;
+               snprintf(SGE_EVENT, SGE_EVENT_SIZE, SFNMAX, MSG_GDI_OKNL);
+               answer_list_add(&(task->answer_list), SGE_EVENT, STATUS_OK, ANSWER_QUALITY_END);
             } else {
                /* lSelect will be postponed till packing */
                task->data_list = data_source;
                task->do_select_pack_simultaneous = true;
 
+               /* objects of the reader data store are only changed by its event mirror thread */
+               if (ocs::DataStore::get_active_ds() == ocs::DataStore::READER &&
+                   ocs::PackCache::is_cacheable_request(ao->list_type, task->condition, task->enumeration)) {
+                  task->pack_cache_type = ao->list_type;
+               }
+
                /*
                 * answer list creation is also done during packing!!!!
                 */
@@ -580,6 +859,9 @@ sge_c_gdi_add(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
                                  (event_client_update_func_t) nullptr, nullptr);
          }
       }
+   } else if (task->target == SGE_JB_LIST && lGetNumberOfElem(task->data_list) > 1) {
+      /* bulk submission: all jobs are spooled in one transaction */
+      sge_gdi_add_job_list(&(task->data_list), &(task->answer_list), packet, task, monitor);
    } else if (task->target == SGE_JB_LIST) {
       lListElem *next;
 
@@ -617,6 +899,7 @@ sge_c_gdi_add(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
 
       if (task->target == SGE_ORDER_LIST) {
          sge_set_commit_required();
+         sge_follow_order_begin_batch();
       }
 
       next = lFirstRW(task->data_list);
@@ -681,6 +964,7 @@ sge_c_gdi_add(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
       } /* while loop */
 
       if (task->target == SGE_ORDER_LIST) {
+         sge_follow_order_flush_batch(monitor, packet->gdi_session);
          sge_commit(packet->gdi_session);
          sge_set_next_spooling_time();
          answer_list_add(&(task->answer_list), "OK\n", STATUS_OK, ANSWER_QUALITY_INFO);
@@ -1512,6 +1796,7 @@ sge_task_check_get_perm_host(sge_gdi_packet_class_t *packet, sge_gdi_task_class_
       case SGE_RQS_LIST:
       case SGE_AR_LIST:
       case SGE_DUMMY_LIST:
+      case SGE_QSTAT:
          /* host must be admin or submit host */
          if (!host_list_locate(*ocs::DataStore::get_master_list(SGE_TYPE_ADMINHOST), host) &&
              !host_list_locate(*ocs::DataStore::get_master_list(SGE_TYPE_SUBMITHOST), host)) {
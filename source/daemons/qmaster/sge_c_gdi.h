@@ -39,6 +39,7 @@
 
 #endif
 
+#include "uti/sge_lock.h"
 #include "uti/sge_monitor.h"
 
 #include "cull/cull.h"
@@ -110,6 +111,12 @@ void
 sge_c_gdi_process_in_worker(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task, lList **answer_list,
                             monitoring_t *monitor);
 
+void
+sge_c_gdi_request_latency(const sge_gdi_packet_class_t *packet, monitoring_t *monitor);
+
+void
+sge_c_gdi_get_lock_set(const sge_gdi_packet_class_t *packet, sge_lock_set_t *lock_set);
+
 int
 sge_gdi_add_mod_generic(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task, lList **alpp, lListElem *instructions, int add, gdi_object_t *object,
                         const char *ruser, const char *rhost, int sub_command, lList **ppList, monitoring_t *monitor);
@@ -35,6 +35,8 @@
 /*___INFO__MARK_END__*/
 #include <cstring>
 #include <pthread.h>
+#include <set>
+#include <vector>
 
 #include "uti/sge_bitfield.h"
 #include "uti/sge_string.h"
@@ -109,6 +111,16 @@ static sge_follow_t Follow_Control = {
         nullptr
 };
 
+/* jobs started while processing an order list, spooled and announced once by sge_follow_order_flush_batch() */
+typedef struct {
+   bool active;
+   std::vector<u_long32> jobs;   /* in the order of the first start order */
+   std::set<u_long32> known;
+} sge_follow_batch_t;
+
+/* guarded by the global lock, see sge_follow_order_begin_batch() */
+static sge_follow_batch_t Follow_Batch;
+
 static int ticket_orders_field[] = {OR_job_number,
                                     OR_ja_task_number,
                                     OR_ticket,
@@ -155,6 +167,89 @@ sge_set_next_spooling_time() {
    DRETURN_VOID;
 }
 
+/****** sge_follow/sge_follow_order_begin_batch() ******************************
+*  NAME
+*     sge_follow_order_begin_batch() -- start batched order processing
+*
+*  SYNOPSIS
+*     void sge_follow_order_begin_batch()
+*
+*  FUNCTION
+*     Switches the processing of job start orders into batch mode until
+*     sge_follow_order_flush_batch() is called:
+*
+*        - for each started task only the ja_task is spooled
+*        - the job object is spooled once per job and only one sgeE_JOB_MOD
+*          event is sent per job, containing all started tasks
+*        - the deliveries to the execution daemons are coalesced into one
+*          message per execution host, see sge_give_job_begin_batch()
+*
+*     When an array job starts thousands of tasks in one scheduling run this
+*     avoids spooling the job and sending the complete job in an event for
+*     every single task.
+*
+*  NOTES
+*     MT-NOTE: sge_follow_order_begin_batch() is not MT safe, the caller must
+*     MT-NOTE: hold the global lock until sge_follow_order_flush_batch()
+*
+*  SEE ALSO
+*     qmaster/sge_follow/sge_follow_order_flush_batch()
+*******************************************************************************/
+void
+sge_follow_order_begin_batch() {
+   Follow_Batch.active = true;
+   sge_give_job_begin_batch();
+}
+
+/****** sge_follow/sge_follow_order_flush_batch() ******************************
+*  NAME
+*     sge_follow_order_flush_batch() -- finish batched order processing
+*
+*  SYNOPSIS
+*     void sge_follow_order_flush_batch(monitoring_t *monitor, u_long64 gdi_session)
+*
+*  FUNCTION
+*     Spools the jobs which got tasks started since
+*     sge_follow_order_begin_batch(), sends one sgeE_JOB_MOD event per job
+*     and sends the collected job deliveries to the execution daemons.
+*
+*  INPUTS
+*     monitoring_t *monitor - monitoring structure
+*     u_long64 gdi_session  - gdi session of the order request
+*
+*  NOTES
+*     MT-NOTE: sge_follow_order_flush_batch() is not MT safe, see
+*     MT-NOTE: sge_follow_order_begin_batch()
+*******************************************************************************/
+void
+sge_follow_order_flush_batch(monitoring_t *monitor, u_long64 gdi_session) {
+   const lList *master_job_list = *ocs::DataStore::get_master_list(SGE_TYPE_JOB);
+
+   DENTER(TOP_LAYER);
+
+   for (u_long32 job_number : Follow_Batch.jobs) {
+      lListElem *jep = lGetElemUlongRW(master_job_list, JB_job_number, job_number);
+
+      /* the job might have been removed by a later order */
+      if (jep != nullptr) {
+         lList *answer_list = nullptr;
+
+         sge_event_spool(&answer_list, 0, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, lGetString(jep, JB_session),
+                         jep, nullptr, nullptr, true, true, gdi_session);
+         answer_list_output(&answer_list);
+      }
+   }
+   DPRINTF("batched order processing spooled %zu jobs\n", Follow_Batch.jobs.size());
+
+   Follow_Batch.jobs.clear();
+   Follow_Batch.known.clear();
+   Follow_Batch.active = false;
+
+   sge_give_job_flush_batch(monitor, gdi_session);
+
+   DRETURN_VOID;
+}
+
 /**********************************************************************
  Gets an order and executes it.
 
@@ -579,10 +674,21 @@ sge_follow_order(lListElem *ep, char *ruser, char *rhost, lList **topp, monitori
             lList *answer_list = nullptr;
             const char *session = lGetString(jep, JB_session);
 
-            /* spool job and ja_task in one transaction, send job mod event */
-            sge_event_spool(&answer_list, 0, sgeE_JOB_MOD,
-                            job_number, task_number, nullptr, nullptr, session,
-                            jep, jatp, nullptr, true, true, gdi_session);
+            if (Follow_Batch.active) {
+               /* spool only the ja_task, the job is spooled and its mod event
+                * is sent once per batch by sge_follow_order_flush_batch() */
+               sge_event_spool(&answer_list, 0, sgeE_JATASK_MOD,
+                               job_number, task_number, nullptr, nullptr, session,
+                               jep, jatp, nullptr, false, true, gdi_session);
+               if (Follow_Batch.known.insert(job_number).second) {
+                  Follow_Batch.jobs.push_back(job_number);
+               }
+            } else {
+               /* spool job and ja_task in one transaction, send job mod event */
+               sge_event_spool(&answer_list, 0, sgeE_JOB_MOD,
+                               job_number, task_number, nullptr, nullptr, session,
+                               jep, jatp, nullptr, true, true, gdi_session);
+            }
             answer_list_output(&answer_list);
          }
 
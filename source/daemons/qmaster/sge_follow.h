@@ -38,6 +38,12 @@
 #include "sgeobj/sge_daemonize.h"
 #include "sge_qmaster_timed_event.h"
 
+void
+sge_follow_order_begin_batch();
+
+void
+sge_follow_order_flush_batch(monitoring_t *monitor, u_long64 gdi_session);
+
 int
 sge_follow_order(lListElem *order, char *ruser, char *rhost, lList **topp, monitoring_t *monitor, u_long64 gdi_session);
 
@@ -35,6 +35,9 @@
 /*___INFO__MARK_END__*/
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <set>
+#include <string>
 #include <unistd.h>
 #include <ctime>
 #include <signal.h>
@@ -184,6 +187,116 @@ static int queue_field[] = {QU_qhostname,
                             QU_h_vmem,
                             NoName};
 
+/* job deliveries of one execution host collected while a batch is active */
+typedef struct {
+   sge_pack_buffer pb;
+   u_long32 jobs;
+   std::set<std::string> templates;   /* template keys of the jobs already contained in pb */
+} host_delivery_t;
+
+typedef struct {
+   bool active;
+   std::map<std::string, host_delivery_t> hosts;
+} delivery_batch_t;
+
+/* guarded by the global lock, see sge_give_job_begin_batch() */
+static delivery_batch_t Delivery_Batch;
+
+/****** sge_give_jobs/sge_give_job_begin_batch() *******************************
+*  NAME
+*     sge_give_job_begin_batch() -- start collecting job deliveries per host
+*
+*  SYNOPSIS
+*     void sge_give_job_begin_batch()
+*
+*  FUNCTION
+*     Until sge_give_job_flush_batch() is called, the deliveries of master
+*     tasks are not sent as one message per job. They are packed into one
+*     buffer per execution host instead and sent as one message per host
+*     by sge_give_job_flush_batch(). The execution daemon starts all jobs
+*     contained in a TAG_JOB_EXECUTION message from qmaster.
+*
+*     Further tasks of an array job already contained in the message of a
+*     host are packed as task records without the job (script, environment,
+*     requests, ...), see pack_job_delivery_task().
+*
+*     Slave task deliveries (TAG_SLAVE_ALLOW) and jobs having Kerberos
+*     credentials attached are still sent immediately. So are deliveries to
+*     execds which did not announce EH_CAP_JOB_DELIVERY_BATCH when they
+*     registered, e.g. older execds, see job_delivery_is_batch_supported().
+*
+*  NOTES
+*     MT-NOTE: sge_give_job_begin_batch() is not MT safe, the caller must
+*     MT-NOTE: hold the global lock until sge_give_job_flush_batch()
+*
+*  SEE ALSO
+*     qmaster/sge_give_jobs/sge_give_job_flush_batch()
+*******************************************************************************/
+void
+sge_give_job_begin_batch() {
+   Delivery_Batch.active = true;
+}
+
+/****** sge_give_jobs/sge_give_job_flush_batch() *******************************
+*  NAME
+*     sge_give_job_flush_batch() -- send the collected job deliveries
+*
+*  SYNOPSIS
+*     void sge_give_job_flush_batch(monitoring_t *monitor, u_long64 gdi_session)
+*
+*  FUNCTION
+*     Sends one TAG_JOB_EXECUTION message per execution host containing all
+*     job deliveries collected since sge_give_job_begin_batch() and ends
+*     the batch.
+*
+*     If a message cannot be sent the host is marked as unheard. The jobs
+*     are already in transfering state, so they are handled by the job
+*     resend timer like jobs which were not acknowledged by the execd.
+*
+*  INPUTS
+*     monitoring_t *monitor - monitoring structure
+*     u_long64 gdi_session  - gdi session of the order request
+*
+*  NOTES
+*     MT-NOTE: sge_give_job_flush_batch() is not MT safe, see
+*     MT-NOTE: sge_give_job_begin_batch()
+*******************************************************************************/
+void
+sge_give_job_flush_batch(monitoring_t *monitor, u_long64 gdi_session) {
+   const lList *master_exechost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
+
+   DENTER(TOP_LAYER);
+
+   for (auto &[host, delivery] : Delivery_Batch.hosts) {
+      if (delivery.jobs == 0) {
+         clear_packbuffer(&delivery.pb);
+         continue;
+      }
+
+      u_long32 dummymid = 0;
+      int failed = gdi_send_message_pb(0, prognames[EXECD], 1, host.c_str(), TAG_JOB_EXECUTION,
+                                       &delivery.pb, &dummymid);
+      MONITOR_MESSAGES_OUT(monitor);
+
+      if (failed != CL_RETVAL_OK) {
+         ERROR(MSG_COM_SENDJOBSTOHOST_US, sge_u32c(delivery.jobs), host.c_str());
+         ERROR("commlib error: %s\n", cl_get_error_text(failed));
+         lListElem *hep = host_list_locate(master_exechost_list, host.c_str());
+         if (hep != nullptr) {
+            sge_mark_unheard(hep, gdi_session);
+         }
+      } else {
+         DPRINTF("successfully sent " sge_u32 " jobs to host \"%s\"\n", delivery.jobs, host.c_str());
+      }
+      clear_packbuffer(&delivery.pb);
+   }
+
+   Delivery_Batch.hosts.clear();
+   Delivery_Batch.active = false;
+
+   DRETURN_VOID;
+}
+
 
 /************************************************************************
  Master function to give job to the execd.
@@ -491,6 +604,9 @@ send_job(const char *rhost, lListElem *jep, lListElem *jatep, lListElem *hep, in
    lEnumeration *what;
    const lList *master_centry_list = *ocs::DataStore::get_master_list(SGE_TYPE_CENTRY);
    const lList *master_cqueue_list = *ocs::DataStore::get_master_list(SGE_TYPE_CQUEUE);
+   host_delivery_t *delivery = nullptr;
+   std::string template_key;
+   bool is_task_record = false;
 
    DENTER(TOP_LAYER);
 
@@ -506,17 +622,41 @@ send_job(const char *rhost, lListElem *jep, lListElem *jatep, lListElem *hep, in
    }
    // @todo: we do lots of things *with* simulate_execd, why? Just create the timed event.
 
+   /*
+   ** while a batch is active the delivery is appended to the one of the host,
+   ** execds which did not announce that they can handle it get one message per job
+   */
+   if (Delivery_Batch.active && master && !simulate_execd && lGetString(jep, JB_tgt) == nullptr &&
+       job_delivery_is_batch_supported(hep)) {
+      auto it = Delivery_Batch.hosts.find(rhost);
+
+      if (it == Delivery_Batch.hosts.end()) {
+         it = Delivery_Batch.hosts.emplace(rhost, host_delivery_t{}).first;
+         if (init_packbuffer(&it->second.pb, 0, 0) != PACK_SUCCESS) {
+            Delivery_Batch.hosts.erase(it);
+            DRETURN(-1);
+         }
+      }
+      delivery = &it->second;
+   }
+
    if ((tmpjep = copyJob(jep, jatep)) == nullptr) {
       DRETURN(-1);
    } else {
       tmpjatep = lFirstRW(lGetList(tmpjep, JB_ja_tasks));
    }
 
+   /* is the job already contained in the delivery to this host? */
+   if (delivery != nullptr) {
+      template_key = job_delivery_get_template_key(tmpjep);
+      is_task_record = delivery->templates.count(template_key) > 0;
+   }
+
    /* load script into job structure for sending to execd */
    /*
    ** if exec_file is not set, then this is an interactive job
    */
-   if (master && lGetString(tmpjep, JB_exec_file) && !JOB_TYPE_IS_BINARY(lGetUlong(jep, JB_type))) {
+   if (master && !is_task_record && lGetString(tmpjep, JB_exec_file) && !JOB_TYPE_IS_BINARY(lGetUlong(jep, JB_type))) {
       if (!spool_read_script(nullptr, lGetUlong(tmpjep, JB_job_number), tmpjep)) {
          lFreeElem(&tmpjep);
          DRETURN(-1);
@@ -598,6 +738,21 @@ send_job(const char *rhost, lListElem *jep, lListElem *jatep, lListElem *hep, in
    */
    lSetList(tmpjep, JB_ja_template, nullptr);
 
+   if (delivery != nullptr) {
+      if (is_task_record) {
+         pack_job_delivery_task(&delivery->pb, tmpjep);
+      } else {
+         pack_job_delivery(&delivery->pb, tmpjep);
+         delivery->templates.insert(template_key);
+      }
+      delivery->jobs++;
+      lFreeElem(&tmpjep);
+
+      DPRINTF("added %s " sge_u32 " to the delivery to host \"%s\"\n", is_task_record ? "task of job" : "job",
+              lGetUlong(jep, JB_job_number), rhost);
+      DRETURN(0);
+   }
+
    if (init_packbuffer(&pb, 0, 0) != PACK_SUCCESS) {
       lFreeElem(&tmpjep);
       DRETURN(-1);
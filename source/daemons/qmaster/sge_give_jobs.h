@@ -62,6 +62,10 @@ typedef enum {
 
 int sge_give_job(lListElem *jep, lListElem *jatep, const lListElem *master_qep, lListElem *hep, monitoring_t *monitor, u_long64 gdi_session);
 
+void sge_give_job_begin_batch();
+
+void sge_give_job_flush_batch(monitoring_t *monitor, u_long64 gdi_session);
+
 void sge_commit_job(lListElem *jep, lListElem *jatep, lListElem *jr, sge_commit_mode_t mode,
                     int commit_flags, monitoring_t *monitor, u_long64 gdi_session);
 
@@ -1227,6 +1227,7 @@ sge_execd_startedup(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
    }
 
    lSetUlong(hep, EH_featureset_id, lGetUlong(host, EH_featureset_id));
+   lSetUlong(hep, EH_capabilities, lGetUlong(host, EH_capabilities));
    lSetUlong(hep, EH_report_seqno, 0);
 
    /*
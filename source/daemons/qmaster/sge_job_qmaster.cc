@@ -37,6 +37,7 @@
 #include <cstring>
 #include <cerrno>
 #include <cctype>
+#include <vector>
 
 #include "uti/sge_bitfield.h"
 #include "uti/sge_bootstrap.h"
@@ -200,24 +201,19 @@ sge_delete_all_tasks_of_job(const sge_gdi_packet_class_t *packet, lList **alpp,
    */
 static const char JOB_NAME_DEL = ':';
 
-/*-------------------------------------------------------------------------*/
-/* jepp is set to nullptr, if the job was successfully added                   */
-/*                                                                         */
-/* MT-Note: it is thread safe. It is using the global lock to secure the   */
-/*          none safe functions                                            */
-/*-------------------------------------------------------------------------*/
-int
-sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
-                sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
-                monitoring_t *monitor) {
-   int ret;
+/*
+ * JSV part of the first step of a job submission: the server JSV, if one
+ * is configured, verifies the job and might change it
+ *
+ * jsv_do_verify() releases the locks while it waits for the JSV
+ */
+static int
+job_add_jsv(lListElem **jep, lList **alpp, lList **lpp,
+            sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
+            monitoring_t *monitor) {
+   int ret = STATUS_OK;
    bool lret;
-   u_long32 start;
-   u_long32 end;
-   u_long32 step;
    cl_thread_settings_t *tc = cl_thread_get_thread_config();
-   lList **master_job_list = ocs::DataStore::get_master_list_rw(SGE_TYPE_JOB);
-   lList **master_suser_list = ocs::DataStore::get_master_list_rw(SGE_TYPE_SUSER);
 
    DENTER(TOP_LAYER);
 
@@ -239,63 +235,105 @@ sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
       gettimeofday(&start_time, nullptr);
       lret = jsv_do_verify(tc->thread_name, jep, alpp, true);
       gettimeofday(&end_time, nullptr);
+
+      u_long64 jsv_usec = (end_time.tv_sec - start_time.tv_sec) * 1000000 + (end_time.tv_usec - start_time.tv_usec);
+      MONITOR_JSV(monitor, jsv_usec);
       if (((end_time.tv_sec - start_time.tv_sec) * 1000 + (end_time.tv_usec - start_time.tv_usec) / 1000)
           > jsv_threshold || jsv_threshold == 0) {
          INFO(MSG_JSV_THRESHOLD_UU, sge_u32c(lGetUlong(*jep, JB_job_number)), sge_u32c((end_time.tv_sec - start_time.tv_sec) * 1000 + (end_time.tv_usec - start_time.tv_usec) / 1000));
       }
       if (!lret) {
-         DRETURN(STATUS_EUNKNOWN);
+         ret = STATUS_EUNKNOWN;
       }
    }
 
+   DRETURN(ret);
+}
+
+/*
+ * first step of a job submission: JSV and verification of the job,
+ * the job gets its job id here
+ */
+static int
+job_add_verify(lListElem **jep, lList **alpp, lList **lpp,
+               sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
+               monitoring_t *monitor) {
+   int ret;
+
+   DENTER(TOP_LAYER);
+
+   ret = job_add_jsv(jep, alpp, lpp, packet, task, monitor);
+   if (ret != STATUS_OK) {
+      DRETURN(ret);
+   }
+
    /*
     * second try to find something strange
     */
    ret = sge_job_verify_adjust(*jep, alpp, lpp, packet, task, monitor);
-   if (ret != STATUS_OK) {
-      DRETURN(ret);
-   }
+   DRETURN(ret);
+}
+
+/*
+ * second step of a job submission: write the script and the job object,
+ * the caller has to open and to close the spooling transaction
+ */
+static int
+job_add_spool(lListElem *jep, lList **alpp, const sge_gdi_packet_class_t *packet, bool send_event) {
+   DENTER(TOP_LAYER);
 
    /* write script to file */
-   spool_transaction(alpp, spool_get_default_context(), STC_begin);
-   if (lGetString(*jep, JB_script_file) &&
-       !JOB_TYPE_IS_BINARY(lGetUlong(*jep, JB_type))) {
-      if (!spool_write_script(alpp, lGetUlong(*jep, JB_job_number), *jep)) {
-         spool_transaction(alpp, spool_get_default_context(), STC_rollback);
-         ERROR(MSG_JOB_NOWRITE_US, sge_u32c(lGetUlong(*jep, JB_job_number)), strerror(errno));
+   if (lGetString(jep, JB_script_file) &&
+       !JOB_TYPE_IS_BINARY(lGetUlong(jep, JB_type))) {
+      if (!spool_write_script(alpp, lGetUlong(jep, JB_job_number), jep)) {
+         ERROR(MSG_JOB_NOWRITE_US, sge_u32c(lGetUlong(jep, JB_job_number)), strerror(errno));
          answer_list_add(alpp, SGE_EVENT, STATUS_EDISK, ANSWER_QUALITY_ERROR);
          DRETURN(STATUS_EDISK);
       }
    }
 
    /* clean file out of memory */
-   lSetString(*jep, JB_script_ptr, nullptr);
-   lSetUlong(*jep, JB_script_size, 0);
+   lSetString(jep, JB_script_ptr, nullptr);
+   lSetUlong(jep, JB_script_size, 0);
 
    if (!sge_event_spool(alpp, 0, sgeE_JOB_ADD,
-                        lGetUlong(*jep, JB_job_number), 0, nullptr, nullptr, nullptr,
-                        *jep, nullptr, nullptr, true, true, packet->gdi_session)) {
-      spool_transaction(alpp, spool_get_default_context(), STC_rollback);
-      ERROR(MSG_JOB_NOWRITE_U, sge_u32c(lGetUlong(*jep, JB_job_number)));
+                        lGetUlong(jep, JB_job_number), 0, nullptr, nullptr, nullptr,
+                        jep, nullptr, nullptr, send_event, true, packet->gdi_session)) {
+      ERROR(MSG_JOB_NOWRITE_U, sge_u32c(lGetUlong(jep, JB_job_number)));
       answer_list_add(alpp, SGE_EVENT, STATUS_EDISK, ANSWER_QUALITY_ERROR);
-      if ((lGetString(*jep, JB_exec_file) != nullptr)) {
-         unlink(lGetString(*jep, JB_exec_file));
-         lSetString(*jep, JB_exec_file, nullptr);
+      if ((lGetString(jep, JB_exec_file) != nullptr)) {
+         unlink(lGetString(jep, JB_exec_file));
+         lSetString(jep, JB_exec_file, nullptr);
       }
       DRETURN(STATUS_EDISK);
    }
-   spool_transaction(alpp, spool_get_default_context(), STC_commit);
 
-   if (!job_is_array(*jep)) {
-      DPRINTF("Added Job " sge_u32"\n", lGetUlong(*jep, JB_job_number));
+   DRETURN(STATUS_OK);
+}
+
+/*
+ * last step of a job submission: make the spooled job known in the master job list
+ */
+static int
+job_add_register(lListElem *jep, lList **alpp, lList **lpp, const sge_gdi_packet_class_t *packet) {
+   u_long32 start;
+   u_long32 end;
+   u_long32 step;
+   lList **master_job_list = ocs::DataStore::get_master_list_rw(SGE_TYPE_JOB);
+   lList **master_suser_list = ocs::DataStore::get_master_list_rw(SGE_TYPE_SUSER);
+
+   DENTER(TOP_LAYER);
+
+   if (!job_is_array(jep)) {
+      DPRINTF("Added Job " sge_u32"\n", lGetUlong(jep, JB_job_number));
    } else {
-      job_get_submit_task_ids(*jep, &start, &end, &step);
+      job_get_submit_task_ids(jep, &start, &end, &step);
       DPRINTF("Added JobArray " sge_u32"." sge_u32"-" sge_u32":" sge_u32"\n",
-              lGetUlong(*jep, JB_job_number), start, end, step);
+              lGetUlong(jep, JB_job_number), start, end, step);
    }
 
    /* add into job list */
-   if (job_list_add_job(master_job_list, "master job list", lCopyElem(*jep), 0)) {
+   if (job_list_add_job(master_job_list, "master job list", lCopyElem(jep), 0)) {
       answer_list_add(alpp, SGE_EVENT, STATUS_EDISK, ANSWER_QUALITY_ERROR);
       DRETURN(STATUS_EUNKNOWN);
    }
@@ -309,27 +347,20 @@ sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
     * make checks earlier
     */
 
-   /*
-   ** immediate jobs trigger scheduling immediately
-   */
-   if (JOB_TYPE_IS_IMMEDIATE(lGetUlong(*jep, JB_type))) {
-      sge_deliver_events_immediately(EV_ID_SCHEDD);
-   }
-
-   if (!job_is_array(*jep)) {
+   if (!job_is_array(jep)) {
       snprintf(SGE_EVENT, SGE_EVENT_SIZE, MSG_JOB_SUBMITJOB_US,
-               sge_u32c(lGetUlong(*jep, JB_job_number)), lGetString(*jep, JB_job_name));
+               sge_u32c(lGetUlong(jep, JB_job_number)), lGetString(jep, JB_job_name));
    } else {
-      snprintf(SGE_EVENT, SGE_EVENT_SIZE, MSG_JOB_SUBMITJOBARRAY_UUUUS, sge_u32c(lGetUlong(*jep, JB_job_number)),
-               sge_u32c(start), sge_u32c(end), sge_u32c(step), lGetString(*jep, JB_job_name));
+      snprintf(SGE_EVENT, SGE_EVENT_SIZE, MSG_JOB_SUBMITJOBARRAY_UUUUS, sge_u32c(lGetUlong(jep, JB_job_number)),
+               sge_u32c(start), sge_u32c(end), sge_u32c(step), lGetString(jep, JB_job_name));
    }
    answer_list_add(alpp, SGE_EVENT, STATUS_OK, ANSWER_QUALITY_INFO);
 
    /* do job logging */
-   ocs::ReportingFileWriter::create_new_job_records(nullptr, *jep);
-   ocs::ReportingFileWriter::create_job_logs(nullptr, lGetUlong64(*jep, JB_submission_time),
+   ocs::ReportingFileWriter::create_new_job_records(nullptr, jep);
+   ocs::ReportingFileWriter::create_job_logs(nullptr, lGetUlong64(jep, JB_submission_time),
                                              JL_PENDING, packet->user, packet->host, nullptr,
-                                             *jep, nullptr, nullptr, MSG_LOG_NEWJOB);
+                                             jep, nullptr, nullptr, MSG_LOG_NEWJOB);
 
    /*
    **  add element to return list if necessary
@@ -338,12 +369,186 @@ sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
       if (!*lpp) {
          *lpp = lCreateList("Job Return", JB_Type);
       }
-      lAppendElem(*lpp, lCopyElem(*jep));
+      lAppendElem(*lpp, lCopyElem(jep));
+   }
+
+   DRETURN(STATUS_OK);
+}
+
+/*-------------------------------------------------------------------------*/
+/* jepp is set to nullptr, if the job was successfully added                   */
+/*                                                                         */
+/* MT-Note: it is thread safe. It is using the global lock to secure the   */
+/*          none safe functions                                            */
+/*-------------------------------------------------------------------------*/
+int
+sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
+                sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task,
+                monitoring_t *monitor) {
+   int ret;
+
+   DENTER(TOP_LAYER);
+
+   ret = job_add_verify(jep, alpp, lpp, packet, task, monitor);
+   if (ret != STATUS_OK) {
+      DRETURN(ret);
+   }
+
+   spool_transaction(alpp, spool_get_default_context(), STC_begin);
+   ret = job_add_spool(*jep, alpp, packet, true);
+   if (ret != STATUS_OK) {
+      spool_transaction(alpp, spool_get_default_context(), STC_rollback);
+      DRETURN(ret);
+   }
+   spool_transaction(alpp, spool_get_default_context(), STC_commit);
+
+   ret = job_add_register(*jep, alpp, lpp, packet);
+   if (ret != STATUS_OK) {
+      DRETURN(ret);
+   }
+
+   /*
+   ** immediate jobs trigger scheduling immediately
+   */
+   if (JOB_TYPE_IS_IMMEDIATE(lGetUlong(*jep, JB_type))) {
+      sge_deliver_events_immediately(EV_ID_SCHEDD);
    }
 
    DRETURN(STATUS_OK);
 }
 
+/****** sge_job_qmaster/sge_gdi_add_job_list() *********************************
+*  NAME
+*     sge_gdi_add_job_list() -- add all jobs of a bulk submission
+*
+*  SYNOPSIS
+*     void
+*     sge_gdi_add_job_list(lList **job_list, lList **alpp,
+*                          sge_gdi_packet_class_t *packet,
+*                          sge_gdi_task_class_t *task, monitoring_t *monitor)
+*
+*  FUNCTION
+*     Submits all jobs of a job list that was sent with one GDI request
+*     (qsub -batch-file, japi_run_job_list()).
+*
+*     First the server JSV, if one is configured, verifies all jobs. The
+*     JSV releases the locks while it is running, so this is done before
+*     any job of the list is registered.
+*
+*     Then each job is verified and gets its job id like with
+*     sge_gdi_add_job(). It is spooled and added to the master job list
+*     right away, so that
+*     the max_jobs and max_u_jobs limits and -hold_jid references to jobs
+*     submitted earlier in the same list work as with single submissions.
+*     But all jobs share one spooling transaction which is committed once
+*     at the end, and the sgeE_JOB_ADD events are created after the commit.
+*
+*     If spooling a job fails the transaction is rolled back, the jobs
+*     which were spooled before in the same transaction are spooled again
+*     in a new one, and the failing job is rejected.
+*
+*     When the function returns *job_list contains the jobs in the order
+*     they were submitted. Rejected jobs have the job number 0.
+*
+*  INPUTS
+*     lList **job_list               - JB_Type list of submitted jobs
+*     lList **alpp                   - answer list
+*     sge_gdi_packet_class_t *packet - the GDI request
+*     sge_gdi_task_class_t *task     - the GDI task
+*     monitoring_t *monitor          - monitoring structure
+*
+*  NOTES
+*     MT-NOTE: sge_gdi_add_job_list() is MT safe, the caller holds the
+*              lock for the job domain
+*******************************************************************************/
+void
+sge_gdi_add_job_list(lList **job_list, lList **alpp, sge_gdi_packet_class_t *packet,
+                     sge_gdi_task_class_t *task, monitoring_t *monitor) {
+   std::vector<lListElem *> jobs;
+   std::vector<bool> verified;
+   std::vector<lListElem *> registered;
+   bool deliver_immediately = false;
+   lListElem *jep;
+
+   DENTER(TOP_LAYER);
+
+   while ((jep = lFirstRW(*job_list)) != nullptr) {
+      jobs.push_back(lDechainElem(*job_list, jep));
+   }
+
+   /*
+    * the JSV releases the locks while it is running,
+    * so it has to be done for all jobs before the first one is registered
+    */
+   for (auto &job : jobs) {
+      if (!job_verify_submitted_job(job, alpp)) {
+         ERROR(MSG_QMASTER_INVALIDJOBSUBMISSION_SSS, packet->user, packet->commproc, packet->host);
+         lSetUlong(job, JB_job_number, 0);
+         verified.push_back(false);
+      } else {
+         verified.push_back(job_add_jsv(&job, alpp, nullptr, packet, task, monitor) == STATUS_OK);
+      }
+   }
+
+   spool_transaction(alpp, spool_get_default_context(), STC_begin);
+   for (size_t i = 0; i < jobs.size(); i++) {
+      lListElem *&job = jobs[i];
+      int ret = STATUS_EUNKNOWN;
+
+      if (verified[i]) {
+         ret = sge_job_verify_adjust(job, alpp, nullptr, packet, task, monitor);
+      }
+      if (ret == STATUS_OK) {
+         ret = job_add_spool(job, alpp, packet, false);
+         if (ret != STATUS_OK) {
+            // the rollback also drops the jobs spooled before, spool them again
+            spool_transaction(alpp, spool_get_default_context(), STC_rollback);
+            spool_transaction(alpp, spool_get_default_context(), STC_begin);
+            for (auto spooled_job : registered) {
+               if (!sge_event_spool(alpp, 0, sgeE_JOB_ADD, lGetUlong(spooled_job, JB_job_number), 0,
+                                    nullptr, nullptr, nullptr, spooled_job, nullptr, nullptr,
+                                    false, true, packet->gdi_session)) {
+                  ERROR(MSG_JOB_NOWRITE_U, sge_u32c(lGetUlong(spooled_job, JB_job_number)));
+                  answer_list_add(alpp, SGE_EVENT, STATUS_EDISK, ANSWER_QUALITY_ERROR);
+               }
+            }
+         }
+      }
+      if (ret == STATUS_OK) {
+         ret = job_add_register(job, alpp, nullptr, packet);
+      }
+      if (ret != STATUS_OK) {
+         lSetUlong(job, JB_job_number, 0);
+         continue;
+      }
+
+      registered.push_back(job);
+   }
+   spool_transaction(alpp, spool_get_default_context(), STC_commit);
+
+   // the jobs are known to the event clients only after they were committed
+   for (auto job : registered) {
+      sge_event_spool(alpp, 0, sgeE_JOB_ADD, lGetUlong(job, JB_job_number), 0, nullptr, nullptr, nullptr,
+                      job, nullptr, nullptr, true, false, packet->gdi_session);
+      if (JOB_TYPE_IS_IMMEDIATE(lGetUlong(job, JB_type))) {
+         deliver_immediately = true;
+      }
+   }
+
+   /*
+   ** immediate jobs trigger scheduling immediately
+   */
+   if (deliver_immediately) {
+      sge_deliver_events_immediately(EV_ID_SCHEDD);
+   }
+
+   for (auto job : jobs) {
+      lAppendElem(*job_list, job);
+   }
+
+   DRETURN_VOID;
+}
+
 
 /**
  * sge_gdi_delete_job
@@ -3126,7 +3331,10 @@ static u_long32 guess_highest_job_number() {
    /* this function is called during qmaster startup and not while it is running,
       we do not need to monitor this lock */
 
-   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   sge_lock_set_t lock_set;
+   sge_lock_set_init(&lock_set, false);
+   sge_lock_set_add(&lock_set, LOCK_DOMAIN_JOB, LOCK_READ);
+   SGE_LOCK_SET(&lock_set);
 
    jep = lFirst(master_job_list);
    if (jep) {
@@ -3137,7 +3345,7 @@ static u_long32 guess_highest_job_number() {
       }
    }
 
-   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+   SGE_UNLOCK_SET();
 
    DRETURN(maxid);
 }
@@ -76,6 +76,10 @@ int
 sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
                 sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task, monitoring_t *monitor);
 
+void
+sge_gdi_add_job_list(lList **job_list, lList **alpp, sge_gdi_packet_class_t *packet,
+                     sge_gdi_task_class_t *task, monitoring_t *monitor);
+
 int
 sge_gdi_copy_job(lListElem *jep, lList **alpp, lList **lpp,
                  sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *task, monitoring_t *monitor);
@@ -37,6 +37,7 @@
 #include <cstring>
 #include <unistd.h>
 
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_lock.h"
 #include "uti/sge_log.h"
@@ -345,6 +346,7 @@ get_gdi_executor_ds(sge_gdi_packet_class_t *packet) {
 static void
 do_gdi_packet(struct_msg_t *aMsg, monitoring_t *monitor) {
    DENTER(TOP_LAYER);
+   SPAN_TRACE_START(packet_span, "gdi", "packet", nullptr);
 
    // unpack the incoming request
    sge_pack_buffer *pb_in = &(aMsg->buf);
@@ -362,6 +364,10 @@ do_gdi_packet(struct_msg_t *aMsg, monitoring_t *monitor) {
       local_ret = ocs::Version::do_versions_match(&packet->first_task->answer_list, packet->version, packet->host, packet->commproc, packet->commproc_id);
    }
 
+   // remember if answers and other messages to the sender may be compressed
+   gdi_set_peer_compression(packet->host, packet->commproc,
+                            local_ret && (packet->capabilities & GDI_CAP_COMPRESSION) != 0);
+
    // check auth_info (user/group)
    if (local_ret) {
       local_ret = sge_gdi_packet_parse_auth_info(packet, &packet->first_task->answer_list,
@@ -504,6 +510,7 @@ do_report_request(struct_msg_t *aMsg, monitoring_t *monitor) {
    const char *myprogname = component_get_component_name();
 
    DENTER(TOP_LAYER);
+   SPAN_TRACE_START(report_span, "report", "report", nullptr);
 
    /* Load reports are only accepted from admin/root user */
    if (!sge_security_verify_unique_identifier(true, admin_user, myprogname, 0,
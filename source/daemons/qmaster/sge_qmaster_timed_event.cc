@@ -154,6 +154,7 @@ te_delete_all_or_one_time_event(te_type_t aType, u_long32 aKey1, u_long32 aKey2,
       DPRINTF("%s: event list has been freed --> recreate \n", __func__);
 
       Event_Control.list = lCreateList("timed event list", TE_Type);
+      lSortIndexCreate(Event_Control.list, Event_Control.sort_order);
       res = n; /* all elements have been deleted */
    } else {
       res = n - lGetNumberOfElem(Event_Control.list);
@@ -735,6 +736,7 @@ void te_init() {
 
    Event_Control.list = lCreateList("timed event list", TE_Type);
    Event_Control.sort_order = lParseSortOrderVarArg(TE_Type, "%I+", TE_when);
+   lSortIndexCreate(Event_Control.list, Event_Control.sort_order);
 
    Handler_Tbl.list = (struct tbl_elem *) sge_malloc(TBL_INIT_SIZE * sizeof(struct tbl_elem));
    Handler_Tbl.max = TBL_INIT_SIZE;
@@ -917,14 +917,18 @@ ocs::ClassicReportingFileWriter::create_sharelog_record(monitoring_t *monitor) {
          format.format_times = false;
          format.line_prefix = "sharelog";
 
-         /* dump the sharetree data */
-         MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_READ), monitor);
+         /* dump the sharetree data, it refers to users and projects */
+         sge_lock_set_t lock_set;
+         sge_lock_set_init(&lock_set, false);
+         sge_lock_set_add(&lock_set, LOCK_DOMAIN_JOB, LOCK_READ);
+         sge_lock_set_add(&lock_set, LOCK_DOMAIN_CONFIG, LOCK_READ);
+         MONITOR_WAIT_TIME(SGE_LOCK_SET(&lock_set), monitor);
 
          sge_sharetree_print(&data_dstring, nullptr, master_stree_list, master_user_list, master_project_list,
                              master_userset_list,
                              true, false, nullptr, &format);
 
-         SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+         SGE_UNLOCK_SET();
 
          /* write data to reporting buffer */
          // @todo use create_record
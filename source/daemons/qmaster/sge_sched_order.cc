@@ -48,6 +48,37 @@
 
 gdi_request_queue_t Master_Request_Queue;
 
+/* when set orders are collected here instead of being sent to qmaster */
+static lList **Order_Sink = nullptr;
+
+/****** qmaster/sched_order/sge_schedd_set_order_sink() ************************
+*  NAME
+*     sge_schedd_set_order_sink() -- collect orders instead of sending them
+*
+*  SYNOPSIS
+*     void sge_schedd_set_order_sink(lList **sink)
+*
+*  FUNCTION
+*     Makes sge_schedd_add_gdi_order_request() append all orders of the
+*     following scheduling runs to the list 'sink' (OR_Type) instead of
+*     sending them to the worker threads. The order statistics in order_t
+*     are counted as if the orders had been sent.
+*     Passing nullptr switches back to sending the orders.
+*
+*     This is used to run the scheduler offline, e.g. when replaying a
+*     recorded cluster state for benchmarking.
+*
+*  INPUTS
+*     lList **sink - location of the list receiving the orders or nullptr
+*
+*  NOTES
+*     MT-NOTE: sge_schedd_set_order_sink() is not MT safe
+*******************************************************************************/
+void
+sge_schedd_set_order_sink(lList **sink) {
+   Order_Sink = sink;
+}
+
 bool
 schedd_order_initialize() {
    bool ret = true;
@@ -98,6 +129,20 @@ sge_schedd_add_gdi_order_request(order_t *orders, lList **answer_list, lList **o
    state_gdi_multi *state = nullptr;
 
    DENTER(TOP_LAYER);
+
+   if (Order_Sink != nullptr) {
+      orders->numberSendOrders += lGetNumberOfElem(*order_list);
+      orders->numberSendPackages++;
+
+      if (*Order_Sink == nullptr) {
+         *Order_Sink = *order_list;
+         *order_list = nullptr;
+      } else {
+         lAddList(*Order_Sink, order_list);
+      }
+      DRETURN(ret);
+   }
+
    state = (state_gdi_multi *) sge_malloc(sizeof(state_gdi_multi));
    if (state != nullptr) {
       int order_id;
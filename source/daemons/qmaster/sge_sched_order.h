@@ -58,3 +58,6 @@ sge_schedd_send_orders(order_t *orders, lList **order_list, lList **answer_list,
 
 bool
 sge_schedd_block_until_orders_processed(lList **answer_list);
+
+void
+sge_schedd_set_order_sink(lList **sink);
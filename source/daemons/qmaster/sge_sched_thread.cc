@@ -47,6 +47,7 @@
 #include "uti/sge_time.h"
 #include "uti/sge_unistd.h"
 
+#include "sgeobj/ocs_DataStore.h"
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_conf.h"
 #include "sgeobj/sge_report.h"
@@ -86,6 +87,7 @@
 #include "sched/sge_support.h"
 #include "sched/sort_hosts.h"
 #include "sched/debit.h"
+#include "sched/ocs_ResourceMatrix.h"
 
 #include "sge_sched_prepare_data.h"
 #include "sge_sched_job_category.h"
@@ -110,6 +112,42 @@ scheduler_control_t Scheduler_Control = {
         false /* new_global_config */
 };
 
+/*
+ * sublists which are shared between the mirror and the copy used by a
+ * scheduling run (see lSnapshotList()). They are only read by the
+ * scheduler or modified via the RW access functions which create a
+ * private copy of the sublist when it gets modified.
+ *
+ * JB_request_set_list is not shared: the scheduler tags the resource
+ * requests (CE_tagged) of every job it dispatches, sharing it would
+ * only add an unshare per job.
+ */
+static const int job_shared_nm[] = {
+        JB_grp_list,
+        JB_jid_predecessor_list,
+        JB_pe_range,
+        JB_ja_structure,
+        NoName
+};
+
+static const int host_shared_nm[] = {
+        EH_scaling_list,
+        EH_consumable_config_list,
+        EH_usage_scaling_list,
+        EH_acl,
+        EH_xacl,
+        EH_prj,
+        EH_xprj,
+        EH_reschedule_unknown_list,
+        NoName
+};
+
+static const int pe_shared_nm[] = {
+        PE_user_list,
+        PE_xuser_list,
+        NoName
+};
+
 #if 0
 static void rest_busy(sge_evc_class_t *evc);
 
@@ -125,7 +163,7 @@ select_assign_debit(lList **queue_list, lList **dis_queue_list, lListElem *job,
                     lList *load_adjustments, lList **user_list, lList **group_list, order_t *orders,
                     double *total_running_job_tickets, int *sort_hostlist, bool is_start, bool is_reserve,
                     bool is_schedule_based, lList **load_list, const lList *hgrp_list, lList *rqs_list, lList *ar_list,
-                    sched_prof_t *pi, bool monitor_next_run, u_long64 now);
+                    const ocs::ResourceMatrix *resource_matrix, sched_prof_t *pi, bool monitor_next_run, u_long64 now);
 
 void
 st_set_flag_new_global_conf(bool new_value) {
@@ -197,6 +235,200 @@ scheduler_global_queue_messages(scheduler_all_data_t *lists, bool monitor_next_r
    DRETURN_VOID;
 }
 
+/****** schedd/scheduler/scheduler_copy_data() *******************************
+*  NAME
+*     scheduler_copy_data() -- prepare the data of a scheduling run
+*
+*  SYNOPSIS
+*     void scheduler_copy_data(scheduler_all_data_t *copy,
+*                              const sge_where_what_t *where_what)
+*
+*  FUNCTION
+*     Fills 'copy' with the data of the master lists of the active data
+*     store a scheduling run needs. Queue instances, usersets and jobs
+*     are reduced using 'where_what'. Lists which are modified during the
+*     scheduling run are copied, read only lists are referenced.
+*
+*     The copy has to be released with scheduler_free_data().
+*
+*  INPUTS
+*     scheduler_all_data_t *copy         - data of the scheduling run
+*     const sge_where_what_t *where_what - conditions and enumerations
+*
+*  NOTES
+*     MT-NOTE: scheduler_copy_data() is MT safe
+*******************************************************************************/
+void
+scheduler_copy_data(scheduler_all_data_t *copy, const sge_where_what_t *where_what) {
+   const lList *master_cqueue_list = *ocs::DataStore::get_master_list(SGE_TYPE_CQUEUE);
+   const lList *master_job_list = *ocs::DataStore::get_master_list(SGE_TYPE_JOB);
+   const lList *master_userset_list = *ocs::DataStore::get_master_list(SGE_TYPE_USERSET);
+   const lList *master_project_list = *ocs::DataStore::get_master_list(SGE_TYPE_PROJECT);
+   const lList *master_exechost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
+   const lList *master_rqs_list = *ocs::DataStore::get_master_list(SGE_TYPE_RQS);
+   const lList *master_centry_list = *ocs::DataStore::get_master_list(SGE_TYPE_CENTRY);
+   const lList *master_ckpt_list = *ocs::DataStore::get_master_list(SGE_TYPE_CKPT);
+   const lList *master_user_list = *ocs::DataStore::get_master_list(SGE_TYPE_USER);
+   const lList *master_ar_list = *ocs::DataStore::get_master_list(SGE_TYPE_AR);
+   const lList *master_pe_list = *ocs::DataStore::get_master_list(SGE_TYPE_PE);
+   const lList *master_hgrp_list = *ocs::DataStore::get_master_list(SGE_TYPE_HGROUP);
+   const lList *master_sharetree_list = *ocs::DataStore::get_master_list(SGE_TYPE_SHARETREE);
+
+   DENTER(TOP_LAYER);
+
+   memset(copy, 0, sizeof(*copy));
+
+   copy->dept_list = lSelect(nullptr, master_userset_list, where_what->where_dept, where_what->what_acldept);
+   copy->acl_list = lSelect(nullptr, master_userset_list, where_what->where_acl, where_what->what_acldept);
+
+   DPRINTF("RAW CQ:%d, J:%d, H:%d, C:%d, A:%d, D:%d, P:%d, CKPT:%d,"
+            " US:%d, PR:%d, RQS:%d, AR:%d, S:nd:%d/lf:%d\n",
+           lGetNumberOfElem(master_cqueue_list),
+           lGetNumberOfElem(master_job_list),
+           lGetNumberOfElem(master_exechost_list),
+           lGetNumberOfElem(master_centry_list),
+           lGetNumberOfElem(copy->acl_list),
+           lGetNumberOfElem(copy->dept_list),
+           lGetNumberOfElem(master_project_list),
+           lGetNumberOfElem(master_ckpt_list),
+           lGetNumberOfElem(master_user_list),
+           lGetNumberOfElem(master_project_list),
+           lGetNumberOfElem(master_rqs_list),
+           lGetNumberOfElem(master_ar_list),
+           lGetNumberOfNodes(nullptr, master_sharetree_list, STN_children),
+           lGetNumberOfLeafs(nullptr, master_sharetree_list, STN_children)
+           );
+
+   copy->host_list = lSnapshotList(nullptr, master_exechost_list, host_shared_nm);
+
+   // within the scheduler we only need QIs create one big qinstance list
+   {
+      const lListElem *cqueue;
+      lEnumeration *what_queue3 = nullptr;
+
+      for_each_ep(cqueue, master_cqueue_list) {
+         const lList *qinstance_list = lGetList(cqueue, CQ_qinstances);
+         lList *t;
+
+         if (qinstance_list == nullptr) {
+            continue;
+         }
+
+         /* all_queue_list contains all queue instances with state and full queue name only */
+         if (!what_queue3) {
+            what_queue3 = lWhat("%T(%I%I)", lGetListDescr(qinstance_list), QU_full_name, QU_state);
+         }
+         t = lSelect(nullptr, qinstance_list, nullptr, what_queue3);
+         if (t) {
+            if (copy->all_queue_list == nullptr) {
+               copy->all_queue_list = lCreateList("all", lGetListDescr(t));
+            }
+            lAppendList(copy->all_queue_list, t);
+            lFreeList(&t);
+         }
+
+         t = lSelect(nullptr, qinstance_list, where_what->where_queue, where_what->what_queue2);
+         if (t) {
+            if (copy->queue_list == nullptr) {
+               copy->queue_list = lCreateList("enabled", lGetListDescr(t));
+            }
+            lAppendList(copy->queue_list, t);
+            lFreeList(&t);
+         }
+
+         t = lSelect(nullptr, qinstance_list, where_what->where_queue2, where_what->what_queue2);
+         if (t) {
+            if (copy->dis_queue_list == nullptr) {
+               copy->dis_queue_list = lCreateList("disabled", lGetListDescr(t));
+            }
+            lAppendList(copy->dis_queue_list, t);
+            lFreeList(&t);
+         }
+      }
+      if (what_queue3) {
+         lFreeWhat(&what_queue3);
+      }
+   }
+
+   copy->job_list = lSnapshotList(nullptr, master_job_list, job_shared_nm);
+
+   /* no need to copy these lists, they are read only used */
+   copy->centry_list = master_centry_list;
+   copy->ckpt_list = master_ckpt_list;
+   copy->hgrp_list = master_hgrp_list;
+
+   /* these lists need to be copied because they are modified during scheduling run */
+   copy->share_tree = lCopyList(nullptr, master_sharetree_list);
+   copy->pe_list = lSnapshotList(nullptr, master_pe_list, pe_shared_nm);
+   copy->user_list = lCopyList(nullptr, master_user_list);
+   copy->project_list = lCopyList(nullptr, master_project_list);
+   copy->rqs_list = lCopyList(nullptr, master_rqs_list);
+   copy->ar_list = lCopyList(nullptr, master_ar_list);
+
+   /* report number of reduced and raw (in brackets) lists */
+   DPRINTF("Q:" sge_uu32 ", AQ:" sge_uu32 " J:" sge_uu32 "(" sge_uu32 "), H:" sge_uu32 "(" sge_uu32 "), C:" sge_uu32
+            ", A:" sge_uu32 ", D:" sge_uu32 ", P:" sge_uu32 ", CKPT:" sge_uu32 ", US:" sge_uu32 ", PR:" sge_uu32
+            ", RQS:" sge_uu32 ", AR:" sge_uu32 ", S:nd:%d/lf:%d\n",
+           lGetNumberOfElem(copy->queue_list),
+           lGetNumberOfElem(copy->all_queue_list),
+           lGetNumberOfElem(copy->job_list),
+           lGetNumberOfElem(master_job_list),
+           lGetNumberOfElem(copy->host_list),
+           lGetNumberOfElem(master_exechost_list),
+           lGetNumberOfElem(copy->centry_list),
+           lGetNumberOfElem(copy->acl_list),
+           lGetNumberOfElem(copy->dept_list),
+           lGetNumberOfElem(copy->pe_list),
+           lGetNumberOfElem(copy->ckpt_list),
+           lGetNumberOfElem(copy->user_list),
+           lGetNumberOfElem(copy->project_list),
+           lGetNumberOfElem(copy->rqs_list),
+           lGetNumberOfElem(copy->ar_list),
+           lGetNumberOfNodes(nullptr, copy->share_tree, STN_children),
+           lGetNumberOfLeafs(nullptr, copy->share_tree, STN_children)
+           );
+
+   DRETURN_VOID;
+}
+
+/****** schedd/scheduler/scheduler_free_data() *******************************
+*  NAME
+*     scheduler_free_data() -- release the data of a scheduling run
+*
+*  SYNOPSIS
+*     void scheduler_free_data(scheduler_all_data_t *copy)
+*
+*  FUNCTION
+*     Frees the lists created by scheduler_copy_data(). Lists which are
+*     only referenced are left untouched.
+*
+*  INPUTS
+*     scheduler_all_data_t *copy - data of the scheduling run
+*
+*  NOTES
+*     MT-NOTE: scheduler_free_data() is MT safe
+*******************************************************************************/
+void
+scheduler_free_data(scheduler_all_data_t *copy) {
+   DENTER(TOP_LAYER);
+
+   lFreeList(&(copy->host_list));
+   lFreeList(&(copy->queue_list));
+   lFreeList(&(copy->dis_queue_list));
+   lFreeList(&(copy->all_queue_list));
+   lFreeList(&(copy->job_list));
+   lFreeList(&(copy->acl_list));
+   lFreeList(&(copy->dept_list));
+   lFreeList(&(copy->pe_list));
+   lFreeList(&(copy->share_tree));
+   lFreeList(&(copy->user_list));
+   lFreeList(&(copy->project_list));
+   lFreeList(&(copy->rqs_list));
+   lFreeList(&(copy->ar_list));
+
+   DRETURN_VOID;
+}
+
 void scheduler_method(sge_evc_class_t *evc, lList **answer_list, scheduler_all_data_t *lists, lList **order) {
    order_t orders = ORDER_INIT;
    lList **splitted_job_lists[SPLIT_LAST];            /* JB_Type */
@@ -248,7 +480,13 @@ void scheduler_method(sge_evc_class_t *evc, lList **answer_list, scheduler_all_d
    splitted_job_lists[SPLIT_HOLD] = &hold_list;
    splitted_job_lists[SPLIT_NOT_STARTED] = &not_started_list;
    splitted_job_lists[SPLIT_DEFERRED] = &deferred_list;
+
+   PROF_START_MEASUREMENT(SGE_PROF_CUSTOM8);
    split_jobs(&(lists->job_list), mconf_get_max_aj_instances(), splitted_job_lists, false);
+   if (prof_is_active(SGE_PROF_CUSTOM8)) {
+      prof_stop_measurement(SGE_PROF_CUSTOM8, nullptr);
+      PROFILING("PROF: job splitting took %.3f s", prof_get_measurement_wallclock(SGE_PROF_CUSTOM8, false, nullptr));
+   }
 
    // generate global queue messages (disabled, suspended, unknown, ...)
    scheduler_global_queue_messages(lists, evc->monitor_next_run);
@@ -261,6 +499,7 @@ void scheduler_method(sge_evc_class_t *evc, lList **answer_list, scheduler_all_d
                          *(splitted_job_lists[SPLIT_RUNNING]), &orders);
 
    // send orders to worker threads
+   PROF_START_MEASUREMENT(SGE_PROF_CUSTOM9);
    if (!sge_thread_has_shutdown_started()) {
       sge_schedd_send_orders(&orders, &(orders.configOrderList), nullptr, "C: config orders");
       sge_schedd_send_orders(&orders, &(orders.jobStartOrderList), nullptr, "C: job start orders");
@@ -314,6 +553,11 @@ void scheduler_method(sge_evc_class_t *evc, lList **answer_list, scheduler_all_d
       sge_schedd_add_gdi_order_request(&orders, answer_list, &Master_Request_Queue.order_list);
    }
 
+   if (prof_is_active(SGE_PROF_CUSTOM9)) {
+      prof_stop_measurement(SGE_PROF_CUSTOM9, nullptr);
+      PROFILING("PROF: creating and sending orders took %.3f s", prof_get_measurement_wallclock(SGE_PROF_CUSTOM9, false, nullptr));
+   }
+
    if (prof_is_active(SGE_PROF_CUSTOM0)) {
       prof_stop_measurement(SGE_PROF_CUSTOM0, nullptr);
 
@@ -508,6 +752,15 @@ static int dispatch_jobs(sge_evc_class_t *evc, scheduler_all_data_t *lists, orde
     *---------------------------------------------------------------------*/
    correct_capacities(lists->host_list, lists->centry_list);
 
+   /*---------------------------------------------------------------------
+    * CONSUMABLE CAPACITIES
+    * The capacities do not change any more during the dispatch run.
+    * Keep them in columns to find hosts which can never serve a job
+    * without checking each host.
+    *---------------------------------------------------------------------*/
+   ocs::ResourceMatrix resource_matrix;
+   resource_matrix.build(lists->host_list, lists->centry_list);
+
    /*---------------------------------------------------------------------
     * KEEP SUSPEND THRESHOLD QUEUES
     *---------------------------------------------------------------------*/
@@ -802,6 +1055,7 @@ static int dispatch_jobs(sge_evc_class_t *evc, scheduler_all_data_t *lists, orde
                        lists->hgrp_list,
                        lists->rqs_list,
                        lists->ar_list,
+                       &resource_matrix,
                        do_prof ? &pi : nullptr,
                        evc->monitor_next_run,
                        now);
@@ -1060,7 +1314,7 @@ select_assign_debit(lList **queue_list, lList **dis_queue_list, lListElem *job,
                     lList *load_adjustments, lList **user_list, lList **group_list, order_t *orders,
                     double *total_running_job_tickets, int *sort_hostlist, bool is_start, bool is_reserve,
                     bool is_schedule_based, lList **load_list, const lList *hgrp_list, lList *rqs_list, lList *ar_list,
-                    sched_prof_t *pi, bool monitor_next_run, u_long64 now) {
+                    const ocs::ResourceMatrix *resource_matrix, sched_prof_t *pi, bool monitor_next_run, u_long64 now) {
    lListElem *granted_el;
    dispatch_t result = DISPATCH_NOT_AT_TIME;
    const char *pe_name, *ckpt_name;
@@ -1077,6 +1331,7 @@ select_assign_debit(lList **queue_list, lList **dis_queue_list, lListElem *job,
    a.hgrp_list = hgrp_list;
    a.rqs_list = rqs_list;
    a.ar_list = ar_list;
+   a.resource_matrix = resource_matrix;
    a.pi = pi;
    a.monitor_next_run = monitor_next_run;
    a.now = now;
@@ -79,5 +79,11 @@ st_get_flag_new_global_conf();
 int
 subscribe_scheduler(sge_evc_class_t *evc, sge_where_what_t *where_what);
 
+void
+scheduler_copy_data(scheduler_all_data_t *copy, const sge_where_what_t *where_what);
+
+void
+scheduler_free_data(scheduler_all_data_t *copy);
+
 void
 scheduler_method(sge_evc_class_t *evc, lList **answer_list, scheduler_all_data_t *lists, lList **order);
@@ -21,6 +21,7 @@
 #include "basis_types.h"
 #include "sge.h"
 
+#include "sgeobj/ocs_TopologyMask.h"
 #include "sgeobj/sge_ulong.h"
 #include "sgeobj/sge_centry.h"
 #include "sgeobj/sge_grantedres.h"
@@ -159,11 +160,59 @@ gru_list_add_request(lList **granted_resources_list, const char *name, u_long32
    DRETURN(ret);
 }
 
+/**
+ * @brief add the cores selected for the core binding of a job to the granted resource list
+ *
+ * For each host of the gdil free cores are selected from the topology reported
+ * by the host and stored as ids of a granted resource of type GRU_BINDING_TYPE.
+ * Hosts not reporting a topology get no entry, on those binding is done by the
+ * execution daemon itself.
+ *
+ * @param granted_resources_list the granted resource list
+ * @param job  the job requesting core binding
+ * @param gdil the granted destination identifier list
+ * @param host_list the host list containing the topology in use
+ */
+static void
+gru_list_add_binding(lList **granted_resources_list, const lListElem *job, const lList *gdil,
+                     const lList *host_list) {
+   DENTER(TOP_LAYER);
+
+   const lListElem *gdil_ep;
+   const char *last_host = nullptr;
+   for_each_ep(gdil_ep, gdil) {
+      const char *host_name = lGetHost(gdil_ep, JG_qhostname);
+      if (!host_do_per_host_booking(&last_host, host_name)) {
+         continue;
+      }
+
+      const lListElem *host = host_list_locate(host_list, host_name);
+      std::vector<std::string> ids;
+      if (host == nullptr || !host_select_binding(host, job, &ids) || ids.empty()) {
+         DPRINTF("gru_list_add_binding: no cores selected on host %s\n", host_name);
+         continue;
+      }
+
+      lListElem *gru = lAddElemStr(granted_resources_list, GRU_name, "binding", GRU_Type);
+      lSetUlong(gru, GRU_type, GRU_BINDING_TYPE);
+      lSetHost(gru, GRU_host, host_name);
+      lSetDouble(gru, GRU_amount, ids.size());
+      for (const std::string &id : ids) {
+         lListElem *resl = lAddSubStr(gru, RESL_value, id.c_str(), GRU_resource_map_list, RESL_Type);
+         lSetUlong(resl, RESL_amount, 1);
+      }
+      DPRINTF("gru_list_add_binding: selected %d cores on host %s\n", (int)ids.size(), host_name);
+   }
+
+   DRETURN_VOID;
+}
+
 /**
  * @brief add a granted resource list to a just scheduled ja_task
  *
  * The granted resource list is built from the (granted) hard requests of the job
  * and for RSMAPs by searching free ids in the hosts' complex_values lists.
+ * For jobs requesting core binding it also contains the selected cores per host.
  *
  * @param ja_task
  * @param job
@@ -271,6 +320,11 @@ bool add_granted_resource_list(lListElem *ja_task, const lListElem *job, const l
       last_host = host_name;
    }
 
+   // select the cores for core binding
+   if (ret && ocs::TopologyMask::is_binding_requested(job)) {
+      gru_list_add_binding(&granted_resources_list, job, gdil, host_list);
+   }
+
    // if we had some consumables, add the list to the ja_task
    if (ret) {
       if (granted_resources_list != nullptr) {
@@ -57,6 +57,7 @@
 #include "sge_userprj_qmaster.h"
 #include "sge_job_qmaster.h"
 #include "sge_advance_reservation_qmaster.h"
+#include "sge_c_gdi.h"
 #include "sge_c_report.h"
 #include "sge_thread_main.h"
 #include "sge_thread_reader.h"
@@ -298,6 +299,7 @@ sge_reader_main(void *arg) {
          } else {
             SGE_UNLOCK(LOCK_READER, LOCK_WRITE);
          }
+         sge_c_gdi_request_latency(packet, p_monitor);
 
          if (packet->request_type == PACKET_GDI_REQUEST) {
             /*
@@ -39,6 +39,7 @@
 
 #include "comm/cl_commlib.h"
 
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_bootstrap_files.h"
 #include "uti/sge_log.h"
@@ -530,6 +531,8 @@ sge_scheduler_main(void *arg) {
    prof_set_level_name(SGE_PROF_CUSTOM5, "send orders", nullptr);
    prof_set_level_name(SGE_PROF_CUSTOM6, "scheduler event loop", nullptr);
    prof_set_level_name(SGE_PROF_CUSTOM7, "copy lists", nullptr);
+   prof_set_level_name(SGE_PROF_CUSTOM8, "job splitting", nullptr);
+   prof_set_level_name(SGE_PROF_CUSTOM9, "create and send orders", nullptr);
    prof_set_level_name(SGE_PROF_SCHEDLIB4, nullptr, nullptr);
 
    /* set-up needed for 'schedule' file */
@@ -584,6 +587,8 @@ sge_scheduler_main(void *arg) {
       prof_start_stop(SGE_PROF_CUSTOM5, nullptr, do_start);
       prof_start_stop(SGE_PROF_CUSTOM6, nullptr, do_start);
       prof_start_stop(SGE_PROF_CUSTOM7, nullptr, do_start);
+      prof_start_stop(SGE_PROF_CUSTOM8, nullptr, do_start);
+      prof_start_stop(SGE_PROF_CUSTOM9, nullptr, do_start);
       prof_start_stop(SGE_PROF_SCHEDLIB4, nullptr, do_start);
 
       /*
@@ -605,6 +610,7 @@ sge_scheduler_main(void *arg) {
          bool do_shutdown = (lGetElemUlong(event_list, ET_type, sgeE_SHUTDOWN) != nullptr);
 
          /* update mirror and free data */
+         SPAN_TRACE_START(mirror_span, "scheduler", "mirror", nullptr);
          if (!do_shutdown && sge_mirror_process_event_list(evc, event_list) == SGE_EM_OK) {
             handled_events = true;
             DPRINTF("events handled\n");
@@ -612,25 +618,18 @@ sge_scheduler_main(void *arg) {
             DPRINTF("events contain shutdown event - ignoring events\n");
          }
          lFreeList(&event_list);
+         SPAN_TRACE_STOP(mirror_span);
       }
 
       /* if we actually got events, start the scheduling run and further event processing */
       if (handled_events) {
          lList *answer_list = nullptr;
          scheduler_all_data_t copy;
-         const lList *master_cqueue_list = *ocs::DataStore::get_master_list(SGE_TYPE_CQUEUE);
          const lList *master_job_list = *ocs::DataStore::get_master_list(SGE_TYPE_JOB);
          const lList *master_userset_list = *ocs::DataStore::get_master_list(SGE_TYPE_USERSET);
          const lList *master_project_list = *ocs::DataStore::get_master_list(SGE_TYPE_PROJECT);
          const lList *master_exechost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
          const lList *master_rqs_list = *ocs::DataStore::get_master_list(SGE_TYPE_RQS);
-         const lList *master_centry_list = *ocs::DataStore::get_master_list(SGE_TYPE_CENTRY);
-         const lList *master_ckpt_list = *ocs::DataStore::get_master_list(SGE_TYPE_CKPT);
-         const lList *master_user_list = *ocs::DataStore::get_master_list(SGE_TYPE_USER);
-         const lList *master_ar_list = *ocs::DataStore::get_master_list(SGE_TYPE_AR);
-         const lList *master_pe_list = *ocs::DataStore::get_master_list(SGE_TYPE_PE);
-         const lList *master_hgrp_list = *ocs::DataStore::get_master_list(SGE_TYPE_HGROUP);
-         const lList *master_sharetree_list = *ocs::DataStore::get_master_list(SGE_TYPE_SHARETREE);
 
          /* delay scheduling for test purposes, see issue GE-3306 */
          if (SGE_TEST_DELAY_SCHEDULING > 0) {
@@ -648,34 +647,7 @@ sge_scheduler_main(void *arg) {
 
          PROF_START_MEASUREMENT(SGE_PROF_CUSTOM6);
          PROF_START_MEASUREMENT(SGE_PROF_CUSTOM7);
-
-         /*
-          * If there were new events then
-          * copy/filter data necessary for the scheduler run
-          * and run the scheduler method
-          */
-         memset(&copy, 0, sizeof(copy));
-
-         copy.dept_list = lSelect(nullptr, master_userset_list, where_what.where_dept, where_what.what_acldept);
-         copy.acl_list = lSelect(nullptr, master_userset_list, where_what.where_acl, where_what.what_acldept);
-
-         DPRINTF("RAW CQ:%d, J:%d, H:%d, C:%d, A:%d, D:%d, P:%d, CKPT:%d,"
-                  " US:%d, PR:%d, RQS:%d, AR:%d, S:nd:%d/lf:%d\n",
-                 lGetNumberOfElem(master_cqueue_list),
-                 lGetNumberOfElem(master_job_list),
-                 lGetNumberOfElem(master_exechost_list),
-                 lGetNumberOfElem(master_centry_list),
-                 lGetNumberOfElem(copy.acl_list),
-                 lGetNumberOfElem(copy.dept_list),
-                 lGetNumberOfElem(master_project_list),
-                 lGetNumberOfElem(master_ckpt_list),
-                 lGetNumberOfElem(master_user_list),
-                 lGetNumberOfElem(master_project_list),
-                 lGetNumberOfElem(master_rqs_list),
-                 lGetNumberOfElem(master_ar_list),
-                 lGetNumberOfNodes(nullptr, master_sharetree_list, STN_children),
-                 lGetNumberOfLeafs(nullptr, master_sharetree_list, STN_children)
-                 );
+         SPAN_TRACE_START(category_span, "scheduler", "categories", nullptr);
 
          /* rebuild all job categories
           * - when the scheduler config changed
@@ -686,9 +658,11 @@ sge_scheduler_main(void *arg) {
          sge_rebuild_job_category(master_job_list, master_userset_list,
                                   master_project_list, master_rqs_list);
 
+         SPAN_TRACE_STOP(category_span);
          PROF_STOP_MEASUREMENT(SGE_PROF_CUSTOM7);
          double prof_init = prof_get_measurement_wallclock(SGE_PROF_CUSTOM7, true, nullptr);
          PROF_START_MEASUREMENT(SGE_PROF_CUSTOM7);
+         SPAN_TRACE_START(copy_span, "scheduler", "copy", nullptr);
 
          /*
           * - fetch and merge new cluster (global, local) configuration if it has changed
@@ -696,95 +670,12 @@ sge_scheduler_main(void *arg) {
           */
          sge_before_dispatch(evc);
 
-         // prepare data for the scheduler itself
-         copy.host_list = lCopyList(nullptr, master_exechost_list);
-
-         // within the scheduler we only need QIs create one big qinstance list
-         {
-            const lListElem *cqueue;
-            lEnumeration *what_queue3 = nullptr;
-
-            for_each_ep(cqueue, master_cqueue_list) {
-               const lList *qinstance_list = lGetList(cqueue, CQ_qinstances);
-               lList *t;
-
-               if (qinstance_list == nullptr) {
-                  continue;
-               }
-
-               /* all_queue_list contains all queue instances with state and full queue name only */
-               if (!what_queue3) {
-                  what_queue3 = lWhat("%T(%I%I)", lGetListDescr(qinstance_list), QU_full_name, QU_state);
-               }
-               t = lSelect(nullptr, qinstance_list, nullptr, what_queue3);
-               if (t) {
-                  if (copy.all_queue_list == nullptr) {
-                     copy.all_queue_list = lCreateList("all", lGetListDescr(t));
-                  }
-                  lAppendList(copy.all_queue_list, t);
-                  lFreeList(&t);
-               }
-
-               t = lSelect(nullptr, qinstance_list, where_what.where_queue, where_what.what_queue2);
-               if (t) {
-                  if (copy.queue_list == nullptr) {
-                     copy.queue_list = lCreateList("enabled", lGetListDescr(t));
-                  }
-                  lAppendList(copy.queue_list, t);
-                  lFreeList(&t);
-               }
-
-               t = lSelect(nullptr, qinstance_list, where_what.where_queue2, where_what.what_queue2);
-               if (t) {
-                  if (copy.dis_queue_list == nullptr) {
-                     copy.dis_queue_list = lCreateList("disabled", lGetListDescr(t));
-                  }
-                  lAppendList(copy.dis_queue_list, t);
-                  lFreeList(&t);
-               }
-            }
-            if (what_queue3) {
-               lFreeWhat(&what_queue3);
-            }
-         }
-
-         copy.job_list = lCopyList(nullptr, master_job_list);
-
-         /* no need to copy these lists, they are read only used */
-         copy.centry_list = master_centry_list;
-         copy.ckpt_list = master_ckpt_list;
-         copy.hgrp_list = master_hgrp_list;
-
-         /* these lists need to be copied because they are modified during scheduling run */
-         copy.share_tree = lCopyList(nullptr, master_sharetree_list);
-         copy.pe_list = lCopyList(nullptr, master_pe_list);
-         copy.user_list = lCopyList(nullptr, master_user_list);
-         copy.project_list = lCopyList(nullptr, master_project_list);
-         copy.rqs_list = lCopyList(nullptr, master_rqs_list);
-         copy.ar_list = lCopyList(nullptr, master_ar_list);
-
-         /* report number of reduced and raw (in brackets) lists */
-         DPRINTF("Q:" sge_uu32 ", AQ:" sge_uu32 " J:" sge_uu32 "(" sge_uu32 "), H:" sge_uu32 "(" sge_uu32 "), C:" sge_uu32
-                  ", A:" sge_uu32 ", D:" sge_uu32 ", P:" sge_uu32 ", CKPT:" sge_uu32 ", US:" sge_uu32 ", PR:" sge_uu32
-                  ", RQS:" sge_uu32 ", AR:" sge_uu32 ", S:nd:%d/lf:%d\n",
-                 lGetNumberOfElem(copy.queue_list),
-                 lGetNumberOfElem(copy.all_queue_list),
-                 lGetNumberOfElem(copy.job_list),
-                 lGetNumberOfElem(master_job_list),
-                 lGetNumberOfElem(copy.host_list),
-                 lGetNumberOfElem(master_exechost_list),
-                 lGetNumberOfElem(copy.centry_list),
-                 lGetNumberOfElem(copy.acl_list),
-                 lGetNumberOfElem(copy.dept_list),
-                 lGetNumberOfElem(copy.pe_list),
-                 lGetNumberOfElem(copy.ckpt_list),
-                 lGetNumberOfElem(copy.user_list),
-                 lGetNumberOfElem(copy.project_list),
-                 lGetNumberOfElem(copy.rqs_list),
-                 lGetNumberOfElem(copy.ar_list),
-                 lGetNumberOfNodes(nullptr, copy.share_tree, STN_children),
-                 lGetNumberOfLeafs(nullptr, copy.share_tree, STN_children)
-                 );
+         /*
+          * If there were new events then
+          * copy/filter data necessary for the scheduler run
+          * and run the scheduler method
+          */
+         scheduler_copy_data(&copy, &where_what);
 
          if (getenv("SGE_ND")) {
             printf("Q:" sge_uu32 ", AQ:" sge_uu32 " J:" sge_uu32 "(" sge_uu32 "), H:" sge_uu32 "(" sge_uu32 "), C:" sge_uu32
@@ -812,6 +703,7 @@ sge_scheduler_main(void *arg) {
             schedd_log("-------------START-SCHEDULER-RUN-------------", nullptr, evc->monitor_next_run);
          }
 
+         SPAN_TRACE_STOP(copy_span);
          PROF_STOP_MEASUREMENT(SGE_PROF_CUSTOM7);
          double prof_copy = prof_get_measurement_wallclock(SGE_PROF_CUSTOM7, true, nullptr);
          PROF_START_MEASUREMENT(SGE_PROF_CUSTOM7);
@@ -829,7 +721,9 @@ sge_scheduler_main(void *arg) {
          }
 #endif
 
+         SPAN_TRACE_START(dispatch_span, "scheduler", "dispatch", nullptr);
          scheduler_method(evc, &answer_list, &copy, &orders);
+         SPAN_TRACE_STOP(dispatch_span);
 
 #ifdef WITH_GPERF
          if (evc->monitor_next_run) {
@@ -845,19 +739,9 @@ sge_scheduler_main(void *arg) {
          PROF_START_MEASUREMENT(SGE_PROF_CUSTOM7);
 
          /* ... which gets deleted after using */
-         lFreeList(&(copy.host_list));
-         lFreeList(&(copy.queue_list));
-         lFreeList(&(copy.dis_queue_list));
-         lFreeList(&(copy.all_queue_list));
-         lFreeList(&(copy.job_list));
-         lFreeList(&(copy.acl_list));
-         lFreeList(&(copy.dept_list));
-         lFreeList(&(copy.pe_list));
-         lFreeList(&(copy.share_tree));
-         lFreeList(&(copy.user_list));
-         lFreeList(&(copy.project_list));
-         lFreeList(&(copy.rqs_list));
-         lFreeList(&(copy.ar_list));
+         SPAN_TRACE_START(free_span, "scheduler", "free", nullptr);
+         scheduler_free_data(&copy);
+         SPAN_TRACE_STOP(free_span);
 
          PROF_STOP_MEASUREMENT(SGE_PROF_CUSTOM7);
          double prof_free = prof_get_measurement_wallclock(SGE_PROF_CUSTOM7, true, nullptr);
@@ -883,7 +767,9 @@ sge_scheduler_main(void *arg) {
          }
 
          /* block till master handled all GDI orders */
+         SPAN_TRACE_START(orders_span, "scheduler", "wait_for_orders", nullptr);
          sge_schedd_block_until_orders_processed(nullptr);
+         SPAN_TRACE_STOP(orders_span);
          schedd_order_destroy();
 
          /*
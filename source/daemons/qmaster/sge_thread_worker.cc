@@ -68,6 +68,7 @@
 #include "sge_userprj_qmaster.h"
 #include "sge_job_qmaster.h"
 #include "sge_advance_reservation_qmaster.h"
+#include "sge_c_gdi.h"
 #include "sge_c_report.h"
 #include "sge_thread_main.h"
 #include "sge_thread_worker.h"
@@ -218,7 +219,7 @@ sge_worker_main(void *arg) {
       // handle the packet only if it is not nullptr and the shutdown has not started
       if (packet != nullptr) {
          sge_gdi_task_class_t *task;
-         bool is_only_read_request = true;
+         sge_lock_set_t lock_set;
 
          DPRINTF("Request should be handled by thread type %d\n", packet->ds_type);
 
@@ -233,33 +234,11 @@ sge_worker_main(void *arg) {
 
          MONITOR_MESSAGES(p_monitor);
 
-         if (packet->request_type == PACKET_GDI_REQUEST) {
-            /*
-             * test if a write lock is necessary
-             */
-            task = packet->first_task;
-            while (task != nullptr) {
-               u_long32 command = SGE_GDI_GET_OPERATION(task->command);
-
-               if (command != SGE_GDI_GET) {
-                  is_only_read_request = false;
-                  break;
-               }
-               task = task->next;
-            }
-         } else {
-            // PACKET_REPORT_REQUEST or PACKET_ACK_REQUEST
-            is_only_read_request = false;
-         }
-
          /*
-          * acquire the correct lock
+          * acquire the locks of the domains the request works on
           */
-         if (is_only_read_request) {
-            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_READ), p_monitor);
-         } else {
-            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE), p_monitor);
-         }
+         sge_c_gdi_get_lock_set(packet, &lock_set);
+         MONITOR_WAIT_TIME(SGE_LOCK_SET(&lock_set), p_monitor);
 
 #ifdef OBSERVE
          lObserveStart();
@@ -301,13 +280,10 @@ sge_worker_main(void *arg) {
 #endif
 
          /*
-          * do unlock
+          * do unlock, a JSV might have changed the held lock set
           */
-         if (is_only_read_request) {
-            SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
-         } else {
-            SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
-         }
+         SGE_UNLOCK_SET();
+         sge_c_gdi_request_latency(packet, p_monitor);
 
          if (packet->request_type == PACKET_GDI_REQUEST) {
             /*
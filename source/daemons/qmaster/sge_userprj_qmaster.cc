@@ -628,7 +628,10 @@ void sge_userprj_spool(u_long64 gdi_session) {
    DENTER(TOP_LAYER);
 
    /* this function is used on qmaster shutdown, no need to monitor this lock */
-   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   sge_lock_set_t lock_set;
+   sge_lock_set_init(&lock_set, false);
+   sge_lock_set_add(&lock_set, LOCK_DOMAIN_JOB, LOCK_READ);
+   SGE_LOCK_SET(&lock_set);
 
    for_each_rw(elem, *ocs::DataStore::get_master_list(SGE_TYPE_USER)) {
       name = lGetString(elem, UU_name);
@@ -640,7 +643,7 @@ void sge_userprj_spool(u_long64 gdi_session) {
       sge_event_spool(&answer_list, now, sgeE_PROJECT_MOD, 0, 0, name, nullptr, nullptr, elem, nullptr, nullptr, false, true, gdi_session);
    }
 
-   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+   SGE_UNLOCK_SET();
 
    answer_list_output(&answer_list);
 
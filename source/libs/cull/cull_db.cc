@@ -157,7 +157,8 @@ lList *lJoinSublist(const char *name, int nm0, const lList *lp,
                     const lCondition *cp0, const lEnumeration *enp0,
                     const lDescr *sldp, const lCondition *cp1,
                     const lEnumeration *enp1) {
-   lList *dlp, *tlp, *joinedlist, *sublist;
+   lList *dlp, *tlp, *joinedlist;
+   const lList *sublist;
    const lListElem *ep;
    lDescr *dp;
    const lDescr *tdp;
@@ -219,7 +220,7 @@ lList *lJoinSublist(const char *name, int nm0, const lList *lp,
 
    for_each_where(ep, lp, cp0) {
       /* is there a sublist for the join */
-      if ((sublist = lGetListRW(ep, nm0)) != nullptr) {
+      if ((sublist = lGetList(ep, nm0)) != nullptr) {
 
          /* put each element in the tlp to be used by lJoin */
          if (lAppendElem(tlp, lCopyElem(ep)) == -1) {
@@ -876,6 +877,175 @@ lList *lSelectDPack(const char *name, const lList *slp, const lCondition *cp,
    DRETURN(dlp);
 }
 
+/* max-heap of elements ordered by the ulong at position pos, used by lSelectPage() */
+static void cull_page_heap_sift_down(const lListElem **heap, u_long32 size, u_long32 i, int pos) {
+   while (true) {
+      u_long32 largest = i;
+      u_long32 left = 2 * i + 1;
+      u_long32 right = left + 1;
+
+      if (left < size && lGetPosUlong(heap[left], pos) > lGetPosUlong(heap[largest], pos)) {
+         largest = left;
+      }
+      if (right < size && lGetPosUlong(heap[right], pos) > lGetPosUlong(heap[largest], pos)) {
+         largest = right;
+      }
+      if (largest == i) {
+         break;
+      }
+      const lListElem *tmp = heap[i];
+      heap[i] = heap[largest];
+      heap[largest] = tmp;
+      i = largest;
+   }
+}
+
+static void cull_page_heap_sift_up(const lListElem **heap, u_long32 i, int pos) {
+   while (i > 0) {
+      u_long32 parent = (i - 1) / 2;
+
+      if (lGetPosUlong(heap[parent], pos) >= lGetPosUlong(heap[i], pos)) {
+         break;
+      }
+      const lListElem *tmp = heap[i];
+      heap[i] = heap[parent];
+      heap[parent] = tmp;
+      i = parent;
+   }
+}
+
+/****** cull/db/lSelectPage() *************************************************
+*  NAME
+*     lSelectPage() -- Extracts one page of elements fulfilling a condition
+*
+*  SYNOPSIS
+*     lList *lSelectPage(const char *name, const lList *slp,
+*                        const lCondition *cp, const lEnumeration *enp,
+*                        int key_nm, u_long32 cursor, u_long32 limit)
+*
+*  FUNCTION
+*     Creates a new list containing at most 'limit' elements of 'slp'
+*     fulfilling the condition 'cp' whose ulong field 'key_nm' is
+*     greater than 'cursor'. These are the elements with the smallest
+*     keys and they are returned sorted by the key.
+*
+*     Passing the highest key of a page as cursor of the next call
+*     makes it possible to transfer a large list in several parts.
+*     The source list need not be sorted, only the page is held in
+*     memory: one pass over the list keeps the 'limit' smallest keys
+*     in a heap.
+*
+*  INPUTS
+*     const char *name        - name for the new list
+*     const lList *slp        - source list pointer
+*     const lCondition *cp    - selects rows
+*     const lEnumeration *enp - selects columns (nullptr for all)
+*     int key_nm              - ulong field used as key
+*     u_long32 cursor         - only keys greater than cursor are returned
+*     u_long32 limit          - maximum number of elements
+*
+*  RESULT
+*     lList* - list containing the page (maybe empty)
+*              or nullptr in case of an error
+******************************************************************************/
+lList *lSelectPage(const char *name, const lList *slp, const lCondition *cp, const lEnumeration *enp,
+                   int key_nm, u_long32 cursor, u_long32 limit) {
+   const lListElem **heap = nullptr;
+   u_long32 size = 0;
+   lDescr *dp = nullptr;
+   lList *dlp = nullptr;
+   const lListElem *ep;
+   int pos;
+
+   DENTER(CULL_LAYER);
+
+   if (slp == nullptr || limit == 0) {
+      DRETURN(nullptr);
+   }
+   pos = lGetPosInDescr(slp->descr, key_nm);
+   if (pos < 0 || pos >= lCountDescr(slp->descr) || slp->descr[pos].nm != key_nm) {
+      LERROR(LENAMENOT);
+      DRETURN(nullptr);
+   }
+   if (lGetPosType(slp->descr, pos) != lUlongT) {
+      LERROR(LEINCTYPE);
+      DRETURN(nullptr);
+   }
+
+   heap = (const lListElem **) sge_malloc(sizeof(lListElem *) * limit);
+   if (heap == nullptr) {
+      LERROR(LEMALLOC);
+      DRETURN(nullptr);
+   }
+
+   /* keep the 'limit' smallest keys greater than cursor, the biggest of them is on top */
+   for (ep = slp->first; ep != nullptr; ep = ep->next) {
+      u_long32 key = lGetPosUlong(ep, pos);
+
+      if (key <= cursor || (size == limit && key >= lGetPosUlong(heap[0], pos)) || !lCompare(ep, cp)) {
+         continue;
+      }
+      if (size < limit) {
+         heap[size] = ep;
+         cull_page_heap_sift_up(heap, size, pos);
+         size++;
+      } else {
+         heap[0] = ep;
+         cull_page_heap_sift_down(heap, size, 0, pos);
+      }
+   }
+
+   /* heap sort: biggest key moves to the end */
+   for (u_long32 i = size; i > 1; i--) {
+      const lListElem *tmp = heap[0];
+      heap[0] = heap[i - 1];
+      heap[i - 1] = tmp;
+      cull_page_heap_sift_down(heap, i - 1, 0, pos);
+   }
+
+   if (enp != nullptr) {
+      dp = lGetReducedDescr(slp->descr, enp);
+      if (dp == nullptr) {
+         LERROR(LEPARTIALDESCR);
+         sge_free(&heap);
+         DRETURN(nullptr);
+      }
+      dlp = lCreateListHash(name, dp, false);
+      cull_hash_free_descr(dp);
+      sge_free(&dp);
+   } else {
+      dlp = lCreateListHash(name, slp->descr, false);
+   }
+   if (dlp == nullptr) {
+      LERROR(LECREATELIST);
+      sge_free(&heap);
+      DRETURN(nullptr);
+   }
+
+   for (u_long32 i = 0; i < size; i++) {
+      lListElem *new_ep;
+
+      if (enp != nullptr) {
+         new_ep = lSelectElemDPack(heap[i], nullptr, dlp->descr, enp, false, nullptr, nullptr);
+      } else {
+         new_ep = lCopyElem(heap[i]);
+      }
+      if (new_ep == nullptr || lAppendElem(dlp, new_ep) == -1) {
+         LERROR(LEAPPENDELEM);
+         lFreeElem(&new_ep);
+         lFreeList(&dlp);
+         break;
+      }
+   }
+   sge_free(&heap);
+
+   if (dlp != nullptr) {
+      cull_hash_create_hashtables(dlp);
+   }
+
+   DRETURN(dlp);
+}
+
 /****** cull/db/lPartialDescr() ***********************************************
 *  NAME
 *     lPartialDescr() -- Extracts some fields of a descriptor 
@@ -57,6 +57,9 @@ lList *lSelectDPack(const char *name, const lList *slp, const lCondition *cp, co
                     bool isHash,
                     sge_pack_buffer *pb, u_long32 *elements);
 
+lList *lSelectPage(const char *name, const lList *slp, const lCondition *cp, const lEnumeration *enp,
+                   int key_nm, u_long32 cursor, u_long32 limit);
+
 lDescr *lGetReducedDescr(const lDescr *type, const lEnumeration *what);
 
 lList *lSelectDestroy(lList *slp, const lCondition *cp);
@@ -374,7 +374,7 @@ int lDumpElemFp(FILE *fp, const lListElem *ep, int indent) {
             }
             break;
          case lListT:
-            if ((tlp = lGetPosList(ep, i)) == nullptr)
+            if ((tlp = ep->cont[i].glp) == nullptr)
                ret = fprintf(fp, "%s/* %-20.20s */ empty\n",
                              space, lNm2Str(ep->descr[i].nm));
             else {
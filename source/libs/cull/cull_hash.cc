@@ -192,7 +192,8 @@ cull_htable cull_hash_create(const lDescr *descr, int size) {
          ht = sge_htable_create(size, dup_func_string, hash_func_string, hash_compare_string);
          break;
       case lHostT:
-         ht = sge_htable_create(size, dup_func_string, hash_func_string, hash_compare_string);
+         /* hostnames are hashed by their interned id, see cull_hash_key() */
+         ht = sge_htable_create(size, dup_func_u_long32, hash_func_u_long32, hash_compare_u_long32);
          break;
       case lUlongT:
          ht = sge_htable_create(size, dup_func_u_long32, hash_func_u_long32, hash_compare_u_long32);
@@ -357,7 +358,6 @@ void cull_hash_insert(const lListElem *ep, void *key, cull_htable ht, bool uniqu
 *     const int pos       - position of the data field 
 *******************************************************************************/
 void cull_hash_remove(const lListElem *ep, const int pos) {
-   char host_key[CL_MAXHOSTNAMELEN + 1];
    cull_htable ht;
    void *key;
 
@@ -372,7 +372,7 @@ void cull_hash_remove(const lListElem *ep, const int pos) {
       return;
    }
 
-   key = cull_hash_key(ep, pos, host_key);
+   key = cull_hash_key(ep, pos);
    if (key != nullptr) {
       if (mt_is_unique(ep->descr[pos].mt)) {
          sge_htable_delete(ht->ht, key);
@@ -440,7 +440,6 @@ void cull_hash_remove(const lListElem *ep, const int pos) {
 void cull_hash_elem(const lListElem *ep) {
    int i;
    lDescr *descr;
-   char host_key[CL_MAXHOSTNAMELEN];
 
    if (ep == nullptr) {
       return;
@@ -450,7 +449,7 @@ void cull_hash_elem(const lListElem *ep) {
 
    for (i = 0; mt_get_type(descr[i].mt) != lEndT; i++) {
       if (descr[i].ht != nullptr) {
-         cull_hash_insert(ep, cull_hash_key(ep, i, host_key), descr[i].ht,
+         cull_hash_insert(ep, cull_hash_key(ep, i), descr[i].ht,
                           mt_is_unique(descr[i].mt));
       }
    }
@@ -736,7 +735,6 @@ int cull_hash_new(lList *lp, int nm, bool unique) {
    lDescr *descr;
    const lListElem *ep;
    int pos, size;
-   char host_key[CL_MAXHOSTNAMELEN];
 
    DENTER(CULL_LAYER);
 
@@ -774,14 +772,14 @@ int cull_hash_new(lList *lp, int nm, bool unique) {
 
    /* insert all elements into the new hash table */
    for_each_ep(ep, lp) {
-      cull_hash_insert(ep, cull_hash_key(ep, pos, host_key), descr[pos].ht,
+      cull_hash_insert(ep, cull_hash_key(ep, pos), descr[pos].ht,
                        unique);
    }
 
    DRETURN(1);
 }
 
-void *cull_hash_key(const lListElem *ep, int pos, char *host_key) {
+void *cull_hash_key(const lListElem *ep, int pos) {
    void *key = nullptr;
 
    lDescr *descr = &(ep->descr[pos]);
@@ -800,10 +798,9 @@ void *cull_hash_key(const lListElem *ep, int pos, char *host_key) {
          break;
 
       case lHostT:
-         if (ep->cont[pos].host != nullptr && host_key != nullptr) {
-            sge_hostcpy(host_key, ep->cont[pos].host);
-            sge_strtoupper(host_key, CL_MAXHOSTNAMELEN);
-            key = host_key;
+         if (ep->cont[pos].host != nullptr) {
+            /* the interned entry lives as long as the process */
+            key = (void *) &(sge_host_intern(ep->cont[pos].host)->id);
          }
          break;
 
@@ -867,14 +864,13 @@ void cull_hash_recreate_after_sort(lList *lp) {
       }
 
       if (hash_index > 0) {
-         char host_key[CL_MAXHOSTNAMELEN];
-         const lListElem *ep;
+               const lListElem *ep;
 
          /* now insert into the cleared hash list */
          for_each_ep(ep, lp) {
             for (i = 0; i < hash_index; i++) {
                int index = cleared_hash_index[i];
-               cull_hash_insert(ep, cull_hash_key(ep, index, host_key), descr[index].ht, false);
+               cull_hash_insert(ep, cull_hash_key(ep, index), descr[index].ht, false);
             }
          }
       }
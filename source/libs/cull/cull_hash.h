@@ -60,7 +60,7 @@ void cull_hash_free_descr(lDescr *descr);
 
 void cull_hash_create_hashtables(lList *lp);
 
-void *cull_hash_key(const lListElem *ep, int pos, char *host_key);
+void *cull_hash_key(const lListElem *ep, int pos);
 
 const char *cull_hash_statistics(cull_htable ht, dstring *buffer);
 
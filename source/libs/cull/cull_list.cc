@@ -34,6 +34,7 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -709,7 +710,7 @@ static void lWriteElem_(const lListElem *ep, dstring *buffer, int nesting_level)
             sge_dstring_sprintf_append(buffer, "%s%-20.20s (Host)    = %s\n", space, name, str ? str : "(null)");
             break;
          case lListT:
-            tlp = lGetPosList(ep, i);
+            tlp = ep->cont[i].glp;
             sge_dstring_sprintf_append(buffer, "%s%-20.20s (List)    = %s\n", space, name, tlp ? "full {" : "empty");
             if (tlp) {
                lWriteList_(tlp, buffer, nesting_level + 1);
@@ -979,6 +980,7 @@ lList *lCreateListHash(const char *listname, const lDescr *descr, bool hash) {
    }
 
    lp->nelem = 0;
+   lp->shared = 0;
    if ((n = lCountDescr(descr)) <= 0) {
       sge_free(&(lp->listname));
       sge_free(&lp);
@@ -988,6 +990,7 @@ lList *lCreateListHash(const char *listname, const lDescr *descr, bool hash) {
 
    lp->first = nullptr;
    lp->last = nullptr;
+   lp->sort_index = nullptr;
    if (!(lp->descr = (lDescr *) sge_malloc(sizeof(lDescr) * (n + 1)))) {
       sge_free(&(lp->listname));
       sge_free(&lp);
@@ -1160,6 +1163,17 @@ void lFreeElem(lListElem **ep1) {
    DRETURN_VOID;
 }
 
+/* drops one additional owner of a shared list, false if the caller is the only owner */
+static bool cull_list_release_owner(lList *lp) {
+   std::atomic_ref<u_long32> shared(lp->shared);
+   u_long32 owners = shared.load();
+
+   while (owners > 0 && !shared.compare_exchange_weak(owners, owners - 1)) {
+      ;
+   }
+   return owners > 0;
+}
+
 /****** cull/list/lFreeList() *************************************************
 *  NAME
 *     lFreeList() -- Frees a list including all elements  
@@ -1186,6 +1200,12 @@ void lFreeList(lList **lp) {
       DRETURN_VOID;
    }
 
+   /* a shared list is freed by its last owner */
+   if (cull_list_release_owner(*lp)) {
+      *lp = nullptr;
+      DRETURN_VOID;
+   }
+
    /* 
     * remove all hash tables, 
     * it is more efficient than removing it at the end 
@@ -1193,6 +1213,7 @@ void lFreeList(lList **lp) {
    if ((*lp)->descr != nullptr) {
       cull_hash_free_descr((*lp)->descr);
    }
+   cull_sort_index_free(&((*lp)->sort_index));
 
    while ((*lp)->first) {
       lListElem *elem = (*lp)->first;
@@ -1501,6 +1522,165 @@ lList *lCopyList(const char *name, const lList *src) {
    return lCopyListHash(name, src, true);
 }
 
+/****** cull/list/lSnapshotList() *********************************************
+*  NAME
+*     lSnapshotList() -- Copy a list sharing some of the sublists
+*
+*  SYNOPSIS
+*     lList *lSnapshotList(const char *name, const lList *src,
+*                          const int *shared_nm)
+*
+*  FUNCTION
+*     Creates a copy of 'src' like lCopyList() but the sublists stored
+*     in the fields 'shared_nm' are not copied. Source and copy reference
+*     the same sublist objects (copy on write):
+*
+*     - lFreeList() frees a shared list when the last owner releases it
+*     - the functions returning a sublist for modification (lGetListRW(),
+*       lGetListRef(), lXchgList(), lGetSub*RW(), lAddSub*(), lDelSub*())
+*       replace a shared sublist by a private copy before returning it
+*     - read accessors (lGetList(), lGetPosList(), lGetSub*()) never
+*       modify the element, they return the shared sublist
+*
+*     Only sublists are shared, all other fields are copied. Fields not
+*     being part of the descriptor of 'src' are ignored. This makes the
+*     snapshot of big lists cheap when most of the sublists are only read.
+*
+*  INPUTS
+*     const char *name     - list name (nullptr: name of src)
+*     const lList *src     - source list
+*     const int *shared_nm - lListT fields to share, terminated by NoName
+*
+*  RESULT
+*     lList* - Copy of 'src' or nullptr
+*
+*  NOTES
+*     Modifications via a const sublist pointer casted to non const
+*     (e.g. lFirstRW(lGetList(ep, nm))) would be visible in both lists.
+*     Only fields which are read or modified via the RW functions
+*     must be shared.
+*
+*     MT-NOTE: lSnapshotList() is MT safe as long as 'src' is not modified
+*     MT-NOTE: concurrently. The owner count of a shared sublist is updated
+*     MT-NOTE: atomically, source and copy may be used by different threads.
+*
+*  SEE ALSO
+*     cull/list/lCopyList()
+******************************************************************************/
+lList *lSnapshotList(const char *name, const lList *src, const int *shared_nm) {
+   DENTER(CULL_LAYER);
+
+   if (src == nullptr) {
+      LERROR(LELISTNULL);
+      DRETURN(nullptr);
+   }
+
+   if (name == nullptr) {
+      name = src->listname;
+   }
+
+   lList *dst = lCreateListHash(name, src->descr, false);
+   if (dst == nullptr) {
+      LERROR(LECREATELIST);
+      DRETURN(nullptr);
+   }
+
+   /* find the positions of the shared fields in the (maybe reduced) descriptor */
+   int n = lCountDescr(src->descr);
+   bool *is_shared = (bool *) calloc(n, sizeof(bool));
+   for (int i = 0; shared_nm != nullptr && shared_nm[i] != NoName; i++) {
+      int pos = lGetPosInDescr(src->descr, shared_nm[i]);
+      if (pos >= 0 && pos < n && src->descr[pos].nm == shared_nm[i] &&
+          mt_get_type(src->descr[pos].mt) == lListT) {
+         is_shared[pos] = true;
+      }
+   }
+
+   for (const lListElem *sep = src->first; sep != nullptr; sep = sep->next) {
+      lListElem *dep = lCreateElem(src->descr);
+
+      for (int i = 0; i < n; i++) {
+         if (is_shared[i] && sep->cont[i].glp != nullptr) {
+            std::atomic_ref<u_long32>(sep->cont[i].glp->shared).fetch_add(1);
+            dep->cont[i].glp = sep->cont[i].glp;
+         } else {
+            lCopySwitchPack(sep, dep, i, i, true, nullptr, nullptr);
+         }
+      }
+
+      if (lAppendElem(dst, dep) == -1) {
+         lFreeElem(&dep);
+         lFreeList(&dst);
+         sge_free(&is_shared);
+         LERROR(LEAPPENDELEM);
+         DRETURN(nullptr);
+      }
+   }
+   sge_free(&is_shared);
+
+   cull_hash_create_hashtables(dst);
+
+   DRETURN(dst);
+}
+
+/****** cull/list/cull_list_unshare() ******************************************
+*  NAME
+*     cull_list_unshare() -- make a sublist private before modifying it
+*
+*  SYNOPSIS
+*     lList *cull_list_unshare(lList **lpp)
+*
+*  FUNCTION
+*     If the list '*lpp' is shared with other owners (see lSnapshotList())
+*     then it is replaced by a private copy.
+*
+*  INPUTS
+*     lList **lpp - reference to the list stored in an element
+*
+*  RESULT
+*     lList* - list which can be modified
+*
+*  NOTES
+*     A shared list is never modified, so it can be copied while other
+*     owners are reading it.
+*
+*     MT-NOTE: cull_list_unshare() is MT safe as long as the element
+*     MT-NOTE: holding '*lpp' is not used by other threads
+******************************************************************************/
+lList *cull_list_unshare(lList **lpp) {
+   if (*lpp != nullptr && cull_list_is_shared(*lpp)) {
+      lList *copy = lCopyList(nullptr, *lpp);
+
+      if (cull_list_release_owner(*lpp)) {
+         *lpp = copy;
+      } else {
+         /* the other owners released the list meanwhile */
+         lFreeList(&copy);
+      }
+   }
+   return *lpp;
+}
+
+/****** cull/list/cull_list_is_shared() ****************************************
+*  NAME
+*     cull_list_is_shared() -- is a list referenced by other owners
+*
+*  SYNOPSIS
+*     bool cull_list_is_shared(const lList *lp)
+*
+*  INPUTS
+*     const lList *lp - list
+*
+*  RESULT
+*     bool - true if other owners reference the list (see lSnapshotList())
+*
+*  NOTES
+*     MT-NOTE: cull_list_is_shared() is MT safe
+******************************************************************************/
+bool cull_list_is_shared(const lList *lp) {
+   return lp != nullptr && std::atomic_ref<u_long32>(const_cast<lList *>(lp)->shared).load() > 0;
+}
+
 /****** cull/list/lCopyListHash() *************************************************
 *  NAME
 *     lCopyListHash() -- Copy a list including strings and sublists 
@@ -1626,6 +1806,9 @@ int lInsertElem(lList *lp, lListElem *ep, lListElem *new_ep) {
    new_ep->descr = lp->descr;
 
    cull_hash_elem(new_ep);
+   if (lp->sort_index != nullptr) {
+      cull_sort_index_insert(lp->sort_index, new_ep);
+   }
 
    lp->nelem++;
 
@@ -1694,6 +1877,9 @@ int lAppendElem(lList *lp, lListElem *ep) {
    ep->descr = lp->descr;
 
    cull_hash_elem(ep);
+   if (lp->sort_index != nullptr) {
+      cull_sort_index_insert(lp->sort_index, ep);
+   }
    lp->nelem++;
 
 #ifdef OBSERVE
@@ -1741,6 +1927,10 @@ int lRemoveElem(lList *lp, lListElem **ep1) {
       abort();
    }
 
+   if (lp->sort_index != nullptr) {
+      cull_sort_index_remove(lp->sort_index, ep);
+   }
+
    if (ep->prev) {
       ep->prev->next = ep->next;
    } else {
@@ -1847,6 +2037,13 @@ lDechainList(lList *source, lList **target, lListElem *ep) {
    cull_hash_create_hashtables(source);
    cull_hash_create_hashtables(*target);
 
+   if (source->sort_index != nullptr) {
+      cull_sort_index_rebuild(source->sort_index, source);
+   }
+   if ((*target)->sort_index != nullptr) {
+      cull_sort_index_rebuild((*target)->sort_index, *target);
+   }
+
 #ifdef OBSERVE
    lListElem *elem;
    for_each_ep(elem, *target) {
@@ -1895,6 +2092,10 @@ lListElem *lDechainElem(lList *lp, lListElem *ep) {
       abort();
    }
 
+   if (lp->sort_index != nullptr) {
+      cull_sort_index_remove(lp->sort_index, ep);
+   }
+
    if (ep->prev) {
       ep->prev->next = ep->next;
    } else {
@@ -2302,6 +2503,9 @@ int lSortList(lList *lp, const lSortOrder *sp) {
 
    n = lGetNumberOfElem(lp);
    if (n < 2) {
+      if (lp->sort_index != nullptr) {
+         cull_sort_index_rebuild(lp->sort_index, lp);
+      }
       DRETURN(0);                 /* ok list is sorted */
    }
 
@@ -2357,6 +2561,11 @@ int lSortList(lList *lp, const lSortOrder *sp) {
 
    cull_hash_recreate_after_sort(lp);
 
+   /* the index mirrors the new list order */
+   if (lp->sort_index != nullptr) {
+      cull_sort_index_rebuild(lp->sort_index, lp);
+   }
+
    DRETURN(0);
 }
 
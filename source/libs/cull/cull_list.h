@@ -52,6 +52,7 @@ typedef struct _lCondition lCondition;
 typedef struct _lEnumeration lEnumeration;
 typedef union _lMultiType lMultiType;
 typedef struct _lSortOrder lSortOrder;
+typedef struct _lSortIndex lSortIndex;
 typedef struct _WhereArg WhereArg, *WhereArgList;
 
 typedef float lFloat;
@@ -268,6 +269,8 @@ lList *lCopyList(const char *name, const lList *src);
 
 lList *lCopyListHash(const char *name, const lList *src, bool hash);
 
+lList *lSnapshotList(const char *name, const lList *src, const int *shared_nm);
+
 lListElem *lCopyElem(const lListElem *src);
 
 lListElem *lCopyElemHash(const lListElem *src, bool isHash);
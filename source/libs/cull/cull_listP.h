@@ -76,8 +76,14 @@ struct _lListElem {
 
 struct _lList {
    u_long32 nelem;              /* number of elements in the list            */
+   u_long32 shared;             /* number of additional owners, see lSnapshotList(), atomic access only */
    char *listname;              /* name of the list                          */
    lDescr *descr;               /* pointer to the descriptor array           */
    lListElem *first;            /* pointer to the first element of the list  */
    lListElem *last;             /* pointer to the last element of the list   */
+   lSortIndex *sort_index;      /* optional ordered index, see lSortIndexCreate() */
 };
+
+bool cull_list_is_shared(const lList *lp);
+
+lList *cull_list_unshare(lList **lpp);
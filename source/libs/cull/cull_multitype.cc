@@ -600,7 +600,7 @@ int lGetPosType(const lDescr *dp, int pos) {
    return mt_get_type(dp[pos].mt);
 }
 
-lList **lGetListRef(const lListElem *ep, int name) {
+lList **lGetListRef(lListElem *ep, int name) {
    int pos;
 
    DENTER(CULL_BASIS_LAYER);
@@ -610,6 +610,7 @@ lList **lGetListRef(const lListElem *ep, int name) {
    if (mt_get_type(ep->descr[pos].mt) != lListT)
       incompatibleType("lGetPosListRef");
 
+   cull_list_unshare(&(ep->cont[pos].glp));
    DRETURN(&(ep->cont[pos].glp));
 }
 
@@ -1120,11 +1121,21 @@ lList *lGetListRW(const lListElem *ep, int name) {
                         lNm2Str(name), multitypes[mt_get_type(ep->descr[pos].mt)]);
    }
 
-   DRETURN((lList *) ep->cont[pos].glp);
+   DRETURN(cull_list_unshare(&(ep->cont[pos].glp)));
 }
 
 const lList *lGetList(const lListElem *ep, int nm) {
-   return lGetListRW(ep, nm);
+   int pos;
+   DENTER(CULL_BASIS_LAYER);
+
+   pos = lGetPosViaElem(ep, nm, SGE_DO_ABORT);
+
+   if (mt_get_type(ep->descr[pos].mt) != lListT) {
+      incompatibleType2(MSG_CULL_GETLIST_WRONGTYPEFORFIELDXY_SS,
+                        lNm2Str(nm), multitypes[mt_get_type(ep->descr[pos].mt)]);
+   }
+
+   DRETURN(ep->cont[pos].glp);
 }
 
 /****** cull/multitype/lGetOrCreateList() **************************************
@@ -2151,8 +2162,7 @@ int lSetPosHost(lListElem *ep, int pos, const char *value) {
 
       /* create entry in hash table */
       if (ep->descr[pos].ht != nullptr) {
-         char host_key[CL_MAXHOSTNAMELEN + 1];
-         cull_hash_insert(ep, cull_hash_key(ep, pos, host_key),
+         cull_hash_insert(ep, cull_hash_key(ep, pos),
                           ep->descr[pos].ht, mt_is_unique(ep->descr[pos].mt));
       }
    }
@@ -2344,8 +2354,7 @@ int lSetHost(lListElem *ep, int name, const char *value) {
 
       /* create entry in hash table */
       if (ep->descr[pos].ht != nullptr) {
-         char host_key[CL_MAXHOSTNAMELEN + 1];
-         cull_hash_insert(ep, cull_hash_key(ep, pos, host_key),
+         cull_hash_insert(ep, cull_hash_key(ep, pos),
                           ep->descr[pos].ht, mt_is_unique(ep->descr[pos].mt));
       }
    }
@@ -2576,7 +2585,7 @@ int lXchgList(lListElem *ep, int name, lList **lpp) {
 #endif
 
    if (*lpp != ep->cont[pos].glp) {
-      tmp = ep->cont[pos].glp;
+      tmp = cull_list_unshare(&(ep->cont[pos].glp));
       ep->cont[pos].glp = *lpp;
       *lpp = tmp;
    }
@@ -3536,6 +3545,7 @@ lListElem *lAddSubStr(lListElem *ep, int nm, const char *str, int snm,
       DRETURN(nullptr);
    }
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lAddElemStr(&(ep->cont[sublist_pos].glp), nm, str, dp);
 
    DRETURN(ret);
@@ -3589,6 +3599,7 @@ lListElem *lAddSubHost(lListElem *ep, int nm, const char *str, int snm,
       DRETURN(nullptr);
    }
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lAddElemHost(&(ep->cont[sublist_pos].glp), nm, str, dp);
 
    DRETURN(ret);
@@ -3745,6 +3756,7 @@ int lDelSubStr(lListElem *ep, int nm, const char *str, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lDelElemStr(&(ep->cont[sublist_pos].glp), nm, str);
 
    DRETURN(ret);
@@ -3833,6 +3845,9 @@ lListElem *lGetSubStrRW(const lListElem *ep, int nm, const char *str, int snm) {
       sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
       ret = lGetElemStrRW(ep->cont[sublist_pos].glp, nm, str);
+      if (ret != nullptr && cull_list_is_shared(ep->cont[sublist_pos].glp)) {
+         ret = lGetElemStrRW(cull_list_unshare(&(ep->cont[sublist_pos].glp)), nm, str);
+      }
    }
 
    DRETURN(ret);
@@ -3840,7 +3855,12 @@ lListElem *lGetSubStrRW(const lListElem *ep, int nm, const char *str, int snm) {
 
 const lListElem *
 lGetSubStr(const lListElem *ep, int nm, const char *str, int snm) {
-   return lGetSubStrRW(ep, nm, str, snm);
+   const lListElem *ret = nullptr;
+
+   if (ep != nullptr) {
+      ret = lGetElemStr(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp, nm, str);
+   }
+   return ret;
 }
 
 /****** cull/multitype/lGetElemStr() ******************************************
@@ -4168,6 +4188,7 @@ lListElem *lAddSubUlong(lListElem *ep, int nm, lUlong val, int snm,
       DRETURN(nullptr);
    }
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lAddElemUlong(&(ep->cont[sublist_pos].glp), nm, val, dp);
 
    DRETURN(ret);
@@ -4259,6 +4280,7 @@ int lDelSubUlong(lListElem *ep, int nm, lUlong val, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lDelElemUlong(&(ep->cont[sublist_pos].glp), nm, val);
 
    DRETURN(ret);
@@ -4344,12 +4366,15 @@ lListElem *lGetSubUlongRW(const lListElem *ep, int nm, lUlong val, int snm) {
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
    ret = lGetElemUlongRW(ep->cont[sublist_pos].glp, nm, val);
+   if (ret != nullptr && cull_list_is_shared(ep->cont[sublist_pos].glp)) {
+      ret = lGetElemUlongRW(cull_list_unshare(&(ep->cont[sublist_pos].glp)), nm, val);
+   }
 
    DRETURN(ret);
 }
 
 const lListElem *lGetSubUlong(const lListElem *ep, int nm, lUlong val, int snm) {
-   return lGetSubUlongRW(ep, nm, val, snm);
+   return lGetElemUlong(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp, nm, val);
 }
 
 /****** cull/multitype/lGetElemUlong() ****************************************
@@ -4567,6 +4592,7 @@ lListElem *lAddSubUlong64(lListElem *ep, int nm, lUlong64 val, int snm,
       DRETURN(nullptr);
    }
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lAddElemUlong64(&(ep->cont[sublist_pos].glp), nm, val, dp);
 
    DRETURN(ret);
@@ -4658,6 +4684,7 @@ int lDelSubUlong64(lListElem *ep, int nm, lUlong64 val, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
+   cull_list_unshare(&(ep->cont[sublist_pos].glp));
    ret = lDelElemUlong64(&(ep->cont[sublist_pos].glp), nm, val);
 
    DRETURN(ret);
@@ -4743,12 +4770,15 @@ lListElem *lGetSubUlong64RW(const lListElem *ep, int nm, lUlong64 val, int snm)
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
    ret = lGetElemUlong64RW(ep->cont[sublist_pos].glp, nm, val);
+   if (ret != nullptr && cull_list_is_shared(ep->cont[sublist_pos].glp)) {
+      ret = lGetElemUlong64RW(cull_list_unshare(&(ep->cont[sublist_pos].glp)), nm, val);
+   }
 
    DRETURN(ret);
 }
 
 const lListElem *lGetSubUlong64(const lListElem *ep, int nm, lUlong64 val, int snm) {
-   return lGetSubUlong64RW(ep, nm, val, snm);
+   return lGetElemUlong64(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp, nm, val);
 }
 
 /****** cull/multitype/lGetElemUlong64() **************************************
@@ -4952,6 +4982,9 @@ lListElem *lGetSubCaseStr(const lListElem *ep, int nm, const char *str,
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
    ret = lGetElemCaseStrRW(ep->cont[sublist_pos].glp, nm, str);
+   if (ret != nullptr && cull_list_is_shared(ep->cont[sublist_pos].glp)) {
+      ret = lGetElemCaseStrRW(cull_list_unshare(&(ep->cont[sublist_pos].glp)), nm, str);
+   }
 
    DRETURN(ret);
 }
@@ -5084,8 +5117,6 @@ lListElem *lGetElemHostFirstRW(const lList *lp, int nm, const char *str, const v
    int data_type;
    lListElem *ep = nullptr;
    const lDescr *listDescriptor = nullptr;
-   char uhost[CL_MAXHOSTNAMELEN + 1];
-   char cmphost[CL_MAXHOSTNAMELEN + 1];
    const char *s = nullptr;
 
    DENTER(TOP_LAYER);
@@ -5110,28 +5141,26 @@ lListElem *lGetElemHostFirstRW(const lList *lp, int nm, const char *str, const v
 
    *iterator = nullptr;
    if (lp->descr[pos].ht != nullptr) {
-      /* we have a hash table */
-      char host_key[CL_MAXHOSTNAMELEN + 1];
-      sge_hostcpy(host_key, str);
-      sge_strtoupper(host_key, CL_MAXHOSTNAMELEN);
-      ep = cull_hash_first(lp->descr[pos].ht, host_key,
+      /* we have a hash table, all hostnames in it are interned */
+      const sge_host_id_t *host_id = sge_host_intern_lookup(str);
+      if (host_id == nullptr) {
+         DRETURN(nullptr);
+      }
+      ep = cull_hash_first(lp->descr[pos].ht, &(host_id->id),
                            mt_is_unique(lp->descr[pos].mt), iterator);
       DRETURN(ep);
    } else {
       /* expensive host search algorithm */
 
-      /* copy searched hostname */
-      sge_hostcpy(uhost, str);
+      /* the searched hostname is only compared by name if it is not interned */
+      const sge_host_id_t *host_id = sge_host_intern_lookup(str);
 
       /* sequence search */
       for_each_rw(ep, lp) {
          s = lGetPosHost(ep, pos);
-         if (s != nullptr) {
-            sge_hostcpy(cmphost, s);
-            if (!SGE_STRCASECMP(cmphost, uhost)) {
-               *iterator = ep;
-               DRETURN(ep);
-            }
+         if (s != nullptr && (host_id != nullptr ? sge_host_intern_lookup(s) == host_id : sge_hostcmp(s, str) == 0)) {
+            *iterator = ep;
+            DRETURN(ep);
          }
       }
    }
@@ -5169,8 +5198,6 @@ lListElem *lGetElemHostNextRW(const lList *lp, int nm, const char *str, const vo
    int pos;
    lListElem *ep = nullptr;
    const lDescr *listDescriptor = nullptr;
-   char uhost[CL_MAXHOSTNAMELEN + 1];
-   char cmphost[CL_MAXHOSTNAMELEN + 1];
    const char *s = nullptr;
 
    DENTER(TOP_LAYER);
@@ -5197,18 +5224,15 @@ lListElem *lGetElemHostNextRW(const lList *lp, int nm, const char *str, const vo
    } else {
       /* expensive host search algorithm */
 
-      /* copy searched hostname */
-      sge_hostcpy(uhost, str);
+      /* the searched hostname is only compared by name if it is not interned */
+      const sge_host_id_t *host_id = sge_host_intern_lookup(str);
 
       /* sequence search */
       for (ep = ((lListElem *) *iterator)->next; ep; ep = ep->next) {
          s = lGetPosHost(ep, pos);
-         if (s != nullptr) {
-            sge_hostcpy(cmphost, s);
-            if (!SGE_STRCASECMP(cmphost, uhost)) {
-               *iterator = ep;
-               DRETURN(ep);
-            }
+         if (s != nullptr && (host_id != nullptr ? sge_host_intern_lookup(s) == host_id : sge_hostcmp(s, str) == 0)) {
+            *iterator = ep;
+            DRETURN(ep);
          }
       }
    }
@@ -5253,12 +5277,15 @@ lListElem *lGetSubHostRW(const lListElem *ep, int nm, const char *str, int snm)
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
    ret = lGetElemHostRW(ep->cont[sublist_pos].glp, nm, str);
+   if (ret != nullptr && cull_list_is_shared(ep->cont[sublist_pos].glp)) {
+      ret = lGetElemHostRW(cull_list_unshare(&(ep->cont[sublist_pos].glp)), nm, str);
+   }
 
    DRETURN(ret);
 }
 
 const lListElem *lGetSubHost(const lListElem *ep, int nm, const char *str, int snm) {
-   return lGetSubHostRW(ep, nm, str, snm);
+   return lGetElemHost(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp, nm, str);
 }
 
 /****** cull/multitype/lDelElemHost() ****************************************
@@ -75,7 +75,7 @@ char **lGetPosStringRef(const lListElem *ep, int id);
 
 char **lGetPosHostRef(const lListElem *ep, int id);
 
-lList **lGetListRef(const lListElem *ep, int name);
+lList **lGetListRef(lListElem *ep, int name);
 
 int lGetType(const lDescr *dp, int nm);
 
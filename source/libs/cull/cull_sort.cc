@@ -41,7 +41,10 @@
 #define NO_SGE_COMPILE_DEBUG
 #endif
 
+#include "uti/sge_htable.h"
+#include "uti/sge_log.h"
 #include "uti/sge_rmon_macros.h"
+#include "uti/sge_stdlib.h"
 #include "uti/sge_string.h"
 
 #include "cull/cull_listP.h"
@@ -50,11 +53,432 @@
 #include "cull/cull_sortP.h"
 #include "cull/cull_lerrnoP.h"
 
-/* ------------------------------------------------------------ 
-
-   insert ep into sorted list lp using so as sort order
+/****** cull/sort/--CULL_SortIndex *********************************************
+*  NAME
+*     SortIndex -- ordered index for sorted cull lists
+*
+*  SYNOPSIS
+*     int lSortIndexCreate(lList *lp, const lSortOrder *so);
+*
+*     void lSortIndexFree(lList *lp);
+*
+*     bool lHasSortIndex(const lList *lp, const lSortOrder *so);
+*
+*  FUNCTION
+*     A sort index is a skip list that mirrors the order of the elements
+*     of a cull list. It is attached to a list which is sorted by a
+*     certain sort order and allows lInsertSorted() and lResortElem() to
+*     find the insert position with O(log n) comparisons instead of
+*     walking through the whole list.
+*
+*     The index is purely structural: the list functions inserting,
+*     removing or reordering elements (lInsertElem(), lAppendElem(),
+*     lRemoveElem(), lDechainElem(), lDechainList(), lSortList())
+*     keep it in sync with the list order. Iterating over the list
+*     is not affected.
+*
+*     As with the linear search, the result of lInsertSorted() is only
+*     well defined if the list is sorted by the sort order of the index.
+*     Elements whose sort key is modified have to be resorted via
+*     lResortElem().
+*
+*  NOTES
+*     The index is not copied by lCopyList() and not packed.
+*
+*     MT-NOTE: the sort index functions are MT safe as long as the list
+*     MT-NOTE: is not accessed by multiple threads concurrently
+*
+*  SEE ALSO
+*     cull/sort/lSortIndexCreate()
+*     cull/sort/lInsertSorted()
+*     cull/sort/lResortElem()
+*******************************************************************************/
 
+/* 
+ * maximum height of the skip list, with a branching factor of 4 this is 
+ * sufficient for 4^16 elements
  */
+#define CULL_SORT_INDEX_MAX_LEVEL 16
+
+typedef struct _lSortIndexNode lSortIndexNode;
+
+struct _lSortIndexNode {
+   const lListElem *ep;         /* the indexed list element, nullptr for head */
+   int level;                   /* number of levels of this node             */
+   lSortIndexNode **next;       /* successor per level                       */
+   lSortIndexNode **prev;       /* predecessor per level                     */
+};
+
+struct _lSortIndex {
+   lSortOrder *so;              /* copy of the sort order of the index       */
+   lSortIndexNode *head;        /* head node having all levels               */
+   int level;                   /* highest level currently in use            */
+   unsigned int seed;           /* state of the level generator              */
+   htable node_ht;              /* lListElem pointer -> lSortIndexNode       */
+};
+
+static lSortIndexNode *cull_sort_index_node_create(const lListElem *ep, int level) {
+   lSortIndexNode *node;
+
+   /* node and both link arrays are allocated in one chunk */
+   node = (lSortIndexNode *) sge_malloc(sizeof(lSortIndexNode) + 2 * level * sizeof(lSortIndexNode *));
+   if (node != nullptr) {
+      node->ep = ep;
+      node->level = level;
+      node->next = (lSortIndexNode **) (node + 1);
+      node->prev = node->next + level;
+      memset(node->next, 0, 2 * level * sizeof(lSortIndexNode *));
+   }
+
+   return node;
+}
+
+static int cull_sort_index_random_level(lSortIndex *index) {
+   int level = 1;
+   unsigned int x = index->seed;
+
+   /* xorshift, cheaper than rand_r() and good enough for a skip list */
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   index->seed = x;
+
+   /* each level with probability 1/4 */
+   while ((x & 3) == 0 && level < CULL_SORT_INDEX_MAX_LEVEL) {
+      level++;
+      x >>= 2;
+   }
+
+   return level;
+}
+
+static void cull_sort_index_clear(lSortIndex *index) {
+   lSortIndexNode *node = index->head->next[0];
+
+   while (node != nullptr) {
+      lSortIndexNode *next = node->next[0];
+      sge_htable_delete(index->node_ht, &(node->ep));
+      sge_free(&node);
+      node = next;
+   }
+   memset(index->head->next, 0, CULL_SORT_INDEX_MAX_LEVEL * sizeof(lSortIndexNode *));
+   index->level = 1;
+}
+
+/* link a new node for ep directly behind node pred */
+static void cull_sort_index_link(lSortIndex *index, lSortIndexNode *pred, const lListElem *ep) {
+   int level = cull_sort_index_random_level(index);
+   lSortIndexNode *node = cull_sort_index_node_create(ep, level);
+
+   if (node == nullptr) {
+      return;
+   }
+
+   for (int i = 0; i < level; i++) {
+      /* the next predecessor having this level is found walking backwards on the level below */
+      while (pred->level <= i) {
+         pred = pred->prev[i - 1];
+      }
+      node->prev[i] = pred;
+      node->next[i] = pred->next[i];
+      if (pred->next[i] != nullptr) {
+         pred->next[i]->prev[i] = node;
+      }
+      pred->next[i] = node;
+   }
+
+   if (level > index->level) {
+      index->level = level;
+   }
+   sge_htable_store(index->node_ht, &(node->ep), node);
+}
+
+/****** cull/sort/cull_sort_index_insert() *************************************
+*  NAME
+*     cull_sort_index_insert() -- add a newly chained element to the index
+*
+*  SYNOPSIS
+*     void cull_sort_index_insert(lSortIndex *index, const lListElem *ep)
+*
+*  FUNCTION
+*     Adds the element ep to the index. ep must already be chained into
+*     the list, it is inserted into the index behind its predecessor
+*     in the list.
+*
+*  INPUTS
+*     lSortIndex *index   - the sort index of the list
+*     const lListElem *ep - the element
+*******************************************************************************/
+void cull_sort_index_insert(lSortIndex *index, const lListElem *ep) {
+   lSortIndexNode *pred = index->head;
+
+   if (ep->prev != nullptr) {
+      if (sge_htable_lookup(index->node_ht, &(ep->prev), (const void **) &pred) != True) {
+         /* should never happen, but we cannot continue with an inconsistent index */
+         CRITICAL("predecessor of element is missing in sort index\n");
+         abort();
+      }
+   }
+
+   cull_sort_index_link(index, pred, ep);
+}
+
+/****** cull/sort/cull_sort_index_remove() *************************************
+*  NAME
+*     cull_sort_index_remove() -- remove an element from the index
+*
+*  SYNOPSIS
+*     void cull_sort_index_remove(lSortIndex *index, const lListElem *ep)
+*
+*  FUNCTION
+*     Removes the element ep from the index. Has to be called before
+*     ep is dechained from the list.
+*
+*  INPUTS
+*     lSortIndex *index   - the sort index of the list
+*     const lListElem *ep - the element
+*******************************************************************************/
+void cull_sort_index_remove(lSortIndex *index, const lListElem *ep) {
+   lSortIndexNode *node = nullptr;
+
+   if (sge_htable_lookup(index->node_ht, &ep, (const void **) &node) == True) {
+      for (int i = 0; i < node->level; i++) {
+         node->prev[i]->next[i] = node->next[i];
+         if (node->next[i] != nullptr) {
+            node->next[i]->prev[i] = node->prev[i];
+         }
+      }
+      sge_htable_delete(index->node_ht, &ep);
+      sge_free(&node);
+   }
+}
+
+/****** cull/sort/cull_sort_index_rebuild() ************************************
+*  NAME
+*     cull_sort_index_rebuild() -- rebuild the index from the list order
+*
+*  SYNOPSIS
+*     void cull_sort_index_rebuild(lSortIndex *index, const lList *lp)
+*
+*  FUNCTION
+*     Drops all nodes of the index and creates them again in the order
+*     of the elements in lp. No element comparisons are done.
+*
+*  INPUTS
+*     lSortIndex *index - the sort index of the list
+*     const lList *lp   - the list
+*******************************************************************************/
+void cull_sort_index_rebuild(lSortIndex *index, const lList *lp) {
+   lSortIndexNode *tail[CULL_SORT_INDEX_MAX_LEVEL];
+   const lListElem *ep;
+
+   cull_sort_index_clear(index);
+
+   for (int i = 0; i < CULL_SORT_INDEX_MAX_LEVEL; i++) {
+      tail[i] = index->head;
+   }
+
+   /* appending is O(1) per level when the last node of each level is known */
+   for (ep = lp->first; ep != nullptr; ep = ep->next) {
+      int level = cull_sort_index_random_level(index);
+      lSortIndexNode *node = cull_sort_index_node_create(ep, level);
+
+      if (node == nullptr) {
+         continue;
+      }
+      for (int i = 0; i < level; i++) {
+         node->prev[i] = tail[i];
+         tail[i]->next[i] = node;
+         tail[i] = node;
+      }
+      if (level > index->level) {
+         index->level = level;
+      }
+      sge_htable_store(index->node_ht, &(node->ep), node);
+   }
+}
+
+/****** cull/sort/cull_sort_index_free() ***************************************
+*  NAME
+*     cull_sort_index_free() -- free a sort index
+*
+*  SYNOPSIS
+*     void cull_sort_index_free(lSortIndex **index)
+*
+*  INPUTS
+*     lSortIndex **index - the sort index, will be set to nullptr
+*******************************************************************************/
+void cull_sort_index_free(lSortIndex **index) {
+   if (index != nullptr && *index != nullptr) {
+      cull_sort_index_clear(*index);
+      sge_htable_destroy((*index)->node_ht);
+      sge_free(&((*index)->head));
+      lFreeSortOrder(&((*index)->so));
+      sge_free(index);
+   }
+}
+
+static bool cull_sort_order_equal(const lSortOrder *so0, const lSortOrder *so1) {
+   int i;
+
+   for (i = 0; so0[i].nm != NoName && so1[i].nm != NoName; i++) {
+      if (so0[i].nm != so1[i].nm || so0[i].ad != so1[i].ad) {
+         return false;
+      }
+   }
+
+   return so0[i].nm == so1[i].nm;
+}
+
+/* returns the node of the last element sorting before ep, the head if there is none */
+static lSortIndexNode *cull_sort_index_search(const lSortIndex *index, const lListElem *ep) {
+   lSortIndexNode *node = index->head;
+
+   for (int i = index->level - 1; i >= 0; i--) {
+      while (node->next[i] != nullptr && lSortCompare(ep, node->next[i]->ep, index->so) > 0) {
+         node = node->next[i];
+      }
+   }
+
+   return node;
+}
+
+/****** cull/sort/lSortIndexCreate() *******************************************
+*  NAME
+*     lSortIndexCreate() -- attach an ordered index to a list
+*
+*  SYNOPSIS
+*     int lSortIndexCreate(lList *lp, const lSortOrder *so)
+*
+*  FUNCTION
+*     Sorts the list lp by the sort order so and attaches a sort index
+*     to it. Subsequent calls of lInsertSorted() and lResortElem() with
+*     the same sort order will do a O(log n) search for the insert
+*     position. An index that already exists will be replaced.
+*
+*  INPUTS
+*     lList *lp            - the list
+*     const lSortOrder *so - the sort order, a copy is kept in the index
+*
+*  RESULT
+*     int - 0 on success, -1 on error
+*
+*  NOTES
+*     MT-NOTE: lSortIndexCreate() is MT safe
+*
+*  SEE ALSO
+*     cull/sort/--CULL_SortIndex
+*******************************************************************************/
+int lSortIndexCreate(lList *lp, const lSortOrder *so) {
+   lSortIndex *index;
+   int n;
+
+   DENTER(CULL_LAYER);
+
+   if (lp == nullptr || so == nullptr) {
+      DRETURN(-1);
+   }
+
+   lSortIndexFree(lp);
+
+   if ((index = (lSortIndex *) sge_malloc(sizeof(lSortIndex))) == nullptr) {
+      LERROR(LEMALLOC);
+      DRETURN(-1);
+   }
+
+   for (n = 0; so[n].nm != NoName; n++);
+   index->so = (lSortOrder *) sge_malloc(sizeof(lSortOrder) * (n + 1));
+   index->head = cull_sort_index_node_create(nullptr, CULL_SORT_INDEX_MAX_LEVEL);
+   index->node_ht = sge_htable_create(hash_compute_size(lGetNumberOfElem(lp)), dup_func_pointer, hash_func_pointer,
+                                      hash_compare_pointer);
+   index->level = 1;
+   index->seed = 0x9e3779b9U;
+   if (index->so == nullptr || index->head == nullptr || index->node_ht == nullptr) {
+      if (index->node_ht != nullptr) {
+         sge_htable_destroy(index->node_ht);
+      }
+      sge_free(&(index->head));
+      sge_free(&(index->so));
+      sge_free(&index);
+      LERROR(LEMALLOC);
+      DRETURN(-1);
+   }
+   memcpy(index->so, so, sizeof(lSortOrder) * (n + 1));
+
+   /* lSortList() builds the index after sorting */
+   lp->sort_index = index;
+   lSortList(lp, so);
+
+   DRETURN(0);
+}
+
+/****** cull/sort/lSortIndexFree() *********************************************
+*  NAME
+*     lSortIndexFree() -- remove the ordered index of a list
+*
+*  SYNOPSIS
+*     void lSortIndexFree(lList *lp)
+*
+*  INPUTS
+*     lList *lp - the list
+*
+*  NOTES
+*     MT-NOTE: lSortIndexFree() is MT safe
+*******************************************************************************/
+void lSortIndexFree(lList *lp) {
+   if (lp != nullptr) {
+      cull_sort_index_free(&(lp->sort_index));
+   }
+}
+
+/****** cull/sort/lHasSortIndex() **********************************************
+*  NAME
+*     lHasSortIndex() -- does a list have an ordered index
+*
+*  SYNOPSIS
+*     bool lHasSortIndex(const lList *lp, const lSortOrder *so)
+*
+*  INPUTS
+*     const lList *lp      - the list
+*     const lSortOrder *so - sort order or nullptr for any sort order
+*
+*  RESULT
+*     bool - true if lp has an index for so
+*
+*  NOTES
+*     MT-NOTE: lHasSortIndex() is MT safe
+*******************************************************************************/
+bool lHasSortIndex(const lList *lp, const lSortOrder *so) {
+   if (lp == nullptr || lp->sort_index == nullptr) {
+      return false;
+   }
+   return so == nullptr || cull_sort_order_equal(lp->sort_index->so, so);
+}
+
+/****** cull/sort/lInsertSorted() **********************************************
+*  NAME
+*     lInsertSorted() -- insert an element into a sorted list
+*
+*  SYNOPSIS
+*     int lInsertSorted(const lSortOrder *so, lListElem *ep, lList *lp)
+*
+*  FUNCTION
+*     Inserts ep into the list lp which is sorted by so. ep is inserted
+*     before the first element not sorting before it.
+*     If lp has a sort index for so the insert position is searched
+*     in the index, otherwise the list is walked through.
+*
+*  INPUTS
+*     const lSortOrder *so - sort order of the list
+*     lListElem *ep        - element to insert
+*     lList *lp            - the sorted list
+*
+*  RESULT
+*     int - 0 on success, -1 on error
+*
+*  SEE ALSO
+*     cull/sort/--CULL_SortIndex
+*******************************************************************************/
 int lInsertSorted(const lSortOrder *so, lListElem *ep, lList *lp) {
    lListElem *tmp;
 
@@ -64,6 +488,14 @@ int lInsertSorted(const lSortOrder *so, lListElem *ep, lList *lp) {
       DRETURN(-1);
    }
 
+   if (lHasSortIndex(lp, so)) {
+      lSortIndexNode *pred = cull_sort_index_search(lp->sort_index, ep);
+
+      /* insert behind the last element sorting before ep */
+      lInsertElem(lp, const_cast<lListElem *>(pred->ep), ep);
+      DRETURN(0);
+   }
+
    for_each_rw(tmp, lp)if (lSortCompare(ep, tmp, so) <= 0)
          break;                    /* insert before tmp */
 
@@ -43,6 +43,12 @@ int lInsertSorted(const lSortOrder *so, lListElem *ep, lList *lp);
 
 int lResortElem(const lSortOrder *so, lListElem *ep, lList *lp);
 
+int lSortIndexCreate(lList *lp, const lSortOrder *so);
+
+void lSortIndexFree(lList *lp);
+
+bool lHasSortIndex(const lList *lp, const lSortOrder *so);
+
 lSortOrder *lParseSortOrderVarArg(const lDescr *dp, const char *fmt, ...);
 
 lSortOrder *lParseSortOrder(const lDescr *dp, const char *fmt, va_list ap);
@@ -43,3 +43,12 @@ struct _lSortOrder {
 };
 
 int lSortCompareUsingGlobal(const void *ep0, const void *ep1);
+
+/* maintenance of the ordered index, called by the list functions in cull_list.cc */
+void cull_sort_index_insert(lSortIndex *index, const lListElem *ep);
+
+void cull_sort_index_remove(lSortIndex *index, const lListElem *ep);
+
+void cull_sort_index_rebuild(lSortIndex *index, const lList *lp);
+
+void cull_sort_index_free(lSortIndex **index);
@@ -72,7 +72,7 @@ int lGetNumberOfNodes(const lListElem *ep, const lList *lp, int nm) {
       n = 1;
 
       if ((pos = lGetPosViaElem(ep, nm, SGE_NO_ABORT)) >= 0 && mt_get_type(ep->descr[pos].mt) == lListT) {
-         if ((lp = lGetPosList(ep, pos)))
+         if ((lp = lGetList(ep, nm)))
             n += lGetNumberOfNodes(nullptr, lp, nm);
       }
       DRETURN(n);
@@ -111,7 +111,7 @@ int lGetNumberOfLeafs(const lListElem *ep, const lList *lp, int nm) {
       int pos;
 
       if ((pos = lGetPosViaElem(ep, nm, SGE_NO_ABORT)) >= 0 && mt_get_type(ep->descr[pos].mt) == lListT) {
-         if (!(lp = lGetPosList(ep, pos)))
+         if (!(lp = lGetList(ep, nm)))
             n = 1;
          else
             n = lGetNumberOfLeafs(nullptr, lp, nm);
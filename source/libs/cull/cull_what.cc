@@ -532,6 +532,28 @@ lEnumeration *lWhatAll() {
    DRETURN(nullptr);
 }
 
+/****** cull/what/lIsWhatAll() ************************************************
+*  NAME
+*     lIsWhatAll() -- Does an enumeration request all elements? 
+*
+*  SYNOPSIS
+*     bool lIsWhatAll(const lEnumeration *ep) 
+*
+*  FUNCTION
+*     Returns true if the enumeration requests complete elements
+*     like an enumeration created with lWhatAll() or 
+*     lWhat("%T(ALL)", <List_type>). 
+*
+*  INPUTS
+*     const lEnumeration *ep - enumeration 
+*
+*  RESULT
+*     bool - true if all attributes are requested
+******************************************************************************/
+bool lIsWhatAll(const lEnumeration *ep) {
+   return ep != nullptr && ep[0].pos == WHAT_ALL;
+}
+
 /****** cull/what/lFreeWhat() *************************************************
 *  NAME
 *     lFreeWhat() -- Frees a enumeration array 
@@ -46,6 +46,8 @@ lEnumeration *_lWhat(const char *fmt, const lDescr *dp, const int *nm_list, int
 
 lEnumeration *lWhatAll();
 
+bool lIsWhatAll(const lEnumeration *ep);
+
 void lFreeWhat(lEnumeration **ep);
 
 lEnumeration *lCopyWhat(const lEnumeration *ep);
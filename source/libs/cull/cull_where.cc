@@ -81,6 +81,20 @@ static lCondition *_subscope(cull_parse_state *state, WhereArgList *wapp);
 
 static void lWriteWhereTo_(const lCondition *cp, int depth, FILE *fp);
 
+static int lCompare_(const lListElem *ep, const lCondition *cp);
+
+/* pattern classes of PATTERNCMP compares in compiled conditions */
+enum {
+   CULL_MATCH_DEFAULT = 0,      /* no pattern, evaluated like lCompare()     */
+   CULL_MATCH_LITERAL,          /* pattern without wildcards                 */
+   CULL_MATCH_PREFIX,           /* literal prefix followed by a single '*'   */
+   CULL_MATCH_GLOB              /* any other pattern, fnmatch() is used      */
+};
+
+/* end of a compiled condition */
+#define CULL_PROGRAM_TRUE  -1
+#define CULL_PROGRAM_FALSE -2
+
 /****** cull/where/lOrWhere() *************************************************
 *  NAME
 *     lOrWhere() -- Combines two conditions with an OR
@@ -1090,6 +1104,11 @@ void lFreeWhere(lCondition **cp) {
       DRETURN_VOID;
    }
 
+   if ((*cp)->program != nullptr) {
+      sge_free(&((*cp)->program->instr));
+      sge_free(&((*cp)->program));
+   }
+
    switch ((*cp)->op) {
       case EQUAL:
       case NOT_EQUAL:
@@ -1137,6 +1156,199 @@ void lFreeWhere(lCondition **cp) {
    DRETURN_VOID;
 }
 
+/* evaluates a compiled condition, compares are done like in lCompare_() except for patterns */
+static int lCompareProgram(const lListElem *ep, const lConditionProgram *program) {
+   int pc = 0;
+
+   while (pc >= 0) {
+      const lConditionInstr *instr = &(program->instr[pc]);
+      const lCondition *cp = instr->cmp;
+      const char *str;
+      int result;
+
+      switch (instr->match) {
+         case CULL_MATCH_LITERAL:
+         case CULL_MATCH_PREFIX:
+         case CULL_MATCH_GLOB:
+            if (mt_get_type(cp->operand.cmp.mt) == lStringT) {
+               str = lGetPosString(ep, cp->operand.cmp.pos);
+            } else {
+               str = lGetPosHost(ep, cp->operand.cmp.pos);
+            }
+            if (str == nullptr) {
+               str = "";
+            }
+            if (instr->match == CULL_MATCH_LITERAL) {
+               result = strcmp(str, instr->pattern) == 0;
+            } else if (instr->match == CULL_MATCH_PREFIX) {
+               result = strncmp(str, instr->pattern, instr->len) == 0;
+            } else {
+               result = !fnmatch(instr->pattern, str, 0);
+            }
+            break;
+         default:
+            result = lCompare_(ep, cp);
+            break;
+      }
+
+      pc = result ? instr->on_true : instr->on_false;
+   }
+
+   return pc == CULL_PROGRAM_TRUE ? 1 : 0;
+}
+
+/* returns the number of compares in a condition or -1 if it cannot be compiled */
+static int lCompileCount(const lCondition *cp) {
+   int first, second;
+
+   if (cp == nullptr) {
+      return -1;
+   }
+
+   switch (cp->op) {
+      case AND:
+      case OR:
+         first = lCompileCount(cp->operand.log.first);
+         second = lCompileCount(cp->operand.log.second);
+         return (first < 0 || second < 0) ? -1 : first + second;
+      case NEG:
+         return lCompileCount(cp->operand.log.first);
+      case EQUAL:
+      case NOT_EQUAL:
+      case LOWER_EQUAL:
+      case LOWER:
+      case GREATER_EQUAL:
+      case GREATER:
+      case SUBSCOPE:
+      case BITMASK:
+      case STRCASECMP:
+      case PATTERNCMP:
+      case HOSTNAMECMP:
+         return 1;
+      default:
+         return -1;
+   }
+}
+
+/* emits the compares of 'cp', a compare jumps to the first compare of the next operand or to a result */
+static void lCompileEmit(lCondition *cp, lConditionInstr *instr, int *pc, int on_true, int on_false) {
+   lConditionInstr *ip;
+   int second;
+
+   switch (cp->op) {
+      case AND:
+         second = *pc + lCompileCount(cp->operand.log.first);
+         lCompileEmit(cp->operand.log.first, instr, pc, second, on_false);
+         lCompileEmit(cp->operand.log.second, instr, pc, on_true, on_false);
+         break;
+      case OR:
+         second = *pc + lCompileCount(cp->operand.log.first);
+         lCompileEmit(cp->operand.log.first, instr, pc, on_true, second);
+         lCompileEmit(cp->operand.log.second, instr, pc, on_true, on_false);
+         break;
+      case NEG:
+         lCompileEmit(cp->operand.log.first, instr, pc, on_false, on_true);
+         break;
+      default:
+         ip = &(instr[(*pc)++]);
+         ip->cmp = cp;
+         ip->match = CULL_MATCH_DEFAULT;
+         ip->pattern = nullptr;
+         ip->len = 0;
+         ip->on_true = on_true;
+         ip->on_false = on_false;
+
+         if (cp->op == PATTERNCMP &&
+             (mt_get_type(cp->operand.cmp.mt) == lStringT || mt_get_type(cp->operand.cmp.mt) == lHostT)) {
+            const char *pattern = mt_get_type(cp->operand.cmp.mt) == lStringT ? cp->operand.cmp.val.str
+                                                                              : cp->operand.cmp.val.host;
+            size_t len = pattern != nullptr ? strcspn(pattern, "*?[\\") : 0;
+
+            ip->pattern = pattern;
+            if (pattern == nullptr) {
+               /* lCompare_() reports the missing pattern */
+               ip->match = CULL_MATCH_DEFAULT;
+            } else if (pattern[len] == '\0') {
+               ip->match = CULL_MATCH_LITERAL;
+            } else if (pattern[len] == '*' && pattern[len + 1] == '\0') {
+               ip->match = CULL_MATCH_PREFIX;
+               ip->len = len;
+            } else {
+               ip->match = CULL_MATCH_GLOB;
+            }
+         } else if (cp->op == SUBSCOPE || mt_get_type(cp->operand.cmp.mt) == lListT) {
+            /* sub conditions are evaluated by lCompare() and get their own program */
+            lCompileWhere(cp->operand.cmp.val.cp);
+         }
+         break;
+   }
+}
+
+/****** cull/where/lCompileWhere() ********************************************
+*  NAME
+*     lCompileWhere() -- Compile a condition for faster evaluation
+*
+*  SYNOPSIS
+*     bool lCompileWhere(lCondition *cp)
+*
+*  FUNCTION
+*     Translates the condition tree into a flat array of compares.
+*     Each compare contains the positions of the next compare for
+*     both results, so AND, OR and NEG need no evaluation at all.
+*     Patterns are classified once: patterns without wildcards and
+*     patterns only ending with '*' are matched without fnmatch().
+*
+*     lCompare() will use the compiled form for 'cp' afterwards.
+*     Conditions used for many elements, like the where filters of
+*     event client subscriptions, should be compiled.
+*
+*     The condition must not be changed after compiling it.
+*     lCopyWhere() returns a condition which is not compiled.
+*
+*  INPUTS
+*     lCondition *cp - condition
+*
+*  RESULT
+*     bool - true if the condition was compiled
+*
+*  NOTES
+*     MT-NOTE: lCompileWhere() is not MT safe for 'cp', evaluating a
+*     MT-NOTE: compiled condition is MT safe
+******************************************************************************/
+bool lCompileWhere(lCondition *cp) {
+   lConditionProgram *program;
+   int size;
+   int pc = 0;
+
+   DENTER(CULL_LAYER);
+
+   if (cp == nullptr || cp->program != nullptr) {
+      DRETURN(cp != nullptr);
+   }
+
+   if ((size = lCompileCount(cp)) <= 0) {
+      DRETURN(false);
+   }
+
+   program = (lConditionProgram *) sge_malloc(sizeof(lConditionProgram));
+   if (program == nullptr) {
+      LERROR(LEMALLOC);
+      DRETURN(false);
+   }
+   program->instr = (lConditionInstr *) sge_malloc(sizeof(lConditionInstr) * size);
+   if (program->instr == nullptr) {
+      LERROR(LEMALLOC);
+      sge_free(&program);
+      DRETURN(false);
+   }
+   program->size = size;
+
+   lCompileEmit(cp, program->instr, &pc, CULL_PROGRAM_TRUE, CULL_PROGRAM_FALSE);
+   cp->program = program;
+
+   DRETURN(true);
+}
+
 /****** cull/where/lCompare() *************************************************
 *  NAME
 *     lCompare() -- Decide if a element suffices a condition 
@@ -1157,9 +1369,6 @@ void lFreeWhere(lCondition **cp) {
 *         1 - true 
 ******************************************************************************/
 int lCompare(const lListElem *ep, const lCondition *cp) {
-   int result = 0;
-   const char *str1, *str2;
-
    DENTER(CULL_LAYER);
 
    if (!ep) {
@@ -1172,6 +1381,23 @@ int lCompare(const lListElem *ep, const lCondition *cp) {
       DRETURN(1);
    }
 
+   if (cp->program != nullptr) {
+      DRETURN(lCompareProgram(ep, cp->program));
+   }
+
+   DRETURN(lCompare_(ep, cp));
+}
+
+static int lCompare_(const lListElem *ep, const lCondition *cp) {
+   int result = 0;
+   const char *str1, *str2;
+
+   DENTER(CULL_LAYER);
+
+   if (!cp) {
+      DRETURN(1);
+   }
+
    switch (cp->op) {
       case EQUAL:
       case NOT_EQUAL:
@@ -1223,7 +1449,7 @@ int lCompare(const lListElem *ep, const lCondition *cp) {
                                    cp->operand.cmp.val.ul64);
                break;
             case lListT:
-               result = (lFindFirstRW(lGetPosList(ep, cp->operand.cmp.pos),
+               result = (lFindFirstRW(ep->cont[cp->operand.cmp.pos].glp,
                                       cp->operand.cmp.val.cp) != nullptr);
                DRETURN(result);
             case lFloatT:
@@ -1354,23 +1580,23 @@ int lCompare(const lListElem *ep, const lCondition *cp) {
          break;
 
       case AND:
-         if (!lCompare(ep, cp->operand.log.first)) {
+         if (!lCompare_(ep, cp->operand.log.first)) {
             result = 0;
             break;
          }
-         result = lCompare(ep, cp->operand.log.second);
+         result = lCompare_(ep, cp->operand.log.second);
          break;
 
       case OR:
-         if (lCompare(ep, cp->operand.log.first)) {
+         if (lCompare_(ep, cp->operand.log.first)) {
             result = 1;
             break;
          }
-         result = lCompare(ep, cp->operand.log.second);
+         result = lCompare_(ep, cp->operand.log.second);
          break;
 
       case NEG:
-         result = !lCompare(ep, cp->operand.log.first);
+         result = !lCompare_(ep, cp->operand.log.first);
          break;
 
       default:
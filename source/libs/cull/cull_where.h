@@ -35,6 +35,8 @@
 
 int lCompare(const lListElem *ep, const lCondition *cp);
 
+bool lCompileWhere(lCondition *cp);
+
 void lWriteWhereTo(const lCondition *cp, FILE *fp);
 
 lCondition *lWhere(const char *fmt, ...);
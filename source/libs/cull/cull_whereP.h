@@ -37,7 +37,23 @@
 #include "cull/cull_where.h"
 #include "cull/cull_multitypeP.h"
 
+/* one compare of a compiled condition, see lCompileWhere() */
+typedef struct {
+   const lCondition *cmp;       /* compare node of the source condition      */
+   int match;                   /* how patterns are matched (literal, ...)   */
+   const char *pattern;         /* pattern of a PATTERNCMP compare           */
+   size_t len;                  /* length of a literal pattern prefix        */
+   int on_true;                 /* next instruction if the compare is true   */
+   int on_false;                /* next instruction if the compare is false  */
+} lConditionInstr;
+
+typedef struct {
+   int size;                    /* number of instructions                    */
+   lConditionInstr *instr;      /* flat array of compares                    */
+} lConditionProgram;
+
 struct _lCondition {
+   lConditionProgram *program;  /* compiled condition (only in the root)     */
    int op;                      /* operator of the condition                 */
    union {
       struct {
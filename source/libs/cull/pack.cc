@@ -34,6 +34,8 @@
 
 #include "cull/pack.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
@@ -46,6 +48,10 @@
 #  include <rpc/xdr.h>
 #endif
 
+#ifdef WITH_ZLIB
+#  include <zlib.h>
+#endif
+
 #if defined(SOLARIS)
 #define htobe64(x) htonll(x)
 #define be64toh(x) ntohll(x)
@@ -490,7 +496,8 @@ int packbuf(
       if (buf_size + (u_long32) pb->bytes_used > (u_long32) pb->mem_size) {
          /* realloc */
          DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-         pb->mem_size += CHUNK;
+         while (buf_size + pb->bytes_used > pb->mem_size)
+            pb->mem_size += CHUNK;
          pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
          if (!(pb->head_ptr)) {
             DRETURN(PACK_ENOMEM);
@@ -785,3 +792,203 @@ pb_print_to(sge_pack_buffer *pb, bool only_header, FILE *file) {
    }
 }
 
+
+/* compression of large packbuffers, see pb_set_compression() */
+static std::atomic<int> Compression_Level{0};
+static std::atomic<u_long32> Compression_Threshold{64 * 1024};
+
+/* upper limit for the uncompressed size announced by a received packbuffer */
+#define MAX_UNCOMPRESSED_SIZE (1024 * 1024 * 1024)
+
+/****** cull/pack/pb_set_compression() ****************************************
+*  NAME
+*     pb_set_compression() -- Configure compression of large packbuffers
+*
+*  SYNOPSIS
+*     void pb_set_compression(int level, u_long32 threshold)
+*
+*  FUNCTION
+*     Sets the zlib compression level and the minimum size of packbuffers
+*     that are compressed by pb_compress(). Level 0 disables compression.
+*
+*     The GDI send functions compress only messages to communication
+*     partners which announced that they can uncompress them, see
+*     gdi_set_peer_compression().
+*
+*  INPUTS
+*     int level          - zlib compression level (0 - 9)
+*     u_long32 threshold - minimum size of compressed packbuffers in bytes
+*
+*  NOTES
+*     MT-NOTE: pb_set_compression() is MT safe
+*
+*  SEE ALSO
+*     cull/pack/pb_compress()
+*******************************************************************************/
+void
+pb_set_compression(int level, u_long32 threshold) {
+   if (level < 0) {
+      level = 0;
+   } else if (level > 9) {
+      level = 9;
+   }
+   Compression_Level = level;
+   Compression_Threshold = threshold;
+}
+
+/****** cull/pack/pb_compress() ***********************************************
+*  NAME
+*     pb_compress() -- Compress a packbuffer before it is sent
+*
+*  SYNOPSIS
+*     bool pb_compress(sge_pack_buffer *pb)
+*
+*  FUNCTION
+*     Replaces the content of a filled packbuffer by a compressed packbuffer
+*     if compression is enabled, the packbuffer is not smaller than the
+*     configured threshold and compression saves space.
+*
+*     The compressed packbuffer starts with the 0 pad and the version
+*     CULL_VERSION_COMPRESSED followed by the size of the uncompressed
+*     packbuffer and the zlib stream. It cannot be unpacked any more and
+*     has to be restored with pb_uncompress_buffer() by the receiver.
+*
+*  INPUTS
+*     sge_pack_buffer *pb - filled packbuffer
+*
+*  RESULT
+*     bool - true if the packbuffer was compressed
+*
+*  NOTES
+*     MT-NOTE: pb_compress() is MT safe
+*
+*  SEE ALSO
+*     cull/pack/pb_set_compression()
+*     cull/pack/pb_uncompress_buffer()
+*******************************************************************************/
+bool
+pb_compress(sge_pack_buffer *pb) {
+   bool ret = false;
+
+   DENTER(PACK_LAYER);
+
+#ifdef WITH_ZLIB
+   int level = Compression_Level;
+
+   if (pb != nullptr && !pb->just_count && pb->head_ptr != nullptr && level > 0 &&
+       pb->bytes_used > 2 * INTSIZE && pb->bytes_used >= Compression_Threshold) {
+      uLongf stream_size = compressBound(pb->bytes_used);
+      size_t mem_size = 3 * INTSIZE + stream_size;
+      char *buf = sge_malloc(mem_size);
+
+      if (buf != nullptr &&
+          compress2((Bytef *) (buf + 3 * INTSIZE), &stream_size, (const Bytef *) pb->head_ptr, pb->bytes_used, level) == Z_OK &&
+          3 * INTSIZE + stream_size < pb->bytes_used) {
+         sge_pack_buffer header;
+
+         memset(&header, 0, sizeof(sge_pack_buffer));
+         header.head_ptr = header.cur_ptr = buf;
+         header.mem_size = 3 * INTSIZE;
+         packint(&header, 0);
+         packint(&header, CULL_VERSION_COMPRESSED);
+         packint(&header, pb->bytes_used);
+
+         DPRINTF("compressed packbuffer from %d to %d bytes\n", (int) pb->bytes_used, (int) (3 * INTSIZE + stream_size));
+         sge_free(&(pb->head_ptr));
+         pb->head_ptr = buf;
+         pb->mem_size = mem_size;
+         pb->bytes_used = 3 * INTSIZE + stream_size;
+         pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
+         ret = true;
+      } else {
+         sge_free(&buf);
+      }
+   }
+#endif
+
+   DRETURN(ret);
+}
+
+/****** cull/pack/pb_uncompress_buffer() **************************************
+*  NAME
+*     pb_uncompress_buffer() -- Restore a received compressed packbuffer
+*
+*  SYNOPSIS
+*     int pb_uncompress_buffer(char **buf, u_long32 *buflen)
+*
+*  FUNCTION
+*     If the buffer contains a packbuffer compressed by pb_compress() then
+*     it is replaced by the uncompressed packbuffer. Other buffers are not
+*     touched. The buffer can be passed to init_packbuffer_from_buffer()
+*     afterwards.
+*
+*  INPUTS
+*     char **buf       - received buffer allocated with malloc()
+*     u_long32 *buflen - size of the buffer
+*
+*  RESULT
+*     int - PACK_SUCCESS on success
+*           PACK_ENOMEM  if memory allocation fails
+*           PACK_FORMAT  if the compressed data is corrupted or the
+*                        uncompressed size is implausible, see
+*                        MAX_UNCOMPRESSED_SIZE
+*           PACK_VERSION if compression is not supported by this binary
+*
+*  NOTES
+*     MT-NOTE: pb_uncompress_buffer() is MT safe
+*
+*  SEE ALSO
+*     cull/pack/pb_compress()
+*******************************************************************************/
+int
+pb_uncompress_buffer(char **buf, u_long32 *buflen) {
+   sge_pack_buffer header;
+   u_long32 pad = 1;
+   u_long32 version = 0;
+
+   DENTER(PACK_LAYER);
+
+   if (buf == nullptr || *buf == nullptr || buflen == nullptr || *buflen < 3 * INTSIZE) {
+      DRETURN(PACK_SUCCESS);
+   }
+
+   memset(&header, 0, sizeof(sge_pack_buffer));
+   header.head_ptr = header.cur_ptr = *buf;
+   header.mem_size = *buflen;
+   unpackint(&header, &pad);
+   unpackint(&header, &version);
+   if (pad != 0 || version != CULL_VERSION_COMPRESSED) {
+      DRETURN(PACK_SUCCESS);
+   }
+
+#ifdef WITH_ZLIB
+   u_long32 size = 0;
+   unpackint(&header, &size);
+
+   // the size comes from the wire, zlib cannot expand data by more than ~1:1032
+   u_long64 max_size = std::min((u_long64) (*buflen - 3 * INTSIZE) * 1032, (u_long64) MAX_UNCOMPRESSED_SIZE);
+   if (size <= 2 * INTSIZE || size > max_size) {
+      DRETURN(PACK_FORMAT);
+   }
+
+   // no sge_malloc(), it aborts the process if the memory is not available
+   auto uncompressed = (char *) malloc(size);
+   if (uncompressed == nullptr) {
+      DRETURN(PACK_ENOMEM);
+   }
+
+   uLongf uncompressed_size = size;
+   if (uncompress((Bytef *) uncompressed, &uncompressed_size, (const Bytef *) (*buf + 3 * INTSIZE),
+                  *buflen - 3 * INTSIZE) != Z_OK || uncompressed_size != size) {
+      sge_free(&uncompressed);
+      DRETURN(PACK_FORMAT);
+   }
+
+   sge_free(buf);
+   *buf = uncompressed;
+   *buflen = size;
+   DRETURN(PACK_SUCCESS);
+#else
+   DRETURN(PACK_VERSION);
+#endif
+}
@@ -88,12 +88,18 @@
 *                             0x10000000
 *                             Introduction of version control.
 *
+*     CULL_VERSION_COMPRESSED marks a compressed packbuffer. It is followed
+*     by the size of the uncompressed packbuffer and the zlib stream
+*     containing the complete uncompressed packbuffer including its version
+*     information. See pb_compress().
+*
 *  SEE ALSO
 *     cull/pack/--CULL_Packing
 *
 ****************************************************************************
 */
 #define CULL_VERSION 0x10020000
+#define CULL_VERSION_COMPRESSED (CULL_VERSION | 0x0001)
 
 typedef struct {
    char *head_ptr;
@@ -123,6 +129,12 @@ bool pb_are_equivalent(sge_pack_buffer *pb1, sge_pack_buffer *pb2);
 
 void pb_print_to(sge_pack_buffer *pb, bool only_header, FILE *);
 
+void pb_set_compression(int level, u_long32 threshold);
+
+bool pb_compress(sge_pack_buffer *pb);
+
+int pb_uncompress_buffer(char **buf, u_long32 *buflen);
+
 int repackint(sge_pack_buffer *, u_long32);
 
 int packint(sge_pack_buffer *, u_long32);
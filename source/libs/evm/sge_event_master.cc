@@ -40,6 +40,7 @@
 #include <cstring>
 #include <cerrno>
 
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_hostname.h"
 #include "uti/sge_lock.h"
@@ -716,7 +717,13 @@ sge_event_master_process_mod_event_client(const lListElem *request, monitoring_t
 
    DENTER(TOP_LAYER);
 
-   MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_READ), monitor);
+   // a changed subscription sends the newly subscribed master lists of all domains
+   sge_lock_set_t lock_set;
+   sge_lock_set_init(&lock_set, false);
+   sge_lock_set_add(&lock_set, LOCK_DOMAIN_JOB, LOCK_READ);
+   sge_lock_set_add(&lock_set, LOCK_DOMAIN_HOST, LOCK_READ);
+   sge_lock_set_add(&lock_set, LOCK_DOMAIN_CONFIG, LOCK_READ);
+   MONITOR_WAIT_TIME(SGE_LOCK_SET(&lock_set), monitor);
 
    clio = lGetObject(request, EVR_event_client);
 
@@ -728,7 +735,7 @@ sge_event_master_process_mod_event_client(const lListElem *request, monitoring_t
 
    if (event_client == nullptr) {
       sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
-      SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+      SGE_UNLOCK_SET();
       ERROR(MSG_EVE_UNKNOWNEVCLIENT_US, sge_u32c(id), "modify");
       DRETURN_VOID;
    }
@@ -741,14 +748,14 @@ sge_event_master_process_mod_event_client(const lListElem *request, monitoring_t
    /* check for validity */
    if (ev_d_time < 1) {
       sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
-      SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+      SGE_UNLOCK_SET();
       ERROR(MSG_EVE_INVALIDINTERVAL_U, sge_u32c(ev_d_time));
       DRETURN_VOID;
    }
 
    if (lGetBool(clio, EV_changed) && lGetList(clio, EV_subscribed) == nullptr) {
       sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
-      SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+      SGE_UNLOCK_SET();
       ERROR(SFNMAX, MSG_EVE_INVALIDSUBSCRIPTION);
       DRETURN_VOID;
    }
@@ -838,7 +845,7 @@ sge_event_master_process_mod_event_client(const lListElem *request, monitoring_t
    DEBUG(MSG_SGETEXT_MODIFIEDINLIST_SSSS, thread_config ? thread_config->thread_name : "-NA-", "master host", lGetString(event_client, EV_name), MSG_EVE_EVENTCLIENT);
 
    sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
-   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+   SGE_UNLOCK_SET();
 
    DRETURN_VOID;
 } /* sge_event_master_process_mod_event_client() */
@@ -2149,6 +2156,7 @@ sge_event_master_send_events(lListElem *report, lList *report_list, monitoring_t
    void *update_func_arg = nullptr;
 
    DENTER(TOP_LAYER);
+   SPAN_TRACE_START(event_span, "event", "send_events", nullptr);
 
    sge_mutex_lock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
 
@@ -2467,7 +2475,9 @@ static void build_subscription(lListElem *event_el)
       sub_array[event].flush_time = lGetUlong(sub_el, EVS_interval);
 
       if ((temp = lGetObject(sub_el, EVS_where))) {
+         /* the filter is evaluated for each element of each event, compile it once */
          sub_array[event].where = lWhereFromElem(temp);
+         lCompileWhere(sub_array[event].where);
       }
 
       if ((temp = lGetObject(sub_el, EVS_what))) {
@@ -3469,6 +3479,7 @@ void sge_event_master_process_requests(monitoring_t *monitor)
    lList *requests = nullptr;
 
    DENTER(TOP_LAYER);
+   SPAN_TRACE_START(event_span, "event", "process_requests", nullptr);
 
    /*
     * get the request list
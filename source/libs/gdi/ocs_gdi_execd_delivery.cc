@@ -35,6 +35,10 @@
 #include "cull/cull.h"
 
 #include "sgeobj/sge_feature.h"
+#include "sgeobj/sge_host.h"
+#include "sgeobj/cull/sge_job_JB_L.h"
+#include "sgeobj/cull/sge_ja_task_JAT_L.h"
+#include "sgeobj/cull/sge_job_JG_L.h"
 
 #include "gdi/ocs_gdi_execd_delivery.h"
 
@@ -73,3 +77,132 @@ int pack_job_delivery(sge_pack_buffer *pb, lListElem *jep)
    return PACK_SUCCESS;
 }
 
+
+/****** pack_job_delivery/pack_job_delivery_task() *****************************
+*  NAME
+*     pack_job_delivery_task() -- pack only the task of a job sent to execd
+*
+*  SYNOPSIS
+*     int pack_job_delivery_task(sge_pack_buffer *pb, lListElem *jep)
+*
+*  FUNCTION
+*     When qmaster sends multiple tasks of an array job to the same execd in
+*     one message, the job itself is packed only once with the first task
+*     (pack_job_delivery()). The following tasks are packed as task records
+*     only containing the job number and the ja_task.
+*
+*     execd rebuilds the job from the task record and the job sent before
+*     in the same message having the same template key.
+*
+*  INPUTS
+*     sge_pack_buffer *pb - packing buffer
+*     lListElem *jep      - JB_Type, containing the ja_task to be started
+*
+*  RESULT
+*     int - PACK_SUCCESS on success
+*
+*  NOTES
+*     MT-NOTE: pack_job_delivery_task() is MT safe
+*
+*  SEE ALSO
+*     pack_job_delivery/job_delivery_is_task()
+*     pack_job_delivery/job_delivery_get_template_key()
+*******************************************************************************/
+int pack_job_delivery_task(sge_pack_buffer *pb, lListElem *jep)
+{
+   lEnumeration *what = lWhat("%T(%I %I)", JB_Type, JB_job_number, JB_ja_tasks);
+   int ret;
+
+   if ((ret=packint(pb, feature_get_active_featureset_id())) == PACK_SUCCESS) {
+      ret = cull_pack_elem_partial(pb, jep, what, 0);
+   }
+   lFreeWhat(&what);
+   return ret;
+}
+
+/****** pack_job_delivery/job_delivery_is_task() *******************************
+*  NAME
+*     job_delivery_is_task() -- is an unpacked delivery a task record?
+*
+*  SYNOPSIS
+*     bool job_delivery_is_task(const lListElem *jep)
+*
+*  FUNCTION
+*     Returns true if the element was packed by pack_job_delivery_task().
+*
+*  NOTES
+*     MT-NOTE: job_delivery_is_task() is MT safe
+*******************************************************************************/
+bool job_delivery_is_task(const lListElem *jep)
+{
+   const lDescr *descr = lGetElemDescr(jep);
+
+   return lCountDescr(descr) == 2 &&
+          lGetPosInDescr(descr, JB_job_number) == 0 && lGetPosInDescr(descr, JB_ja_tasks) == 1;
+}
+
+/****** pack_job_delivery/job_delivery_get_template_key() **********************
+*  NAME
+*     job_delivery_get_template_key() -- key of the job part of a delivery
+*
+*  SYNOPSIS
+*     std::string job_delivery_get_template_key(const lListElem *jep)
+*
+*  FUNCTION
+*     The job sent to execd is not identical for all tasks of an array job,
+*     qmaster reduces the resource limits of the job to the limits of the
+*     queues the task got. The key therefore consists of the job number and
+*     the names of the granted queues of the task.
+*
+*     It can be built from a job as well as from a task record.
+*
+*  INPUTS
+*     const lListElem *jep - JB_Type or task record, containing one ja_task
+*
+*  RESULT
+*     std::string - the template key
+*
+*  NOTES
+*     MT-NOTE: job_delivery_get_template_key() is MT safe
+*******************************************************************************/
+std::string job_delivery_get_template_key(const lListElem *jep)
+{
+   std::string key = std::to_string(lGetUlong(jep, JB_job_number));
+   const lListElem *ja_task = lFirst(lGetList(jep, JB_ja_tasks));
+   const lListElem *gdil_ep;
+
+   for_each_ep(gdil_ep, lGetList(ja_task, JAT_granted_destin_identifier_list)) {
+      const char *qname = lGetString(gdil_ep, JG_qname);
+
+      key += ' ';
+      key += qname != nullptr ? qname : "";
+   }
+   return key;
+}
+
+/****** pack_job_delivery/job_delivery_is_batch_supported() ********************
+*  NAME
+*     job_delivery_is_batch_supported() -- can an execd take multiple jobs?
+*
+*  SYNOPSIS
+*     bool job_delivery_is_batch_supported(const lListElem *hep)
+*
+*  FUNCTION
+*     Returns true if the execd of the host announced at registration that
+*     it starts all jobs and task records contained in one TAG_JOB_EXECUTION
+*     message. Other execds only unpack the first job of a message, they
+*     have to get one message per job.
+*
+*  INPUTS
+*     const lListElem *hep - EH_Type
+*
+*  RESULT
+*     bool - true if multiple deliveries may be sent in one message
+*
+*  NOTES
+*     MT-NOTE: job_delivery_is_batch_supported() is MT safe
+*******************************************************************************/
+bool job_delivery_is_batch_supported(const lListElem *hep)
+{
+   return hep != nullptr && (lGetUlong(hep, EH_capabilities) & EH_CAP_JOB_DELIVERY_BATCH) != 0;
+}
@@ -33,4 +33,16 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <string>
+
+#include "cull/cull.h"
+
 int pack_job_delivery(sge_pack_buffer *pb, lListElem *jep);
+
+int pack_job_delivery_task(sge_pack_buffer *pb, lListElem *jep);
+
+bool job_delivery_is_task(const lListElem *jep);
+
+std::string job_delivery_get_template_key(const lListElem *jep);
+
+bool job_delivery_is_batch_supported(const lListElem *hep);
@@ -34,8 +34,12 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <algorithm>
+#include <cctype>
 #include <cstring>
 #include <pthread.h>
+#include <set>
+#include <string>
 
 #include <pwd.h>
 
@@ -62,6 +66,9 @@
 #include "sgeobj/sge_host.h"
 #include "sgeobj/sge_conf.h"
 #include "sgeobj/cull/sge_permission_PERM_L.h"
+#include "sgeobj/cull/sge_gdi_page_PG_L.h"
+#include "sgeobj/cull/sge_job_JB_L.h"
+#include "sgeobj/cull/sge_advance_reservation_AR_L.h"
 
 #include "gdi/qm_name.h"
 #include "gdi/sge_gdi.h"
@@ -368,6 +375,198 @@ lList *sge_gdi(u_long32 target, u_long32 cmd, lList **lpp, lCondition *cp, lEnum
    DRETURN(alp);
 }
 
+/****** gdi/sge/sge_gdi_page_key() *******************************************
+*  NAME
+*     sge_gdi_page_key() -- key attribute used for paged GET requests
+*
+*  SYNOPSIS
+*     int sge_gdi_page_key(u_long32 target)
+*
+*  FUNCTION
+*     Returns the unique ulong attribute by which the answer of a GET
+*     request for 'target' can be transferred in pages (see
+*     sge_gdi_page_create()). Only lists that may grow very large
+*     support paging.
+*
+*  INPUTS
+*     u_long32 target - GDI target (e.g. SGE_JB_LIST)
+*
+*  RESULT
+*     int - key attribute or NoName if paging is not supported
+*
+*  NOTES
+*     MT-NOTE: sge_gdi_page_key() is MT safe
+******************************************************************************/
+int sge_gdi_page_key(u_long32 target) {
+   switch (target) {
+      case SGE_JB_LIST:
+      case SGE_ZOMBIE_LIST:
+         return JB_job_number;
+      case SGE_AR_LIST:
+         return AR_id;
+      default:
+         return NoName;
+   }
+}
+
+/****** gdi/sge/sge_gdi_page_create() ****************************************
+*  NAME
+*     sge_gdi_page_create() -- create the request list of a paged GET
+*
+*  SYNOPSIS
+*     lList *sge_gdi_page_create(u_long32 cursor, u_long32 limit)
+*
+*  FUNCTION
+*     Creates a list which can be passed as data list of a GET request.
+*     qmaster will then answer with at most 'limit' objects whose
+*     key (see sge_gdi_page_key()) is greater than 'cursor', sorted
+*     by the key.
+*
+*  INPUTS
+*     u_long32 cursor - return objects with a key greater than cursor
+*     u_long32 limit  - maximum number of objects in the answer, at most
+*                       SGE_GDI_PAGE_MAX
+*
+*  RESULT
+*     lList* - PG_Type list, the caller has to free it
+*
+*  NOTES
+*     MT-NOTE: sge_gdi_page_create() is MT safe
+******************************************************************************/
+lList *sge_gdi_page_create(u_long32 cursor, u_long32 limit) {
+   lList *page_list = nullptr;
+
+   // qmaster does not answer with bigger pages, a bigger limit would look like the last page
+   limit = std::min(limit, (u_long32) SGE_GDI_PAGE_MAX);
+   lListElem *page = lAddElemUlong(&page_list, PG_limit, limit, PG_Type);
+
+   lSetUlong(page, PG_cursor, cursor);
+   return page_list;
+}
+
+/****** gdi/sge/sge_gdi_get_remaining_pages() ********************************
+*  NAME
+*     sge_gdi_get_remaining_pages() -- fetch all pages following a first page
+*
+*  SYNOPSIS
+*     bool sge_gdi_get_remaining_pages(lList **alpp, u_long32 target,
+*                                      lList **lpp, lCondition *cp,
+*                                      lEnumeration *enp, u_long32 limit)
+*
+*  FUNCTION
+*     '*lpp' contains the answer of a GET request which was sent with a
+*     page list created by sge_gdi_page_create(0, limit).
+*     As long as the last answer was a full page, the next page is
+*     requested and appended to '*lpp'. Each request only holds the
+*     qmaster locks and memory for a single page.
+*
+*     A qmaster not supporting paging returns the whole list with the
+*     first answer. This is detected and no further pages are requested.
+*
+*  INPUTS
+*     lList **alpp      - answer list
+*     u_long32 target   - GDI target (see sge_gdi_page_key())
+*     lList **lpp       - first page, the following pages are appended
+*     lCondition *cp    - condition of the first request
+*     lEnumeration *enp - enumeration of the first request
+*     u_long32 limit    - page size of the first request
+*
+*  RESULT
+*     bool - false if a request failed
+*
+*  NOTES
+*     Each page is a separate request. The pages do not form a snapshot
+*     of the list and are not consistent with other lists fetched by
+*     the multi request of the first page. Clients which need a
+*     consistent view of several lists (e.g. qstat) must not use paging.
+*
+*     MT-NOTE: sge_gdi_get_remaining_pages() is MT safe
+******************************************************************************/
+bool sge_gdi_get_remaining_pages(lList **alpp, u_long32 target, lList **lpp, lCondition *cp, lEnumeration *enp,
+                                 u_long32 limit) {
+   DENTER(GDI_LAYER);
+   int key_nm = sge_gdi_page_key(target);
+   bool ret = true;
+
+   if (lpp == nullptr || *lpp == nullptr || key_nm == NoName || limit == 0) {
+      DRETURN(ret);
+   }
+   int pos = lGetPosViaElem(lFirst(*lpp), key_nm, SGE_NO_ABORT);
+   u_long32 size = lGetNumberOfElem(*lpp);
+
+   // a partial page is the last one, a bigger one comes from a qmaster ignoring the page request
+   while (pos >= 0 && size == limit) {
+      u_long32 cursor = lGetPosUlong(lLast(*lpp), pos);
+      lList *page_list = sge_gdi_page_create(cursor, limit);
+      lList *answer_list = sge_gdi(target, SGE_GDI_GET, &page_list, cp, enp);
+
+      if (answer_list_has_error(&answer_list)) {
+         answer_list_append_list(alpp, &answer_list);
+         lFreeList(&page_list);
+         ret = false;
+         break;
+      }
+      lFreeList(&answer_list);
+
+      size = lGetNumberOfElem(page_list);
+      if (size > limit || (size > 0 && lGetPosUlong(lFirst(page_list), pos) <= cursor)) {
+         lFreeList(&page_list);
+         break;
+      }
+      lAddList(*lpp, &page_list);
+   }
+
+   DRETURN(ret);
+}
+
+/****** gdi/sge/sge_gdi_get_paged() ******************************************
+*  NAME
+*     sge_gdi_get_paged() -- GET a complete list in pages
+*
+*  SYNOPSIS
+*     lList *sge_gdi_get_paged(u_long32 target, lList **lpp, lCondition *cp,
+*                              lEnumeration *enp)
+*
+*  FUNCTION
+*     Same as sge_gdi(target, SGE_GDI_GET, lpp, cp, enp) but the list is
+*     requested in pages of SGE_GDI_PAGE_SIZE objects. So neither qmaster
+*     nor the client has to hold the pack buffer of the whole list and
+*     qmaster locks its data store only for one page at a time.
+*
+*     The objects are returned sorted by their key, see
+*     sge_gdi_page_key(). The enumeration has to contain the key.
+*
+*  INPUTS
+*     u_long32 target   - GDI target (SGE_JB_LIST, SGE_ZOMBIE_LIST or
+*                         SGE_AR_LIST)
+*     lList **lpp       - returns the selected list
+*     lCondition *cp    - condition
+*     lEnumeration *enp - enumeration
+*
+*  RESULT
+*     lList* - answer list
+*
+*  NOTES
+*     The pages are no snapshot of the list, see
+*     sge_gdi_get_remaining_pages(). Only clients reading a single list
+*     should use this function.
+*
+*     MT-NOTE: sge_gdi_get_paged() is MT safe
+******************************************************************************/
+lList *sge_gdi_get_paged(u_long32 target, lList **lpp, lCondition *cp, lEnumeration *enp) {
+   DENTER(GDI_LAYER);
+   lList *page_list = sge_gdi_page_create(0, SGE_GDI_PAGE_SIZE);
+   lList *alp = sge_gdi(target, SGE_GDI_GET, &page_list, cp, enp);
+
+   if (!answer_list_has_error(&alp)) {
+      sge_gdi_get_remaining_pages(&alp, target, &page_list, cp, enp, SGE_GDI_PAGE_SIZE);
+   }
+   lFreeList(lpp);
+   *lpp = page_list;
+
+   DRETURN(alp);
+}
+
 int sge_gdi_multi(lList **alpp, int mode, u_long32 target, u_long32 cmd, lList **lp, lCondition *cp, lEnumeration *enp,
                    state_gdi_multi *state, bool do_copy) {
    DENTER(GDI_LAYER);
@@ -530,6 +729,108 @@ sge_gdi_wait(lList **malpp, state_gdi_multi *state) {
    DRETURN_VOID;
 }
 
+/*
+ * communication partners which announced GDI_CAP_COMPRESSION in their last GDI request,
+ * key is "<commproc>@<host>", see gdi_set_peer_compression()
+ */
+static pthread_mutex_t compression_peers_mutex = PTHREAD_MUTEX_INITIALIZER;
+static std::set<std::string> compression_peers;
+
+static std::string
+compression_peer_key(const char *host, const char *commproc) {
+   std::string key = std::string(commproc) + "@" + host;
+
+   std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+   return key;
+}
+
+/****** gdi/request/gdi_set_peer_compression() ********************************
+*  NAME
+*     gdi_set_peer_compression() -- store if a peer accepts compressed messages
+*
+*  SYNOPSIS
+*     void gdi_set_peer_compression(const char *host, const char *commproc,
+*                                   bool accepts)
+*
+*  FUNCTION
+*     Called by qmaster for each received GDI request with the
+*     GDI_CAP_COMPRESSION bit announced by the sender. Messages are only
+*     compressed by sge_gdi_send_any_request() and gdi_send_message_pb()
+*     if the receiving component on that host announced the capability.
+*     Other receivers, e.g. binaries built without zlib or execds which did
+*     not register again after a qmaster restart, get uncompressed messages.
+*
+*     Peers are identified by host and component name only, not by the
+*     component id. So the number of entries is limited by the number of
+*     hosts and not by the number of client connections. The last request
+*     of a component on a host decides.
+*
+*  INPUTS
+*     const char *host     - host of the peer
+*     const char *commproc - component name of the peer
+*     bool accepts         - true if the peer can uncompress messages
+*
+*  NOTES
+*     MT-NOTE: gdi_set_peer_compression() is MT safe
+*
+*  SEE ALSO
+*     gdi/request/gdi_peer_accepts_compression()
+*     cull/pack/pb_compress()
+*******************************************************************************/
+void
+gdi_set_peer_compression(const char *host, const char *commproc, bool accepts) {
+   if (host == nullptr || commproc == nullptr) {
+      return;
+   }
+   std::string key = compression_peer_key(host, commproc);
+
+   sge_mutex_lock("compression_peers_mutex", __func__, __LINE__, &compression_peers_mutex);
+   if (accepts) {
+      compression_peers.insert(key);
+   } else {
+      compression_peers.erase(key);
+   }
+   sge_mutex_unlock("compression_peers_mutex", __func__, __LINE__, &compression_peers_mutex);
+}
+
+/****** gdi/request/gdi_peer_accepts_compression() ****************************
+*  NAME
+*     gdi_peer_accepts_compression() -- may messages to a peer be compressed?
+*
+*  SYNOPSIS
+*     bool gdi_peer_accepts_compression(const char *host, const char *commproc)
+*
+*  FUNCTION
+*     Returns true if the component on the host announced
+*     GDI_CAP_COMPRESSION in its last GDI request.
+*
+*  INPUTS
+*     const char *host     - host of the peer
+*     const char *commproc - component name of the peer
+*
+*  RESULT
+*     bool - true if messages to the peer may be compressed
+*
+*  NOTES
+*     MT-NOTE: gdi_peer_accepts_compression() is MT safe
+*
+*  SEE ALSO
+*     gdi/request/gdi_set_peer_compression()
+*******************************************************************************/
+bool
+gdi_peer_accepts_compression(const char *host, const char *commproc) {
+   if (host == nullptr || commproc == nullptr) {
+      return false;
+   }
+   std::string key = compression_peer_key(host, commproc);
+
+   sge_mutex_lock("compression_peers_mutex", __func__, __LINE__, &compression_peers_mutex);
+   bool ret = compression_peers.find(key) != compression_peers.end();
+   sge_mutex_unlock("compression_peers_mutex", __func__, __LINE__, &compression_peers_mutex);
+
+   return ret;
+}
+
 /*---------------------------------------------------------
  *  sge_send_any_request
  *  returns 0 if ok
@@ -575,6 +876,10 @@ sge_gdi_send_any_request(int synchron, u_long32 *mid, const char *rhost, const c
       mid_pointer = &dummy_mid;
    }
 
+   // large messages like event lists or GET answers are compressed if enabled (qmaster_params COMPRESSION_LEVEL)
+   if (gdi_peer_accepts_compression(rhost, commproc)) {
+      pb_compress(pb);
+   }
    i = cl_commlib_send_message(handle, (char *) rhost, (char *) commproc, id, ack_type, (cl_byte_t **) &pb->head_ptr,
                                (unsigned long) pb->bytes_used, mid_pointer, response_id, tag, false, (bool) synchron);
 
@@ -682,7 +987,12 @@ sge_gdi_get_any_request(char *rhost, char *commproc, u_short *id, sge_pack_buffe
 
 
       /* fill it in the packing buffer */
-      i = init_packbuffer_from_buffer(pb, (char *) message->message, message->message_length);
+      u_long32 message_length = message->message_length;
+      int uncompress_ret = pb_uncompress_buffer((char **) &message->message, &message_length);
+      i = init_packbuffer_from_buffer(pb, (char *) message->message, message_length);
+      if (uncompress_ret != PACK_SUCCESS) {
+         i = uncompress_ret;
+      }
 
       /* TODO: the packbuffer must be hold, not deleted !!! */
       message->message = nullptr;
@@ -936,7 +1246,8 @@ sge_gdi_get_permission(lList **alpp, bool *is_manager, bool *is_operator,
   send a message giving a packbuffer
 
   same as gdi_send_message, but this is delivered a sge_pack_buffer.
-  this function flushes the z_stream_buffer if compression is turned on
+  this function compresses the packbuffer if compression is turned on
+  and the receiver accepts it (see gdi_set_peer_compression())
   and passes the result on to send_message
   Always use this function instead of gdi_send_message directly, even
   if compression is turned off.
@@ -954,6 +1265,9 @@ gdi_send_message_pb(int synchron, const char *tocomproc, int toid, const char *t
       ret = gdi_send_message(synchron, tocomproc, toid, tohost, tag, nullptr, 0, mid);
       DRETURN(ret);
    }
+   if (gdi_peer_accepts_compression(tohost, tocomproc)) {
+      pb_compress(pb);
+   }
    ret = gdi_send_message(synchron, tocomproc, toid, tohost, tag, &pb->head_ptr, pb->bytes_used, mid);
    DRETURN(ret);
 }
@@ -1150,9 +1464,18 @@ gdi_receive_message(char *fromcommproc, u_short *fromid, char *fromhost,
    }
 
    if (message != nullptr && ret == CL_RETVAL_OK) {
+      int pack_ret;
+
       *buffer = (char *) message->message;
       message->message = nullptr;
       *buflen = message->message_length;
+      pack_ret = pb_uncompress_buffer(buffer, buflen);
+      if (pack_ret != PACK_SUCCESS) {
+         ERROR(MSG_GDI_ERRORUNPACKINGGDIREQUEST_S, cull_pack_strerror(pack_ret));
+         sge_free(buffer);
+         *buflen = 0;
+         ret = CL_RETVAL_READ_ERROR;
+      }
       if (tag) {
          *tag = (int) message->message_tag;
       }
@@ -128,7 +128,7 @@ enum {
 **            directly above
 */
 enum {
-   SGE_QSTAT = 1024,
+   SGE_QSTAT = 1024,     /* cluster queue summary (CQS_Type), see qstat -g c */
    SGE_QHOST
 };
 
@@ -218,6 +218,21 @@ typedef struct {
 lList
 *sge_gdi(u_long32 target, u_long32 cmd, lList **lpp, lCondition *cp, lEnumeration *enp);
 
+/* number of objects per page of a paged GET request */
+#define SGE_GDI_PAGE_SIZE 10000
+
+/* qmaster answers a paged GET request with at most this number of objects */
+#define SGE_GDI_PAGE_MAX 100000
+
+int sge_gdi_page_key(u_long32 target);
+
+lList *sge_gdi_page_create(u_long32 cursor, u_long32 limit);
+
+bool sge_gdi_get_remaining_pages(lList **alpp, u_long32 target, lList **lpp, lCondition *cp, lEnumeration *enp,
+                                 u_long32 limit);
+
+lList *sge_gdi_get_paged(u_long32 target, lList **lpp, lCondition *cp, lEnumeration *enp);
+
 int
 sge_gdi_multi(lList **alpp, int mode, u_long32 target, u_long32 cmd, lList **lp, lCondition *cp, lEnumeration *enp,
                state_gdi_multi *state, bool do_copy);
@@ -231,6 +246,10 @@ int sge_gdi_get_any_request(char *rhost, char *commproc, u_short *id, sge_pack_b
 int sge_gdi_send_any_request(int synchron, u_long32 *mid, const char *rhost, const char *commproc, int id,
                               sge_pack_buffer *pb, int tag, u_long32 response_id, lList **alpp);
 
+void gdi_set_peer_compression(const char *host, const char *commproc, bool accepts);
+
+bool gdi_peer_accepts_compression(const char *host, const char *commproc);
+
 lList *gdi_kill(lList *id_list, u_long32 action_flag);
 
 lList *gdi_tsm();
@@ -49,9 +49,11 @@
 #include "uti/sge_stdlib.h"
 #include "uti/sge_string.h"
 #include "uti/sge_thread_ctrl.h"
+#include "uti/sge_time.h"
 
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_feature.h"
+#include "sgeobj/cull/sge_gdi_page_PG_L.h"
 
 #include "gdi/sge_gdiP.h"
 #include "gdi/sge_gdi_packet.h"
@@ -227,8 +229,12 @@ sge_gdi_task_create(sge_gdi_packet_class_t *packet, lList **answer_list, u_long3
    task->target = target;
    task->next = nullptr;
    task->do_select_pack_simultaneous = false;
+   task->pack_cache_type = SGE_TYPE_NONE;
    if (do_copy) {
-      if (enumeration != nullptr && *enumeration != nullptr) {
+      /* the page request of a paged GET is copied as is, the enumeration describes the answer */
+      bool is_page_request = SGE_GDI_GET_OPERATION(command) == SGE_GDI_GET && lp != nullptr && *lp != nullptr &&
+                             lGetPosInDescr(lGetListDescr(*lp), PG_limit) >= 0;
+      if (enumeration != nullptr && *enumeration != nullptr && !is_page_request) {
          task->data_list = (((lp != nullptr) && (*lp != nullptr)) ?
                             lSelect("", *lp, nullptr, *enumeration) : nullptr);
       } else {
@@ -389,6 +395,10 @@ sge_gdi_packet_create_base(lList **answer_list) {
 
    ret->request_type = PACKET_GDI_REQUEST;
    ret->version = ocs::Version::get_version();
+#ifdef WITH_ZLIB
+   ret->capabilities = GDI_CAP_COMPRESSION;
+#endif
+   ret->creation_time = sge_get_monotonic_time64();
    memset(&(ret->pb), 0, sizeof(sge_pack_buffer));
 
    DRETURN(ret);
@@ -50,6 +50,7 @@
 #include "gdi/sge_gdi_packet.h"
 #include "gdi/msg_gdilib.h"
 
+#include "sgeobj/ocs_PackCache.h"
 #include "sgeobj/sge_answer.h"
 
 #include "msg_qmaster.h"
@@ -234,6 +235,7 @@ sge_gdi_packet_unpack(sge_gdi_packet_class_t **packet, lList **answer_list, sge_
          char *auth_info = nullptr;
          u_long32 task_id = 0;
          u_long32 packet_id = 0;
+         u_long32 capabilities = 0;
          u_long32 has_next_int = 0;
 
          if ((pack_ret = unpackint(pb, &(command)))) {
@@ -274,6 +276,9 @@ sge_gdi_packet_unpack(sge_gdi_packet_class_t **packet, lList **answer_list, sge_
          if ((pack_ret = unpackint(pb, &(packet_id)))) {
             goto error_with_mapping;
          }
+         if ((pack_ret = unpackint(pb, &(capabilities)))) {
+            goto error_with_mapping;
+         }
          if ((pack_ret = unpackint(pb, &has_next_int))) {
             goto error_with_mapping;
          }
@@ -282,6 +287,7 @@ sge_gdi_packet_unpack(sge_gdi_packet_class_t **packet, lList **answer_list, sge_
          if (first) {
             (*packet)->id = packet_id;
             (*packet)->version = version;
+            (*packet)->capabilities = capabilities;
             (*packet)->auth_info = auth_info;
             auth_info = nullptr;
             first = false;
@@ -429,7 +435,15 @@ sge_gdi_packet_pack_task(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *t
        * (which will be packed below). 
        */
       if (task->do_select_pack_simultaneous) {
-         lSelectHashPack("", task->data_list, task->condition, task->enumeration, false, pb);
+         if (task->pack_cache_type != SGE_TYPE_NONE) {
+            /* unfiltered request: unchanged objects are already packed */
+            pack_ret = ocs::PackCache::pack_list(pb, task->data_list, task->pack_cache_type, task->enumeration);
+            if (pack_ret != PACK_SUCCESS) {
+               goto error_with_mapping;
+            }
+         } else {
+            lSelectHashPack("", task->data_list, task->condition, task->enumeration, false, pb);
+         }
          lFreeWhat(&(task->enumeration));
          lFreeWhere(&(task->condition));
          task->data_list = nullptr;
@@ -471,6 +485,10 @@ sge_gdi_packet_pack_task(sge_gdi_packet_class_t *packet, sge_gdi_task_class_t *t
       if (pack_ret != PACK_SUCCESS) {
          goto error_with_mapping;
       }
+      pack_ret = packint(pb, packet->capabilities);
+      if (pack_ret != PACK_SUCCESS) {
+         goto error_with_mapping;
+      }
       pack_ret = packint(pb, (task->next != nullptr) ? 1 : 0);
       if (pack_ret != PACK_SUCCESS) {
          goto error_with_mapping;
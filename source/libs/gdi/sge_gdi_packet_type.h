@@ -40,6 +40,8 @@
 
 #include "comm/cl_communication.h"
 
+#include "sgeobj/sge_object.h"
+
 typedef struct _sge_gdi_task_class_t sge_gdi_task_class_t;
 
 typedef struct _sge_gdi_packet_class_t sge_gdi_packet_class_t;
@@ -51,6 +53,9 @@ typedef enum {
    PACKET_ACK_REQUEST
 } gdi_packet_request_type_t;
 
+// capabilities of the sender of a GDI packet
+#define GDI_CAP_COMPRESSION (1 << 0)     // accepts compressed messages, see pb_compress()
+
 struct _sge_gdi_task_class_t {
    /*
     * id identifying the GDI packet uniquely within the
@@ -82,6 +87,14 @@ struct _sge_gdi_task_class_t {
     */
    bool do_select_pack_simultaneous;
 
+   /*
+    * Type of the master list referenced by data_list if the
+    * postponed lSelect of an unfiltered GET request can take the
+    * packed objects from the pack cache of the reader data store.
+    * SGE_TYPE_NONE if the objects have to be packed.
+    */
+   sge_object_type pack_cache_type;
+
    /*
     * pointer to the next task in a multi GDI request
     */
@@ -139,6 +152,11 @@ struct _sge_gdi_packet_class_t {
     */
    u_long32 version;
 
+   /*
+    * GDI_CAP_* bits announced by the sender of this packet
+    */
+   u_long32 capabilities;
+
    /*
     * pointers to the first and last task part of a multi
     * GDI request. This list contains at least one element
@@ -193,6 +211,12 @@ struct _sge_gdi_packet_class_t {
    // DS hint
    u_long32 ds_type;
 
+   /*
+    * time when the packet was created (in qmaster: when the request was received)
+    * on a monotonic clock (sge_get_monotonic_time64()), used to measure the request latency
+    */
+   u_long64 creation_time;
+
    /* 
     * if this packet is part of a packet queue then this
     * pointer might point to the next packet in the queue
@@ -1225,6 +1225,92 @@ int drmaa_run_bulk_jobs(drmaa_job_ids_t **jobids, const drmaa_job_template_t *jt
    DRETURN(drmaa_errno);
 }
 
+/****** DRMAA/drmaa_run_job_list() *********************************************
+*  NAME
+*     drmaa_run_job_list() -- Submit many jobs with one request
+*
+*  SYNOPSIS
+*     int drmaa_run_job_list(drmaa_job_ids_t **jobids, 
+*           const drmaa_job_template_t *jt[], int count, 
+*           char *error_diagnosis, size_t error_diag_len)
+*
+*  FUNCTION
+*     Submit 'count' independent jobs, each with attributes defined in one 
+*     of the job templates 'jt', with a single request. qmaster verifies and
+*     spools all jobs in one go. This is an extension of the DRMAA interface 
+*     for applications submitting many small jobs in a burst.
+*
+*  INPUTS
+*     const drmaa_job_template_t *jt[] - job templates
+*     int count                        - number of job templates
+*  
+*  OUTPUTS
+*     drmaa_job_ids_t **jobids         - returns vector of job ids, one per 
+*                                        job template, an empty string for 
+*                                        each job that was rejected
+*     char *error_diagnosis            - diagnosis buffer
+*     size_t error_diag_len            - diagnosis buffer length
+*
+*  RESULT
+*     int - DRMAA_ERRNO_SUCCESS if all jobs were submitted or any DRMAA 
+*           error code. If some jobs were rejected the job ids are returned
+*           nevertheless.
+*
+*  NOTES
+*      MT-NOTE: drmaa_run_job_list() is MT safe
+*******************************************************************************/
+int drmaa_run_job_list(drmaa_job_ids_t **jobids, const drmaa_job_template_t *jt[], int count,
+      char *error_diagnosis, size_t error_diag_len)
+{
+   dstring diag, *diagp = nullptr;
+   int drmaa_errno = DRMAA_ERRNO_SUCCESS;
+   lList *sge_job_templates = nullptr;
+   int i;
+
+   DENTER(TOP_LAYER);
+
+   if (error_diagnosis) {
+      sge_dstring_init(&diag, error_diagnosis, error_diag_len+1);
+      diagp = &diag;
+   }
+
+   if ((jobids == nullptr) || (jt == nullptr) || (count < 1)) {
+      japi_standard_error(DRMAA_ERRNO_INVALID_ARGUMENT, diagp);
+      DRETURN(DRMAA_ERRNO_INVALID_ARGUMENT);
+   }
+
+   /* per thread initialization */
+   drmaa_errno = japi_was_init_called(diagp);
+   if( drmaa_errno != DRMAA_ERRNO_SUCCESS ) {
+      /* diagp written by japi_was_init_called() */
+      DRETURN(drmaa_errno);
+   }
+
+   /* convert DRMAA job templates into Cluster Scheduler job templates */
+   sge_job_templates = lCreateList("job templates", JB_Type);
+   for (i = 0; i < count; i++) {
+      lListElem *sge_job_template = nullptr;
+
+      if (jt[i] == nullptr) {
+         lFreeList(&sge_job_templates);
+         japi_standard_error(DRMAA_ERRNO_INVALID_ARGUMENT, diagp);
+         DRETURN(DRMAA_ERRNO_INVALID_ARGUMENT);
+      }
+      drmaa_errno = drmaa_job2sge_job(&sge_job_template, jt[i], 0, 1, 1, 1, diagp);
+      if (drmaa_errno != DRMAA_ERRNO_SUCCESS) {
+         /* diag written by drmaa_job2sge_job() */
+         lFreeList(&sge_job_templates);
+         DRETURN(drmaa_errno);
+      }
+      lAppendElem(sge_job_templates, sge_job_template);
+   }
+
+   drmaa_errno = japi_run_job_list((drmaa_attr_values_t **)jobids, &sge_job_templates, diagp);
+   lFreeList(&sge_job_templates);
+
+   DRETURN(drmaa_errno);
+}
+
 /****** DRMAA/drmaa_control() ****************************************************
 *  NAME
 *     drmaa_control() -- Start, stop, restart, or kill jobs
@@ -66,6 +66,7 @@ extern "C" {
 *     DRMAA/drmaa_get_vector_attribute_names()
 *     DRMAA/drmaa_run_job()
 *     DRMAA/drmaa_run_bulk_jobs()
+*     DRMAA/drmaa_run_job_list()
 *     DRMAA/drmaa_control()
 *     DRMAA/drmaa_synchronize()
 *     DRMAA/drmaa_wait()
@@ -508,6 +509,27 @@ int drmaa_run_bulk_jobs(drmaa_job_ids_t **jobids,
                         const drmaa_job_template_t *jt, int start, int end,
                         int incr, char *error_diagnosis, size_t error_diag_len);
 
+/*
+ * Submit 'count' independent jobs with attributes defined in the job
+ * templates 'jt' with one request. This is an extension of the DRMAA
+ * interface, it is much faster than calling drmaa_run_job() 'count' times.
+ * 'jobids' contains one job identifier per job template in the order of
+ * the templates, the job identifier of a job which was rejected is an 
+ * empty string.
+ *
+ * drmaa_run_job_list() SHALL return DRMAA_ERRNO_SUCCESS if all jobs were
+ * submitted, otherwise:
+ *    DRMAA_ERRNO_TRY_LATER,
+ *    DRMAA_ERRNO_DENIED_BY_DRM,
+ *    DRMAA_ERRNO_NO_MEMORY,
+ *    DRMAA_ERRNO_DRM_COMMUNICATION_FAILURE or
+ *    DRMAA_ERRNO_AUTH_FAILURE.
+ * If some of the jobs were rejected 'jobids' is returned nevertheless.
+ */
+int drmaa_run_job_list(drmaa_job_ids_t **jobids,
+                       const drmaa_job_template_t *jt[], int count,
+                       char *error_diagnosis, size_t error_diag_len);
+
 /* ------------------- job control routines ------------------- */
 
 /*
@@ -36,9 +36,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <unistd.h>
 #include <cerrno>
 #include <csignal>
+#include <poll.h>
 #include <pthread.h>
 #include <pwd.h>
 
@@ -60,6 +62,7 @@
 #include "japi/japi.h"
 #include "japi/msg_japi.h"
 #include "japi/japiP.h"
+#include "japi/ocs_DrmaaRelay.h"
 
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_conf.h"
@@ -124,6 +127,8 @@ static pthread_once_t japi_once_control = PTHREAD_ONCE_INIT;
 *     static int japi_ec_state = JAPI_EC_DOWN;
 *     static u_long32 japi_ec_id = 0;
 *     static lList *Master_japi_job_list = nullptr;
+*     static std::deque<u_long32> japi_finished_queue;
+*     static u_long32 japi_unfinished_jobs = 0;
 *     static int japi_threads_in_session = 0;
 *     static char *japi_session_key = nullptr;
 *     static bool japi_delegated_file_staging_is_enabled = false;
@@ -164,6 +169,12 @@ static pthread_once_t japi_once_control = PTHREAD_ONCE_INIT;
 *                    is used. See japi_threads_in_session on strategy to ensure 
 *                    Master_japi_job_list integrity in case of multiple application 
 *                    threads.
+*     japi_finished_queue - Job ids of finished tasks in the order the tasks
+*                    finished. Allows japi_wait() for any job to find a finished 
+*                    task without searching the Master_japi_job_list. Guarded by
+*                    Master_japi_job_list_mutex.
+*     japi_unfinished_jobs - The number of jobs in Master_japi_job_list having
+*                    tasks not yet finished. Guarded by Master_japi_job_list_mutex.
 *     japi_threads_in_session - A counter indicating the number of threads depending 
 *                    upon Master_japi_job_list: Each thread entering such a JAPI call 
 *                    must increase this counter and decrese it again when leaving. 
@@ -253,6 +264,13 @@ static pthread_mutex_t Master_japi_job_list_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* this condition is raised each time when a job/task is finshed */
 static pthread_cond_t Master_japi_job_list_finished_cv = PTHREAD_COND_INITIALIZER;
 
+/* job ids of finished tasks in the order they finished, one entry per task,
+   entries of tasks reaped meanwhile are skipped by japi_wait_retry() */
+static std::deque<u_long32> japi_finished_queue;
+
+/* number of jobs in Master_japi_job_list having unfinished tasks */
+static u_long32 japi_unfinished_jobs = 0;
+
 /* ---- japi_threads_in_session ------------------------------ */
 
 int japi_threads_in_session = 0;
@@ -289,7 +307,10 @@ static bool virgin_session = true;
 *     JAPI/japi_implementation_thread()
 *     JAPI/japi_parse_jobid()
 *     JAPI/japi_send_job()
+*     JAPI/japi_send_job_list()
 *     JAPI/japi_add_job()
+*     JAPI/japi_finish_task()
+*     JAPI/japi_remove_job()
 *     JAPI/japi_synchronize_retry()
 *     JAPI/japi_synchronize_all_retry()
 *     JAPI/japi_synchronize_jobids_retry()
@@ -305,9 +326,12 @@ static void *japi_implementation_thread(void *);
 static int japi_parse_jobid(const char *jobid_str, u_long32 *jobid, u_long32 *taskid, 
    bool *is_array, dstring *diag);
 static int japi_send_job(lListElem **job, u_long32 *jobid, dstring *diag);
+static int japi_send_job_list(lList **job_lp, dstring *diag);
 static int japi_add_job(u_long32 jobid, u_long32 start, u_long32 end, u_long32 incr, 
       bool is_array, dstring *diag);
-static int japi_synchronize_jobids_retry(const char *jobids[], bool dispose);
+static lListElem *japi_finish_task(lListElem *japi_job, u_long32 taskid);
+static void japi_remove_job(lListElem **japi_job);
+static int japi_synchronize_jobids_retry(const char *jobids[], int *next_id, bool dispose);
 static int japi_wait_retry(lList *japi_job_list, int wait4any, u_long32 jobid,
                            u_long32 taskid, bool is_array_task, int event_mask,
                            u_long32 *wjobidp, u_long32 *wtaskidp,
@@ -949,7 +973,8 @@ int japi_exit(int flag, dstring *diag)
       japi_ec_state = JAPI_EC_FINISHING;
       JAPI_UNLOCK_EC_STATE();
 
-      if (my_state == JAPI_EC_UP) {
+      /* sessions using sge_drmaa_relay have no own event client */
+      if (my_state == JAPI_EC_UP && japi_ec_id != 0) {
          japi_stop_event_client(default_cell);
       }
 
@@ -1003,6 +1028,8 @@ int japi_exit(int flag, dstring *diag)
     * have exited.  Otherwise, they may think their jobs exited badly. */
    JAPI_LOCK_JOB_LIST();    
    lFreeList(&Master_japi_job_list);
+   japi_finished_queue.clear();
+   japi_unfinished_jobs = 0;
    JAPI_UNLOCK_JOB_LIST();    
 
    /* Session is not inactive until the session has been closed (or not).  If
@@ -1218,62 +1245,55 @@ void japi_delete_string_vector(drmaa_attr_values_t* iter )
    return;
 }
 
-/****** JAPI/japi_send_job() ***************************************************
+/****** JAPI/japi_send_job_list() **********************************************
 *  NAME
-*     japi_send_job() -- Send job to qmaster using GDI
+*     japi_send_job_list() -- Send jobs to qmaster using one GDI request
 *
 *  SYNOPSIS
-*     static int japi_send_job(lListElem *job, u_long32 *jobid, dstring *diag) 
+*     static int japi_send_job_list(lList **job_lp, dstring *diag)
 *
 *  FUNCTION
-*     The job passed is sent to qmaster using GDI. The jobid is returned.
+*     The jobs passed are sent to qmaster using one GDI request. The job list
+*     is replaced by the jobs as they were added by qmaster. If more than one
+*     job is sent, qmaster returns all jobs in the order they were sent and 
+*     jobs which were rejected have the job number 0.
 *
 *  INPUTS
-*     lListElem *job  - the job (JB_Type)
-*     u_long32 *jobid - destination for resulting jobid
+*     lList **job_lp  - the jobs (JB_Type)
 *     dstring *diag   - diagnosis information
 *
 *  RESULT
-*     int - DRMAA error codes
+*     int - DRMAA error codes, an error is returned if one of the jobs
+*           was rejected
 *
 *  NOTES
-*     MT-NOTE: japi_send_job() is MT safe
+*     MT-NOTE: japi_send_job_list() is MT safe
 *******************************************************************************/
-static int japi_send_job(lListElem **sge_job_template, u_long32 *jobid, dstring *diag)
+static int japi_send_job_list(lList **job_lp, dstring *diag)
 {
-   lList *job_lp, *alp;
+   lList *alp;
    const lListElem *aep;
    lListElem *job;
+   int amount;
+   ocs_grp_elem_t *grp_array;
+   u_long32 sent = lGetNumberOfElem(*job_lp);
    int result = DRMAA_ERRNO_SUCCESS;
 
    DENTER(TOP_LAYER);
 
-   job_lp = lCreateList(nullptr, JB_Type);
-   job = lCopyElem(*sge_job_template);
-   lAppendElem(job_lp, job);
-
    /* 
     * Set owner and group so that information will be available in
     * client JSV scripts
     */
-   int amount;
-   ocs_grp_elem_t *grp_array;
    component_get_supplementray_groups(&amount, &grp_array);
-   job_set_owner_and_group(job, component_get_uid(), component_get_gid(),
-                           component_get_username(), component_get_groupname(),
-                           amount, grp_array);
-
-   /* use GDI to submit job for this session */
-   alp = sge_gdi(SGE_JB_LIST, SGE_GDI_ADD|SGE_GDI_RETURN_NEW_VERSION, &job_lp, nullptr, nullptr);
-
-   /* reinitialize 'job' with pointer to new version from qmaster */
-   lFreeElem(sge_job_template);
-   if ((*sge_job_template = lFirstRW(job_lp))) {
-      *jobid = lGetUlong(*sge_job_template, JB_job_number);
+   for_each_rw(job, *job_lp) {
+      job_set_owner_and_group(job, component_get_uid(), component_get_gid(),
+                              component_get_username(), component_get_groupname(),
+                              amount, grp_array);
    }
 
-   lDechainElem(job_lp, *sge_job_template);
-   lFreeList(&job_lp);
+   /* use GDI to submit jobs for this session */
+   alp = sge_gdi(SGE_JB_LIST, SGE_GDI_ADD|SGE_GDI_RETURN_NEW_VERSION, job_lp, nullptr, nullptr);
 
    if (!(aep = lFirst(alp))) {
       lFreeList(&alp);
@@ -1310,10 +1330,137 @@ static int japi_send_job(lListElem **sge_job_template, u_long32 *jobid, dstring
    }
    lFreeList(&alp);
 
+   /* 
+    * a single job is returned together with a copy of the new version,
+    * and it keeps its job number also if it was rejected
+    */
+   if (sent == 1) {
+      while (lGetNumberOfElem(*job_lp) > 1) {
+         job = lLastRW(*job_lp);
+         lRemoveElem(*job_lp, &job);
+      }
+      if (result != DRMAA_ERRNO_SUCCESS && (job = lFirstRW(*job_lp)) != nullptr) {
+         lSetUlong(job, JB_job_number, 0);
+      }
+   }
+
+   DRETURN(result);
+}
+
+/****** JAPI/japi_send_job() ***************************************************
+*  NAME
+*     japi_send_job() -- Send job to qmaster using GDI
+*
+*  SYNOPSIS
+*     static int japi_send_job(lListElem *job, u_long32 *jobid, dstring *diag) 
+*
+*  FUNCTION
+*     The job passed is sent to qmaster using GDI. The jobid is returned.
+*
+*  INPUTS
+*     lListElem *job  - the job (JB_Type)
+*     u_long32 *jobid - destination for resulting jobid
+*     dstring *diag   - diagnosis information
+*
+*  RESULT
+*     int - DRMAA error codes
+*
+*  NOTES
+*     MT-NOTE: japi_send_job() is MT safe
+*******************************************************************************/
+static int japi_send_job(lListElem **sge_job_template, u_long32 *jobid, dstring *diag)
+{
+   lList *job_lp;
+   int result;
+
+   DENTER(TOP_LAYER);
+
+   job_lp = lCreateList(nullptr, JB_Type);
+   lAppendElem(job_lp, lCopyElem(*sge_job_template));
+
+   result = japi_send_job_list(&job_lp, diag);
+
+   /* reinitialize 'job' with pointer to new version from qmaster */
+   lFreeElem(sge_job_template);
+   if ((*sge_job_template = lFirstRW(job_lp))) {
+      *jobid = lGetUlong(*sge_job_template, JB_job_number);
+      lDechainElem(job_lp, *sge_job_template);
+   }
+   lFreeList(&job_lp);
+
    DRETURN(result);
 }
 
 
+/****** JAPI/japi_finish_task() ***********************************************
+*  NAME
+*     japi_finish_task() -- Move a task into the finished tasks of a job
+*
+*  SYNOPSIS
+*     static lListElem *japi_finish_task(lListElem *japi_job, u_long32 taskid)
+*
+*  FUNCTION
+*     The task is removed from JJ_not_yet_finished_ids and added to 
+*     JJ_finished_tasks. japi_finished_queue and japi_unfinished_jobs are 
+*     updated accordingly.
+*
+*  INPUTS
+*     lListElem *japi_job - the JAPI job
+*     u_long32 taskid     - the task id
+*
+*  RESULT
+*     static lListElem * - the new finished task (JJAT_Type)
+*
+*  NOTES
+*     MT-NOTE: japi_finish_task() is not MT safe, caller must hold 
+*     MT-NOTE: Master_japi_job_list_mutex
+*******************************************************************************/
+static lListElem *japi_finish_task(lListElem *japi_job, u_long32 taskid)
+{
+   lListElem *japi_task;
+   bool was_unfinished = lGetList(japi_job, JJ_not_yet_finished_ids) != nullptr;
+
+   object_delete_range_id(japi_job, nullptr, JJ_not_yet_finished_ids, taskid);
+   if (was_unfinished && lGetList(japi_job, JJ_not_yet_finished_ids) == nullptr) {
+      japi_unfinished_jobs--;
+   }
+
+   japi_task = lAddSubUlong(japi_job, JJAT_task_id, taskid, JJ_finished_tasks, JJAT_Type);
+   japi_finished_queue.push_back(lGetUlong(japi_job, JJ_jobid));
+
+   return japi_task;
+}
+
+/****** JAPI/japi_remove_job() ************************************************
+*  NAME
+*     japi_remove_job() -- Remove a job from library session data
+*
+*  SYNOPSIS
+*     static void japi_remove_job(lListElem **japi_job)
+*
+*  FUNCTION
+*     The job is removed from Master_japi_job_list. Once the list is empty
+*     all entries left in japi_finished_queue belong to reaped tasks and 
+*     are dropped.
+*
+*  INPUTS
+*     lListElem **japi_job - the JAPI job, set to nullptr
+*
+*  NOTES
+*     MT-NOTE: japi_remove_job() is not MT safe, caller must hold 
+*     MT-NOTE: Master_japi_job_list_mutex
+*******************************************************************************/
+static void japi_remove_job(lListElem **japi_job)
+{
+   if (lGetList(*japi_job, JJ_not_yet_finished_ids) != nullptr) {
+      japi_unfinished_jobs--;
+   }
+   lRemoveElem(Master_japi_job_list, japi_job);
+   if (lGetNumberOfElem(Master_japi_job_list) == 0) {
+      japi_finished_queue.clear();
+   }
+}
+
 /****** JAPI/japi_add_job() ****************************************************
 *  NAME
 *     japi_add_job() -- Add job/bulk job to library session data
@@ -1358,6 +1505,7 @@ static int japi_add_job(u_long32 jobid, u_long32 start, u_long32 end, u_long32 i
       -  no task in JJ_finished_jobs */
    japi_job = lAddElemUlong(&Master_japi_job_list, JJ_jobid, jobid, JJ_Type);
    object_set_range_id(japi_job, JJ_not_yet_finished_ids, start, end, incr);
+   japi_unfinished_jobs++;
 
    /* mark it as array job */
    if (is_array) {
@@ -1576,6 +1724,137 @@ int japi_run_bulk_jobs(drmaa_attr_values_t **jobidsp, lListElem **sge_job_templa
    DRETURN(DRMAA_ERRNO_SUCCESS);
 }
 
+/****** JAPI/japi_run_job_list() ************************************************
+*  NAME
+*     japi_run_job_list() -- Submit many jobs with one request
+*
+*  SYNOPSIS
+*     int japi_run_job_list(drmaa_attr_values_t **jobidsp, 
+*           lList **sge_job_templates, dstring *diag)
+*
+*  FUNCTION
+*     Submit all jobs of the SGE job template list with one GDI request.
+*     qmaster verifies and spools all jobs in one go, this is much faster
+*     than submitting the jobs one by one with japi_run_job().
+*
+*  INPUTS
+*     lList **sge_job_templates - SGE job templates (JB_Type), 
+*                                 replaced by the jobs as added by qmaster
+*  
+*  OUTPUTS
+*     drmaa_attr_values_t **jobidsp - a string array with one job id per
+*                                     template, an empty string for jobs 
+*                                     which were rejected
+*     dstring *diag                 - diagnosis information
+*
+*  RESULT
+*     int - DRMAA error codes, an error is returned if one of the jobs
+*           was rejected. The job ids are returned nevertheless in this
+*           case, the accepted jobs are part of the session.
+*
+*  NOTES
+*      MT-NOTE: japi_run_job_list() is MT safe
+*******************************************************************************/
+int japi_run_job_list(drmaa_attr_values_t **jobidsp, lList **sge_job_templates, dstring *diag)
+{
+   drmaa_attr_values_t *jobids;
+   lListElem *job;
+   int drmaa_errno;
+   int send_errno;
+
+   DENTER(TOP_LAYER);
+
+   /* check arguments */
+   if (lGetNumberOfElem(*sge_job_templates) == 0) {
+      japi_standard_error(DRMAA_ERRNO_INVALID_ARGUMENT, diag);
+      DRETURN(DRMAA_ERRNO_INVALID_ARGUMENT);
+   }
+
+   /* ensure japi_init() was called */
+   JAPI_LOCK_SESSION();
+   if (japi_session != JAPI_SESSION_ACTIVE) {
+      JAPI_UNLOCK_SESSION();
+      japi_standard_error(DRMAA_ERRNO_NO_ACTIVE_SESSION, diag);
+      DRETURN(DRMAA_ERRNO_NO_ACTIVE_SESSION);
+   }
+
+   japi_inc_threads(__func__);
+
+   JAPI_UNLOCK_SESSION();
+
+   /* per thread initialization */
+   if (japi_init_mt(diag) != DRMAA_ERRNO_SUCCESS) {
+      japi_dec_threads(__func__);
+      /* diag written by japi_init_mt() */
+      DRETURN(DRMAA_ERRNO_INTERNAL_ERROR);
+   }
+
+   if (!(jobids = japi_allocate_string_vector(JAPI_ITERATOR_STRINGS))) {
+      japi_dec_threads(__func__);
+      japi_standard_error(DRMAA_ERRNO_NO_MEMORY, diag);
+      DRETURN(DRMAA_ERRNO_NO_MEMORY);
+   }
+
+   /* tag jobs with JAPI session key */
+   if (japi_session_key != nullptr) {
+      for_each_rw(job, *sge_job_templates) {
+         lSetString(job, JB_session, japi_session_key);
+      }
+   }
+
+   JAPI_LOCK_JOB_LIST();    
+
+   /* send jobs to qmaster using GDI */
+   send_errno = japi_send_job_list(sge_job_templates, diag);
+   if (lGetNumberOfElem(*sge_job_templates) == 0) {
+      JAPI_UNLOCK_JOB_LIST();    
+      japi_dec_threads(__func__);
+      japi_delete_string_vector(jobids);
+      /* diag written by japi_send_job_list() */
+      DRETURN(send_errno);
+   }
+
+   /* add the accepted jobs to library session data */
+   drmaa_errno = DRMAA_ERRNO_SUCCESS;
+   for_each_rw(job, *sge_job_templates) {
+      u_long32 jobid = lGetUlong(job, JB_job_number);
+      dstring id_str = DSTRING_INIT;
+
+      if (jobid != 0) {
+         if (job_is_array(job)) {
+            u_long32 start, end, incr;
+
+            job_get_submit_task_ids(job, &start, &end, &incr);
+            drmaa_errno = japi_add_job(jobid, start, end, incr, true, diag);
+         } else {
+            drmaa_errno = japi_add_job(jobid, 1, 1, 1, false, diag);
+         }
+         if (drmaa_errno != DRMAA_ERRNO_SUCCESS) {
+            break;
+         }
+         sge_dstring_sprintf(&id_str, sge_u32, jobid);
+      }
+      lAddElemStr(&(jobids->it.si.strings), ST_name,
+                  jobid != 0 ? sge_dstring_get_string(&id_str) : "", ST_Type);
+      sge_dstring_free(&id_str);
+   }
+
+   JAPI_UNLOCK_JOB_LIST();    
+
+   japi_dec_threads(__func__);
+   if (drmaa_errno != DRMAA_ERRNO_SUCCESS) {
+      /* diag written by japi_add_job() */
+      japi_delete_string_vector(jobids);
+      DRETURN(drmaa_errno);
+   }
+
+   /* return jobids */
+   jobids->it.si.next_pos = lFirstRW(jobids->it.si.strings);
+   *jobidsp = jobids;
+
+   DRETURN(send_errno);
+}
+
 /****** JAPI/japi_user_hold_add_jobid() *****************************************
 *  NAME
 *     japi_user_hold_add_jobid() -- Helper function for composing GDI request
@@ -2164,6 +2443,7 @@ int japi_synchronize(const char *job_ids[], signed long timeout, bool dispose, d
    bool sync_all = false;
    int drmaa_errno, i;
    int wait_result;
+   int next_id = 0;
    struct timespec ts;
    const char **sync_job_ids = nullptr;
    lList *sync_list = nullptr;
@@ -2293,7 +2573,7 @@ int japi_synchronize(const char *job_ids[], signed long timeout, bool dispose, d
       sync_job_ids = job_ids;
    }
    
-   while ((wait_result = japi_synchronize_jobids_retry(sync_job_ids, dispose) == JAPI_WAIT_UNFINISHED)) {
+   while ((wait_result = japi_synchronize_jobids_retry(sync_job_ids, &next_id, dispose) == JAPI_WAIT_UNFINISHED)) {
 
       /* must return DRMAA_ERRNO_DRM_COMMUNICATION_FAILURE when event client 
          thread was shutdown during japi_wait() use japi_session */
@@ -2358,15 +2638,19 @@ int japi_synchronize(const char *job_ids[], signed long timeout, bool dispose, d
 *
 *  SYNOPSIS
 *     static int japi_synchronize_jobids_retry(const char *job_ids[], 
-*     int dispose) 
+*     int *next_id, int dispose) 
 *
 *  FUNCTION
 *     The Master_japi_job_list is searched to investigate whether particular
 *     jobs specified in job_ids finshed. If dispose is true job finish 
 *     information is also removed during this operation.
+*     Finished tasks never become unfinished again, so the search starts
+*     with the first job id not synchronized by a previous call. 
 *
 *  INPUTS
 *     const char *job_ids[] - the jobids
+*     int *next_id          - index of the first job id to be checked,
+*                             set to 0 before the first call
 *     bool dispose          - should job finish information be removed
 *
 *  RESULT
@@ -2380,7 +2664,7 @@ int japi_synchronize(const char *job_ids[], signed long timeout, bool dispose, d
 *     MT-NOTE: due to acess to Master_japi_job_list japi_synchronize_jobids_retry() 
 *     MT-NOTE: is not MT safe; only one instance may be called at a time!
 *******************************************************************************/
-static int japi_synchronize_jobids_retry(const char *job_ids[], bool dispose)
+static int japi_synchronize_jobids_retry(const char *job_ids[], int *next_id, bool dispose)
 {
    int i;
    lListElem *japi_job;
@@ -2392,7 +2676,7 @@ static int japi_synchronize_jobids_retry(const char *job_ids[], bool dispose)
     * We simply iterate over all jobids and do the wait operation 
     * for each of them. 
     */
-   for (i=0; job_ids[i] != nullptr; i++) {
+   for (i=*next_id; job_ids[i] != nullptr; i++) {
       u_long32 jobid, taskid;  
       bool is_array;
     
@@ -2410,6 +2694,7 @@ static int japi_synchronize_jobids_retry(const char *job_ids[], bool dispose)
       not_yet_finished = lGetList(japi_job, JJ_not_yet_finished_ids);
       if (not_yet_finished && range_list_is_id_within(not_yet_finished, taskid)) {
          DPRINTF("job " sge_u32"." sge_u32" is a still unfinished task\n", jobid, taskid);
+         *next_id = i;
          DRETURN(JAPI_WAIT_UNFINISHED);
       } 
 
@@ -2420,7 +2705,7 @@ static int japi_synchronize_jobids_retry(const char *job_ids[], bool dispose)
          DPRINTF("dispose job finish information for job " sge_u32" task " sge_u32"\n", jobid, taskid);
          if (!lGetList(japi_job, JJ_finished_tasks) && !not_yet_finished) {
             /* remove JAPI job if no longer needed */
-            lRemoveElem(Master_japi_job_list, &japi_job);
+            japi_remove_job(&japi_job);
          }
       }
    }
@@ -2752,24 +3037,22 @@ static int japi_wait_retry(lList *japi_job_list, int wait4any, u_long32 jobid,
    /* seek for job_id in JJ_finished_jobs of all jobs */
    if (event_mask & JAPI_JOB_FINISH) {
       if (wait4any) {
-         int not_yet_reaped = 0;
-
-         for_each_rw (job, japi_job_list) {
-            task = lFirstRW(lGetList(job, JJ_finished_tasks));
-            
-            if (task != nullptr) {
-               break;
-            }
-            
-            /* This comes after the break because if we have a non-nullptr task,
-             * we don't bother looking at not_yet_reaped. */
-            if (lGetList(job, JJ_not_yet_finished_ids) != nullptr) {
-               not_yet_reaped = 1;
+         /* take the task finished first, entries of jobs whose finished
+            tasks were already reaped by japi_wait() for a particular job or
+            by japi_synchronize() are dropped */
+         while (!japi_finished_queue.empty()) {
+            job = lGetElemUlongRW(japi_job_list, JJ_jobid, japi_finished_queue.front());
+            japi_finished_queue.pop_front();
+            if (job != nullptr) {
+               task = lFirstRW(lGetList(job, JJ_finished_tasks));
+               if (task != nullptr) {
+                  break;
+               }
             }
          }
 
          if ((task == nullptr) || (job == nullptr)) {
-            if (not_yet_reaped) {
+            if (japi_unfinished_jobs > 0) {
                return_value = JAPI_WAIT_UNFINISHED;
             } else {
                return_value = JAPI_WAIT_ALLFINISHED;
@@ -2946,7 +3229,7 @@ static int japi_wait_retry(lList *japi_job_list, int wait4any, u_long32 jobid,
       lRemoveElem(lGetListRW(job, JJ_finished_tasks), &task);
       if (range_list_is_empty(lGetList(job, JJ_not_yet_finished_ids)) 
          && lGetNumberOfElem(lGetList(job, JJ_finished_tasks))==0) {
-         lRemoveElem(Master_japi_job_list, &job);
+         japi_remove_job(&job);
       }
    }
 
@@ -3955,23 +4238,24 @@ int japi_get_drm_system(dstring *drm, dstring *diag, int me)
 *  NOTES
 *     MT-NOTE: japi_subscribe_job_list() is MT safe
 *******************************************************************************/
+/* job attributes needed to synchronize the session jobs with the job list */
+static const int japi_job_list_nm[] = {
+   JB_job_number,
+   JB_project,
+   JB_type,
+   JB_ja_tasks,
+   JB_ja_structure,
+   JB_ja_n_h_ids,
+   JB_ja_u_h_ids,
+   JB_ja_s_h_ids,
+   JB_ja_o_h_ids,
+   JB_ja_z_ids,
+   JB_ja_template,
+   NoName
+};
+
 static void japi_subscribe_job_list(const char *japi_session_key, sge_evc_class_t *evc)
 {
-   const int job_nm[] = {
-      JB_job_number,
-      JB_project,
-      JB_type,
-      JB_ja_tasks,
-      JB_ja_structure,
-      JB_ja_n_h_ids,
-      JB_ja_u_h_ids,
-      JB_ja_s_h_ids,
-      JB_ja_o_h_ids,
-      JB_ja_z_ids,
-      JB_ja_template,
-      NoName
-   };
-
    lCondition *where = nullptr;
    lEnumeration *what = nullptr;
    lListElem *where_el = nullptr;
@@ -3980,7 +4264,7 @@ static void japi_subscribe_job_list(const char *japi_session_key, sge_evc_class_
    evc->ec_subscribe(evc, sgeE_JOB_LIST);
 
    where = lWhere("%T(%I==%s)", JB_Type, JB_session, japi_session_key);
-   what = lIntVector2What(JB_Type, job_nm);
+   what = lIntVector2What(JB_Type, japi_job_list_nm);
 
    where_el = lWhereToElem(where);
    what_el = lWhatToElem(what);
@@ -4000,6 +4284,153 @@ static void japi_subscribe_job_list(const char *japi_session_key, sge_evc_class_
    return;
 }
 
+/****** JAPI/japi_relay_register() *********************************************
+*  NAME
+*     japi_relay_register() -- Register the session at sge_drmaa_relay
+*
+*  SYNOPSIS
+*     static bool japi_relay_register(const char *relay_path, int *relay_fd)
+*
+*  FUNCTION
+*     Used instead of registering an event client at qmaster if the
+*     environment variable SGE_DRMAA_RELAY is set. The relay passes the
+*     job finish and task start events of the session jobs.
+*
+*  INPUTS
+*     const char *relay_path - socket path of the relay
+*
+*  OUTPUTS
+*     int *relay_fd          - the connection to the relay
+*
+*  RESULT
+*     static bool - true on success, errors are stored in japi_ec_alp_struct
+*
+*  NOTES
+*     MT-NOTE: japi_relay_register() is MT safe
+*******************************************************************************/
+static bool japi_relay_register(const char *relay_path, int *relay_fd)
+{
+   lList *alp = nullptr;
+
+   DENTER(TOP_LAYER);
+
+   DPRINTF("registering at DRMAA relay %s ...\n", relay_path);
+
+   JAPI_LOCK_EC_STATE();
+   if (japi_ec_state != JAPI_EC_STARTING && japi_ec_state != JAPI_EC_RESTARTING) {
+      JAPI_UNLOCK_EC_STATE();
+      DRETURN(false);
+   }
+
+   *relay_fd = ocs::DrmaaRelay::connect(relay_path, japi_session_key, &alp);
+   if (*relay_fd < 0) {
+      const lListElem *aep = lFirst(alp);
+      if (aep) {
+         JAPI_LOCK_EC_ALP(japi_ec_alp_struct);
+         answer_list_add(&(japi_ec_alp_struct.japi_ec_alp), lGetString(aep, AN_text),
+               lGetUlong(aep, AN_status), (answer_quality_t)lGetUlong(aep, AN_quality));
+         JAPI_UNLOCK_EC_ALP(japi_ec_alp_struct);
+      }
+      JAPI_UNLOCK_EC_STATE();
+      lFreeList(&alp);
+      DRETURN(false);
+   }
+   japi_ec_id = 0;
+   JAPI_UNLOCK_EC_STATE();
+
+   DRETURN(true);
+}
+
+/****** JAPI/japi_relay_get() **************************************************
+*  NAME
+*     japi_relay_get() -- Get the events of the session from sge_drmaa_relay
+*
+*  SYNOPSIS
+*     static bool japi_relay_get(const char *relay_path, int *relay_fd,
+*        bool *resync, int timeout, lList **event_list)
+*
+*  FUNCTION
+*     Counterpart of ec_get() for sessions using sge_drmaa_relay. Waits up 
+*     to timeout milliseconds for events. A broken connection is closed 
+*     and opened again with the next call.
+*
+*     The relay only passes events of jobs it knows, jobs finished while 
+*     the session or the relay was not connected are found with a job list 
+*     fetched from qmaster. It is added as sgeE_JOB_LIST event if resync 
+*     is set or the relay sent a sgeE_JOB_LIST event.
+*
+*  INPUTS
+*     const char *relay_path - socket path of the relay
+*     int *relay_fd          - connection to the relay, -1 if not connected
+*     bool *resync           - fetch the job list, reset on success
+*     int timeout            - milliseconds to wait for events
+*
+*  OUTPUTS
+*     lList **event_list     - the events, nullptr if there were none
+*
+*  RESULT
+*     static bool - false if the relay or qmaster are not reachable
+*
+*  NOTES
+*     MT-NOTE: japi_relay_get() is MT safe
+*******************************************************************************/
+static bool japi_relay_get(const char *relay_path, int *relay_fd, bool *resync,
+                           int timeout, lList **event_list)
+{
+   lList *alp = nullptr;
+   lListElem *event;
+   struct pollfd pfd;
+
+   DENTER(TOP_LAYER);
+
+   if (*relay_fd < 0) {
+      *relay_fd = ocs::DrmaaRelay::connect(relay_path, japi_session_key, &alp);
+      lFreeList(&alp);
+      if (*relay_fd < 0) {
+         DRETURN(false);
+      }
+      *resync = true;
+   }
+
+   pfd.fd = *relay_fd;
+   pfd.events = POLLIN;
+   pfd.revents = 0;
+   if (poll(&pfd, 1, timeout) > 0 && !ocs::DrmaaRelay::receive_events(*relay_fd, event_list)) {
+      DPRINTF("lost connection to DRMAA relay\n");
+      close(*relay_fd);
+      *relay_fd = -1;
+      DRETURN(false);
+   }
+
+   if (*resync) {
+      lAddElemUlong(event_list, ET_type, sgeE_JOB_LIST, ET_Type);
+   }
+
+   for_each_rw(event, *event_list) {
+      if (lGetUlong(event, ET_type) == sgeE_JOB_LIST) {
+         lCondition *where = lWhere("%T(%I==%s)", JB_Type, JB_session, japi_session_key);
+         lEnumeration *what = lIntVector2What(JB_Type, japi_job_list_nm);
+         lList *job_list = nullptr;
+
+         alp = sge_gdi(SGE_JB_LIST, SGE_GDI_GET, &job_list, where, what);
+         lFreeWhere(&where);
+         lFreeWhat(&what);
+         if (answer_list_has_error(&alp)) {
+            /* an incomplete job list would let all missing jobs appear finished */
+            lFreeList(&alp);
+            lFreeList(&job_list);
+            lFreeList(event_list);
+            DRETURN(false);
+         }
+         lFreeList(&alp);
+         lSetList(event, ET_new_version, job_list);
+      }
+   }
+   *resync = false;
+
+   DRETURN(true);
+}
+
 /****** JAPI/japi_implementation_thread() **************************************
 *  Under construction
 *  NAME   
@@ -4033,6 +4464,9 @@ static void *japi_implementation_thread(void * a_user_data_pointer)
                                  qmaster. */
    static sge_evc_class_t *evc = nullptr;
    int gdi_errno = AE_OK;
+   const char *relay_path = ocs::DrmaaRelay::get_socket_path();
+   int relay_fd = -1;
+   bool relay_resync = false;
 
    DENTER(TOP_LAYER);
 
@@ -4078,76 +4512,94 @@ static void *japi_implementation_thread(void * a_user_data_pointer)
          flush_delay_rate = parameter;       
    }
 
-   /* register at qmaster as event client */
-   DPRINTF("registering as event client ...\n");
-   evc = sge_evc_class_create(EV_ID_ANY, &alp, nullptr);
-   if (evc == nullptr) {
-      const lListElem *aep = lFirst(alp);
-      if (aep) {
-         JAPI_LOCK_EC_ALP(japi_ec_alp_struct);
-         answer_list_add(&(japi_ec_alp_struct.japi_ec_alp), lGetString(aep, AN_text), 
-               lGetUlong(aep, AN_status), (answer_quality_t)lGetUlong(aep, AN_quality));
-         JAPI_UNLOCK_EC_ALP(japi_ec_alp_struct);
+   if (relay_path != nullptr) {
+      /* sge_drmaa_relay passes the events of our jobs, no own event client */
+      evc = nullptr;
+      if (!japi_relay_register(relay_path, &relay_fd)) {
+         goto SetupFailed;
       }
-      lFreeList(&alp);
-      goto SetupFailed;
-   }   
-   
-   evc->ec_set_edtime(evc, ed_time); 
-   evc->ec_set_busy_handling(evc, EV_BUSY_UNTIL_ACK);
-   evc->ec_set_flush_delay(evc, flush_delay_rate); 
-   evc->ec_set_session(evc, japi_session_key);
-
-   /* subscription of the entire job list at start-up
-      required only for session reconnect (DRMAA) */
-   if (restarting) {
-      japi_subscribe_job_list(japi_session_key, evc);
-      evc->ec_mark4registration(evc);
+      /* jobs of a reconnected session are fetched from qmaster */
+      relay_resync = restarting;
       job_list_subscribed = true;
-   }
+   } else {
+      /* register at qmaster as event client */
+      DPRINTF("registering as event client ...\n");
+      evc = sge_evc_class_create(EV_ID_ANY, &alp, nullptr);
+      if (evc == nullptr) {
+         const lListElem *aep = lFirst(alp);
+         if (aep) {
+            JAPI_LOCK_EC_ALP(japi_ec_alp_struct);
+            answer_list_add(&(japi_ec_alp_struct.japi_ec_alp), lGetString(aep, AN_text), 
+                  lGetUlong(aep, AN_status), (answer_quality_t)lGetUlong(aep, AN_quality));
+            JAPI_UNLOCK_EC_ALP(japi_ec_alp_struct);
+         }
+         lFreeList(&alp);
+         goto SetupFailed;
+      }   
+   
+      evc->ec_set_edtime(evc, ed_time); 
+      evc->ec_set_busy_handling(evc, EV_BUSY_UNTIL_ACK);
+      evc->ec_set_flush_delay(evc, flush_delay_rate); 
+      evc->ec_set_session(evc, japi_session_key);
+
+      /* subscription of the entire job list at start-up
+         required only for session reconnect (DRMAA) */
+      if (restarting) {
+         japi_subscribe_job_list(japi_session_key, evc);
+         evc->ec_mark4registration(evc);
+         job_list_subscribed = true;
+      }
 
-   evc->ec_subscribe(evc, sgeE_JOB_FINISH);
-   evc->ec_set_flush(evc, sgeE_JOB_FINISH, true, 0);
+      evc->ec_subscribe(evc, sgeE_JOB_FINISH);
+      evc->ec_set_flush(evc, sgeE_JOB_FINISH, true, 0);
 
-   evc->ec_subscribe(evc, sgeE_JATASK_MOD);
-   evc->ec_set_flush(evc, sgeE_JATASK_MOD, true, 0);
+      evc->ec_subscribe(evc, sgeE_JATASK_MOD);
+      evc->ec_set_flush(evc, sgeE_JATASK_MOD, true, 0);
 
-   evc->ec_subscribe(evc, sgeE_SHUTDOWN);
-   evc->ec_set_flush(evc, sgeE_SHUTDOWN, true, 0);
+      evc->ec_subscribe(evc, sgeE_SHUTDOWN);
+      evc->ec_set_flush(evc, sgeE_SHUTDOWN, true, 0);
 
-/*    sgeE_QMASTER_GOES_DOWN  ??? */
+   /*    sgeE_QMASTER_GOES_DOWN  ??? */
 
-   /* Check again before we commit to this. */
-   JAPI_LOCK_EC_STATE();
-   if (japi_ec_state != JAPI_EC_STARTING && japi_ec_state != JAPI_EC_RESTARTING ) {
-      JAPI_UNLOCK_EC_STATE();
-      lFreeList(&alp);
-      goto SetupFailed;
-   }
+      /* Check again before we commit to this. */
+      JAPI_LOCK_EC_STATE();
+      if (japi_ec_state != JAPI_EC_STARTING && japi_ec_state != JAPI_EC_RESTARTING ) {
+         JAPI_UNLOCK_EC_STATE();
+         lFreeList(&alp);
+         goto SetupFailed;
+      }
    
-   if (!evc->ec_register(evc, false, &alp)) {
-      const lListElem *aep = lFirst(alp);
-      DPRINTF("error: ec_register() failed\n");
-      if (aep) {
-         JAPI_LOCK_EC_ALP(japi_ec_alp_struct);
-         answer_list_add(&(japi_ec_alp_struct.japi_ec_alp), lGetString(aep, AN_text), 
-               lGetUlong(aep, AN_status), (answer_quality_t)lGetUlong(aep, AN_quality));
-         JAPI_UNLOCK_EC_ALP(japi_ec_alp_struct);
+      if (!evc->ec_register(evc, false, &alp)) {
+         const lListElem *aep = lFirst(alp);
+         DPRINTF("error: ec_register() failed\n");
+         if (aep) {
+            JAPI_LOCK_EC_ALP(japi_ec_alp_struct);
+            answer_list_add(&(japi_ec_alp_struct.japi_ec_alp), lGetString(aep, AN_text), 
+                  lGetUlong(aep, AN_status), (answer_quality_t)lGetUlong(aep, AN_quality));
+            JAPI_UNLOCK_EC_ALP(japi_ec_alp_struct);
+         }
+         JAPI_UNLOCK_EC_STATE();
+         lFreeList(&alp);
+         goto SetupFailed;
       }
+      japi_ec_id = evc->ec_get_id(evc);
       JAPI_UNLOCK_EC_STATE();
-      lFreeList(&alp);
-      goto SetupFailed;
-   }
-   japi_ec_id = evc->ec_get_id(evc);
-   JAPI_UNLOCK_EC_STATE();
 
-   cl_com_set_synchron_receive_timeout(cl_com_get_handle(component_get_component_name(), 0),ed_time*2);
+      cl_com_set_synchron_receive_timeout(cl_com_get_handle(component_get_component_name(), 0),ed_time*2);
+   }
 
    while (!stop_ec) {
       /* read events and add relevant information into library session data */
-      int ec_get_ret = evc->ec_get(evc, &event_list, false);
+      int ec_get_ret;
+      if (relay_path != nullptr) {
+         ec_get_ret = japi_relay_get(relay_path, &relay_fd, &relay_resync, up_and_running ? 1000 : 0, &event_list);
+      } else {
+         ec_get_ret = evc->ec_get(evc, &event_list, false);
+      }
       if (!ec_get_ret) {
-         evc->ec_mark4registration(evc);
+         if (evc != nullptr) {
+            evc->ec_mark4registration(evc);
+         }
          
          DPRINTF (("Sleeping 10 seconds before trying to register again.\n"));
          sleep(10);
@@ -4221,12 +4673,9 @@ static void *japi_implementation_thread(void * a_user_data_pointer)
 
                   if (!(sge_job = lGetElemUlongRW(sge_job_list, JB_job_number, jobid))) {
                      while ((taskid = range_list_get_first_id(lGetList(japi_job, JJ_not_yet_finished_ids), nullptr))) {
-                        /* remove task from not yet finished job id list */
-                        object_delete_range_id(japi_job, nullptr, JJ_not_yet_finished_ids, taskid);
-
-                        /* add entry to the finished tasks */
+                        /* move task from not yet finished job id list to the finished tasks */
                         DPRINTF("adding finished task " sge_u32" for job " sge_u32" existing not any longer\n", taskid, jobid);
-                        lAddSubUlong(japi_job, JJAT_task_id, taskid, JJ_finished_tasks, JJAT_Type);
+                        japi_finish_task(japi_job, taskid);
                         finished_tasks++;
 
                      } /* while */
@@ -4249,6 +4698,9 @@ static void *japi_implementation_thread(void * a_user_data_pointer)
                   lSetUlong(japi_job, JJ_type, lGetUlong(sge_job, JB_type));
                   lXchgList(sge_job, JB_ja_structure, &task_list);
                   lSetList(japi_job, JJ_not_yet_finished_ids, task_list);
+                  if (lGetList(japi_job, JJ_not_yet_finished_ids) != nullptr) {
+                     japi_unfinished_jobs++;
+                  }
                   finished_tasks = japi_sync_job_tasks (japi_job, sge_job);
                }
 
@@ -4288,12 +4740,9 @@ static void *japi_implementation_thread(void * a_user_data_pointer)
                   if (range_list_is_id_within(lGetList(japi_job, JJ_not_yet_finished_ids), intkey2)) {
                      const lList *usage = nullptr;
 
-                     /* remove task from not yet finished job id list */
-                     object_delete_range_id(japi_job, nullptr, JJ_not_yet_finished_ids, intkey2);
-
-                     /* add an entry to the finished tasks */
+                     /* move task from not yet finished job id list to the finished tasks */
                      DPRINTF("adding finished task %ld for job %ld\n", intkey2, intkey);
-                     japi_task = lAddSubUlong(japi_job, JJAT_task_id, intkey2, JJ_finished_tasks, JJAT_Type);
+                     japi_task = japi_finish_task(japi_job, intkey2);
                      lSetUlong(japi_task, JJAT_stat, wait_status);
                      lSetString(japi_task, JJAT_failed_text, err_str);
 
@@ -4446,12 +4895,19 @@ static void *japi_implementation_thread(void * a_user_data_pointer)
       }
    } /* while */
 
-   /* Unregister event client */
-   DPRINTF("unregistering from qmaster ...\n");
-   if (evc->ec_deregister(evc)==FALSE) {
-      DPRINTF("failed unregistering event client from qmaster.\n");
+   if (relay_path != nullptr) {
+      DPRINTF("disconnecting from DRMAA relay\n");
+      if (relay_fd >= 0) {
+         close(relay_fd);
+      }
    } else {
-      DPRINTF("... unregistered.\n");
+      /* Unregister event client */
+      DPRINTF("unregistering from qmaster ...\n");
+      if (evc->ec_deregister(evc)==FALSE) {
+         DPRINTF("failed unregistering event client from qmaster.\n");
+      } else {
+         DPRINTF("... unregistered.\n");
+      }
    }
 
    JAPI_LOCK_EC_STATE();
@@ -4565,12 +5021,9 @@ static int japi_sync_job_tasks(lListElem *japi_job, lListElem *sge_job)
             DPRINTF("task " sge_u32"." sge_u32" presumably has finished meanwhile\n", lGetUlong(japi_job, JJ_jobid), taskid);
          }
 
-         /* remove task from not yet finished job id list */
-         object_delete_range_id(japi_job, nullptr, JJ_not_yet_finished_ids,
-                                taskid);
-         /* add entry to the finished tasks */
+         /* move task from not yet finished job id list to the finished tasks */
          DPRINTF("adding finished task %ld for job %ld which still exists\n", taskid, lGetUlong(japi_job, JJ_jobid));
-         lAddSubUlong(japi_job, JJAT_task_id, taskid, JJ_finished_tasks, JJAT_Type);
+         japi_finish_task(japi_job, taskid);
          finished_tasks++;
       } /* for */
    } /* for_each */
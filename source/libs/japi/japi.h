@@ -50,6 +50,7 @@
 *     JAPI/japi_exit()
 *     JAPI/japi_run_job()
 *     JAPI/japi_run_bulk_jobs()
+*     JAPI/japi_run_job_list()
 *     JAPI/japi_control()
 *     JAPI/japi_synchronize()
 *     JAPI/japi_wait()
@@ -152,6 +153,13 @@ int japi_run_job(dstring *jobid, lListElem **sge_job_template, dstring *diag);
 
 int japi_run_bulk_jobs(drmaa_attr_values_t **values, lListElem **sge_job_template, int start, int end, int incr, dstring *diag);
 
+/*
+ * Submit all jobs of the list 'sge_job_templates' with one request.
+ * One job id per job is returned in 'values', the job id of a job which
+ * was rejected is an empty string.
+ */
+int japi_run_job_list(drmaa_attr_values_t **values, lList **sge_job_templates, dstring *diag);
+
 /* ------------------- job control routines ------------------- */
 
 /*
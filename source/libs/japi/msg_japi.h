@@ -54,3 +54,10 @@
 #define MSG_JAPI_BAD_JOB_ID_S  _MESSAGE(45518, _("Job id, " SFQ ", is not a valid job id"))
 #define MSG_JAPI_BAD_BULK_JOB_ID_S  _MESSAGE(45519, _("Job id, " SFQ ", is not a valid bulk job id"))
 #define MSG_JAPI_QMASTER_TIMEDOUT _MESSAGE(45520, _("Timed out at qmaster. Waiting to reconnect."))
+#define MSG_JAPI_RELAY_PATH_TOO_LONG_S _MESSAGE(45521, _("Socket path of the DRMAA relay is too long: " SFQ))
+#define MSG_JAPI_RELAY_SOCKET_SS _MESSAGE(45522, _("Cannot open socket " SFQ " of the DRMAA relay: " SFN))
+#define MSG_JAPI_RELAY_REGISTER_S _MESSAGE(45523, _("Cannot register at the DRMAA relay " SFQ))
+#define MSG_JAPI_RELAY_USAGE _MESSAGE(45524, _("usage: sge_drmaa_relay [-help] [socket_path]"))
+#define MSG_JAPI_RELAY_NO_SOCKET_S _MESSAGE(45525, _("No socket path given and " SFN " is not set"))
+#define MSG_JAPI_RELAY_LISTENING_S _MESSAGE(45526, _("DRMAA relay listening on " SFQ))
+#define MSG_JAPI_RELAY_CLIENT_LOST_S _MESSAGE(45527, _("Lost connection to DRMAA session " SFQ))
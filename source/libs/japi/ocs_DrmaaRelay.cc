@@ -0,0 +1,252 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include "uti/sge_io.h"
+#include "uti/sge_stdlib.h"
+
+#include "cull/cull_pack.h"
+
+#include "sgeobj/sge_answer.h"
+
+#include "japi/msg_japi.h"
+#include "japi/ocs_DrmaaRelay.h"
+
+// upper limit for the size of a message, protects against reading garbage
+#define MAX_MESSAGE_SIZE (256 * 1024 * 1024)
+
+/** @brief Returns the socket path of the relay to be used by DRMAA sessions
+ *
+ * @return the value of SGE_DRMAA_RELAY or nullptr if no relay shall be used
+ */
+const char *
+ocs::DrmaaRelay::get_socket_path() {
+   const char *path = getenv(SOCKET_ENV);
+
+   if (path == nullptr || *path == '\0') {
+      return nullptr;
+   }
+   return path;
+}
+
+/** @brief Creates the listening socket of the relay
+ *
+ * The socket can only be used by the owner of the relay process. A socket file
+ * left over by a relay which terminated without cleaning up is replaced,
+ * a socket of a running relay is not.
+ *
+ * @param path socket path
+ * @param answer_list gets the error messages
+ * @return the socket or -1 on error
+ */
+int
+ocs::DrmaaRelay::listen(const char *path, lList **answer_list) {
+   struct sockaddr_un addr{};
+
+   if (strlen(path) >= sizeof(addr.sun_path)) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_PATH_TOO_LONG_S, path);
+      return -1;
+   }
+   addr.sun_family = AF_UNIX;
+   strcpy(addr.sun_path, path);
+
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_SOCKET_SS, path, strerror(errno));
+      return -1;
+   }
+
+   if (::connect(fd, (struct sockaddr *) &addr, sizeof(addr)) == 0) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_SOCKET_SS, path, strerror(EADDRINUSE));
+      close(fd);
+      return -1;
+   }
+   unlink(path);
+
+   // the socket file gets the permissions from the umask, only the owner may connect
+   mode_t old_mask = umask(077);
+   int ret = bind(fd, (struct sockaddr *) &addr, sizeof(addr));
+   umask(old_mask);
+   if (ret != 0 || ::listen(fd, SOMAXCONN) != 0) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_SOCKET_SS, path, strerror(errno));
+      close(fd);
+      return -1;
+   }
+
+   return fd;
+}
+
+/** @brief Connects a DRMAA session to the relay
+ *
+ * @param path socket path
+ * @param session session key of the DRMAA session
+ * @param answer_list gets the error messages
+ * @return the connected socket or -1 on error
+ */
+int
+ocs::DrmaaRelay::connect(const char *path, const char *session, lList **answer_list) {
+   struct sockaddr_un addr{};
+
+   if (strlen(path) >= sizeof(addr.sun_path)) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_PATH_TOO_LONG_S, path);
+      return -1;
+   }
+   addr.sun_family = AF_UNIX;
+   strcpy(addr.sun_path, path);
+
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0 || ::connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_SOCKET_SS, path, strerror(errno));
+      if (fd >= 0) {
+         close(fd);
+      }
+      return -1;
+   }
+   set_io_timeout(fd);
+
+   // the relay acknowledges the registration with an empty event list
+   lList *ack = nullptr;
+   if (!send_session(fd, session) || !receive_events(fd, &ack)) {
+      answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, ANSWER_QUALITY_ERROR, MSG_JAPI_RELAY_REGISTER_S, path);
+      close(fd);
+      return -1;
+   }
+   lFreeList(&ack);
+
+   return fd;
+}
+
+/** @brief Sends the session key of a DRMAA session to the relay */
+bool
+ocs::DrmaaRelay::send_session(int fd, const char *session) {
+   sge_pack_buffer pb;
+   bool ret = false;
+
+   if (init_packbuffer(&pb, 256, 0) == PACK_SUCCESS) {
+      ret = packstr(&pb, session) == PACK_SUCCESS && send_buffer(fd, &pb);
+      clear_packbuffer(&pb);
+   }
+   return ret;
+}
+
+/** @brief Receives the session key of a newly connected DRMAA session
+ *
+ * Sets a timeout for reading and writing on the socket, a session which
+ * does not register in time or does not read its events is disconnected.
+ */
+bool
+ocs::DrmaaRelay::receive_session(int fd, std::string &session) {
+   sge_pack_buffer pb;
+   char *str = nullptr;
+   bool ret = false;
+
+   set_io_timeout(fd);
+   if (receive_buffer(fd, &pb)) {
+      if (unpackstr(&pb, &str) == PACK_SUCCESS && str != nullptr && *str != '\0') {
+         session = str;
+         ret = true;
+      }
+      sge_free(&str);
+      clear_packbuffer(&pb);
+   }
+   return ret;
+}
+
+/** @brief Sends a list of events (ET_Type) */
+bool
+ocs::DrmaaRelay::send_events(int fd, const lList *event_list) {
+   sge_pack_buffer pb;
+   bool ret = false;
+
+   if (init_packbuffer(&pb, 1024, 0) == PACK_SUCCESS) {
+      ret = cull_pack_list(&pb, event_list) == PACK_SUCCESS && send_buffer(fd, &pb);
+      clear_packbuffer(&pb);
+   }
+   return ret;
+}
+
+/** @brief Receives a list of events (ET_Type)
+ *
+ * @param fd connected socket
+ * @param event_list gets the events, the list may be empty
+ * @return false if the connection is broken
+ */
+bool
+ocs::DrmaaRelay::receive_events(int fd, lList **event_list) {
+   sge_pack_buffer pb;
+   bool ret = false;
+
+   if (receive_buffer(fd, &pb)) {
+      ret = cull_unpack_list(&pb, event_list) == PACK_SUCCESS;
+      clear_packbuffer(&pb);
+   }
+   return ret;
+}
+
+void
+ocs::DrmaaRelay::set_io_timeout(int fd) {
+   struct timeval tv{IO_TIMEOUT, 0};
+
+   setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+   setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool
+ocs::DrmaaRelay::send_buffer(int fd, sge_pack_buffer *pb) {
+   int size = pb_used(pb);
+   u_long32 header = htonl((u_long32) size);
+
+   return sge_writenbytes(fd, (const char *) &header, sizeof(header)) == sizeof(header) &&
+          sge_writenbytes(fd, pb->head_ptr, size) == size;
+}
+
+bool
+ocs::DrmaaRelay::receive_buffer(int fd, sge_pack_buffer *pb) {
+   u_long32 header;
+
+   if (sge_readnbytes(fd, (char *) &header, sizeof(header)) != sizeof(header)) {
+      return false;
+   }
+   u_long32 size = ntohl(header);
+   if (size == 0 || size > MAX_MESSAGE_SIZE) {
+      return false;
+   }
+
+   char *buf = sge_malloc(size);
+   if (sge_readnbytes(fd, buf, (int) size) != (int) size) {
+      sge_free(&buf);
+      return false;
+   }
+   // the pack buffer owns buf now
+   if (init_packbuffer_from_buffer(pb, buf, size) != PACK_SUCCESS) {
+      sge_free(&buf);
+      return false;
+   }
+   return true;
+}
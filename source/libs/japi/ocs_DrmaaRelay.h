@@ -0,0 +1,61 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <string>
+
+#include "cull/cull.h"
+#include "cull/pack.h"
+
+namespace ocs {
+   /** @brief Connection between sge_drmaa_relay and the DRMAA library
+    *
+    * sge_drmaa_relay holds one event client at qmaster for all DRMAA sessions of a
+    * user on a host. The sessions connect to the relay through a Unix domain socket,
+    * register with their session key and receive the job finish and task start
+    * events of their jobs instead of registering an own event client.
+    *
+    * Every message is a CULL pack buffer preceded by its size as 4 byte integer in
+    * network byte order. A session sends its session key once after connecting,
+    * the relay answers with an empty event list and afterwards sends lists of events.
+    * A sgeE_JOB_LIST event without a job list tells the session to fetch its jobs
+    * from qmaster again, e.g. after the relay had to register again at qmaster.
+    */
+   class DrmaaRelay {
+   public:
+      static constexpr const char *SOCKET_ENV = "SGE_DRMAA_RELAY"; ///< socket path of the relay
+      static constexpr int IO_TIMEOUT = 10; ///< seconds a blocked read or write may take
+
+      static const char *get_socket_path();
+
+      static int listen(const char *path, lList **answer_list);
+      static int connect(const char *path, const char *session, lList **answer_list);
+
+      static bool send_session(int fd, const char *session);
+      static bool receive_session(int fd, std::string &session);
+      static bool send_events(int fd, const lList *event_list);
+      static bool receive_events(int fd, lList **event_list);
+
+   private:
+      static void set_io_timeout(int fd);
+      static bool send_buffer(int fd, sge_pack_buffer *pb);
+      static bool receive_buffer(int fd, sge_pack_buffer *pb);
+   };
+}
@@ -0,0 +1,201 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <unistd.h>
+
+#include "uti/sge_log.h"
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_event.h"
+
+#include "japi/msg_japi.h"
+#include "japi/ocs_DrmaaRelay.h"
+#include "japi/ocs_DrmaaRelaySessions.h"
+
+namespace {
+   void
+   add_event(lList **event_list, const lListElem *event) {
+      if (*event_list == nullptr) {
+         *event_list = lCreateList("events", ET_Type);
+      }
+      lAppendElem(*event_list, lCopyElem(event));
+   }
+}
+
+/** @brief Adds a session which registered at the relay
+ *
+ * @param session session key
+ * @param fd socket of the session, it is closed when the session is removed
+ */
+void
+ocs::DrmaaRelaySessions::add(const std::string &session, int fd) {
+   std::lock_guard<std::mutex> guard(mutex);
+   sessions.emplace(session, fd);
+}
+
+/** @brief Returns the sockets of all sessions
+ *
+ * @param fds gets the sockets appended
+ */
+void
+ocs::DrmaaRelaySessions::get_sockets(std::vector<int> &fds) {
+   std::lock_guard<std::mutex> guard(mutex);
+   for (const auto &session : sessions) {
+      fds.push_back(session.second);
+   }
+}
+
+/** @brief Removes the session using a socket and closes the socket
+ *
+ * @param fd socket of the session
+ */
+void
+ocs::DrmaaRelaySessions::close(int fd) {
+   std::lock_guard<std::mutex> guard(mutex);
+   for (auto it = sessions.begin(); it != sessions.end(); ++it) {
+      if (it->second == fd) {
+         close_session(it);
+         break;
+      }
+   }
+}
+
+/** @brief Removes all sessions and closes their sockets */
+void
+ocs::DrmaaRelaySessions::close_all() {
+   std::lock_guard<std::mutex> guard(mutex);
+   for (const auto &session : sessions) {
+      ::close(session.second);
+   }
+   sessions.clear();
+}
+
+/** @brief Passes events received from qmaster to the sessions
+ *
+ * sgeE_JOB_LIST and sgeE_JOB_ADD events tell which session a job belongs to.
+ * Job finish and task start events are sent to the session of the job only.
+ * sgeE_JOB_LIST is passed to all sessions without the job list, they have to
+ * fetch their jobs from qmaster again. Sessions whose socket cannot be written
+ * are removed.
+ *
+ * @param event_list events received from qmaster (ET_Type)
+ * @return true if the events contained sgeE_SHUTDOWN
+ */
+bool
+ocs::DrmaaRelaySessions::relay_events(const lList *event_list) {
+   std::map<std::string, lList *> session_events;
+   lList *all_events = nullptr;
+   const lListElem *event;
+   bool shutdown = false;
+
+   for_each_ep(event, event_list) {
+      u_long32 job_id = lGetUlong(event, ET_intkey);
+
+      switch (lGetUlong(event, ET_type)) {
+         case sgeE_JOB_LIST: {
+            lListElem *resync = lCreateElem(ET_Type);
+
+            job_sessions.clear();
+            remember_jobs(lGetList(event, ET_new_version));
+
+            // events got lost while the relay was not registered,
+            // the sessions have to fetch their jobs from qmaster
+            lSetUlong(resync, ET_type, sgeE_JOB_LIST);
+            add_event(&all_events, resync);
+            lFreeElem(&resync);
+            break;
+         }
+         case sgeE_JOB_ADD:
+            remember_jobs(lGetList(event, ET_new_version));
+            break;
+         case sgeE_JOB_DEL:
+            job_sessions.erase(job_id);
+            break;
+         case sgeE_JOB_FINISH:
+         case sgeE_JATASK_MOD: {
+            auto it = job_sessions.find(job_id);
+
+            if (it != job_sessions.end()) {
+               add_event(&session_events[it->second], event);
+            }
+            break;
+         }
+         case sgeE_SHUTDOWN:
+            shutdown = true;
+            add_event(&all_events, event);
+            break;
+         case sgeE_QMASTER_GOES_DOWN:
+            add_event(&all_events, event);
+            break;
+         default:
+            break;
+      }
+   }
+
+   if (all_events != nullptr || !session_events.empty()) {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      for (auto it = sessions.begin(); it != sessions.end();) {
+         auto events = session_events.find(it->first);
+         bool sent = true;
+
+         if (all_events != nullptr) {
+            sent = ocs::DrmaaRelay::send_events(it->second, all_events);
+         }
+         if (sent && events != session_events.end()) {
+            sent = ocs::DrmaaRelay::send_events(it->second, events->second);
+         }
+         if (sent) {
+            ++it;
+         } else {
+            it = close_session(it);
+         }
+      }
+   }
+
+   lFreeList(&all_events);
+   for (auto &events : session_events) {
+      lFreeList(&events.second);
+   }
+   return shutdown;
+}
+
+void
+ocs::DrmaaRelaySessions::remember_jobs(const lList *job_list) {
+   const lListElem *job;
+
+   for_each_ep(job, job_list) {
+      const char *session = lGetString(job, JB_session);
+
+      if (session != nullptr) {
+         job_sessions[lGetUlong(job, JB_job_number)] = session;
+      }
+   }
+}
+
+// the caller holds the mutex
+std::multimap<std::string, int>::iterator
+ocs::DrmaaRelaySessions::close_session(std::multimap<std::string, int>::iterator it) {
+   DENTER(TOP_LAYER);
+   INFO(MSG_JAPI_RELAY_CLIENT_LOST_S, it->first.c_str());
+   ::close(it->second);
+   DRETURN(sessions.erase(it));
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /** @brief DRMAA sessions connected to sge_drmaa_relay
+    *
+    * Keeps the sockets of the connected sessions and the session key of the
+    * jobs of the user. relay_events() passes the job finish and task start
+    * events to the session which submitted the job and events concerning
+    * all sessions, e.g. qmaster shutdown, to every session.
+    *
+    * Sessions are added by the accept thread and removed by both the accept
+    * thread and the event thread. The job sessions are only used by the
+    * event thread calling relay_events().
+    */
+   class DrmaaRelaySessions {
+   private:
+      std::mutex mutex;
+      std::multimap<std::string, int> sessions; ///< session key -> socket
+      std::unordered_map<u_long32, std::string> job_sessions; ///< job id -> session key
+
+      void remember_jobs(const lList *job_list);
+      std::multimap<std::string, int>::iterator close_session(std::multimap<std::string, int>::iterator it);
+
+   public:
+      void add(const std::string &session, int fd);
+      void get_sockets(std::vector<int> &fds);
+      void close(int fd);
+      void close_all();
+      bool relay_events(const lList *event_list);
+   };
+}
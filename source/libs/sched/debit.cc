@@ -271,8 +271,9 @@ debit_job_from_hosts(lListElem *job, lListElem *ja_task, const lListElem *pe, lL
    lListElem *hep;
    lListElem *global;
    const char *hnm = nullptr;
-   const char *load_formula = nullptr;
-   u_long64 load_adjustment_decay_time = sge_gmt32_to_gmt64(sconf_get_load_adjustment_decay_time());
+   auto sconf = sconf_get_snapshot();
+   const char *load_formula = sconf->load_formula.empty() ? nullptr : sconf->load_formula.c_str();
+   u_long64 load_adjustment_decay_time = sge_gmt32_to_gmt64(sconf->load_adjustment_decay_time);
    bool is_master_task = true;
 
    double old_sort_value, new_sort_value;
@@ -283,8 +284,6 @@ debit_job_from_hosts(lListElem *job, lListElem *ja_task, const lListElem *pe, lL
 
    global = host_list_locate(host_list, "global");
 
-   load_formula = sconf_get_load_formula();
-
    /* debit from hosts */
    const lListElem *gdil_ep;
    const char *last_hostname = nullptr;
@@ -323,7 +322,6 @@ debit_job_from_hosts(lListElem *job, lListElem *ja_task, const lListElem *pe, lL
       lResortElem(so, hep, host_list);
    }
 
-   sge_free(&load_formula);
    lFreeSortOrder(&so);
 
    DRETURN(0);
@@ -352,6 +350,9 @@ debit_host_consumable(const lListElem *jep, const lListElem *jatep, const lListE
                                lGetHost(hep, EH_name), is_master_task, do_per_host_booking, just_check);
    if (jep != nullptr && jatep != nullptr) {
       mods += ja_task_debit_host_rsmaps(jatep, hep, slots, just_check);
+      if (do_per_host_booking) {
+         mods += ja_task_debit_host_binding(jatep, hep, slots, just_check);
+      }
    }
    return mods;
 }
@@ -0,0 +1,138 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <limits>
+
+#include "uti/sge_parse_num_par.h"
+
+#include "sgeobj/cull/sge_centry_CE_L.h"
+#include "sgeobj/cull/sge_host_EH_L.h"
+#include "sgeobj/cull/sge_resource_utilization_RUE_L.h"
+#include "sgeobj/sge_centry.h"
+
+#include "ocs_ResourceMatrix.h"
+
+/** @brief Builds the matrix from the hosts of a scheduling run
+ *
+ * A capacity is only taken over if the host also has a utilization entry
+ * for the consumable, otherwise the dispatch code does not check
+ * the consumable on host level.
+ *
+ * @param host_list the execution hosts (EH_Type)
+ * @param centry_list the complex attributes (CE_Type)
+ */
+void ocs::ResourceMatrix::build(const lList *host_list, const lList *centry_list) {
+   clear();
+
+   const lListElem *hep;
+   size_t row = 0;
+   for_each_ep(hep, host_list) {
+      rows.emplace(hep, row++);
+   }
+
+   const double unlimited = std::numeric_limits<double>::infinity();
+   row = 0;
+   for_each_ep(hep, host_list) {
+      const lList *actual_attr = lGetList(hep, EH_resource_utilization);
+      const lListElem *cep;
+
+      for_each_ep(cep, lGetList(hep, EH_consumable_config_list)) {
+         const char *name = lGetString(cep, CE_name);
+         auto it = columns.find(name);
+
+         if (it == columns.end()) {
+            const lListElem *centry = lGetElemStr(centry_list, CE_name, name);
+            if (centry == nullptr || lGetUlong(centry, CE_consumable) == CONSUMABLE_NO) {
+               continue;
+            }
+            u_long32 relop = lGetUlong(centry, CE_relop);
+            if (relop != CMPLXLE_OP && relop != CMPLXLT_OP) {
+               continue;
+            }
+            it = columns.emplace(name, capacity.size()).first;
+            capacity.emplace_back(rows.size(), unlimited);
+         }
+         if (lGetElemStr(actual_attr, RUE_name, name) != nullptr) {
+            capacity[it->second][row] = lGetDouble(cep, CE_doubleval);
+         }
+      }
+      row++;
+   }
+}
+
+void ocs::ResourceMatrix::clear() {
+   columns.clear();
+   rows.clear();
+   capacity.clear();
+}
+
+/** @brief Finds the hosts which can never serve the requests of a job
+ *
+ * @param requests the resource requests of the job (CE_Type)
+ * @param centry_list the complex attributes (CE_Type)
+ * @param slots the number of slots requested on a host
+ * @param rejected out: per row of the matrix a non-zero value for rejected hosts
+ * @return true if the requests could be checked, false if none of them refers
+ *         to a column of the matrix and no host is rejected
+ */
+bool ocs::ResourceMatrix::reject_hosts(const lList *requests, const lList *centry_list, int slots,
+                                       std::vector<unsigned char> &rejected) const {
+   bool checked = false;
+   size_t n = rows.size();
+
+   rejected.assign(n, 0);
+
+   const lListElem *rep;
+   for_each_ep(rep, requests) {
+      const char *name = lGetString(rep, CE_name);
+      auto it = columns.find(name);
+      if (it == columns.end()) {
+         continue;
+      }
+
+      // same conversion as done in ri_time_by_slots(), but only once per job
+      const lListElem *centry = lGetElemStr(centry_list, CE_name, name);
+      double request;
+      if (centry == nullptr ||
+          !parse_ulong_val(&request, nullptr, lGetUlong(centry, CE_valtype), lGetString(rep, CE_stringval), nullptr, 0)) {
+         continue;
+      }
+
+      double amount = request * slots;
+      const double *cap = capacity[it->second].data();
+      unsigned char *rej = rejected.data();
+      for (size_t i = 0; i < n; i++) {
+         rej[i] |= cap[i] < amount;
+      }
+      checked = true;
+   }
+
+   return checked;
+}
+
+/** @brief Returns if a host was rejected by reject_hosts()
+ *
+ * Hosts which were not part of the host list the matrix was built from are never rejected.
+ */
+bool ocs::ResourceMatrix::is_rejected(const std::vector<unsigned char> &rejected, const lListElem *hep) const {
+   auto it = rows.find(hep);
+   return it != rows.end() && it->second < rejected.size() && rejected[it->second] != 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /** @brief Columnar view on the consumable capacities of the execution hosts
+    *
+    * The matrix holds one column per consumable complex attribute which is
+    * configured on at least one host, and one row per host of the host list
+    * it is built from. A cell holds the capacity of the consumable on the host
+    * (CE_doubleval of EH_consumable_config_list) or infinity if the host does
+    * not limit the consumable.
+    *
+    * Capacities do not change while the scheduler dispatches jobs, therefore the
+    * matrix is built once per scheduling run. Per job all hosts which can never
+    * serve one of the requested amounts are found by a few passes over contiguous
+    * arrays, instead of evaluating the request on every host one by one.
+    * Only consumables with relational operator <= or < are considered, for them
+    * a request exceeding the capacity is rejected by every layer of the
+    * dispatch code (see ri_time_by_slots()).
+    */
+   class ResourceMatrix {
+      std::unordered_map<std::string, size_t> columns;
+      std::unordered_map<const lListElem *, size_t> rows;
+      std::vector<std::vector<double>> capacity;
+
+   public:
+      void build(const lList *host_list, const lList *centry_list);
+      void clear();
+
+      size_t num_hosts() const {
+         return rows.size();
+      }
+
+      size_t num_columns() const {
+         return capacity.size();
+      }
+
+      bool reject_hosts(const lList *requests, const lList *centry_list, int slots,
+                        std::vector<unsigned char> &rejected) const;
+      bool is_rejected(const std::vector<unsigned char> &rejected, const lListElem *hep) const;
+   };
+}
@@ -0,0 +1,126 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include "uti/sge_hostname.h"
+
+#include "sgeobj/cull/sge_resource_quota_RQR_L.h"
+#include "sgeobj/cull/sge_resource_quota_RQRF_L.h"
+
+#include "ocs_RqsLimitIndex.h"
+
+size_t ocs::RqsLimitIndex::KeyHash::operator()(const Key &key) const {
+   size_t hash = std::hash<const lListElem *>{}(key.rule);
+
+   for (u_long32 id : {key.user, key.project, key.pe, key.queue, key.host}) {
+      hash ^= id + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+   }
+   return hash;
+}
+
+/** @brief Returns the id of a user, project, pe or queue name
+ *
+ * Names are compared case-sensitive like in the rue string.
+ * Ids are never 0, 0 is used for names a rule does not expand.
+ */
+u_long32 ocs::RqsLimitIndex::name_id(const char *name) {
+   auto it = names.find(std::string_view(name));
+   if (it != names.end()) {
+      return it->second;
+   }
+   u_long32 id = names.size() + 1;
+   names.emplace(name, id);
+   return id;
+}
+
+/** @brief Returns the id of a host name
+ *
+ * Host names are resolved with sge_hostcpy() like in rqs_get_rue_string(), but only
+ * the first time a certain spelling is seen.
+ * All spellings of a host resolving to the same name share the same id.
+ */
+u_long32 ocs::RqsLimitIndex::host_id(const char *host) {
+   auto it = hosts.find(std::string_view(host));
+   if (it != hosts.end()) {
+      return it->second;
+   }
+
+   char buffer[CL_MAXHOSTNAMELEN + 1];
+   sge_hostcpy(buffer, host);
+   auto resolved = resolved_hosts.find(std::string_view(buffer));
+   u_long32 id;
+   if (resolved != resolved_hosts.end()) {
+      id = resolved->second;
+   } else {
+      id = resolved_hosts.size() + 1;
+      resolved_hosts.emplace(buffer, id);
+   }
+   hosts.emplace(host, id);
+   return id;
+}
+
+/** @brief Creates the key for the limit of a rule
+ *
+ * The key identifies the same tuple as the string created by
+ * rqs_get_rue_string() together with the rule: only names the
+ * rule filter expands are part of the key.
+ *
+ * @param rule    resource quota rule (RQR_Type)
+ * @param user    user name
+ * @param project project name
+ * @param host    host name
+ * @param queue   cluster queue name
+ * @param pe      pe name
+ * @return the key
+ */
+ocs::RqsLimitIndex::Key
+ocs::RqsLimitIndex::make_key(const lListElem *rule, const char *user, const char *project, const char *host,
+                             const char *queue, const char *pe) {
+   Key key{rule, 0, 0, 0, 0, 0};
+   const lListElem *filter;
+
+   if (user != nullptr && (filter = lGetObject(rule, RQR_filter_users)) != nullptr && lGetBool(filter, RQRF_expand)) {
+      key.user = name_id(user);
+   }
+   if (project != nullptr && (filter = lGetObject(rule, RQR_filter_projects)) != nullptr && lGetBool(filter, RQRF_expand)) {
+      key.project = name_id(project);
+   }
+   if (pe != nullptr && (filter = lGetObject(rule, RQR_filter_pes)) != nullptr && lGetBool(filter, RQRF_expand)) {
+      key.pe = name_id(pe);
+   }
+   if (queue != nullptr && (filter = lGetObject(rule, RQR_filter_queues)) != nullptr && lGetBool(filter, RQRF_expand)) {
+      key.queue = name_id(queue);
+   }
+   if (host != nullptr && (filter = lGetObject(rule, RQR_filter_hosts)) != nullptr && lGetBool(filter, RQRF_expand)) {
+      key.host = host_id(host);
+   }
+
+   return key;
+}
+
+/** @brief Returns the cached limit (RQL_Type) for a key or nullptr */
+lListElem *ocs::RqsLimitIndex::find(const Key &key) const {
+   auto it = index.find(key);
+   return it != index.end() ? it->second : nullptr;
+}
+
+/** @brief Registers a limit (RQL_Type) of the limit list under a key */
+void ocs::RqsLimitIndex::add(const Key &key, lListElem *rql) {
+   index[key] = rql;
+}
@@ -0,0 +1,84 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /** @brief Hash index on the resource quota limit cache of an assignment
+    *
+    * The scheduler caches the result of resource quota checks in the limit list
+    * of an assignment (RQL_Type). Elements of this list are identified by the matching
+    * rule and the user, project, pe, queue and host names the rule expands to, which
+    * rqs_get_rue_string() concatenates to a string.
+    *
+    * RqsLimitIndex identifies the same tuple by a compact key of interned name ids
+    * and maps it to the RQL_Type element, so that the lookup in the innermost
+    * dispatch loops does neither build nor compare strings.
+    * Names a rule does not expand are represented by id 0, so the key is shared by
+    * all tuples that map to the same rue string.
+    */
+   class RqsLimitIndex {
+   public:
+      struct Key {
+         const lListElem *rule;
+         u_long32 user;
+         u_long32 project;
+         u_long32 pe;
+         u_long32 queue;
+         u_long32 host;
+
+         bool operator==(const Key &other) const = default;
+      };
+
+   private:
+      struct KeyHash {
+         size_t operator()(const Key &key) const;
+      };
+
+      struct NameHash {
+         using is_transparent = void;
+         size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+         }
+      };
+
+      using NameMap = std::unordered_map<std::string, u_long32, NameHash, std::equal_to<>>;
+
+      NameMap names;
+      NameMap hosts;
+      NameMap resolved_hosts;
+      std::unordered_map<Key, lListElem *, KeyHash> index;
+
+      u_long32 name_id(const char *name);
+      u_long32 host_id(const char *host);
+
+   public:
+      Key make_key(const lListElem *rule, const char *user, const char *project, const char *host,
+                   const char *queue, const char *pe);
+      lListElem *find(const Key &key) const;
+      void add(const Key &key, lListElem *rql);
+   };
+}
@@ -0,0 +1,75 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+#include "sge_pe_schedd.h"
+
+#include "ocs_SlotCapacityIndex.h"
+
+/** @brief Adds the slots a host can offer
+ *
+ * Values below 0 are stored as 0, values above INT_MAX as INT_MAX (no limit).
+ * finish() must be called after the last host was added.
+ */
+void ocs::SlotCapacityIndex::add_host(long long slots) {
+   host_slots.push_back(static_cast<int>(std::clamp(slots, 0LL, static_cast<long long>(INT_MAX))));
+}
+
+/** @brief Sorts the hosts and accumulates their slots */
+void ocs::SlotCapacityIndex::finish() {
+   std::sort(host_slots.begin(), host_slots.end(), std::greater<>());
+
+   long long accu = 0;
+   accu_slots.clear();
+   accu_slots.reserve(host_slots.size());
+   for (int slots : host_slots) {
+      accu += slots;
+      accu_slots.push_back(accu);
+   }
+}
+
+/** @brief Returns the number of hosts offering at least the given number of slots */
+size_t ocs::SlotCapacityIndex::hosts_offering(int slots) const {
+   // host_slots is sorted descending, find the first host offering less
+   auto it = std::upper_bound(host_slots.begin(), host_slots.end(), slots, std::greater<>());
+   return it - host_slots.begin();
+}
+
+/** @brief Checks if the hosts could offer a slot count with an allocation rule
+ *
+ * @param slots the slot count of the parallel job
+ * @param allocation_rule the allocation rule as returned by sge_pe_slots_per_host()
+ * @return false if the slot count can certainly not be assigned
+ */
+bool ocs::SlotCapacityIndex::is_possible(int slots, int allocation_rule) const {
+   if (allocation_rule == ALLOC_RULE_FILLUP || allocation_rule == ALLOC_RULE_ROUNDROBIN) {
+      return total_slots() >= slots;
+   }
+   if (ALLOC_RULE_IS_BALANCED(allocation_rule)) {
+      // a fixed number of slots on each host, with $pe_slots all slots on one host
+      return static_cast<long long>(hosts_offering(allocation_rule)) * allocation_rule >= slots;
+   }
+   // the allocation rule cannot be applied to the slot count, leave the decision to the assignment
+   return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <vector>
+
+namespace ocs {
+   /** @brief Upper bound of the slots the hosts can offer to a parallel job
+    *
+    * The index holds per host the maximum number of slots a parallel job can get
+    * on the host, sorted descending, and the accumulated slots of the hosts.
+    * With it the search for the highest possible slot count of a slot range
+    * can decide without tagging hosts and queues that a certain slot count
+    * cannot be assigned with a given allocation rule.
+    *
+    * The index is only a necessary condition: if is_possible() returns true the
+    * full assignment still has to be done.
+    */
+   class SlotCapacityIndex {
+      std::vector<int> host_slots;
+      std::vector<long long> accu_slots;
+
+   public:
+      void add_host(long long slots);
+      void finish();
+
+      size_t num_hosts() const {
+         return host_slots.size();
+      }
+
+      long long total_slots() const {
+         return accu_slots.empty() ? 0 : accu_slots.back();
+      }
+
+      size_t hosts_offering(int slots) const;
+      bool is_possible(int slots, int allocation_rule) const;
+   };
+}
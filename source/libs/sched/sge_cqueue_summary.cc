@@ -0,0 +1,339 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include "uti/sge_parse_num_par.h"
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_time.h"
+
+#include "sgeobj/cull/sge_cqueue_CQS_L.h"
+#include "sgeobj/cull/sge_resource_utilization_RUE_L.h"
+#include "sgeobj/sge_cqueue.h"
+#include "sgeobj/sge_host.h"
+#include "sgeobj/sge_qinstance.h"
+#include "sgeobj/sge_qinstance_state.h"
+
+#include "sched/load_correction.h"
+#include "sched/sge_resource_utilization.h"
+#include "sched/sge_select_queue.h"
+#include "sched/sge_cqueue_summary.h"
+
+/****** sched/cqueue_summary/qinstance_slots_reserved_now() ********************
+ *  NAME
+ *     qinstance_slots_reserved_now() -- get current reserved slots
+ *
+ *  SYNOPSIS
+ *     int qinstance_slots_reserved_now(const lListElem *this_elem)
+ *
+ *  FUNCTION
+ *     returns the current number of reserved slots
+ *
+ *  INPUTS
+ *     const lListElem *this_elem - queue elem (QU_Type)
+ *
+ *  RESULT
+ *     int - number of currently reserved slots
+ *
+ *  NOTES
+ *     MT-NOTE: qinstance_slots_reserved_now() is MT safe
+ *
+ *  SEE ALSO
+ *     qinstance_slots_reserved()
+ *******************************************************************************/
+int qinstance_slots_reserved_now(const lListElem *this_elem) {
+   DENTER(TOP_LAYER);
+   int ret = 0;
+   const lListElem *slots = lGetSubStr(this_elem, RUE_name, SGE_ATTR_SLOTS, QU_resource_utilization);
+   if (slots != nullptr) {
+      u_long64 now = sge_get_gmt64();
+      ret = utilization_max(slots, now, 0, false);
+   }
+   DRETURN(ret);
+}
+
+/*
+ * Evaluate the load and suspend alarm of a queue instance without modifying it.
+ * Clients set the alarm states in their local copy (see select_by_queue_state()), within
+ * sge_qmaster the queue instance belongs to a master list and must not be changed.
+ */
+static void
+qinstance_get_alarms(const lListElem *qinstance, const lList *exechost_list, const lList *centry_list,
+                     bool *is_alarm, bool *is_suspend_alarm) {
+   u_long32 interval;
+
+   *is_alarm = qinstance_state_is_alarm(qinstance) ||
+               sge_load_alarm(nullptr, 0, qinstance, lGetList(qinstance, QU_load_thresholds),
+                              exechost_list, centry_list, nullptr, true);
+
+   parse_ulong_val(nullptr, &interval, TYPE_TIM, lGetString(qinstance, QU_suspend_interval), nullptr, 0);
+   *is_suspend_alarm = qinstance_state_is_suspend_alarm(qinstance) ||
+                       (lGetUlong(qinstance, QU_nsuspend) != 0 && interval != 0 &&
+                        sge_load_alarm(nullptr, 0, qinstance, lGetList(qinstance, QU_suspend_thresholds),
+                                       exechost_list, centry_list, nullptr, false));
+}
+
+/*
+ * Fill the CQS_Type element summary with the summary of cqueue.
+ *
+ * If is_master_list is true then cqueue is part of a master list: the queue
+ * instances do not contain the alarm states, they are evaluated on the fly.
+ * exechost_list has to be prepared with correct_capacities() in both cases.
+ */
+static void
+cqueue_fill_summary(lListElem *summary, const lListElem *cqueue, const lList *exechost_list,
+                    const lList *centry_list, bool is_master_list) {
+   const lListElem *qinstance;
+   double load = 0.0;
+   double host_load_avg = 0.0;
+   u_long32 load_slots = 0;
+   u_long32 used_available = 0;
+   u_long32 used = 0, resv = 0, total = 0;
+   u_long32 available = 0, temp_disabled = 0, manual_intervention = 0;
+   u_long32 suspend_manual = 0, suspend_threshold = 0, suspend_on_subordinate = 0;
+   u_long32 suspend_calendar = 0, unknown = 0, load_alarm = 0;
+   u_long32 disabled_manual = 0, disabled_calendar = 0, ambiguous = 0;
+   u_long32 orphaned = 0, error = 0;
+
+   DENTER(TOP_LAYER);
+
+   for_each_ep(qinstance, lGetList(cqueue, CQ_qinstances)) {
+      u_long32 slots = lGetUlong(qinstance, QU_job_slots);
+      u_long32 used_slots = qinstance_slots_used(qinstance);
+      bool has_value_from_object;
+      bool is_alarm;
+      bool is_suspend_alarm;
+
+      used += used_slots;
+      resv += qinstance_slots_reserved_now(qinstance);
+      total += slots;
+
+      if (is_master_list) {
+         qinstance_get_alarms(qinstance, exechost_list, centry_list, &is_alarm, &is_suspend_alarm);
+      } else {
+         is_alarm = qinstance_state_is_alarm(qinstance);
+         is_suspend_alarm = qinstance_state_is_suspend_alarm(qinstance);
+      }
+
+      if (!sge_get_double_qattr(&host_load_avg, LOAD_ATTR_NP_LOAD_AVG, qinstance, exechost_list, centry_list,
+                                &has_value_from_object)) {
+         if (has_value_from_object) {
+            load_slots += slots;
+            load += host_load_avg * slots;
+         }
+      }
+
+      /*
+       * manual_intervention: cdsuE
+       * temp_disabled: aoACDS
+       */
+      if (qinstance_state_is_manual_suspended(qinstance) || qinstance_state_is_unknown(qinstance) ||
+          qinstance_state_is_manual_disabled(qinstance) || qinstance_state_is_ambiguous(qinstance) ||
+          qinstance_state_is_error(qinstance)) {
+         manual_intervention += slots;
+      } else if (is_alarm || qinstance_state_is_cal_disabled(qinstance) ||
+                 qinstance_state_is_orphaned(qinstance) || qinstance_state_is_susp_on_sub(qinstance) ||
+                 qinstance_state_is_cal_suspended(qinstance) || is_suspend_alarm) {
+         temp_disabled += slots;
+      } else {
+         available += slots;
+         used_available += used_slots;
+      }
+      if (qinstance_state_is_unknown(qinstance)) {
+         unknown += slots;
+      }
+      if (is_alarm) {
+         load_alarm += slots;
+      }
+      if (qinstance_state_is_manual_disabled(qinstance)) {
+         disabled_manual += slots;
+      }
+      if (qinstance_state_is_cal_disabled(qinstance)) {
+         disabled_calendar += slots;
+      }
+      if (qinstance_state_is_ambiguous(qinstance)) {
+         ambiguous += slots;
+      }
+      if (qinstance_state_is_orphaned(qinstance)) {
+         orphaned += slots;
+      }
+      if (qinstance_state_is_manual_suspended(qinstance)) {
+         suspend_manual += slots;
+      }
+      if (qinstance_state_is_susp_on_sub(qinstance)) {
+         suspend_on_subordinate += slots;
+      }
+      if (qinstance_state_is_cal_suspended(qinstance)) {
+         suspend_calendar += slots;
+      }
+      if (is_suspend_alarm) {
+         suspend_threshold += slots;
+      }
+      if (qinstance_state_is_error(qinstance)) {
+         error += slots;
+      }
+   }
+   if (load_slots > 0) {
+      load /= load_slots;
+   }
+
+   lSetString(summary, CQS_name, lGetString(cqueue, CQ_name));
+   lSetDouble(summary, CQS_load, load);
+   lSetBool(summary, CQS_is_load_available, load_slots > 0);
+   lSetUlong(summary, CQS_used, used);
+   lSetUlong(summary, CQS_resv, resv);
+   lSetUlong(summary, CQS_total, total);
+   lSetUlong(summary, CQS_temp_disabled, temp_disabled);
+   lSetUlong(summary, CQS_available, available - used_available);
+   lSetUlong(summary, CQS_manual_intervention, manual_intervention);
+   lSetUlong(summary, CQS_suspend_manual, suspend_manual);
+   lSetUlong(summary, CQS_suspend_threshold, suspend_threshold);
+   lSetUlong(summary, CQS_suspend_on_subordinate, suspend_on_subordinate);
+   lSetUlong(summary, CQS_suspend_calendar, suspend_calendar);
+   lSetUlong(summary, CQS_unknown, unknown);
+   lSetUlong(summary, CQS_load_alarm, load_alarm);
+   lSetUlong(summary, CQS_disabled_manual, disabled_manual);
+   lSetUlong(summary, CQS_disabled_calendar, disabled_calendar);
+   lSetUlong(summary, CQS_ambiguous, ambiguous);
+   lSetUlong(summary, CQS_orphaned, orphaned);
+   lSetUlong(summary, CQS_error, error);
+
+   DRETURN_VOID;
+}
+
+/****** sched/cqueue_summary/cqueue_calculate_summary() ************************
+ *  NAME
+ *     cqueue_calculate_summary() -- slot summary of a cluster queue
+ *
+ *  SYNOPSIS
+ *     bool cqueue_calculate_summary(const lListElem *cqueue, const lList *exechost_list,
+ *                                   const lList *centry_list, double *load, ...)
+ *
+ *  FUNCTION
+ *     Calculates the values shown by "qstat -g c" for one cluster queue.
+ *
+ *     The function expects client side copies of the lists: load
+ *     corrections must already have been applied to exechost_list
+ *     (correct_capacities()) and afterwards the alarm states must have
+ *     been set in the queue instances (select_by_queue_state()).
+ *
+ *  INPUTS
+ *     const lListElem *cqueue     - cluster queue (CQ_Type)
+ *     const lList *exechost_list  - execution host list (EH_Type)
+ *     const lList *centry_list    - complex entry list (CE_Type)
+ *     double *load, ...           - the calculated values
+ *
+ *  RESULT
+ *     bool - always true
+ *
+ *  NOTES
+ *     MT-NOTE: cqueue_calculate_summary() is MT safe
+ *
+ *  SEE ALSO
+ *     sched/cqueue_summary/cqueue_list_calculate_summary()
+ *******************************************************************************/
+bool cqueue_calculate_summary(const lListElem *cqueue, const lList *exechost_list, const lList *centry_list,
+                              double *load, bool *is_load_available, u_long32 *used, u_long32 *resv, u_long32 *total,
+                              u_long32 *suspend_manual, u_long32 *suspend_threshold, u_long32 *suspend_on_subordinate,
+                              u_long32 *suspend_calendar, u_long32 *unknown, u_long32 *load_alarm,
+                              u_long32 *disabled_manual, u_long32 *disabled_calendar, u_long32 *ambiguous,
+                              u_long32 *orphaned, u_long32 *error, u_long32 *available, u_long32 *temp_disabled,
+                              u_long32 *manual_intervention) {
+   DENTER(TOP_LAYER);
+   if (cqueue != nullptr) {
+      lListElem *summary = lCreateElem(CQS_Type);
+
+      cqueue_fill_summary(summary, cqueue, exechost_list, centry_list, false);
+
+      *load = lGetDouble(summary, CQS_load);
+      *is_load_available = lGetBool(summary, CQS_is_load_available);
+      *used = lGetUlong(summary, CQS_used);
+      *resv = lGetUlong(summary, CQS_resv);
+      *total = lGetUlong(summary, CQS_total);
+      *suspend_manual = lGetUlong(summary, CQS_suspend_manual);
+      *suspend_threshold = lGetUlong(summary, CQS_suspend_threshold);
+      *suspend_on_subordinate = lGetUlong(summary, CQS_suspend_on_subordinate);
+      *suspend_calendar = lGetUlong(summary, CQS_suspend_calendar);
+      *unknown = lGetUlong(summary, CQS_unknown);
+      *load_alarm = lGetUlong(summary, CQS_load_alarm);
+      *disabled_manual = lGetUlong(summary, CQS_disabled_manual);
+      *disabled_calendar = lGetUlong(summary, CQS_disabled_calendar);
+      *ambiguous = lGetUlong(summary, CQS_ambiguous);
+      *orphaned = lGetUlong(summary, CQS_orphaned);
+      *error = lGetUlong(summary, CQS_error);
+      *available = lGetUlong(summary, CQS_available);
+      *temp_disabled = lGetUlong(summary, CQS_temp_disabled);
+      *manual_intervention = lGetUlong(summary, CQS_manual_intervention);
+
+      lFreeElem(&summary);
+   }
+   DRETURN(true);
+}
+
+/****** sched/cqueue_summary/cqueue_list_calculate_summary() *******************
+ *  NAME
+ *     cqueue_list_calculate_summary() -- slot summary of all cluster queues
+ *
+ *  SYNOPSIS
+ *     lList *cqueue_list_calculate_summary(const lList *cqueue_list,
+ *                                          const lList *exechost_list,
+ *                                          const lList *centry_list)
+ *
+ *  FUNCTION
+ *     Creates one CQS_Type element for each cluster queue in cqueue_list.
+ *
+ *     In contrast to cqueue_calculate_summary() the lists are not modified
+ *     and not expected to be prepared. The load scaling and capacity
+ *     correction of correct_capacities() are applied to a copy of
+ *     exechost_list, the load/suspend alarms are evaluated on these values
+ *     while the summary is calculated. So the summary matches the one of
+ *     the client side calculation, and it can be calculated within
+ *     sge_qmaster using the master lists of a data store that is only
+ *     locked for reading.
+ *
+ *  INPUTS
+ *     const lList *cqueue_list   - cluster queue list (CQ_Type)
+ *     const lList *exechost_list - execution host list (EH_Type)
+ *     const lList *centry_list   - complex entry list (CE_Type)
+ *
+ *  RESULT
+ *     lList * - summary list (CQS_Type)
+ *
+ *  NOTES
+ *     MT-NOTE: cqueue_list_calculate_summary() is MT safe
+ *******************************************************************************/
+lList *
+cqueue_list_calculate_summary(const lList *cqueue_list, const lList *exechost_list, const lList *centry_list) {
+   DENTER(TOP_LAYER);
+   lList *summary_list = lCreateList("cluster queue summary", CQS_Type);
+   lList *scaled_exechost_list = lCopyList("scaled hosts", exechost_list);
+   const lListElem *cqueue;
+
+   // thresholds and np_load_avg are evaluated on scaled load values like on client side
+   correct_capacities(scaled_exechost_list, centry_list);
+
+   for_each_ep(cqueue, cqueue_list) {
+      lListElem *summary = lCreateElem(CQS_Type);
+
+      cqueue_fill_summary(summary, cqueue, scaled_exechost_list, centry_list, true);
+      lAppendElem(summary_list, summary);
+   }
+   lFreeList(&scaled_exechost_list);
+
+   DRETURN(summary_list);
+}
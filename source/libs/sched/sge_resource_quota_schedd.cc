@@ -55,6 +55,7 @@
 #include "sge_complex_schedd.h"
 #include "sge_select_queue.h"
 #include "sge_resource_quota_schedd.h"
+#include "ocs_RqsLimitIndex.h"
 #include "sort_hosts.h"
 #include "sge_schedd_text.h"
 #include "schedd_message.h"
@@ -850,6 +851,70 @@ bool sge_user_is_referenced_in_rqs(const lList *rqs, const char *user, const cha
    return ret;
 }
 
+/****** sge_resource_quota_schedd/rqs_limit_index() ****************************
+*  NAME
+*     rqs_limit_index() -- Get the hash index on the assignments limit list
+*
+*  SYNOPSIS
+*     static ocs::RqsLimitIndex *rqs_limit_index(sge_assignment_t *a)
+*
+*  FUNCTION
+*     Returns the index on a->limit_list, the index is created on first use.
+*     All elements of a->limit_list have to be registered in the index.
+*
+*  INPUTS
+*     sge_assignment_t *a - assignment
+*
+*  RESULT
+*     ocs::RqsLimitIndex * - the index
+*
+*  NOTES
+*     MT-NOTE: rqs_limit_index() is MT safe
+*******************************************************************************/
+static ocs::RqsLimitIndex *
+rqs_limit_index(sge_assignment_t *a)
+{
+   if (a->limit_index == nullptr) {
+      a->limit_index = new ocs::RqsLimitIndex;
+   }
+   return a->limit_index;
+}
+
+/****** sge_resource_quota_schedd/rqs_limit_find() *****************************
+*  NAME
+*     rqs_limit_find() -- Find the cached limit for a rule
+*
+*  SYNOPSIS
+*     static lListElem *rqs_limit_find(sge_assignment_t *a, const lListElem
+*     *rule, const char *user, const char *project, const char *host, const
+*     char *queue, const char *pe)
+*
+*  FUNCTION
+*     Returns the element of a->limit_list that caches the limit of the
+*     rule for the given user, project, host, queue and pe.
+*
+*  INPUTS
+*     sge_assignment_t *a   - assignment
+*     const lListElem *rule - resource quota rule (RQR_Type)
+*     const char *user      - user name
+*     const char *project   - project name
+*     const char *host      - host name
+*     const char *queue     - cluster queue name
+*     const char *pe        - pe name
+*
+*  RESULT
+*     lListElem * - the cached limit (RQL_Type) or nullptr
+*
+*  NOTES
+*     MT-NOTE: rqs_limit_find() is MT safe
+*******************************************************************************/
+static lListElem *
+rqs_limit_find(sge_assignment_t *a, const lListElem *rule, const char *user, const char *project,
+               const char *host, const char *queue, const char *pe)
+{
+   ocs::RqsLimitIndex *index = rqs_limit_index(a);
+   return index->find(index->make_key(rule, user, project, host, queue, pe));
+}
 
 /****** sge_resource_quota_schedd/check_and_debit_rqs_slots() *********************
 *  NAME
@@ -858,7 +923,7 @@ bool sge_user_is_referenced_in_rqs(const lList *rqs, const char *user, const cha
 *  SYNOPSIS
 *     static void check_and_debit_rqs_slots(sge_assignment_t *a, const char 
 *     *host, const char *queue, int *slots, int *slots_qend, dstring 
-*     *rule_name, dstring *rue_name, dstring *limit_name) 
+*     *rule_name) 
 *
 *  FUNCTION
 *     The function determines the final slot and slots_qend amount due
@@ -873,14 +938,12 @@ bool sge_user_is_referenced_in_rqs(const lList *rqs, const char *user, const cha
 *     int *slots          - needed/available slots
 *     int *slots_qend     - needed/available slots_qend
 *     dstring *rule_name  - caller maintained buffer
-*     dstring *rue_name   - caller maintained buffer
-*     dstring *limit_name - caller maintained buffer
 *
 *  NOTES
 *     MT-NOTE: check_and_debit_rqs_slots() is MT safe 
 *******************************************************************************/
 void parallel_check_and_debit_rqs_slots(sge_assignment_t *a, const char *host, const char *queue, 
-      int *slots, int *slots_qend, dstring *rule_name, dstring *rue_name, dstring *limit_name)
+      int *slots, int *slots_qend, dstring *rule_name)
 {
    const lListElem *rqs, *rule;
    const char* user = a->user;
@@ -901,10 +964,8 @@ void parallel_check_and_debit_rqs_slots(sge_assignment_t *a, const char *host, c
       sge_dstring_clear(rule_name);
       rule = rqs_get_matching_rule(rqs, user, group, grp_list, project, pe, host, queue, a->acl_list, a->hgrp_list, rule_name);
       if (rule != nullptr) {
-         const lListElem *rql;
-         rqs_get_rue_string(rue_name, rule, user, project, host, queue, pe);
-         sge_dstring_sprintf(limit_name, "%s=%s", sge_dstring_get_string(rule_name), sge_dstring_get_string(rue_name));
-         if ((rql = lGetElemStr(a->limit_list, RQL_name, sge_dstring_get_string(limit_name)))) {
+         const lListElem *rql = rqs_limit_find(a, rule, user, project, host, queue, pe);
+         if (rql != nullptr) {
             *slots = MIN(*slots, lGetInt(rql, RQL_slots));
             *slots_qend = MIN(*slots_qend, lGetInt(rql, RQL_slots_qend));
          } else {
@@ -928,10 +989,7 @@ void parallel_check_and_debit_rqs_slots(sge_assignment_t *a, const char *host, c
          sge_dstring_clear(rule_name);
          rule = rqs_get_matching_rule(rqs, user, group, grp_list, project, pe, host, queue, a->acl_list, a->hgrp_list, rule_name);
          if (rule != nullptr) {
-            lListElem *rql;
-            rqs_get_rue_string(rue_name, rule, user, project, host, queue, pe);
-            sge_dstring_sprintf(limit_name, "%s=%s", sge_dstring_get_string(rule_name), sge_dstring_get_string(rue_name));
-            rql = lGetElemStrRW(a->limit_list, RQL_name, sge_dstring_get_string(limit_name));
+            lListElem *rql = rqs_limit_find(a, rule, user, project, host, queue, pe);
             lSetInt(rql, RQL_slots,      lGetInt(rql, RQL_slots) - *slots);
             lSetInt(rql, RQL_slots_qend, lGetInt(rql, RQL_slots_qend) - *slots_qend);
          }
@@ -944,7 +1002,7 @@ void parallel_check_and_debit_rqs_slots(sge_assignment_t *a, const char *host, c
 }
 
 void parallel_revert_rqs_slot_debitation(sge_assignment_t *a, const char *host, const char *queue,
-      int slots, int slots_qend, dstring *rule_name, dstring *rue_name, dstring *limit_name)
+      int slots, int slots_qend, dstring *rule_name)
 {
    const lListElem *rqs, *rule;
    const char* user = a->user;
@@ -964,11 +1022,8 @@ void parallel_revert_rqs_slot_debitation(sge_assignment_t *a, const char *host,
       sge_dstring_clear(rule_name);
       rule = rqs_get_matching_rule(rqs, user, group, grp_list, project, pe, host, queue, a->acl_list, a->hgrp_list, rule_name);
       if (rule != nullptr) {
-         lListElem *rql;
-         rqs_get_rue_string(rue_name, rule, user, project, host, queue, pe);
-         sge_dstring_sprintf(limit_name, "%s=%s", sge_dstring_get_string(rule_name), sge_dstring_get_string(rue_name));
-         rql = lGetElemStrRW(a->limit_list, RQL_name, sge_dstring_get_string(limit_name));
-         DPRINTF("limit: %s %d <--- %d\n", sge_dstring_get_string(limit_name), lGetInt(rql, RQL_slots), lGetInt(rql, RQL_slots)+slots);
+         lListElem *rql = rqs_limit_find(a, rule, user, project, host, queue, pe);
+         DPRINTF("limit: %s %d <--- %d\n", lGetString(rql, RQL_name), lGetInt(rql, RQL_slots), lGetInt(rql, RQL_slots)+slots);
          lSetInt(rql, RQL_slots,      lGetInt(rql, RQL_slots) + slots);
          lSetInt(rql, RQL_slots_qend, lGetInt(rql, RQL_slots_qend) + slots_qend);
       }
@@ -1138,12 +1193,10 @@ parallel_rqs_slots_by_time(sge_assignment_t *a, int *slots, int *slots_qend, lLi
          rule = rqs_get_matching_rule(rqs, user, group, grp_list, project, pe, host, queue, a->acl_list, a->hgrp_list, &dstr_rule_name);
          if (rule != nullptr) {
             lListElem *limit = nullptr;
-            const char *limit_s;
-            rqs_get_rue_string(&dstr_rue_string, rule, user, project, host, queue, pe);
-            limit_s = sge_dstring_sprintf(&dstr_limit_name, "%s=%s", sge_dstring_get_string(&dstr_rule_name), sge_dstring_get_string(&dstr_rue_string));
+            ocs::RqsLimitIndex::Key key = rqs_limit_index(a)->make_key(rule, user, project, host, queue, pe);
 
             /* reuse earlier result */
-            if ((rql=lGetElemStrRW(a->limit_list, RQL_name, limit_s))) {
+            if ((rql = a->limit_index->find(key)) != nullptr) {
                result = (dispatch_t)lGetInt(rql, RQL_result);
                tslots = MIN(tslots, lGetInt(rql, RQL_slots));
                tslots_qend = MIN(tslots_qend, lGetInt(rql, RQL_slots_qend));
@@ -1152,8 +1205,12 @@ parallel_rqs_slots_by_time(sge_assignment_t *a, int *slots, int *slots_qend, lLi
                lAndUlongBitMask(qep, QU_tagged4schedule, lGetUlong(rql, RQL_tagged4schedule));
 
                DPRINTF("parallel_rqs_slots_by_time(%s@%s) result %d slots %d slots_qend %d for " SFQ " (cache)\n",
-                       queue, host, result, tslots, tslots_qend, limit_s);
+                       queue, host, result, tslots, tslots_qend, lGetString(rql, RQL_name));
             } else {
+               const char *limit_s;
+               rqs_get_rue_string(&dstr_rue_string, rule, user, project, host, queue, pe);
+               limit_s = sge_dstring_sprintf(&dstr_limit_name, "%s=%s", sge_dstring_get_string(&dstr_rule_name), sge_dstring_get_string(&dstr_rue_string));
+
                int ttslots = INT_MAX;
                int ttslots_qend = INT_MAX;
                
@@ -1179,9 +1236,6 @@ parallel_rqs_slots_by_time(sge_assignment_t *a, int *slots, int *slots_qend, lLi
 
                   /* found a rule, now check limit */
                   if (lGetUlong(raw_centry, CE_consumable)) {
-
-                     rqs_get_rue_string(&dstr_rue_string, rule, user, project, host, queue, pe);
-
                      if (rqs_set_dynamical_limit(limit, a->gep, exec_host, a->centry_list)) {
                         int tttslots = INT_MAX;
                         int tttslots_qend = INT_MAX;
@@ -1217,6 +1271,7 @@ parallel_rqs_slots_by_time(sge_assignment_t *a, int *slots, int *slots_qend, lLi
 
                /* store result for reuse */
                rql = lAddElemStr(&(a->limit_list), RQL_name, limit_s, RQL_Type);
+               a->limit_index->add(key, rql);
                lSetInt(rql, RQL_result, result);
                lSetInt(rql, RQL_slots, ttslots);
                lSetInt(rql, RQL_slots_qend, ttslots_qend);
@@ -1231,6 +1286,7 @@ parallel_rqs_slots_by_time(sge_assignment_t *a, int *slots, int *slots_qend, lLi
 
             if (result != DISPATCH_OK || (tslots == 0 && ( a->is_reservation || !a->care_reservation || tslots_qend == 0))) {
                DPRINTF("RQS PARALLEL SORT OUT\n");
+               rqs_get_rue_string(&dstr_rue_string, rule, user, project, host, queue, pe);
                schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
                               SCHEDD_INFO_CANNOTRUNRQSGLOBAL_SS,
                      sge_dstring_get_string(&dstr_rue_string), sge_dstring_get_string(&dstr_rule_name));
@@ -1465,23 +1521,23 @@ dispatch_t rqs_by_slots(sge_assignment_t *a, const char *queue, const char *host
       sge_dstring_clear(rule_name);
       rule = rqs_get_matching_rule(rqs, user, group, grp_list, project, nullptr, host, queue, a->acl_list, a->hgrp_list, rule_name);
       if (rule != nullptr) {
-         const char *limit;
          lListElem *rql;
 
          /* need unique identifier for cache */
-         rqs_get_rue_string(rue_string, rule, user, project, host, queue, nullptr);
-         sge_dstring_sprintf(limit_name, "%s=%s", sge_dstring_get_string(rule_name), sge_dstring_get_string(rue_string));
-         limit = sge_dstring_get_string(limit_name);
+         ocs::RqsLimitIndex::Key key = rqs_limit_index(a)->make_key(rule, user, project, host, queue, nullptr);
 
          /* check limit or reuse earlier results */
-         if ((rql=lGetElemStrRW(a->limit_list, RQL_name, limit))) {
+         if ((rql = a->limit_index->find(key)) != nullptr) {
             tt_rqs = lGetUlong64(rql, RQL_time);
             result = (dispatch_t)lGetInt(rql, RQL_result);
          } else {
             /* Check booked usage */
             result = rqs_limitation_reached(a, rule, host, queue, &tt_rqs);
 
-            rql = lAddElemStr(&(a->limit_list), RQL_name, limit, RQL_Type);
+            rqs_get_rue_string(rue_string, rule, user, project, host, queue, nullptr);
+            sge_dstring_sprintf(limit_name, "%s=%s", sge_dstring_get_string(rule_name), sge_dstring_get_string(rue_string));
+            rql = lAddElemStr(&(a->limit_list), RQL_name, sge_dstring_get_string(limit_name), RQL_Type);
+            a->limit_index->add(key, rql);
             lSetInt(rql, RQL_result, result);
             lSetUlong64(rql, RQL_time, tt_rqs);
             /* init with same value as QU_tagged4schedule */
@@ -48,9 +48,9 @@ dispatch_t
 parallel_rqs_slots_by_time(sge_assignment_t *a, int *slots, int *slots_qend, lListElem *qep, bool need_master,
                            bool is_master_queue);
 void parallel_check_and_debit_rqs_slots(sge_assignment_t *a, const char *host, const char *queue, 
-      int *slots, int *slots_qend, dstring *rule_name, dstring *rue_name, dstring *limit_name);
+      int *slots, int *slots_qend, dstring *rule_name);
 void parallel_revert_rqs_slot_debitation(sge_assignment_t *a, const char *host, const char *queue, 
-      int slots, int slots_qend, dstring *rule_name, dstring *rue_name, dstring *limit_name);
+      int slots, int slots_qend, dstring *rule_name);
 
 /* sequential assignments */
 dispatch_t rqs_by_slots(sge_assignment_t *a, const char *queue, const char *host, 
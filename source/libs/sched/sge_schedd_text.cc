@@ -237,6 +237,9 @@ const char* sge_get_schedd_text( int nr )
       case SCHEDD_INFO_ARISINERROR_I:
          return MSG_SCHEDD_INFO_ARISINERROR_I; 
 
+      case SCHEDD_INFO_BINDINGNOTPOSSIBLE_S:
+         return MSG_SCHEDD_INFO_BINDINGNOTPOSSIBLE_S;
+
 /* */
 
       case SCHEDD_INFO_CANNOTRUNATHOST          :
@@ -401,6 +404,9 @@ const char* sge_get_schedd_text( int nr )
       case SCHEDD_INFO_ARISINERROR:
          return MSG_SCHEDD_INFO_ARISINERROR; 
 
+      case SCHEDD_INFO_BINDINGNOTPOSSIBLE:
+         return MSG_SCHEDD_INFO_BINDINGNOTPOSSIBLE;
+
       default:
          return "";
    }
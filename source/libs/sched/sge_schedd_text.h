@@ -111,6 +111,7 @@ enum {
    SCHEDD_INFO_QINOTARRESERVED_SI,
    SCHEDD_INFO_QNOTARRESERVED_SI,
    SCHEDD_INFO_ARISINERROR_I,
+   SCHEDD_INFO_BINDINGNOTPOSSIBLE_S,
 
    /* global messages*/
    SCHEDD_INFO_CANNOTRUNATHOST,
@@ -167,6 +168,7 @@ enum {
    SCHEDD_INFO_QINOTARRESERVED,
    SCHEDD_INFO_QNOTARRESERVED,
    SCHEDD_INFO_ARISINERROR,
+   SCHEDD_INFO_BINDINGNOTPOSSIBLE,
 
    TOOBIG /* don't move from last position! */
 };
@@ -36,6 +36,8 @@
 #include <cstdlib>
 #include <cfloat>
 #include <climits>
+#include <unordered_map>
+#include <vector>
 
 #include "uti/sge_bitfield.h"
 #include "uti/sge_hostname.h"
@@ -48,6 +50,7 @@
 #include "cull/cull.h"
 
 #include "sgeobj/ocs_DataStore.h"
+#include "sgeobj/ocs_TopologyMask.h"
 #include "sgeobj/sge_range.h"
 #include "sgeobj/sge_pe.h"
 #include "sgeobj/sge_qinstance.h"
@@ -78,6 +81,9 @@
 #include "sge_resource_utilization.h"
 #include "sge_schedd_text.h"
 #include "sge_select_queue.h"
+#include "ocs_ResourceMatrix.h"
+#include "ocs_RqsLimitIndex.h"
+#include "ocs_SlotCapacityIndex.h"
 #include "uti/sge.h"
 #include "valid_queue_user.h"
 
@@ -120,7 +126,7 @@ fill_category_use_t(const sge_assignment_t *a, category_use_t *use_category, con
 
 static bool
 add_pe_slots_to_category(category_use_t *use_category, u_long32 *max_slotsp, lListElem *pe,
-                         int min_slots, int max_slots, lList *pe_range);
+                         int min_slots, int max_slots, const lList *pe_range);
 /* -- these implement parallel assignment ------------------------- */
 
 static dispatch_t
@@ -132,6 +138,12 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots);
 static dispatch_t
 parallel_assignment(sge_assignment_t *a, category_use_t *use_category, int *available_slots);
 
+static bool
+parallel_slot_capacity(const sge_assignment_t *a, ocs::SlotCapacityIndex &capacity);
+
+static bool
+parallel_slots_impossible(const ocs::SlotCapacityIndex *capacity, const lListElem *pe, int slots);
+
 #ifdef SOLARIS
 #pragma no_inline(parallel_assignment)
 #endif
@@ -176,6 +188,9 @@ sequential_queue_time(u_long64 *start, const sge_assignment_t *a, int *violation
 static dispatch_t
 sequential_host_time(u_long64 *start, const sge_assignment_t *a, int *violations, const lListElem *hep);
 
+static bool
+host_binding_possible(const sge_assignment_t *a, const lListElem *hep);
+
 static dispatch_t
 sequential_global_time(u_long64 *start_time, const sge_assignment_t *a, int *violations);
 
@@ -298,6 +313,7 @@ void assignment_copy(sge_assignment_t *dst, sge_assignment_t *src, bool move_gdi
    if (move_gdil) {
       lFreeList(&(dst->gdil));
       lFreeList(&(dst->limit_list));
+      delete dst->limit_index;
       lFreeList(&(dst->skip_cqueue_list));
       lFreeList(&(dst->skip_host_list));
    }
@@ -310,8 +326,10 @@ void assignment_copy(sge_assignment_t *dst, sge_assignment_t *src, bool move_gdi
 
    if (move_gdil) {
       src->gdil = src->limit_list = src->skip_cqueue_list = src->skip_host_list = nullptr;
+      src->limit_index = nullptr;
    } else {
       dst->gdil = dst->limit_list = dst->skip_cqueue_list = dst->skip_host_list = nullptr;
+      dst->limit_index = nullptr;
    }
 }
 
@@ -319,6 +337,8 @@ void assignment_release(sge_assignment_t *a)
 {
    lFreeList(&(a->gdil));
    lFreeList(&(a->limit_list));
+   delete a->limit_index;
+   a->limit_index = nullptr;
    lFreeList(&(a->skip_cqueue_list));
    lFreeList(&(a->skip_host_list));
 }
@@ -326,6 +346,8 @@ void assignment_release(sge_assignment_t *a)
 void assignment_clear_cache(sge_assignment_t *a)
 {
    lFreeList(&(a->limit_list));
+   delete a->limit_index;
+   a->limit_index = nullptr;
    lFreeList(&(a->skip_cqueue_list));
    lFreeList(&(a->skip_host_list));
 }
@@ -890,7 +912,7 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots)
    int min_slots, max_slots;
    int max_pe_slots;
    int first, last;
-   lList *pe_range;
+   const lList *pe_range;
    lListElem *pe;
    sge_assignment_t tmp = SGE_ASSIGNMENT_INIT;
    dispatch_t result = DISPATCH_NEVER_CAT;
@@ -903,11 +925,13 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots)
    int match_current = 0;
    int runs = 0;
    schedd_pe_algorithm alg =  sconf_best_pe_alg();
+   ocs::SlotCapacityIndex slot_capacity;
+   const ocs::SlotCapacityIndex *capacity = nullptr;
 
    DENTER(TOP_LAYER);
 
    if (best == nullptr ||
-       (pe_range=lGetListRW(best->job, JB_pe_range)) == nullptr ||
+       (pe_range=lGetList(best->job, JB_pe_range)) == nullptr ||
        (pe=best->pe) == nullptr) {
       DRETURN(DISPATCH_NEVER_CAT);
    }
@@ -965,6 +989,11 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots)
 
    assignment_copy(&tmp, best, false);
 
+   /* --- upper bound of the slots the hosts can offer, allows to skip slot counts without tagging */
+   if (parallel_slot_capacity(best, slot_capacity)) {
+      capacity = &slot_capacity;
+   }
+
    /* --- work on the different slot ranges and try to find the best one --- */
    if (alg == SCHEDD_PE_BINARY) {
       int min = 0;
@@ -980,6 +1009,13 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots)
             use_category.mod_category = false;
             schedd_mes_set_logging(0);
             sconf_set_mes_schedd_info(false);
+
+            /* once we have a match a failing run does not change the result, skip the impossible ones */
+            if (best->gdil != nullptr &&
+                parallel_slots_impossible(capacity, pe, use_category.possible_pe_slots[current])) {
+               max = current - 1;
+               continue;
+            }
          }
 
          /* we try that slot amount */
@@ -1015,6 +1051,12 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots)
                use_category.mod_category = false;
                schedd_mes_set_logging(0);
                sconf_set_mes_schedd_info(false);
+
+               /* higher slot counts will not work either */
+               if (best->gdil != nullptr &&
+                   parallel_slots_impossible(capacity, pe, use_category.possible_pe_slots[current])) {
+                  break;
+               }
             }
 
             /* we try that slot amount */
@@ -1039,6 +1081,15 @@ parallel_maximize_slots_pe(sge_assignment_t *best, int *available_slots)
                use_category.mod_category = false;
                schedd_mes_set_logging(0);
                sconf_set_mes_schedd_info(false);
+
+               /*
+                * skip slot counts the hosts cannot offer, but do the run with the lowest
+                * slot count, without a match it determines the result
+                */
+               if ((current > 0 || best->gdil != nullptr) &&
+                   parallel_slots_impossible(capacity, pe, use_category.possible_pe_slots[current])) {
+                  continue;
+               }
             }
 
             /* we try that slot amount */
@@ -3327,12 +3378,25 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
    lListElem *best_qep = nullptr;
    u_long32 best_qep_violations = U_LONG32_MAX;
    u_long64 best_qep_tt = U_LONG64_MAX;
+   std::vector<unsigned char> rejected_hosts;
+   bool use_resource_matrix = false;
 
    DENTER(TOP_LAYER);
 
    /* assemble job category information */
    fill_category_use_t(a, &use_category, "NONE");
 
+   /*
+    * find the hosts which can never serve the consumable requests of the job in one go,
+    * they are skipped without the dynamic host matching as long as no diagnosis messages
+    * need to be created per host
+    */
+   if (ar_ep == nullptr && a->resource_matrix != nullptr && a->monitor_alpp == nullptr && !a->monitor_next_run &&
+       sconf_get_schedd_job_info() == SCHEDD_JOB_INFO_FALSE) {
+      use_resource_matrix = a->resource_matrix->reject_hosts(job_get_hard_resource_list(a->job), a->centry_list,
+                                                             1, rejected_hosts);
+   }
+
    /* restore job messages from previous dispatch runs of jobs of the same category */
    if (use_category.use_category) {
       schedd_mes_set_tmp_list(use_category.cache, CCT_job_messages, a->job_id);
@@ -3522,6 +3586,17 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
          // not running in an AR
          queue_violations = global_violations;
 
+         /* a request exceeds the capacity of a host consumable, see ri_time_by_slots() */
+         if (use_resource_matrix && a->resource_matrix->is_rejected(rejected_hosts, hep)) {
+            if (skip_host_list)
+               lAddElemStr(&skip_host_list, CTI_name, eh_name, CTI_Type);
+            else
+               lAddElemStr(&(a->skip_host_list), CTI_name, eh_name, CTI_Type);
+            DPRINTF("host %s can never serve the consumable requests\n", eh_name);
+            best_queue_result = find_best_result(DISPATCH_NEVER_CAT, best_queue_result);
+            continue;
+         }
+
          /* dynamic host matching */
          SCHED_PROF_INC(a->pi, seq_hdyn);
          result = sequential_host_time(&tt_host, a, &queue_violations, hep);
@@ -3534,6 +3609,11 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
             best_queue_result = find_best_result(result, best_queue_result);
             continue;
          }
+         if (!host_binding_possible(a, hep)) {
+            lAddElemStr(&(a->skip_host_list), CTI_name, eh_name, CTI_Type);
+            best_queue_result = find_best_result(DISPATCH_NOT_AT_TIME, best_queue_result);
+            continue;
+         }
          if (got_solution && is_not_better(a, violations_best, tt_best, queue_violations, tt_host)) {
             lAddElemStr(&(a->skip_host_list), CTI_name, eh_name, CTI_Type);
             DPRINTF("CUT TREE: Due to HOST for \"%s\"\n", qname);
@@ -3656,8 +3736,8 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
 *
 *  SYNOPSIS
 *     static bool add_pe_slots_to_category(category_use_t *use_category,
-*     u_long32 *max_slotsp, lListElem *pe, int min_slots, int max_slots, lList
-*     *pe_range)
+*     u_long32 *max_slotsp, lListElem *pe, int min_slots, int max_slots,
+*     const lList *pe_range)
 *
 *  FUNCTION
 *     In case of pe ranges does this function alocate memory and filles it wil
@@ -3670,7 +3750,7 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
 *     lListElem *pe                - pe, must not be nullptr
 *     int min_slots                - min slot setting (pe range)
 *     int max_slots                - max slot setting (pe range)
-*     lList *pe_range              - pe range, must not be nullptr
+*     const lList *pe_range        - pe range, must not be nullptr
 *
 *  RESULT
 *     static bool - true, if successful
@@ -3681,7 +3761,7 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
 *******************************************************************************/
 static bool
 add_pe_slots_to_category(category_use_t *use_category, u_long32 *max_slotsp, lListElem *pe,
-                         int min_slots, int max_slots, lList *pe_range)
+                         int min_slots, int max_slots, const lList *pe_range)
 {
    if (use_category->cache != nullptr) {
       use_category->possible_pe_slots = (u_long32 *)lGetRef(use_category->cache, CCT_pe_job_slots);
@@ -4015,8 +4095,6 @@ parallel_tag_queues_suitable4job(sge_assignment_t *a, category_use_t *use_catego
       minslots = ALLOC_RULE_IS_BALANCED(allocation_rule)?allocation_rule:1;
 
       dstring rule_name = DSTRING_INIT;
-      dstring rue_name = DSTRING_INIT;
-      dstring limit_name = DSTRING_INIT;
 
       const lListElem *master_host = nullptr; // here we remember the master host, it is used when we are in the second round
       // @todo do we need to remember the master queue as well? We also do matching on queues and might have multiple
@@ -4158,7 +4236,7 @@ parallel_tag_queues_suitable4job(sge_assignment_t *a, category_use_t *use_catego
                      if (ar_id == 0 && !a->is_advance_reservation) {
                         DPRINTF("RQS: trying to debit %d slots in queue " SFQ "\n", slots, qname);
                         parallel_check_and_debit_rqs_slots(a, eh_name, lGetString(qep, QU_qname),
-                              &slots, &slots_qend, &rule_name, &rue_name, &limit_name);
+                              &slots, &slots_qend, &rule_name);
                         DPRINTF("RQS: could debiting %d slots in queue " SFQ "\n", slots, qname);
                      }
 
@@ -4202,7 +4280,7 @@ parallel_tag_queues_suitable4job(sge_assignment_t *a, category_use_t *use_catego
                         if (slots != 0) {
                            if (ar_id == 0 && !a->is_advance_reservation) {
                               parallel_revert_rqs_slot_debitation(a, eh_name, lGetString(qep, QU_qname),
-                                    slots, 0, &rule_name, &rue_name, &limit_name);
+                                    slots, 0, &rule_name);
                            }
                            lListElem *gdil_ep;
                            if ((gdil_ep=lGetElemStrRW(a->gdil, JG_qname, lGetString(qep, QU_full_name)))) {
@@ -4297,7 +4375,7 @@ parallel_tag_queues_suitable4job(sge_assignment_t *a, category_use_t *use_catego
                      if (ar_id == 0 && !a->is_advance_reservation) {
                         DPRINTF("trying to debit %d slots_qend in queue " SFQ "\n", slots_qend, lGetString(qep, QU_full_name));
                         parallel_check_and_debit_rqs_slots(a, eh_name, lGetString(qep, QU_qname),
-                              &slots, &slots_qend, &rule_name, &rue_name, &limit_name);
+                              &slots, &slots_qend, &rule_name);
                         DPRINTF("could debiting %d slots_qend in queue " SFQ "\n", slots_qend, lGetString(qep, QU_full_name));
                      }
 
@@ -4324,7 +4402,7 @@ parallel_tag_queues_suitable4job(sge_assignment_t *a, category_use_t *use_catego
                         if (slots_qend != 0) {
                            if (ar_id == 0 && !a->is_advance_reservation)
                               parallel_revert_rqs_slot_debitation(a, eh_name, lGetString(qep, QU_qname),
-                                    0, slots_qend, &rule_name, &rue_name, &limit_name);
+                                    0, slots_qend, &rule_name);
                            lSetUlong64(qep, QU_tag_qend, 0);
                         }
                      }
@@ -4373,8 +4451,6 @@ parallel_tag_queues_suitable4job(sge_assignment_t *a, category_use_t *use_catego
       lFreeList(&unclear_cqueue_list);
 
       sge_dstring_free(&rule_name);
-      sge_dstring_free(&rue_name);
-      sge_dstring_free(&limit_name);
 
       if (accu_host_slots >= a->slots && have_master_host) {
          /* stop looking for smaller slot amounts */
@@ -4477,6 +4553,49 @@ host_or_queue_clear_tags(const char *object_name, lListElem *queue, lList *queue
    }
 }
 
+/****** sge_select_queue/host_binding_possible() ****************************
+*  NAME
+*     host_binding_possible() -- Does a host offer the cores for core binding?
+*
+*  SYNOPSIS
+*     static bool host_binding_possible(const sge_assignment_t *a,
+*                                       const lListElem *hep)
+*
+*  FUNCTION
+*     Checks if the topology in use reported by the host has enough free
+*     cores for the core binding request of the job.
+*     This is only done when dispatching now, it is not known which cores
+*     will be free at a later time. Hosts which do not report a topology are
+*     accepted, binding will be decided by the execution daemon.
+*
+*  INPUTS
+*     const sge_assignment_t *a - assignment of the job
+*     const lListElem *hep      - the host (EH_Type)
+*
+*  RESULT
+*     static bool - false if the host can not fulfill the binding request
+*
+*  NOTES
+*     MT-NOTE: host_binding_possible() is MT safe
+*******************************************************************************/
+static bool
+host_binding_possible(const sge_assignment_t *a, const lListElem *hep) {
+   DENTER(TOP_LAYER);
+
+   if (a->start != DISPATCH_TIME_NOW || !ocs::TopologyMask::is_binding_requested(a->job)) {
+      DRETURN(true);
+   }
+
+   if (!host_select_binding(hep, a->job, nullptr)) {
+      const char *eh_name = lGetHost(hep, EH_name);
+      DPRINTF("host %s has not enough free cores for core binding\n", eh_name);
+      schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id, SCHEDD_INFO_BINDINGNOTPOSSIBLE_S, eh_name);
+      DRETURN(false);
+   }
+
+   DRETURN(true);
+}
+
 /****** sge_select_queue/parallel_host_slots() ******************************
 *  NAME
 *     parallel_host_slots() -- Return host slots available at time period
@@ -4713,6 +4832,10 @@ parallel_tag_hosts_queues(sge_assignment_t *a, lListElem *hep, int *slots, int *
    } // end checking if job can run in AR
 
 
+   if (hslots > 0 && !host_binding_possible(a, hep)) {
+      hslots = 0;
+   }
+
    DPRINTF("HOST %s itself (and queue threshold) will get us %d slots (%d later) ... "
          "we need %d\n", eh_name, hslots, hslots_qend, min_host_slots);
 
@@ -5194,6 +5317,148 @@ static int sequential_update_host_order(lList *host_list, lList *queues)
    DRETURN(0);
 }
 
+/****** sge_select_queue/parallel_free_slots() ******************************
+*  NAME
+*     parallel_free_slots() -- Upper bound of the free slots of a host or queue
+*
+*  SYNOPSIS
+*     static long long parallel_free_slots(const sge_assignment_t *a,
+*     const lList *total_list, const lList *rue_list)
+*
+*  FUNCTION
+*     Returns the number of slots which are not used at the start time of the
+*     assignment. The utilization is determined like in ri_slots_by_time()
+*     for the implicit slot request, but additional usage and the
+*     utilization by other requests are not taken into account.
+*
+*  INPUTS
+*     const sge_assignment_t *a - the assignment
+*     const lList *total_list   - consumable configuration (CE_Type)
+*     const lList *rue_list     - resource utilization (RUE_Type)
+*
+*  RESULT
+*     long long - free slots, INT_MAX if slots are not limited
+*
+*  NOTES
+*     MT-NOTE: parallel_free_slots() is MT safe
+*******************************************************************************/
+static long long
+parallel_free_slots(const sge_assignment_t *a, const lList *total_list, const lList *rue_list)
+{
+   const lListElem *tep = lGetElemStr(total_list, CE_name, SGE_ATTR_SLOTS);
+   const lListElem *uep = lGetElemStr(rue_list, RUE_name, SGE_ATTR_SLOTS);
+
+   if (tep == nullptr || uep == nullptr || lGetDouble(tep, CE_doubleval) >= INT_MAX) {
+      return INT_MAX;
+   }
+
+   double used = 0;
+   if (a->is_advance_reservation || sconf_get_qs_state() != QS_STATE_EMPTY) {
+      if (a->is_advance_reservation || a->is_schedule_based || lGetNumberOfElem(lGetList(uep, RUE_utilized)) != 0) {
+         used = utilization_max(uep, a->now, a->duration, false);
+      } else {
+         used = lGetDouble(uep, RUE_utilized_now);
+      }
+   }
+
+   return (long long)(lGetDouble(tep, CE_doubleval) - used);
+}
+
+/****** sge_select_queue/parallel_slot_capacity() ***************************
+*  NAME
+*     parallel_slot_capacity() -- Fill the slot capacity index of a job
+*
+*  SYNOPSIS
+*     static bool parallel_slot_capacity(const sge_assignment_t *a,
+*     ocs::SlotCapacityIndex &capacity)
+*
+*  FUNCTION
+*     Determines for each host the maximum number of slots a parallel job
+*     can get now: the free slots of the host, but not more than the sum
+*     of the free slots of its queue instances.
+*     Any other check can only reduce the number of slots.
+*
+*     The index is only built for assignments at DISPATCH_TIME_NOW outside
+*     of advance reservations.
+*
+*  INPUTS
+*     const sge_assignment_t *a          - the assignment
+*     ocs::SlotCapacityIndex &capacity   - out: the index
+*
+*  RESULT
+*     bool - true if the index was built
+*
+*  NOTES
+*     MT-NOTE: parallel_slot_capacity() is MT safe
+*******************************************************************************/
+static bool
+parallel_slot_capacity(const sge_assignment_t *a, ocs::SlotCapacityIndex &capacity)
+{
+   DENTER(TOP_LAYER);
+
+   if (a->start != DISPATCH_TIME_NOW || a->is_reservation || lGetUlong(a->job, JB_ar) != 0) {
+      DRETURN(false);
+   }
+
+   std::unordered_map<const lListElem *, long long> queue_slots;
+   const lListElem *qep;
+   for_each_ep(qep, a->queue_list) {
+      const lListElem *hep = host_list_locate(a->host_list, lGetHost(qep, QU_qhostname));
+      if (hep != nullptr) {
+         long long slots = parallel_free_slots(a, lGetList(qep, QU_consumable_config_list),
+                                               lGetList(qep, QU_resource_utilization));
+         queue_slots[hep] += MAX(slots, 0);
+      }
+   }
+
+   for (const auto &[hep, slots] : queue_slots) {
+      capacity.add_host(MIN(slots, parallel_free_slots(a, lGetList(hep, EH_consumable_config_list),
+                                                       lGetList(hep, EH_resource_utilization))));
+   }
+   capacity.finish();
+
+   DPRINTF("parallel_slot_capacity: %zu hosts offer at most %lld slots\n", capacity.num_hosts(),
+           capacity.total_slots());
+   DRETURN(true);
+}
+
+/****** sge_select_queue/parallel_slots_impossible() ************************
+*  NAME
+*     parallel_slots_impossible() -- Check slot count against the capacity
+*
+*  SYNOPSIS
+*     static bool parallel_slots_impossible(const ocs::SlotCapacityIndex
+*     *capacity, const lListElem *pe, int slots)
+*
+*  FUNCTION
+*     Returns true if the hosts can certainly not offer the slot count
+*     with the allocation rule of the PE. Then parallel_assignment() would
+*     fail for this slot count.
+*
+*  INPUTS
+*     const ocs::SlotCapacityIndex *capacity - slot capacity index or nullptr
+*     const lListElem *pe                    - the parallel environment (PE_Type)
+*     int slots                              - the slot count
+*
+*  RESULT
+*     bool - true if the slot count cannot be assigned
+*
+*  NOTES
+*     MT-NOTE: parallel_slots_impossible() is MT safe
+*******************************************************************************/
+static bool
+parallel_slots_impossible(const ocs::SlotCapacityIndex *capacity, const lListElem *pe, int slots)
+{
+   DENTER(TOP_LAYER);
+
+   bool ret = capacity != nullptr && !capacity->is_possible(slots, sge_pe_slots_per_host(pe, slots));
+   if (ret) {
+      DPRINTF("skipping %d slots, the hosts cannot offer them\n", slots);
+   }
+
+   DRETURN(ret);
+}
+
 /****** sge_select_queue/parallel_assignment() *****************************
 *  NAME
 *     parallel_assignment() -- Can we assign with a fixed PE/slot/time
@@ -5311,7 +5576,7 @@ parallel_queue_slots(sge_assignment_t *a, lListElem *qep, int *slots, int *slots
          ar_queue_actual_attr = lGetList(qep, QU_resource_utilization);
 
          lListElem *jrs;
-         for_each_rw (jrs, lGetList(a->job, JB_request_set_list)) {
+         for_each_rw (jrs, lGetListRW(a->job, JB_request_set_list)) {
             lList *hard_resource_list = lGetListRW(jrs, JRS_hard_resource_list);
             for_each_rw (rep, hard_resource_list) {
                const char *attrname = lGetString(rep, CE_name);
@@ -39,6 +39,11 @@
 
 #include "sge_orders.h"
 
+namespace ocs {
+   class ResourceMatrix;
+   class RqsLimitIndex;
+}
+
 /* min number of jobs in a category to use
  *    the skip host, queue and the soft violations */
 #define MIN_JOBS_IN_CATEGORY 1
@@ -137,8 +142,10 @@ typedef struct {
    bool       is_schedule_based;  /* true, if resource reservation is enabled       */
    bool       is_soft;            /* true, if job has soft requests                 */
    u_long64   now;                /* now time for immediate jobs                    */
+   const ocs::ResourceMatrix *resource_matrix; /* host consumable capacities of the run */
    /* ------ this section is for caching of intermediate results ------------------ */
    lList      *limit_list;        /* the resource quota limit list (RQL_Type)       */ 
+   ocs::RqsLimitIndex *limit_index; /* hash index on limit_list                   */
    lList      *skip_cqueue_list;  /* cluster queues that need not be checked anymore (CTI_Type) */
    lList      *skip_host_list;    /* hosts that need not be checked anymore (CTI_Type) */
    /* ------ this section is the resulting assignment ----------------------------- */
@@ -155,7 +162,7 @@ typedef struct {
 } sge_assignment_t;
 
 #define SGE_ASSIGNMENT_INIT {0, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, \
-   nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, false, false, false, false, false, false, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, 0, 0, nullptr, false, nullptr}
+   nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, false, false, false, false, false, false, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, 0, 0, nullptr, false, nullptr}
 
 void assignment_init(sge_assignment_t *a, lListElem *job, lListElem *ja_task, lList *load_adjustments);
 void assignment_copy(sge_assignment_t *dst, sge_assignment_t *src, bool move_gdil);
@@ -264,18 +264,20 @@ sge_init_node_fields( lListElem *root )
 
 
 /*--------------------------------------------------------------------
- * sge_calc_node_usage - calculate usage for this share tree node
- * and all descendant nodes.
+ * calc_node_usage - calculate usage for this share tree node
+ * and all descendant nodes using the given usage weighting factors.
  *--------------------------------------------------------------------*/
 
-double
-sge_calc_node_usage( lListElem *node,
-                     const lList *user_list,
-                     const lList *project_list,
-                     const lList *decay_list,
-                     u_long64 curr_time,
-                     const char *projname,
-                     u_long seqno )
+static double
+calc_node_usage( lListElem *node,
+                 const lList *user_list,
+                 const lList *project_list,
+                 const lList *decay_list,
+                 u_long64 curr_time,
+                 const char *projname,
+                 u_long seqno,
+                 const lList *usage_weight_list,
+                 double sum_of_usage_weights )
 {
    double usage_value = 0;
    int project_node = 0;
@@ -284,7 +286,6 @@ sge_calc_node_usage( lListElem *node,
    lListElem *userprj = nullptr;
    const lList *usage_list=nullptr;
    const lListElem *usage_weight, *usage_elem;
-   double sum_of_usage_weights = 0;
    const char *usage_name;
    bool is_user = false;
 
@@ -344,7 +345,6 @@ sge_calc_node_usage( lListElem *node,
    }
 
    if (usage_list) {
-      lList *usage_weight_list = nullptr;
 
       /*-------------------------------------------------------------
        * Decay usage
@@ -354,19 +354,6 @@ sge_calc_node_usage( lListElem *node,
          decay_userprj_usage(userprj, is_user, decay_list, seqno, curr_time);
       }  
 
-      /*-------------------------------------------------------------
-       * Sum usage weighting factors
-       *-------------------------------------------------------------*/
-
-      if (sconf_is()) {
-         usage_weight_list = sconf_get_usage_weight_list();
-         if (usage_weight_list) {
-            for_each_ep(usage_weight, usage_weight_list)
-               sum_of_usage_weights +=
-                     lGetPosDouble(usage_weight, UA_value_POS);
-         }
-      }
-
       /*-------------------------------------------------------------
        * Combine user/project usage based on usage weighting factors
        *-------------------------------------------------------------*/
@@ -381,8 +368,6 @@ sge_calc_node_usage( lListElem *node,
          }
       }
 
-      lFreeList(&usage_weight_list);
-
       /*-------------------------------------------------------------
        * Store other usage values in node usage list
        *-------------------------------------------------------------*/
@@ -409,9 +394,10 @@ sge_calc_node_usage( lListElem *node,
 
       for_each_rw(child_node, children) {
          lListElem *nu;
-         child_usage += sge_calc_node_usage(child_node, user_list,
-                                            project_list, decay_list, curr_time,
-                                            projname, seqno);
+         child_usage += calc_node_usage(child_node, user_list,
+                                        project_list, decay_list, curr_time,
+                                        projname, seqno, usage_weight_list,
+                                        sum_of_usage_weights);
 
          /*-------------------------------------------------------------
           * Sum other usage values
@@ -479,6 +465,51 @@ sge_calc_node_usage( lListElem *node,
 }
 
 
+/*--------------------------------------------------------------------
+ * sge_calc_node_usage - calculate usage for this share tree node
+ * and all descendant nodes.
+ *
+ * The usage weighting factors are fetched from the scheduler
+ * configuration once for the whole tree.
+ *--------------------------------------------------------------------*/
+
+double
+sge_calc_node_usage( lListElem *node,
+                     const lList *user_list,
+                     const lList *project_list,
+                     const lList *decay_list,
+                     u_long64 curr_time,
+                     const char *projname,
+                     u_long seqno )
+{
+   lList *usage_weight_list = nullptr;
+   const lListElem *usage_weight;
+   double sum_of_usage_weights = 0;
+   double usage_value;
+
+   /*-------------------------------------------------------------
+    * Sum usage weighting factors
+    *-------------------------------------------------------------*/
+
+   if (sconf_is()) {
+      usage_weight_list = sconf_get_usage_weight_list();
+      if (usage_weight_list) {
+         for_each_ep(usage_weight, usage_weight_list)
+            sum_of_usage_weights +=
+                  lGetPosDouble(usage_weight, UA_value_POS);
+      }
+   }
+
+   usage_value = calc_node_usage(node, user_list, project_list, decay_list,
+                                 curr_time, projname, seqno, usage_weight_list,
+                                 sum_of_usage_weights);
+
+   lFreeList(&usage_weight_list);
+
+   return usage_value;
+}
+
+
 /*--------------------------------------------------------------------
  * sge_calc_node_proportions - calculate share tree node proportions
  * for this node and all descendant nodes.
@@ -42,6 +42,9 @@
 #include <unistd.h>
 #include <cfloat>
 #include <math.h>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_language.h"
@@ -1239,6 +1242,34 @@ combine_usage( sge_ref_t *ref )
 }
 
 
+/*--------------------------------------------------------------------
+ * usage_list_is_debited - true if the job usage equals the usage
+ * which was already debited to the user or project
+ *--------------------------------------------------------------------*/
+
+static bool
+usage_list_is_debited(const lList *job_usage_list,
+                      const lList *debited_usage_list)
+{
+   const lListElem *job_usage;
+
+   if (debited_usage_list == nullptr ||
+       lGetNumberOfElem(job_usage_list) != lGetNumberOfElem(debited_usage_list)) {
+      return false;
+   }
+
+   for_each_ep(job_usage, job_usage_list) {
+      const lListElem *debited_usage = lGetElemStr(debited_usage_list, UA_name, lGetString(job_usage, UA_name));
+
+      if (debited_usage == nullptr ||
+          lGetDouble(debited_usage, UA_value) != lGetDouble(job_usage, UA_value)) {
+         return false;
+      }
+   }
+
+   return true;
+}
+
 /*--------------------------------------------------------------------
  * decay_and_sum_usage - accumulates and decays usage in the correct
  * user and project objects for the specified job
@@ -1316,13 +1347,25 @@ decay_and_sum_usage( sge_ref_t *ref,
       }
    }
 
-   if (userprj) {
+   if (userprj && job_usage_list) {
       const lListElem *upu;
       const lList *upu_list = lGetList(userprj, obj_debited_job_usage);
       if (upu_list) {
          if ((upu = lGetElemUlong(upu_list, UPU_job_number, lGetUlong(job, JB_job_number)))) {
-            if ((old_usage_list = lGetListRW(upu, UPU_old_usage_list))) {
-               old_usage_list = lCopyList("", old_usage_list);
+            const lList *debited_usage_list = lGetList(upu, UPU_old_usage_list);
+
+            /*-------------------------------------------------------------
+             * Most running jobs did not report new usage since the last
+             * scheduling run. Their usage has already been added to the
+             * user and project objects, so there is nothing to sum up.
+             *-------------------------------------------------------------*/
+
+            if (usage_list_is_debited(job_usage_list, debited_usage_list)) {
+               lFreeList(&job_usage_list);
+               return;
+            }
+            if (debited_usage_list) {
+               old_usage_list = lCopyList("", debited_usage_list);
             }
          }
       }
@@ -2498,6 +2541,55 @@ static void calc_pending_job_functional_tickets(sge_ref_t *ref,
    return;
 }
 
+/* job references which are worth starting a thread for */
+#define MIN_JOBS_PER_TICKET_THREAD 1000
+
+/*--------------------------------------------------------------------
+ * job_ref_parallel - calls func(first, last, chunk) for consecutive
+ * chunks of the job references [0, num_jobs). The chunks are processed
+ * by up to threads threads, the calling thread processes chunk 0.
+ * Returns the number of chunks.
+ *
+ * func may only modify the job references of its chunk and their
+ * ja_tasks. Sums have to be collected per chunk and combined in chunk
+ * order by the caller, this way the result does not depend on the
+ * order in which the threads finish.
+ *--------------------------------------------------------------------*/
+
+template <typename F>
+static u_long32
+job_ref_parallel(u_long32 num_jobs, u_long32 threads, F func)
+{
+   u_long32 chunks = MIN(threads, num_jobs / MIN_JOBS_PER_TICKET_THREAD);
+   u_long32 chunk_size;
+   std::vector<std::thread> workers;
+
+   if (chunks <= 1) {
+      func(0, num_jobs, 0);
+      return 1;
+   }
+
+   chunk_size = (num_jobs + chunks - 1) / chunks;
+   for (u_long32 chunk = 1; chunk < chunks; chunk++) {
+      u_long32 first = chunk * chunk_size;
+      u_long32 last = MIN(num_jobs, first + chunk_size);
+
+      try {
+         workers.emplace_back(func, first, last, chunk);
+      } catch (const std::system_error &) {
+         /* no more threads available, do it ourselves */
+         func(first, last, chunk);
+      }
+   }
+   func(0, chunk_size, 0);
+
+   for (std::thread &worker : workers) {
+      worker.join();
+   }
+
+   return chunks;
+}
+
 /*--------------------------------------------------------------------
  * sge_calc_tickets - calculate proportional shares in terms of tickets
  * for all active jobs.
@@ -2523,7 +2615,7 @@ sge_calc_tickets( scheduler_all_data_t *lists,
           sum_of_pending_tickets = 0,
           sum_of_active_override_tickets = 0;
 
-   u_long32 num_jobs, num_queued_jobs, job_ndx;
+   u_long32 num_jobs, num_queued_jobs, num_active_jobs, job_ndx;
 
    u_long32 num_unenrolled_tasks = 0;
 
@@ -2538,6 +2630,7 @@ sge_calc_tickets( scheduler_all_data_t *lists,
    
    bool share_functional_shares = sconf_get_share_functional_shares();
    u_long32 max_pending_tasks_per_job = sconf_get_max_pending_tasks_per_job();
+   u_long32 ticket_threads = sconf_get_ticket_threads();
 
    lList *decay_list = nullptr;
 
@@ -2848,20 +2941,42 @@ sge_calc_tickets( scheduler_all_data_t *lists,
 
    DPRINTF("=====================[Pass 1]======================\n");
 
-   for(job_ndx=0; job_ndx<num_jobs; job_ndx++) {
-      if (job_ref[job_ndx].queued)
+   /* the running jobs are at the beginning of job_ref */
+   for(num_active_jobs=0; num_active_jobs<num_jobs; num_active_jobs++) {
+      if (job_ref[num_active_jobs].queued)
          break;
+   }
 
-      if (total_share_tree_tickets > 0)
+   /* sums up job shares in the share tree nodes, has to be done sequentially */
+   if (total_share_tree_tickets > 0) {
+      for(job_ndx=0; job_ndx<num_active_jobs; job_ndx++) {
          calc_job_share_tree_tickets_pass1(&job_ref[job_ndx]);
+      }
+   }
+
+   if (total_functional_tickets > 0) {
+      std::vector<double> user_fshares(ticket_threads), project_fshares(ticket_threads),
+                          department_fshares(ticket_threads), job_fshares(ticket_threads);
+      u_long32 chunks;
+
+      chunks = job_ref_parallel(num_active_jobs, ticket_threads,
+                                [&](u_long32 first, u_long32 last, u_long32 chunk) {
+         for (u_long32 i = first; i < last; i++) {
+            calc_job_functional_tickets_pass1(&job_ref[i],
+                                              &user_fshares[chunk],
+                                              &project_fshares[chunk],
+                                              &department_fshares[chunk],
+                                              &job_fshares[chunk],
+                                              share_functional_shares, 1);
+         }
+      });
 
-      if (total_functional_tickets > 0)
-         calc_job_functional_tickets_pass1(&job_ref[job_ndx],
-                                          &sum_of_user_functional_shares,
-                                          &sum_of_project_functional_shares,
-                                          &sum_of_department_functional_shares,
-                                          &sum_of_job_functional_shares,
-                                          share_functional_shares, 1);
+      for (u_long32 chunk = 0; chunk < chunks; chunk++) {
+         sum_of_user_functional_shares += user_fshares[chunk];
+         sum_of_project_functional_shares += project_fshares[chunk];
+         sum_of_department_functional_shares += department_fshares[chunk];
+         sum_of_job_functional_shares += job_fshares[chunk];
+      }
    }
 
    PROF_STOP_MEASUREMENT(SGE_PROF_SCHEDLIB4);
@@ -2876,6 +2991,8 @@ sge_calc_tickets( scheduler_all_data_t *lists,
    { 
       double weight[k_last];
       bool share_override_tickets = sconf_get_share_override_tickets();
+      std::vector<double> override_tickets(ticket_threads), active_tickets(ticket_threads);
+      u_long32 chunks;
 
       if(total_functional_tickets > 0) {
          get_functional_weighting_parameters(sum_of_user_functional_shares,
@@ -2885,36 +3002,35 @@ sge_calc_tickets( scheduler_all_data_t *lists,
                                        weight);
       }                                 
 
-      for(job_ndx=0; job_ndx<num_jobs; job_ndx++) {
-
-         /* stop, when teh first pending is found */
-         if (job_ref[job_ndx].queued) {
-            break;
+      chunks = job_ref_parallel(num_active_jobs, ticket_threads,
+                                [&](u_long32 first, u_long32 last, u_long32 chunk) {
+         for (u_long32 i = first; i < last; i++) {
+            if (total_share_tree_tickets > 0) {
+               calc_job_share_tree_tickets_pass2(&job_ref[i],
+                                              total_share_tree_tickets);
+            }                                  
+
+            if (total_functional_tickets > 0) {
+               calc_job_functional_tickets_pass2(&job_ref[i],
+                                              sum_of_user_functional_shares,
+                                              sum_of_project_functional_shares,
+                                              sum_of_department_functional_shares,
+                                              sum_of_job_functional_shares,
+                                              total_functional_tickets,
+                                              weight,
+                                              share_functional_shares);
+            }                                  
+
+            override_tickets[chunk] +=
+                     calc_job_override_tickets(&job_ref[i], share_override_tickets);
+
+            active_tickets[chunk] += calc_job_tickets(&job_ref[i]);
          }
+      });
 
-         job = job_ref[job_ndx].job;
-
-         if (total_share_tree_tickets > 0) {
-            calc_job_share_tree_tickets_pass2(&job_ref[job_ndx],
-                                           total_share_tree_tickets);
-         }                                  
-
-         if (total_functional_tickets > 0) {
-            calc_job_functional_tickets_pass2(&job_ref[job_ndx],
-                                           sum_of_user_functional_shares,
-                                           sum_of_project_functional_shares,
-                                           sum_of_department_functional_shares,
-                                           sum_of_job_functional_shares,
-                                           total_functional_tickets,
-                                           weight,
-                                           share_functional_shares);
-         }                                  
-
-         sum_of_active_override_tickets +=
-                  calc_job_override_tickets(&job_ref[job_ndx], share_override_tickets);
-
-         sum_of_active_tickets += calc_job_tickets(&job_ref[job_ndx]);
-
+      for (u_long32 chunk = 0; chunk < chunks; chunk++) {
+         sum_of_active_override_tickets += override_tickets[chunk];
+         sum_of_active_tickets += active_tickets[chunk];
       }
    }
 
@@ -3345,7 +3461,7 @@ sge_calc_tickets( scheduler_all_data_t *lists,
       prof_stop_measurement(SGE_PROF_SCHEDLIB4, nullptr);
       prof_calc = prof_get_measurement_wallclock(SGE_PROF_SCHEDLIB4, false, nullptr);
    
-      PROFILING("PROF: job ticket calculation: init: %.3f s, pass 0: %.3f s, pass 1: %.3f, pass2: %.3f, calc: %.3f s", prof_init, prof_pass0, prof_pass1, prof_pass2, prof_calc);
+      PROFILING("PROF: job ticket calculation: init: %.3f s, pass 0: %.3f s, pass 1: %.3f, pass2: %.3f, calc: %.3f s, threads: " sge_u32, prof_init, prof_pass0, prof_pass1, prof_pass2, prof_calc, ticket_threads);
    }
 
    DRETURN(sge_scheduling_run);
@@ -102,7 +102,8 @@ int sort_host_list(lList *hl, const lList *centry_list)
    lListElem *hlp = nullptr;
    lListElem *global = host_list_locate(hl, SGE_GLOBAL_NAME);
    lListElem *template_ep = host_list_locate(hl, SGE_TEMPLATE_NAME);
-   const char *load_formula = sconf_get_load_formula();
+   auto sconf = sconf_get_snapshot();
+   const char *load_formula = sconf->load_formula.empty() ? nullptr : sconf->load_formula.c_str();
    double load;
 
    DENTER(TOP_LAYER);
@@ -115,13 +116,16 @@ int sort_host_list(lList *hl, const lList *centry_list)
          DPRINTF("%s: %f\n", lGetHost(hlp, EH_name), load);
       }
    }
-   sge_free(&load_formula);
 
-   if (lPSortList(hl,"%I+", EH_sort_value)) {
-      DRETURN(-1);
-   } else {
-      DRETURN(0);
-   }
+   /* 
+    * sort the host list and attach a sort index to it, debiting jobs
+    * resorts single hosts with lResortElem() using the same sort order
+    */
+   lSortOrder *so = lParseSortOrderVarArg(lGetListDescr(hl), "%I+", EH_sort_value);
+   int ret = lSortIndexCreate(hl, so);
+   lFreeSortOrder(&so);
+
+   DRETURN(ret);
 }
 
 
@@ -155,6 +155,8 @@
 #include "sgeobj/cull/sge_proc_GR_L.h"
 #include "sgeobj/cull/sge_binding_BN_L.h"
 #include "sgeobj/cull/sge_pack_PACK_L.h"
+#include "sgeobj/cull/sge_cqueue_CQS_L.h"
+#include "sgeobj/cull/sge_gdi_page_PG_L.h"
 #if defined(__SGE_GDI_LIBRARY_HOME_OBJECT_FILE__)
 
 lNameSpace nmv[] = {
@@ -298,6 +300,8 @@ lNameSpace nmv[] = {
    {PRO_LOWERBOUND, PRO_SIZE, PRON, PRO_Type},
    {GR_LOWERBOUND, GR_SIZE, GRN, GR_Type},
    {BN_LOWERBOUND, BN_SIZE, BNN, BN_Type},
+   {CQS_LOWERBOUND, CQS_SIZE, CQSN, CQS_Type},
+   {PG_LOWERBOUND, PG_SIZE, PGN, PG_Type},
    {0, 0, nullptr, nullptr}
 };
 
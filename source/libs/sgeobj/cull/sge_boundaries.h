@@ -436,5 +436,11 @@ enum NameSpaceBoundaries {
    PACK_LOWERBOUND = BN_UPPERBOUND + 1,
    PACK_UPPERBOUND = PACK_LOWERBOUND + 2*BASIC_UNIT - 1,
 
+   CQS_LOWERBOUND = PACK_UPPERBOUND + 1,
+   CQS_UPPERBOUND = CQS_LOWERBOUND + 2*BASIC_UNIT - 1,
+
+   PG_LOWERBOUND = CQS_UPPERBOUND + 1,
+   PG_UPPERBOUND = PG_LOWERBOUND + 2*BASIC_UNIT - 1,
+
 };
 
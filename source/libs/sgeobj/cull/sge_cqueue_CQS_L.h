@@ -0,0 +1,171 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+/*
+ * This code was generated from file source/libs/sgeobj/json/CQS.json
+ * DO NOT CHANGE
+ */
+
+#include "cull/cull.h"
+#include "sgeobj/cull/sge_boundaries.h"
+
+/**
+* @brief Cluster Queue Summary
+*
+* One row of the cluster queue summary (qstat -g c).
+* The rows are computed by sge_qmaster when a SGE_GDI_GET request for the target SGE_QSTAT is received,
+* so that clients do not need to fetch the complete cluster queue, host and job lists.
+*
+*    SGE_STRING(CQS_name) - Cluster Queue Name
+*    Name of the cluster queue the summary row was computed for.
+*
+*    SGE_DOUBLE(CQS_load) - Load
+*    Average np_load_avg of all queue instances weighted by their slot count.
+*    Only valid if CQS_is_load_available is true.
+*
+*    SGE_BOOL(CQS_is_load_available) - Load Available
+*    True if at least one queue instance reported a np_load_avg value.
+*
+*    SGE_ULONG(CQS_used) - Used Slots
+*    Number of slots currently in use by jobs.
+*
+*    SGE_ULONG(CQS_resv) - Reserved Slots
+*    Number of slots currently reserved by advance or resource reservations.
+*
+*    SGE_ULONG(CQS_total) - Total Slots
+*    Number of configured slots of all queue instances.
+*
+*    SGE_ULONG(CQS_temp_disabled) - Temporarily Disabled Slots
+*    Slots of queue instances in one of the states aoACDS.
+*
+*    SGE_ULONG(CQS_available) - Available Slots
+*    Slots of queue instances that are not disabled, reduced by the used slots.
+*
+*    SGE_ULONG(CQS_manual_intervention) - Manual Intervention Slots
+*    Slots of queue instances in one of the states cdsuE.
+*
+*    SGE_ULONG(CQS_suspend_manual) - Manually Suspended Slots
+*    Slots of queue instances in state s.
+*
+*    SGE_ULONG(CQS_suspend_threshold) - Suspend Threshold Slots
+*    Slots of queue instances in state A.
+*
+*    SGE_ULONG(CQS_suspend_on_subordinate) - Subordinate Suspended Slots
+*    Slots of queue instances in state S.
+*
+*    SGE_ULONG(CQS_suspend_calendar) - Calendar Suspended Slots
+*    Slots of queue instances in state C.
+*
+*    SGE_ULONG(CQS_unknown) - Unknown Slots
+*    Slots of queue instances in state u.
+*
+*    SGE_ULONG(CQS_load_alarm) - Load Alarm Slots
+*    Slots of queue instances in state a.
+*
+*    SGE_ULONG(CQS_disabled_manual) - Manually Disabled Slots
+*    Slots of queue instances in state d.
+*
+*    SGE_ULONG(CQS_disabled_calendar) - Calendar Disabled Slots
+*    Slots of queue instances in state D.
+*
+*    SGE_ULONG(CQS_ambiguous) - Ambiguous Slots
+*    Slots of queue instances in state c.
+*
+*    SGE_ULONG(CQS_orphaned) - Orphaned Slots
+*    Slots of queue instances in state o.
+*
+*    SGE_ULONG(CQS_error) - Error Slots
+*    Slots of queue instances in state E.
+*
+*/
+
+enum {
+   CQS_name = CQS_LOWERBOUND,
+   CQS_load,
+   CQS_is_load_available,
+   CQS_used,
+   CQS_resv,
+   CQS_total,
+   CQS_temp_disabled,
+   CQS_available,
+   CQS_manual_intervention,
+   CQS_suspend_manual,
+   CQS_suspend_threshold,
+   CQS_suspend_on_subordinate,
+   CQS_suspend_calendar,
+   CQS_unknown,
+   CQS_load_alarm,
+   CQS_disabled_manual,
+   CQS_disabled_calendar,
+   CQS_ambiguous,
+   CQS_orphaned,
+   CQS_error
+};
+
+LISTDEF(CQS_Type)
+   SGE_STRING(CQS_name, CULL_PRIMARY_KEY)
+   SGE_DOUBLE(CQS_load, CULL_DEFAULT)
+   SGE_BOOL(CQS_is_load_available, CULL_DEFAULT)
+   SGE_ULONG(CQS_used, CULL_DEFAULT)
+   SGE_ULONG(CQS_resv, CULL_DEFAULT)
+   SGE_ULONG(CQS_total, CULL_DEFAULT)
+   SGE_ULONG(CQS_temp_disabled, CULL_DEFAULT)
+   SGE_ULONG(CQS_available, CULL_DEFAULT)
+   SGE_ULONG(CQS_manual_intervention, CULL_DEFAULT)
+   SGE_ULONG(CQS_suspend_manual, CULL_DEFAULT)
+   SGE_ULONG(CQS_suspend_threshold, CULL_DEFAULT)
+   SGE_ULONG(CQS_suspend_on_subordinate, CULL_DEFAULT)
+   SGE_ULONG(CQS_suspend_calendar, CULL_DEFAULT)
+   SGE_ULONG(CQS_unknown, CULL_DEFAULT)
+   SGE_ULONG(CQS_load_alarm, CULL_DEFAULT)
+   SGE_ULONG(CQS_disabled_manual, CULL_DEFAULT)
+   SGE_ULONG(CQS_disabled_calendar, CULL_DEFAULT)
+   SGE_ULONG(CQS_ambiguous, CULL_DEFAULT)
+   SGE_ULONG(CQS_orphaned, CULL_DEFAULT)
+   SGE_ULONG(CQS_error, CULL_DEFAULT)
+LISTEND
+
+NAMEDEF(CQSN)
+   NAME("CQS_name")
+   NAME("CQS_load")
+   NAME("CQS_is_load_available")
+   NAME("CQS_used")
+   NAME("CQS_resv")
+   NAME("CQS_total")
+   NAME("CQS_temp_disabled")
+   NAME("CQS_available")
+   NAME("CQS_manual_intervention")
+   NAME("CQS_suspend_manual")
+   NAME("CQS_suspend_threshold")
+   NAME("CQS_suspend_on_subordinate")
+   NAME("CQS_suspend_calendar")
+   NAME("CQS_unknown")
+   NAME("CQS_load_alarm")
+   NAME("CQS_disabled_manual")
+   NAME("CQS_disabled_calendar")
+   NAME("CQS_ambiguous")
+   NAME("CQS_orphaned")
+   NAME("CQS_error")
+NAMEEND
+
+#define CQS_SIZE sizeof(CQSN)/sizeof(char *)
+
+
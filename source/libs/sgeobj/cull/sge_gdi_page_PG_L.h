@@ -0,0 +1,63 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+/*
+ * This code was generated from file source/libs/sgeobj/json/PG.json
+ * DO NOT CHANGE
+ */
+
+#include "cull/cull.h"
+#include "sgeobj/cull/sge_boundaries.h"
+
+/**
+* @brief GDI Page Request
+*
+* Sent as data list of a SGE_GDI_GET request to ask for one page of a large master list.
+* sge_qmaster returns at most PG_limit elements having a key greater than PG_cursor,
+* sorted by the key. See sge_gdi_page_key() for the key of a GDI target.
+*
+*    SGE_ULONG(PG_limit) - Limit
+*    Maximum number of elements to be returned.
+*
+*    SGE_ULONG(PG_cursor) - Cursor
+*    Only elements with a key greater than the cursor are returned.
+*    The highest key of the previous page or 0 for the first page.
+*
+*/
+
+enum {
+   PG_limit = PG_LOWERBOUND,
+   PG_cursor
+};
+
+LISTDEF(PG_Type)
+   SGE_ULONG(PG_limit, CULL_DEFAULT)
+   SGE_ULONG(PG_cursor, CULL_DEFAULT)
+LISTEND
+
+NAMEDEF(PGN)
+   NAME("PG_limit")
+   NAME("PG_cursor")
+NAMEEND
+
+#define PG_SIZE sizeof(PGN)/sizeof(char *)
+
+
@@ -42,6 +42,7 @@
 *    GRU_HARD_REQUEST_TYPE
 *    GRU_SOFT_REQUEST_TYPE
 *    GRU_RESOURCE_MAP_TYPE
+*    GRU_BINDING_TYPE (cores selected for core binding, ids are <socket>,<core>)
 *
 *    SGE_STRING(GRU_name) - Name
 *    Name of the resource (complex variable name).
@@ -105,6 +105,9 @@
 *    SGE_ULONG(EH_featureset_id) - featureset id
 *    supported feature-set id @todo still used?
 *
+*    SGE_ULONG(EH_capabilities) - execd capabilities
+*    bitmask of the EH_CAP_* features the execd supports, reported when it registers at qmaster
+*
 *    SGE_LIST(EH_scaled_usage_list) - scaled usage
 *    scaled usage for jobs on a host - used by sge_host_mon @todo: still used?
 *
@@ -175,6 +178,7 @@ enum {
    EH_sge_ticket_pct,
    EH_sge_load_pct,
    EH_featureset_id,
+   EH_capabilities,
    EH_scaled_usage_list,
    EH_scaled_usage_pct_list,
    EH_num_running_jobs,
@@ -213,6 +217,7 @@ LISTDEF(EH_Type)
    SGE_DOUBLE(EH_sge_ticket_pct, CULL_DEFAULT)
    SGE_DOUBLE(EH_sge_load_pct, CULL_DEFAULT)
    SGE_ULONG(EH_featureset_id, CULL_DEFAULT)
+   SGE_ULONG(EH_capabilities, CULL_DEFAULT)
    SGE_LIST(EH_scaled_usage_list, UA_Type, CULL_DEFAULT)
    SGE_LIST(EH_scaled_usage_pct_list, UA_Type, CULL_DEFAULT)
    SGE_ULONG(EH_num_running_jobs, CULL_DEFAULT)
@@ -251,6 +256,7 @@ NAMEDEF(EHN)
    NAME("EH_sge_ticket_pct")
    NAME("EH_sge_load_pct")
    NAME("EH_featureset_id")
+   NAME("EH_capabilities")
    NAME("EH_scaled_usage_list")
    NAME("EH_scaled_usage_pct_list")
    NAME("EH_num_running_jobs")
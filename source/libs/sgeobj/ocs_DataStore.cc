@@ -112,6 +112,17 @@ namespace ocs {
       DRETURN_VOID;
    }
 
+   /**
+    * Returns the active data store of the calling thread.
+    *
+    * @return id of the data store selected with ocs::DataStore::select_active_ds()
+    */
+   DataStore::Id
+   DataStore::get_active_ds() {
+      GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
+      return obj_state->ds_id;
+   }
+
    /**
     * Returns the master list (RW-access) of the currently active data store for the specified type.
     *
@@ -0,0 +1,223 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <mutex>
+#include <vector>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "cull/cull_what.h"
+
+#include "ocs_PackCache.h"
+
+std::shared_mutex ocs::PackCache::mutex;
+std::unordered_map<std::string, ocs::PackCache::Entry> ocs::PackCache::entries[SGE_TYPE_ALL];
+
+/** @brief Returns the primary key of an object or nullptr if it has none */
+static const char *
+pack_cache_get_key(const lListElem *ep, int key_pos, bool is_host) {
+   return is_host ? lGetPosHost(ep, key_pos) : lGetPosString(ep, key_pos);
+}
+
+/**
+ * @brief Checks if objects of a type are cached
+ *
+ * Only configuration objects with a string or host as primary key are cached.
+ * Jobs, advance reservations and the other objects changing with every
+ * scheduling run are always packed.
+ *
+ * @param type object type
+ * @return true if objects of the type are cached
+ */
+bool
+ocs::PackCache::is_cacheable(sge_object_type type) {
+   switch (type) {
+      case SGE_TYPE_ADMINHOST:
+      case SGE_TYPE_CALENDAR:
+      case SGE_TYPE_CKPT:
+      case SGE_TYPE_EXECHOST:
+      case SGE_TYPE_MANAGER:
+      case SGE_TYPE_OPERATOR:
+      case SGE_TYPE_PE:
+      case SGE_TYPE_PROJECT:
+      case SGE_TYPE_CQUEUE:
+      case SGE_TYPE_SUBMITHOST:
+      case SGE_TYPE_USER:
+      case SGE_TYPE_USERSET:
+      case SGE_TYPE_HGROUP:
+      case SGE_TYPE_CENTRY:
+      case SGE_TYPE_RQS:
+         return true;
+      default:
+         return false;
+   }
+}
+
+/**
+ * @brief Checks if the answer of a GET request can be taken from the cache
+ *
+ * @param type  type of the requested master list
+ * @param where condition of the request
+ * @param what  enumeration of the request
+ * @return true if all attributes of all objects of a cacheable type are requested
+ */
+bool
+ocs::PackCache::is_cacheable_request(sge_object_type type, const lCondition *where, const lEnumeration *what) {
+   return where == nullptr && lIsWhatAll(what) && is_cacheable(type);
+}
+
+/**
+ * @brief Packs a master list like lSelectHashPack() does for an unfiltered request
+ *
+ * Objects found in the cache are copied into the pack buffer, all others are packed
+ * and added to the cache afterward. The caller has to hold the lock of the data store
+ * the list belongs to.
+ *
+ * @param pb   pack buffer
+ * @param lp   master list
+ * @param type type of the master list
+ * @param what enumeration of the request (requesting all attributes)
+ * @return PACK_SUCCESS or the error of the pack function that failed
+ */
+int
+ocs::PackCache::pack_list(sge_pack_buffer *pb, const lList *lp, sge_object_type type, const lEnumeration *what) {
+   DENTER(TOP_LAYER);
+
+   struct Packed {
+      const lListElem *ep;
+      const char *key;
+      size_t start;
+      size_t size;
+   };
+   std::vector<Packed> packed;
+   size_t offset = 0;
+   size_t used = 0;
+
+   // list header with the number of elements, all elements are packed
+   int ret = cull_pack_list_summary(pb, lp, what, "", &offset, &used);
+   if (ret != PACK_SUCCESS || lp == nullptr) {
+      DRETURN(ret);
+   }
+
+   int key_pos = lGetPosInDescr(lGetListDescr(lp), object_type_get_key_nm(type));
+   if (key_pos < 0) {
+      const lListElem *ep;
+
+      for_each_ep(ep, lp) {
+         if ((ret = cull_pack_elem(pb, ep)) != PACK_SUCCESS) {
+            break;
+         }
+      }
+      DRETURN(ret);
+   }
+   bool is_host = lGetPosType(lGetListDescr(lp), key_pos) == lHostT;
+
+   {
+      std::shared_lock lock(mutex);
+      const auto &cache = entries[type];
+      const lListElem *ep;
+
+      for_each_ep(ep, lp) {
+         const char *key = pack_cache_get_key(ep, key_pos, is_host);
+         auto it = key != nullptr ? cache.find(key) : cache.end();
+
+         // a modified object is a new element, even if the invalidation was missed
+         if (it != cache.end() && it->second.ep == ep) {
+            ret = packbuf(pb, it->second.bytes.data(), it->second.bytes.size());
+         } else {
+            size_t start = pb->bytes_used;
+
+            ret = cull_pack_elem(pb, ep);
+            if (key != nullptr && !pb->just_count) {
+               packed.push_back({ep, key, start, pb->bytes_used - start});
+            }
+         }
+         if (ret != PACK_SUCCESS) {
+            DRETURN(ret);
+         }
+      }
+   }
+
+   if (!packed.empty()) {
+      std::unique_lock lock(mutex);
+      auto &cache = entries[type];
+
+      for (const auto &p : packed) {
+         Entry &entry = cache[p.key];
+         entry.ep = p.ep;
+         entry.bytes.assign(pb->head_ptr + p.start, p.size);
+      }
+   }
+
+   DRETURN(ret);
+}
+
+/**
+ * @brief Removes an object from the cache
+ *
+ * @param type type of the object
+ * @param key  primary key of the object
+ */
+void
+ocs::PackCache::invalidate(sge_object_type type, const char *key) {
+   if (type >= SGE_TYPE_ALL || key == nullptr) {
+      return;
+   }
+   std::unique_lock lock(mutex);
+   entries[type].erase(key);
+}
+
+/**
+ * @brief Removes all objects of a type from the cache
+ *
+ * @param type object type
+ */
+void
+ocs::PackCache::invalidate(sge_object_type type) {
+   if (type >= SGE_TYPE_ALL) {
+      return;
+   }
+   std::unique_lock lock(mutex);
+   entries[type].clear();
+}
+
+/** @brief Removes all objects from the cache */
+void
+ocs::PackCache::clear() {
+   std::unique_lock lock(mutex);
+   for (auto &cache : entries) {
+      cache.clear();
+   }
+}
+
+/**
+ * @brief Returns the number of cached objects of a type
+ *
+ * @param type object type
+ * @return number of objects
+ */
+size_t
+ocs::PackCache::size(sge_object_type type) {
+   if (type >= SGE_TYPE_ALL) {
+      return 0;
+   }
+   std::shared_lock lock(mutex);
+   return entries[type].size();
+}
@@ -0,0 +1,65 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cull/cull.h"
+#include "cull/pack.h"
+
+#include "sgeobj/sge_object.h"
+
+namespace ocs {
+   /**
+    * @brief Packed objects of the reader data store
+    *
+    * Clients like qconf, qhost or qsub often fetch complete master lists from the reader
+    * data store although the objects rarely change. The cache keeps the packed representation
+    * of each object so that the answer of an unfiltered GET request can be assembled from
+    * these bytes. Only objects that were changed since they were packed the last time
+    * need to be packed again.
+    *
+    * The event mirror thread of the reader data store invalidates an object before it
+    * applies an event for this object.
+    */
+   class PackCache {
+   private:
+      struct Entry {
+         const lListElem *ep;          ///< object that was packed
+         std::string bytes;            ///< packed object
+      };
+
+      static std::shared_mutex mutex;                                   ///< secures the entries
+      static std::unordered_map<std::string, Entry> entries[SGE_TYPE_ALL]; ///< packed objects per type and key
+
+   public:
+      static bool is_cacheable(sge_object_type type);
+      static bool is_cacheable_request(sge_object_type type, const lCondition *where, const lEnumeration *what);
+
+      static int pack_list(sge_pack_buffer *pb, const lList *lp, sge_object_type type, const lEnumeration *what);
+
+      static void invalidate(sge_object_type type, const char *key);
+      static void invalidate(sge_object_type type);
+      static void clear();
+      static size_t size(sge_object_type type);
+   };
+}
@@ -0,0 +1,416 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <algorithm>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_range.h"
+
+#include "ocs_TaskIdSet.h"
+
+/** @brief Checks if the lower 16 bit of an id are part of the container */
+bool
+ocs::TaskIdSet::Container::contains(uint16_t low) const {
+   if (is_bitmap()) {
+      return (bitmap[low >> 6] & (uint64_t(1) << (low & 63))) != 0;
+   }
+   return std::binary_search(array.begin(), array.end(), low);
+}
+
+/** @brief Adds the lower 16 bit of an id, ids added in ascending order are appended */
+void
+ocs::TaskIdSet::Container::add(uint16_t low) {
+   if (is_bitmap()) {
+      uint64_t &word = bitmap[low >> 6];
+      uint64_t bit = uint64_t(1) << (low & 63);
+
+      if ((word & bit) == 0) {
+         word |= bit;
+         cardinality++;
+      }
+   } else {
+      if (array.empty() || array.back() < low) {
+         array.push_back(low);
+      } else {
+         auto it = std::lower_bound(array.begin(), array.end(), low);
+         if (*it == low) {
+            return;
+         }
+         array.insert(it, low);
+      }
+      cardinality++;
+      if (cardinality > ARRAY_MAX) {
+         to_bitmap();
+      }
+   }
+}
+
+/** @brief Adds all ids from low to high (lower 16 bit, both included) */
+void
+ocs::TaskIdSet::Container::add_range(uint32_t low, uint32_t high) {
+   if (!is_bitmap() && cardinality + (high - low + 1) <= ARRAY_MAX) {
+      for (uint32_t id = low; id <= high; id++) {
+         add(id);
+      }
+      return;
+   }
+
+   to_bitmap();
+   for (uint32_t id = low; id <= high;) {
+      uint32_t first_bit = id & 63;
+      uint32_t last_bit = std::min<uint32_t>(63, first_bit + (high - id));
+      uint64_t mask = (last_bit == 63 ? ~uint64_t(0) : (uint64_t(1) << (last_bit + 1)) - 1) &
+                      ~((uint64_t(1) << first_bit) - 1);
+      uint64_t &word = bitmap[id >> 6];
+
+      cardinality += __builtin_popcountll(mask & ~word);
+      word |= mask;
+      id += last_bit - first_bit + 1;
+   }
+}
+
+/** @brief Removes the lower 16 bit of an id */
+void
+ocs::TaskIdSet::Container::remove(uint16_t low) {
+   if (is_bitmap()) {
+      uint64_t &word = bitmap[low >> 6];
+      uint64_t bit = uint64_t(1) << (low & 63);
+
+      if ((word & bit) != 0) {
+         word &= ~bit;
+         cardinality--;
+      }
+   } else {
+      auto it = std::lower_bound(array.begin(), array.end(), low);
+      if (it != array.end() && *it == low) {
+         array.erase(it);
+         cardinality--;
+      }
+   }
+}
+
+/** @brief Switches the container to the bitmap representation */
+void
+ocs::TaskIdSet::Container::to_bitmap() {
+   if (!is_bitmap()) {
+      bitmap.assign(BITMAP_WORDS, 0);
+      for (uint16_t low : array) {
+         bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+      array.clear();
+      array.shrink_to_fit();
+   }
+}
+
+/** @brief Recalculates the cardinality and chooses the representation that fits the number of ids */
+void
+ocs::TaskIdSet::Container::normalize() {
+   if (is_bitmap()) {
+      cardinality = 0;
+      for (uint64_t word : bitmap) {
+         cardinality += __builtin_popcountll(word);
+      }
+      if (cardinality <= ARRAY_MAX) {
+         std::vector<uint16_t> ids;
+
+         ids.reserve(cardinality);
+         for_each([&ids](uint32_t low) { ids.push_back(low); });
+         bitmap.clear();
+         bitmap.shrink_to_fit();
+         array = std::move(ids);
+      }
+   } else {
+      cardinality = array.size();
+   }
+}
+
+/** @brief Calls f for the lower 16 bit of all ids in ascending order */
+template <typename F>
+void
+ocs::TaskIdSet::Container::for_each(F f) const {
+   if (is_bitmap()) {
+      for (uint32_t i = 0; i < BITMAP_WORDS; i++) {
+         uint64_t word = bitmap[i];
+
+         while (word != 0) {
+            f((i << 6) + __builtin_ctzll(word));
+            word &= word - 1;
+         }
+      }
+   } else {
+      for (uint16_t low : array) {
+         f(low);
+      }
+   }
+}
+
+/** @brief Creates a set containing all ids of a RN_Type list */
+ocs::TaskIdSet::TaskIdSet(const lList *range_list) {
+   add_range_list(range_list);
+}
+
+void
+ocs::TaskIdSet::add(u_long32 id) {
+   containers[id >> 16].add(id & 0xffff);
+}
+
+/**
+ * @brief Adds the ids start, start + step, ... up to end
+ *
+ * Ranges with step 1 are filled word by word.
+ */
+void
+ocs::TaskIdSet::add_range(u_long32 start, u_long32 end, u_long32 step) {
+   if (start > end) {
+      return;
+   }
+   if (step <= 1) {
+      uint64_t id = start;
+
+      while (id <= end) {
+         uint64_t high = id >> 16;
+         uint64_t chunk_end = std::min<uint64_t>(end, (high << 16) | 0xffff);
+
+         containers[high].add_range(id & 0xffff, chunk_end & 0xffff);
+         id = chunk_end + 1;
+      }
+   } else {
+      for (uint64_t id = start; id <= end; id += step) {
+         add(id);
+      }
+   }
+}
+
+/** @brief Adds all ids of a RN_Type list */
+void
+ocs::TaskIdSet::add_range_list(const lList *range_list) {
+   const lListElem *range;
+
+   for_each_ep(range, range_list) {
+      u_long32 start, end, step;
+
+      range_get_all_ids(range, &start, &end, &step);
+      add_range(start, end, step);
+   }
+}
+
+void
+ocs::TaskIdSet::remove(u_long32 id) {
+   auto it = containers.find(id >> 16);
+
+   if (it != containers.end()) {
+      it->second.remove(id & 0xffff);
+      if (it->second.cardinality == 0) {
+         containers.erase(it);
+      }
+   }
+}
+
+bool
+ocs::TaskIdSet::contains(u_long32 id) const {
+   auto it = containers.find(id >> 16);
+
+   return it != containers.end() && it->second.contains(id & 0xffff);
+}
+
+u_long32
+ocs::TaskIdSet::size() const {
+   u_long32 ret = 0;
+
+   for (const auto &[high, container] : containers) {
+      ret += container.cardinality;
+   }
+   return ret;
+}
+
+bool
+ocs::TaskIdSet::empty() const {
+   return containers.empty();
+}
+
+/** @brief Adds all ids of another set */
+void
+ocs::TaskIdSet::unite(const TaskIdSet &other) {
+   for (const auto &[high, other_container] : other.containers) {
+      auto it = containers.find(high);
+
+      if (it == containers.end()) {
+         containers.emplace(high, other_container);
+         continue;
+      }
+
+      Container &container = it->second;
+      if (container.is_bitmap() || other_container.is_bitmap()) {
+         container.to_bitmap();
+         if (other_container.is_bitmap()) {
+            for (uint32_t i = 0; i < BITMAP_WORDS; i++) {
+               container.bitmap[i] |= other_container.bitmap[i];
+            }
+         } else {
+            for (uint16_t low : other_container.array) {
+               container.bitmap[low >> 6] |= uint64_t(1) << (low & 63);
+            }
+         }
+      } else {
+         std::vector<uint16_t> ids;
+
+         ids.reserve(container.array.size() + other_container.array.size());
+         std::set_union(container.array.begin(), container.array.end(),
+                        other_container.array.begin(), other_container.array.end(), std::back_inserter(ids));
+         container.array = std::move(ids);
+         if (container.array.size() > ARRAY_MAX) {
+            container.to_bitmap();
+         }
+      }
+      container.normalize();
+   }
+}
+
+/** @brief Removes all ids that are part of another set */
+void
+ocs::TaskIdSet::subtract(const TaskIdSet &other) {
+   for (auto it = containers.begin(); it != containers.end();) {
+      auto other_it = other.containers.find(it->first);
+
+      if (other_it != other.containers.end()) {
+         Container &container = it->second;
+         const Container &other_container = other_it->second;
+
+         if (container.is_bitmap() && other_container.is_bitmap()) {
+            for (uint32_t i = 0; i < BITMAP_WORDS; i++) {
+               container.bitmap[i] &= ~other_container.bitmap[i];
+            }
+         } else if (container.is_bitmap()) {
+            for (uint16_t low : other_container.array) {
+               container.bitmap[low >> 6] &= ~(uint64_t(1) << (low & 63));
+            }
+         } else {
+            std::erase_if(container.array, [&other_container](uint16_t low) {
+               return other_container.contains(low);
+            });
+         }
+         container.normalize();
+         if (container.cardinality == 0) {
+            it = containers.erase(it);
+            continue;
+         }
+      }
+      ++it;
+   }
+}
+
+/** @brief Keeps only the ids that are also part of another set */
+void
+ocs::TaskIdSet::intersect(const TaskIdSet &other) {
+   for (auto it = containers.begin(); it != containers.end();) {
+      auto other_it = other.containers.find(it->first);
+
+      if (other_it == other.containers.end()) {
+         it = containers.erase(it);
+         continue;
+      }
+
+      Container &container = it->second;
+      const Container &other_container = other_it->second;
+      if (container.is_bitmap() && other_container.is_bitmap()) {
+         for (uint32_t i = 0; i < BITMAP_WORDS; i++) {
+            container.bitmap[i] &= other_container.bitmap[i];
+         }
+      } else if (container.is_bitmap()) {
+         std::vector<uint16_t> ids;
+
+         for (uint16_t low : other_container.array) {
+            if (container.contains(low)) {
+               ids.push_back(low);
+            }
+         }
+         container.bitmap.clear();
+         container.array = std::move(ids);
+      } else {
+         std::erase_if(container.array, [&other_container](uint16_t low) {
+            return !other_container.contains(low);
+         });
+      }
+      container.normalize();
+      if (container.cardinality == 0) {
+         it = containers.erase(it);
+      } else {
+         ++it;
+      }
+   }
+}
+
+/**
+ * @brief Creates a RN_Type list containing the ids of the set
+ *
+ * The ids are merged like range_list_compress() merges a list of single id ranges
+ * so that the list looks the same as one that was created id by id.
+ *
+ * @param name name of the new list
+ * @return new list, an empty list if the set is empty
+ */
+lList *
+ocs::TaskIdSet::to_range_list(const char *name) const {
+   struct Range {
+      u_long32 start;
+      u_long32 end;
+      u_long32 step;
+   };
+   std::vector<Range> ranges;
+
+   DENTER(BASIS_LAYER);
+
+   // same rules as range_list_compress() applied to one single id range after the other
+   for (const auto &[high, container] : containers) {
+      u_long32 base = high << 16;
+
+      container.for_each([&ranges, base](uint32_t low) {
+         u_long32 id = base | low;
+
+         if (ranges.empty()) {
+            ranges.push_back({id, id, 1});
+            return;
+         }
+
+         Range &range = ranges.back();
+         if (range.end + range.step == id) {
+            range.end = id;
+         } else if (range.start == range.end && range.step == 1) {
+            range.end = id;
+            range.step = id - range.start;
+         } else {
+            ranges.push_back({id, id, 1});
+         }
+      });
+   }
+
+   lList *range_list = lCreateList(name, RN_Type);
+   for (const Range &range : ranges) {
+      lListElem *ep = lCreateElem(RN_Type);
+
+      range_set_all_ids(ep, range.start, range.end, range.step);
+      lAppendElem(range_list, ep);
+   }
+
+   DRETURN(range_list);
+}
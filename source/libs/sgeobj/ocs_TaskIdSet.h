@@ -0,0 +1,84 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /**
+    * @brief Set of job array task ids
+    *
+    * Task ids of job arrays are stored as RN_Type range lists (e.g. JB_ja_n_h_ids). Calculating
+    * union, difference or intersection of such lists id by id needs time proportional to the number
+    * of ids times the number of ranges which is slow for arrays with millions of tasks and many holes.
+    *
+    * The set splits the 32 bit ids into the upper and the lower 16 bits. For each upper half a
+    * container keeps the lower halves either as sorted array (few ids) or as bitmap with one bit for
+    * each of the 65536 possible ids (many ids). Set operations work on the bitmap words.
+    *
+    * The result can be converted back into a compressed range list.
+    */
+   class TaskIdSet {
+   private:
+      static constexpr uint32_t ARRAY_MAX = 4096;     ///< max ids of a container stored as array
+      static constexpr uint32_t BITMAP_WORDS = 1024;  ///< 64 bit words of a container stored as bitmap
+
+      struct Container {
+         std::vector<uint16_t> array;     ///< sorted ids, used if bitmap is empty
+         std::vector<uint64_t> bitmap;    ///< one bit per id
+         uint32_t cardinality{0};         ///< number of ids
+
+         bool is_bitmap() const { return !bitmap.empty(); }
+         bool contains(uint16_t low) const;
+         void add(uint16_t low);
+         void add_range(uint32_t low, uint32_t high);
+         void remove(uint16_t low);
+         void to_bitmap();
+         void normalize();
+         template <typename F> void for_each(F f) const;
+      };
+
+      std::map<uint32_t, Container> containers;  ///< containers by upper 16 bit of the ids
+
+   public:
+      TaskIdSet() = default;
+      explicit TaskIdSet(const lList *range_list);
+
+      void add(u_long32 id);
+      void add_range(u_long32 start, u_long32 end, u_long32 step);
+      void add_range_list(const lList *range_list);
+      void remove(u_long32 id);
+
+      bool contains(u_long32 id) const;
+      u_long32 size() const;
+      bool empty() const;
+
+      void unite(const TaskIdSet &other);
+      void subtract(const TaskIdSet &other);
+      void intersect(const TaskIdSet &other);
+
+      lList *to_range_list(const char *name) const;
+   };
+}
@@ -0,0 +1,388 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "sgeobj/cull/sge_binding_BN_L.h"
+#include "sgeobj/cull/sge_job_JB_L.h"
+
+#include "ocs_TopologyMask.h"
+
+static bool
+mask_test(const std::vector<uint64_t> &mask, size_t bit) {
+   return (mask[bit >> 6] >> (bit & 63)) & 1;
+}
+
+static void
+mask_set(std::vector<uint64_t> &mask, size_t bit, bool value) {
+   if (value) {
+      mask[bit >> 6] |= (uint64_t{1} << (bit & 63));
+   } else {
+      mask[bit >> 6] &= ~(uint64_t{1} << (bit & 63));
+   }
+}
+
+/** @brief Parses a "<socket>,<core>" pair, returns the position behind it or nullptr */
+static const char *
+parse_socket_core(const char *str, size_t &socket, size_t &core) {
+   char *end;
+
+   if (!isdigit(*str)) {
+      return nullptr;
+   }
+   socket = strtoul(str, &end, 10);
+   if (*end != ',' || !isdigit(end[1])) {
+      return nullptr;
+   }
+   core = strtoul(end + 1, &end, 10);
+   return end;
+}
+
+/** @brief Initializes the mask from a topology string
+ *
+ * Accepts both the m_topology and the m_topology_inuse format.
+ * A core counts as used if it or one of its threads is shown in lowercase.
+ *
+ * @param topology_inuse topology string, e.g. "SCTTcttSCCcc"
+ * @return false if the string does not describe a topology, e.g. "NONE"
+ */
+bool ocs::TopologyMask::parse(const char *topology_inuse) {
+   std::vector<bool> core_used;
+
+   topology.clear();
+   core_pos.clear();
+   socket_start.clear();
+   used.clear();
+
+   if (topology_inuse == nullptr) {
+      return false;
+   }
+
+   for (size_t i = 0; topology_inuse[i] != '\0'; i++) {
+      char c = topology_inuse[i];
+
+      switch (c) {
+         case 'S':
+         case 's':
+            socket_start.push_back(core_pos.size());
+            break;
+         case 'C':
+         case 'c':
+            if (socket_start.empty()) {
+               return false;
+            }
+            core_pos.push_back(i);
+            core_used.push_back(c == 'c');
+            break;
+         case 'T':
+         case 't':
+            if (socket_start.empty() || core_pos.size() == socket_start.back()) {
+               // a thread needs a core on the same socket
+               core_pos.clear();
+               socket_start.clear();
+               return false;
+            }
+            if (c == 't') {
+               core_used.back() = true;
+            }
+            break;
+         default:
+            core_pos.clear();
+            socket_start.clear();
+            return false;
+      }
+   }
+
+   if (core_pos.empty()) {
+      socket_start.clear();
+      return false;
+   }
+
+   topology = topology_inuse;
+   socket_start.push_back(core_pos.size());
+   used.assign((core_pos.size() + 63) / 64, 0);
+   for (size_t core = 0; core < core_used.size(); core++) {
+      mask_set(used, core, core_used[core]);
+   }
+
+   return true;
+}
+
+size_t ocs::TopologyMask::find_socket_of(size_t core) const {
+   return std::upper_bound(socket_start.begin(), socket_start.end(), core) - socket_start.begin() - 1;
+}
+
+/** @brief Shows a socket in lowercase when none of its cores is free */
+void ocs::TopologyMask::update_socket_char(size_t socket) {
+   size_t socket_pos = core_pos[socket_start[socket]];
+
+   while (socket_pos > 0 && toupper(topology[socket_pos]) != 'S') {
+      socket_pos--;
+   }
+   topology[socket_pos] = get_free_cores(socket) == 0 ? 's' : 'S';
+}
+
+size_t ocs::TopologyMask::get_free_cores() const {
+   size_t free_cores = 0;
+
+   for (size_t core = 0; core < core_pos.size(); core++) {
+      if (!is_used(core)) {
+         free_cores++;
+      }
+   }
+   return free_cores;
+}
+
+size_t ocs::TopologyMask::get_free_cores(size_t socket) const {
+   size_t free_cores = 0;
+
+   for (size_t core = socket_start[socket]; core < socket_start[socket + 1]; core++) {
+      if (!is_used(core)) {
+         free_cores++;
+      }
+   }
+   return free_cores;
+}
+
+/** @brief Returns the host wide index of core number core on socket number socket */
+bool ocs::TopologyMask::find_core(size_t socket, size_t core, size_t &index) const {
+   if (socket >= get_sockets() || socket_start[socket] + core >= socket_start[socket + 1]) {
+      return false;
+   }
+   index = socket_start[socket] + core;
+   return true;
+}
+
+/** @brief Selects cores like the execution daemon's linear_automatic strategy
+ *
+ * Completely free sockets are filled first, the remaining cores are taken
+ * from the sockets having the most free cores.
+ */
+bool ocs::TopologyMask::select_linear_automatic(size_t amount, CoreList &cores) const {
+   std::vector<uint64_t> mask = used;
+   size_t sockets = get_sockets();
+
+   auto take = [&](size_t socket) {
+      for (size_t core = socket_start[socket]; core < socket_start[socket + 1] && cores.size() < amount; core++) {
+         if (!mask_test(mask, core)) {
+            mask_set(mask, core, true);
+            cores.push_back(core);
+         }
+      }
+   };
+
+   for (size_t socket = 0; socket < sockets && cores.size() < amount; socket++) {
+      if (get_free_cores(socket) == socket_start[socket + 1] - socket_start[socket]) {
+         take(socket);
+      }
+   }
+
+   while (cores.size() < amount) {
+      size_t best_socket = 0;
+      size_t best_free = 0;
+
+      for (size_t socket = 0; socket < sockets; socket++) {
+         size_t free_cores = 0;
+         for (size_t core = socket_start[socket]; core < socket_start[socket + 1]; core++) {
+            if (!mask_test(mask, core)) {
+               free_cores++;
+            }
+         }
+         if (free_cores > best_free) {
+            best_free = free_cores;
+            best_socket = socket;
+         }
+      }
+      if (best_free == 0) {
+         return false;
+      }
+      take(best_socket);
+   }
+
+   return true;
+}
+
+/** @brief Selects amount cores with a distance of step cores, starting at core first or behind */
+bool ocs::TopologyMask::select_striding(size_t amount, size_t step, size_t first, CoreList &cores) const {
+   size_t n_cores = core_pos.size();
+
+   if (step == 0) {
+      return false;
+   }
+
+   for (size_t start = first; start + (amount - 1) * step < n_cores; start++) {
+      bool possible = true;
+
+      for (size_t i = 0; i < amount; i++) {
+         if (is_used(start + i * step)) {
+            possible = false;
+            break;
+         }
+      }
+      if (possible) {
+         for (size_t i = 0; i < amount; i++) {
+            cores.push_back(start + i * step);
+         }
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/** @brief Selects the cores of an explicit request "explicit:<socket>,<core>:..." */
+bool ocs::TopologyMask::select_explicit(const char *request, CoreList &cores) const {
+   const char *prefix = "explicit:";
+
+   if (request == nullptr || strncmp(request, prefix, strlen(prefix)) != 0) {
+      return false;
+   }
+
+   const char *pos = request + strlen(prefix);
+   while (pos != nullptr && *pos != '\0') {
+      size_t socket, core, index;
+
+      pos = parse_socket_core(pos, socket, core);
+      if (pos == nullptr || !find_core(socket, core, index) || is_used(index) ||
+          std::find(cores.begin(), cores.end(), index) != cores.end()) {
+         return false;
+      }
+      cores.push_back(index);
+      if (*pos == ':') {
+         pos++;
+      }
+   }
+
+   return !cores.empty();
+}
+
+/** @brief Selects free cores for a binding request
+ *
+ * The cores are chosen following the strategy of the binding request (BN_Type)
+ * the same way the execution daemon would do it.
+ *
+ * @param binding binding request of a job (BN_Type)
+ * @param cores   out: host wide indices of the selected cores
+ * @return true if the request can be fulfilled
+ */
+bool ocs::TopologyMask::select(const lListElem *binding, CoreList &cores) const {
+   const char *strategy = lGetString(binding, BN_strategy);
+   size_t amount = lGetUlong(binding, BN_parameter_n);
+   size_t first = 0;
+
+   cores.clear();
+   if (strategy == nullptr || core_pos.empty()) {
+      return false;
+   }
+
+   if (strcmp(strategy, "explicit") == 0) {
+      return select_explicit(lGetString(binding, BN_parameter_explicit), cores);
+   }
+
+   if (amount == 0) {
+      return false;
+   }
+   if (strcmp(strategy, "linear") == 0 || strcmp(strategy, "striding") == 0) {
+      if (!find_core(lGetUlong(binding, BN_parameter_socket_offset), lGetUlong(binding, BN_parameter_core_offset),
+                     first)) {
+         return false;
+      }
+   }
+
+   if (strcmp(strategy, "linear_automatic") == 0) {
+      return select_linear_automatic(amount, cores);
+   } else if (strcmp(strategy, "linear") == 0) {
+      return select_striding(amount, 1, first, cores);
+   } else if (strcmp(strategy, "striding") == 0 || strcmp(strategy, "striding_automatic") == 0) {
+      return select_striding(amount, lGetUlong(binding, BN_parameter_striding_step_size), first, cores);
+   }
+
+   return false;
+}
+
+/** @brief Checks if all cores exist and are not in use */
+bool ocs::TopologyMask::is_free(const CoreList &cores) const {
+   for (size_t core : cores) {
+      if (core >= core_pos.size() || is_used(core)) {
+         return false;
+      }
+   }
+   return true;
+}
+
+/** @brief Marks cores as used or as free
+ *
+ * The cores and their threads are also shown in lower- or uppercase in the topology string.
+ *
+ * @return true if the state of at least one core changed
+ */
+bool ocs::TopologyMask::book(const CoreList &cores, bool in_use) {
+   bool changed = false;
+
+   for (size_t core : cores) {
+      if (core >= core_pos.size() || is_used(core) == in_use) {
+         continue;
+      }
+      mask_set(used, core, in_use);
+
+      size_t pos = core_pos[core];
+      topology[pos] = in_use ? 'c' : 'C';
+      for (pos++; pos < topology.size() && toupper(topology[pos]) == 'T'; pos++) {
+         topology[pos] = in_use ? 't' : 'T';
+      }
+      update_socket_char(find_socket_of(core));
+      changed = true;
+   }
+
+   return changed;
+}
+
+/** @brief Returns the "<socket>,<core>" ids of cores, e.g. to store them as resource map ids */
+void ocs::TopologyMask::get_ids(std::vector<std::string> &ids, const CoreList &cores) const {
+   for (size_t core : cores) {
+      size_t socket = find_socket_of(core);
+      ids.push_back(std::to_string(socket) + "," + std::to_string(core - socket_start[socket]));
+   }
+}
+
+/** @brief Returns the cores of "<socket>,<core>" ids, fails for ids the topology does not have */
+bool ocs::TopologyMask::parse_ids(const std::vector<std::string> &ids, CoreList &cores) const {
+   for (const std::string &id : ids) {
+      size_t socket, core, index;
+      const char *end = parse_socket_core(id.c_str(), socket, core);
+
+      if (end == nullptr || *end != '\0' || !find_core(socket, core, index)) {
+         return false;
+      }
+      cores.push_back(index);
+   }
+   return true;
+}
+
+/** @brief Checks if a job (JB_Type) requests core binding */
+bool ocs::TopologyMask::is_binding_requested(const lListElem *job) {
+   const lListElem *binding = lFirst(lGetList(job, JB_binding));
+   const char *strategy = binding != nullptr ? lGetString(binding, BN_strategy) : nullptr;
+
+   return strategy != nullptr && strcmp(strategy, "no_job_binding") != 0;
+}
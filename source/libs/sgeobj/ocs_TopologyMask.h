@@ -0,0 +1,79 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /** @brief Bitmask model of the cores of an execution host
+    *
+    * The execution daemon reports the topology of its host in the load values
+    * m_topology and m_topology_inuse, e.g. "SCTTCTTSCTTCTT" for two sockets with two
+    * cores having two threads each. In m_topology_inuse cores (and threads) which are
+    * bound by jobs are shown in lowercase.
+    *
+    * TopologyMask numbers the cores host wide in the order of the topology string and
+    * keeps one bit per core telling if it is in use. Core selection for a binding request
+    * therefore works on the bitmask while the string is only touched to reflect
+    * bookings in the m_topology_inuse load value.
+    */
+   class TopologyMask {
+   public:
+      using CoreList = std::vector<size_t>;
+
+   private:
+      std::string topology;               //< topology string in m_topology_inuse format
+      std::vector<size_t> core_pos;       //< position of each core in the topology string
+      std::vector<size_t> socket_start;   //< index of the first core of each socket, plus the core count
+      std::vector<uint64_t> used;         //< one bit per core, set if the core is in use
+
+      size_t find_socket_of(size_t core) const;
+      void update_socket_char(size_t socket);
+
+      bool select_linear_automatic(size_t amount, CoreList &cores) const;
+      bool select_striding(size_t amount, size_t step, size_t first, CoreList &cores) const;
+      bool select_explicit(const char *request, CoreList &cores) const;
+
+   public:
+      bool parse(const char *topology_inuse);
+      const std::string &get_topology() const { return topology; }
+
+      size_t get_cores() const { return core_pos.size(); }
+      size_t get_sockets() const { return socket_start.empty() ? 0 : socket_start.size() - 1; }
+      size_t get_free_cores() const;
+      size_t get_free_cores(size_t socket) const;
+
+      bool is_used(size_t core) const { return (used[core >> 6] >> (core & 63)) & 1; }
+      bool find_core(size_t socket, size_t core, size_t &index) const;
+
+      bool select(const lListElem *binding, CoreList &cores) const;
+      bool book(const CoreList &cores, bool in_use);
+      bool is_free(const CoreList &cores) const;
+
+      void get_ids(std::vector<std::string> &ids, const CoreList &cores) const;
+      bool parse_ids(const std::vector<std::string> &ids, CoreList &cores) const;
+
+      static bool is_binding_requested(const lListElem *job);
+   };
+}
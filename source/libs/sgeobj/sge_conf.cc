@@ -33,9 +33,11 @@
  *
  ************************************************************************/
 /*___INFO__MARK_END__*/
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <memory>
 #include <string>
 
 #ifdef LINUX
@@ -45,6 +47,7 @@
 #include "cull/cull.h"
 
 #include "uti/config_file.h"
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_lock.h"
 #include "uti/sge_log.h"
@@ -272,6 +275,21 @@ static bool enable_submit_ld_preload = false;
 std::string gperf_name = "gperf";
 std::string gperf_threads = "*";
 
+/*
+ * span tracing in qmaster, see ocs::SpanTrace
+ * spans are written to span_trace_file each time it is set to a new filename
+ */
+static bool span_trace = false;
+static std::string span_trace_file;
+
+/*
+ * compression of large messages sent by qmaster, see pb_compress()
+ * level 0 disables compression
+ */
+#define DEFAULT_COMPRESSION_THRESHOLD (64 * 1024)
+static int compression_level = 0;
+static int compression_threshold = DEFAULT_COMPRESSION_THRESHOLD;
+
 /*
  * notify_kill_default and notify_susp_default
  *       0  -> use the signal type stored in notify_kill and notify_susp
@@ -308,6 +326,133 @@ static void clean_conf();
 static int max_job_deletion_time = 3;
 static int jsv_timeout = 10;
 static int jsv_threshold = 5000;
+static int jsv_pool_size = 0;
+
+/*
+ * Snapshot of the scalar configuration values (RCU like).
+ *
+ * Writers (holding LOCK_MASTER_CONF as write lock) build a new immutable
+ * snapshot and swap the pointer. Readers cache the snapshot per thread and
+ * only fetch the current one if the version has changed. Old snapshots are
+ * released when the last thread has dropped its reference.
+ */
+static std::atomic<u_long64> Master_Config_Version{1};
+static std::shared_ptr<const mconf_snapshot_t> mconf_create_snapshot(u_long64 version);
+static std::shared_ptr<const mconf_snapshot_t> Master_Config_Snapshot = mconf_create_snapshot(1);
+static thread_local std::shared_ptr<const mconf_snapshot_t> Thread_Config_Snapshot;
+
+/*
+ * MT-NOTE: mconf_create_snapshot() is not MT safe, caller needs LOCK_MASTER_CONF
+ * MT-NOTE: (or is running the static initialization)
+ */
+static std::shared_ptr<const mconf_snapshot_t>
+mconf_create_snapshot(u_long64 version) {
+   auto snapshot = std::make_shared<mconf_snapshot_t>();
+
+   snapshot->version = version;
+   snapshot->min_uid = Master_Config.min_uid;
+   snapshot->min_gid = Master_Config.min_gid;
+   snapshot->load_report_time = Master_Config.load_report_time;
+   snapshot->max_unheard = Master_Config.max_unheard;
+   snapshot->loglevel = Master_Config.loglevel;
+   snapshot->token_extend_time = Master_Config.token_extend_time;
+   snapshot->zombie_jobs = Master_Config.zombie_jobs;
+   snapshot->is_new_config = is_new_config;
+   snapshot->reschedule_unknown = Master_Config.reschedule_unknown;
+   snapshot->max_aj_instances = Master_Config.max_aj_instances;
+   snapshot->max_aj_tasks = Master_Config.max_aj_tasks;
+   snapshot->max_u_jobs = Master_Config.max_u_jobs;
+   snapshot->max_jobs = Master_Config.max_jobs;
+   snapshot->max_advance_reservations = Master_Config.max_advance_reservations;
+   snapshot->reprioritize = Master_Config.reprioritize;
+   snapshot->auto_user_fshare = Master_Config.auto_user_fshare;
+   snapshot->auto_user_oticket = Master_Config.auto_user_oticket;
+   snapshot->auto_user_delete_time = Master_Config.auto_user_delete_time;
+   snapshot->is_monitor_message = is_monitor_message;
+   snapshot->use_qidle = use_qidle;
+   snapshot->forbid_reschedule = forbid_reschedule;
+   snapshot->forbid_apperror = forbid_apperror;
+   snapshot->do_credentials = do_credentials;
+   snapshot->do_authentication = do_authentication;
+   snapshot->acct_reserved_usage = acct_reserved_usage;
+   snapshot->sharetree_reserved_usage = sharetree_reserved_usage;
+   snapshot->keep_active = keep_active;
+   snapshot->enable_binding = enable_binding;
+   snapshot->enable_addgrp_kill = enable_addgrp_kill;
+   snapshot->pdc_interval = pdc_interval;
+   snapshot->enable_reschedule_kill = enable_reschedule_kill;
+   snapshot->enable_reschedule_slave = enable_reschedule_slave;
+   snapshot->old_reschedule_behavior = old_reschedule_behavior;
+   snapshot->old_reschedule_behavior_array_job = old_reschedule_behavior_array_job;
+   snapshot->simulate_execds = simulate_execds;
+   snapshot->simulate_jobs = simulate_jobs;
+   snapshot->ptf_max_priority = ptf_max_priority;
+   snapshot->ptf_min_priority = ptf_min_priority;
+   snapshot->use_qsub_gid = use_qsub_gid;
+   snapshot->notify_susp_type = notify_susp_type;
+   snapshot->notify_kill_type = notify_kill_type;
+   snapshot->disable_reschedule = disable_reschedule;
+   snapshot->disable_secondary_ds = disable_secondary_ds;
+   snapshot->disable_secondary_ds_reader = disable_secondary_ds_reader;
+   snapshot->disable_secondary_ds_execd = disable_secondary_ds_execd;
+   snapshot->disable_automatic_session = disable_automatic_sessions;
+   snapshot->scheduler_timeout = scheduler_timeout;
+   snapshot->max_dynamic_event_clients = max_dynamic_event_clients;
+   snapshot->set_lib_path = set_lib_path;
+   snapshot->inherit_env = inherit_env;
+   snapshot->spool_time = spool_time;
+   snapshot->max_ds_deviation = max_ds_deviation;
+   snapshot->monitor_time = monitor_time;
+   snapshot->do_accounting = do_accounting;
+   snapshot->do_reporting = do_reporting;
+   snapshot->do_joblog = do_joblog;
+   snapshot->reporting_flush_time = reporting_flush_time;
+   snapshot->accounting_flush_time = accounting_flush_time;
+   snapshot->old_accounting = old_accounting;
+   snapshot->old_reporting = old_reporting;
+   snapshot->sharelog_time = sharelog_time;
+   snapshot->log_consumables = log_consumables;
+   snapshot->enable_forced_qdel = enable_forced_qdel;
+#if defined(WITH_EXTENSIONS)
+   snapshot->enable_sup_grp_eval = enable_sup_grp_eval;
+#else
+   snapshot->enable_sup_grp_eval = false;
+#endif
+   snapshot->enable_enforce_master_limit = enable_enforce_master_limit;
+   snapshot->enable_test_sleep_after_request = enable_test_sleep_after_request;
+   snapshot->enable_forced_qdel_if_unknown = enable_forced_qdel_if_unknown;
+   snapshot->ignore_ngroups_max_limit = ignore_ngroups_max_limit;
+   snapshot->enable_submit_lib_path = enable_submit_lib_path;
+   snapshot->enable_submit_ld_preload = enable_submit_ld_preload;
+   snapshot->max_job_deletion_time = max_job_deletion_time;
+   snapshot->jsv_threshold = jsv_threshold;
+   snapshot->jsv_timeout = jsv_timeout;
+   snapshot->jsv_pool_size = jsv_pool_size;
+   snapshot->script_timeout = script_timeout;
+
+   return snapshot;
+}
+
+/* MT-NOTE: mconf_publish_snapshot() is not MT safe, caller needs LOCK_MASTER_CONF as write lock */
+static void
+mconf_publish_snapshot() {
+   u_long64 version = Master_Config_Version.load() + 1;
+
+   std::atomic_store(&Master_Config_Snapshot, mconf_create_snapshot(version));
+   Master_Config_Version.store(version, std::memory_order_release);
+}
+
+/* MT-NOTE: mconf_thread_snapshot() is MT safe, the returned pointer is valid until the next call in the same thread */
+static inline const mconf_snapshot_t *
+mconf_thread_snapshot() {
+   const mconf_snapshot_t *snapshot = Thread_Config_Snapshot.get();
+
+   if (snapshot == nullptr || snapshot->version != Master_Config_Version.load(std::memory_order_acquire)) {
+      Thread_Config_Snapshot = std::atomic_load(&Master_Config_Snapshot);
+      snapshot = Thread_Config_Snapshot.get();
+   }
+   return snapshot;
+}
 
 #define MAILER                    "/bin/mail"
 #define PROLOG                    "none"
@@ -653,6 +798,7 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
    SGE_LOCK(LOCK_MASTER_CONF, LOCK_WRITE);
    clean_conf();
    setConfFromCull(*lpp);
+   mconf_publish_snapshot();
    SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_WRITE);
 
    /* put contents of qmaster_params and execd_params  
@@ -667,6 +813,7 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
 #ifdef LINUX
       bool mtrace_before = enable_mtrace;
 #endif
+      std::string span_trace_file_before = span_trace_file;
 
       SGE_LOCK(LOCK_MASTER_CONF, LOCK_WRITE);
       forbid_reschedule = false;
@@ -706,8 +853,13 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
       old_reschedule_behavior_array_job = false;
       jsv_threshold = 5000;
       jsv_timeout= 10;
+      jsv_pool_size = 0;
       enable_submit_lib_path = false;
       enable_submit_ld_preload = false;
+      span_trace = false;
+      span_trace_file = "";
+      compression_level = 0;
+      compression_threshold = DEFAULT_COMPRESSION_THRESHOLD;
 
       for (s=sge_strtok_r(qmaster_params, PARAMS_DELIMITER, &conf_context); s; s=sge_strtok_r(nullptr, PARAMS_DELIMITER, &conf_context)) {
          if (parse_bool_param(s, "FORBID_RESCHEDULE", &forbid_reschedule)) {
@@ -858,6 +1010,15 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
             }
             continue;
          }
+         if (parse_int_param(s, "jsv_pool_size", &jsv_pool_size, TYPE_INT)) {
+            if (jsv_pool_size < 0) {
+               answer_list_add_sprintf(answer_list, STATUS_ESYNTAX, ANSWER_QUALITY_WARNING,
+                                       MSG_CONF_INVALIDPARAM_SSI, "qmaster_params", "jsv_pool_size",
+                                       0);
+               jsv_pool_size = 0;
+            }
+            continue;
+         }
          if (parse_bool_param(s, "ENABLE_SUBMIT_LIB_PATH", &enable_submit_lib_path)) {
             continue;
          }
@@ -870,7 +1031,31 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
          if (parse_string_param(s, "GPERF_THREADS", gperf_threads)) {
             continue;
          }
+         if (parse_bool_param(s, "SPAN_TRACE", &span_trace)) {
+            continue;
+         }
+         if (parse_string_param(s, "SPAN_TRACE_FILE", span_trace_file)) {
+            continue;
+         }
+         if (parse_int_param(s, "COMPRESSION_LEVEL", &compression_level, TYPE_INT)) {
+            if (compression_level < 0 || compression_level > 9) {
+               answer_list_add_sprintf(answer_list, STATUS_ESYNTAX, ANSWER_QUALITY_WARNING,
+                                       MSG_CONF_INVALIDPARAM_SSI, "qmaster_params", "COMPRESSION_LEVEL", 0);
+               compression_level = 0;
+            }
+            continue;
+         }
+         if (parse_int_param(s, "COMPRESSION_THRESHOLD", &compression_threshold, TYPE_MEM)) {
+            if (compression_threshold < 0) {
+               answer_list_add_sprintf(answer_list, STATUS_ESYNTAX, ANSWER_QUALITY_WARNING,
+                                       MSG_CONF_INVALIDPARAM_SSI, "qmaster_params", "COMPRESSION_THRESHOLD",
+                                       DEFAULT_COMPRESSION_THRESHOLD);
+               compression_threshold = DEFAULT_COMPRESSION_THRESHOLD;
+            }
+            continue;
+         }
       }
+      mconf_publish_snapshot();
       SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_WRITE);
       sge_free_saved_vars(conf_context);
       conf_context = nullptr;
@@ -890,6 +1075,21 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
       }
 #endif
 
+      if (progid == QMASTER) {
+         pb_set_compression(compression_level, compression_threshold);
+         ocs::SpanTrace::set_enabled(span_trace);
+         if (!span_trace_file.empty() && span_trace_file != span_trace_file_before) {
+            DSTRING_STATIC(error_dstr, MAX_STRING_SIZE);
+            u_long32 written = 0;
+
+            if (ocs::SpanTrace::dump(span_trace_file.c_str(), &error_dstr, &written)) {
+               INFO(MSG_CONF_SPANTRACEWRITTEN_US, written, span_trace_file.c_str());
+            } else {
+               WARNING(SFNMAX, sge_dstring_get_string(&error_dstr));
+            }
+         }
+      }
+
       conf_update_thread_profiling(nullptr);
 
       /* always initialize to defaults before we check execd_params */
@@ -1088,6 +1288,7 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
             continue;
          } 
       }
+      mconf_publish_snapshot();
       SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_WRITE);
       sge_free_saved_vars(conf_context);
       conf_context = nullptr;
@@ -1144,6 +1345,7 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
             continue;
          }
       }
+      mconf_publish_snapshot();
       SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_WRITE);
       sge_free_saved_vars(conf_context);
       conf_context=nullptr;
@@ -1346,6 +1548,19 @@ void conf_update_thread_profiling(const char *thread_name)
    DRETURN_VOID;
 }
 
+/**
+ * @brief Returns a copy of the current scalar configuration values.
+ *
+ * The copy does not change if a new configuration is set in the meantime.
+ * Fetch it once per request or scheduling run to work with consistent values.
+ *
+ * @return the configuration snapshot
+ * @note MT-NOTE: mconf_get_snapshot() is MT safe, no lock is taken
+ */
+mconf_snapshot_t mconf_get_snapshot() {
+   return *mconf_thread_snapshot();
+}
+
 /* returned pointer needs to be freed */
 char* mconf_get_execd_spool_dir() {
    char* execd_spool_dir = nullptr;
@@ -1452,63 +1667,23 @@ char* mconf_get_login_shells() {
 }
 
 u_long32 mconf_get_min_uid() {
-   u_long32 min_uid;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   min_uid = Master_Config.min_uid;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(min_uid);
+   return mconf_thread_snapshot()->min_uid;
 }
 
 u_long32 mconf_get_min_gid() {
-   u_long32 min_gid;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   min_gid = Master_Config.min_gid;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(min_gid);
+   return mconf_thread_snapshot()->min_gid;
 }
 
 u_long32 mconf_get_load_report_time() {
-   u_long32 load_report_time;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   load_report_time = Master_Config.load_report_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(load_report_time);
+   return mconf_thread_snapshot()->load_report_time;
 }
 
 u_long32 mconf_get_max_unheard() {
-   u_long32 max_unheard;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   max_unheard = Master_Config.max_unheard;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(max_unheard);
+   return mconf_thread_snapshot()->max_unheard;
 }
 
 u_long32 mconf_get_loglevel() {
-   u_long32 loglevel;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   loglevel = Master_Config.loglevel;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(loglevel);
+   return mconf_thread_snapshot()->loglevel;
 }
 
 /* returned pointer needs to be freed */
@@ -1630,15 +1805,7 @@ char* mconf_get_pag_cmd() {
 }
 
 u_long32 mconf_get_token_extend_time() {
-   u_long32 token_extend_time;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   token_extend_time = Master_Config.token_extend_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(token_extend_time);
+   return mconf_thread_snapshot()->token_extend_time;
 }
 
 /* returned pointer needs to be freed */
@@ -1707,15 +1874,7 @@ char* mconf_get_gid_range() {
 }
 
 u_long32 mconf_get_zombie_jobs() {
-   u_long32 zombie_jobs;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   zombie_jobs = Master_Config.zombie_jobs;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(zombie_jobs);
+   return mconf_thread_snapshot()->zombie_jobs;
 }
 
 /* returned pointer needs to be freed */
@@ -1764,21 +1923,14 @@ void mconf_set_new_config(bool new_config)
    
    is_new_config = new_config;
    
+   mconf_publish_snapshot();
    SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_WRITE);
    DRETURN_VOID;
 }
 
 /* make chached values from configuration invalid. */
 bool mconf_is_new_config() {
-   bool is;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   is = is_new_config;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(is);
+   return mconf_thread_snapshot()->is_new_config;
 }
 
 /* returned pointer needs to be freed */
@@ -1849,111 +2001,39 @@ char* mconf_get_rlogin_command() {
 }
 
 u_long32 mconf_get_reschedule_unknown() {
-   u_long32 reschedule_unknown;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   reschedule_unknown = Master_Config.reschedule_unknown;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(reschedule_unknown);
+   return mconf_thread_snapshot()->reschedule_unknown;
 }
 
 u_long32 mconf_get_max_aj_instances() {
-   u_long32 max_aj_instances;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   max_aj_instances = Master_Config.max_aj_instances;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(max_aj_instances);
+   return mconf_thread_snapshot()->max_aj_instances;
 }
 
 u_long32 mconf_get_max_aj_tasks() {
-   u_long32 max_aj_tasks;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   max_aj_tasks = Master_Config.max_aj_tasks;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(max_aj_tasks);
+   return mconf_thread_snapshot()->max_aj_tasks;
 }
 
 u_long32 mconf_get_max_u_jobs() {
-   u_long32 max_u_jobs;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   max_u_jobs = Master_Config.max_u_jobs;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(max_u_jobs);
+   return mconf_thread_snapshot()->max_u_jobs;
 }
 
 u_long32 mconf_get_max_jobs() {
-   u_long32 max_jobs;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   max_jobs = Master_Config.max_jobs;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(max_jobs);
+   return mconf_thread_snapshot()->max_jobs;
 }
 
 u_long32 mconf_get_max_advance_reservations() {
-   u_long32 max_advance_reservations;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   max_advance_reservations = Master_Config.max_advance_reservations;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(max_advance_reservations);
+   return mconf_thread_snapshot()->max_advance_reservations;
 }
 
 u_long32 mconf_get_reprioritize() {
-   u_long32 reprioritize;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   reprioritize = Master_Config.reprioritize;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(reprioritize);
+   return mconf_thread_snapshot()->reprioritize;
 }
 
 u_long32 mconf_get_auto_user_fshare() {
-   u_long32 auto_user_fshare;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   auto_user_fshare = Master_Config.auto_user_fshare;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(auto_user_fshare);
+   return mconf_thread_snapshot()->auto_user_fshare;
 }
 
 u_long32 mconf_get_auto_user_oticket() {
-   u_long32 auto_user_oticket;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   auto_user_oticket = Master_Config.auto_user_oticket;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(auto_user_oticket);
+   return mconf_thread_snapshot()->auto_user_oticket;
 }
 
 /* returned pointer needs to be freed */
@@ -1970,15 +2050,7 @@ char* mconf_get_auto_user_default_project() {
 }
 
 u_long32 mconf_get_auto_user_delete_time() {
-   u_long32 auto_user_delete_time;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   auto_user_delete_time = Master_Config.auto_user_delete_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(auto_user_delete_time);
+   return mconf_thread_snapshot()->auto_user_delete_time;
 }
 
 /* returned pointer needs to be freed */
@@ -1997,134 +2069,47 @@ char* mconf_get_delegated_file_staging() {
 
 /* params */
 bool mconf_is_monitor_message() {
-  bool is;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   is = is_monitor_message;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(is);
+   return mconf_thread_snapshot()->is_monitor_message;
 }
 
 bool mconf_get_use_qidle() {
-   bool idle;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   idle = use_qidle;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(idle);
+   return mconf_thread_snapshot()->use_qidle;
 }
 
 bool mconf_get_forbid_reschedule() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = forbid_reschedule;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->forbid_reschedule;
 }
 
 bool mconf_get_forbid_apperror() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = forbid_apperror;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->forbid_apperror;
 }
 
 bool mconf_get_do_credentials() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = do_credentials;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->do_credentials;
 }
 
 bool mconf_get_do_authentication() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = do_authentication;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->do_authentication;
 }
 
 bool mconf_get_acct_reserved_usage() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = acct_reserved_usage;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->acct_reserved_usage;
 }
 
 bool mconf_get_sharetree_reserved_usage() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = sharetree_reserved_usage;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->sharetree_reserved_usage;
 }
 
 keep_active_t mconf_get_keep_active() {
-   keep_active_t ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = keep_active;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->keep_active;
 }
 
 bool mconf_get_enable_binding() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_binding;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_binding;
 }
 
 bool mconf_get_enable_addgrp_kill() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_addgrp_kill;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_addgrp_kill;
 }
 
 /** @brief Get the value of the PDC_INTERVAL configuration parameter.
@@ -2136,44 +2121,19 @@ bool mconf_get_enable_addgrp_kill() {
  * @return The value of the pdc_interval configuration parameter.
  */
 u_long64 mconf_get_pdc_interval() {
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-   u_long64 ret = pdc_interval;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->pdc_interval;
 }
 
 bool mconf_get_enable_reschedule_kill() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_reschedule_kill;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_reschedule_kill;
 }
 
 bool mconf_get_enable_reschedule_slave() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_reschedule_slave;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_reschedule_slave;
 }
 
 bool mconf_get_old_reschedule_behavior() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = old_reschedule_behavior;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->old_reschedule_behavior;
 }
 
 std::string mconf_get_gperf_name() {
@@ -2193,86 +2153,31 @@ std::string mconf_get_gperf_threads() {
 }
 
 bool mconf_get_old_reschedule_behavior_array_job() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = old_reschedule_behavior_array_job;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-}
+   return mconf_thread_snapshot()->old_reschedule_behavior_array_job;
+}
 
 bool mconf_get_simulate_execds() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = simulate_execds;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->simulate_execds;
 }
 
 bool mconf_get_simulate_jobs() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = simulate_jobs;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->simulate_jobs;
 }
 
 long mconf_get_ptf_max_priority() {
-   long ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = ptf_max_priority;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->ptf_max_priority;
 }
 
 long mconf_get_ptf_min_priority() {
-   long ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = ptf_min_priority;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->ptf_min_priority;
 }
 
 bool mconf_get_use_qsub_gid() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = use_qsub_gid;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->use_qsub_gid;
 }
 
 int mconf_get_notify_susp_type() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = notify_susp_type;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->notify_susp_type;
 }
 
 /* returned pointer needs to be freed */
@@ -2289,15 +2194,7 @@ char* mconf_get_notify_susp() {
 }
 
 int mconf_get_notify_kill_type() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = notify_kill_type;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->notify_kill_type;
 }
 
 /* returned pointer needs to be freed */
@@ -2314,75 +2211,27 @@ char* mconf_get_notify_kill() {
 }
 
 bool mconf_get_disable_reschedule() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = disable_reschedule;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->disable_reschedule;
 }
 
 bool mconf_get_disable_secondary_ds() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = disable_secondary_ds;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->disable_secondary_ds;
 }
 
 bool mconf_get_disable_secondary_ds_reader() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = disable_secondary_ds_reader;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->disable_secondary_ds_reader;
 }
 
 bool mconf_get_disable_secondary_ds_execd() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = disable_secondary_ds_execd;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->disable_secondary_ds_execd;
 }
 
 bool mconf_get_disable_automatic_session() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = disable_automatic_sessions;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->disable_automatic_session;
 }
 
 int mconf_get_scheduler_timeout() {
-   int timeout;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   timeout = scheduler_timeout;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(timeout);
+   return mconf_thread_snapshot()->scheduler_timeout;
 }
 
 void mconf_set_max_dynamic_event_clients(int value) {
@@ -2392,194 +2241,70 @@ void mconf_set_max_dynamic_event_clients(int value) {
 
    max_dynamic_event_clients = value;
 
+   mconf_publish_snapshot();
    SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_WRITE);
    DRETURN_VOID;
 }
 
 int mconf_get_max_dynamic_event_clients() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = max_dynamic_event_clients;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->max_dynamic_event_clients;
 }
 
 bool mconf_get_set_lib_path() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = set_lib_path;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->set_lib_path;
 }
 
 bool mconf_get_inherit_env() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = inherit_env;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->inherit_env;
 }
 
 // spooling interval in seconds
 int mconf_get_spool_time() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = spool_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->spool_time;
 }
 
 int mconf_get_max_ds_deviation() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = max_ds_deviation;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->max_ds_deviation;
 }
 
 u_long32 mconf_get_monitor_time() {
-   u_long32 monitor;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   monitor = monitor_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(monitor);
-
+   return mconf_thread_snapshot()->monitor_time;
 }
 
 bool mconf_get_do_accounting() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = do_accounting;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->do_accounting;
 }
 
 bool mconf_get_do_reporting() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = do_reporting;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->do_reporting;
 }
 
 bool mconf_get_do_joblog() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = do_joblog;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->do_joblog;
 }
 
 int mconf_get_reporting_flush_time() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = reporting_flush_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->reporting_flush_time;
 }
 
 int mconf_get_accounting_flush_time() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = accounting_flush_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->accounting_flush_time;
 }
 
 bool mconf_get_old_accounting() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = old_accounting;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->old_accounting;
 }
 
 bool mconf_get_old_reporting() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = old_reporting;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->old_reporting;
 }
 
 int mconf_get_sharelog_time() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = sharelog_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->sharelog_time;
 }
 
 int mconf_get_log_consumables() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = log_consumables;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->log_consumables;
 }
 
 std::string mconf_get_usage_patterns() {
@@ -2595,106 +2320,39 @@ std::string mconf_get_usage_patterns() {
 }
 
 bool mconf_get_enable_forced_qdel() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_forced_qdel;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->enable_forced_qdel;
 }
 
 bool mconf_get_enable_sup_grp_eval() {
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-   bool ret = false;
-#if defined(WITH_EXTENSIONS)
-   ret = enable_sup_grp_eval;
-#endif
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->enable_sup_grp_eval;
 }
 
 bool mconf_get_enable_enforce_master_limit() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-   ret = enable_enforce_master_limit;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->enable_enforce_master_limit;
 }
 
 bool mconf_get_enable_test_sleep_after_request() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-   ret = enable_test_sleep_after_request;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
-
+   return mconf_thread_snapshot()->enable_test_sleep_after_request;
 }
 
 bool mconf_get_enable_forced_qdel_if_unknown() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-   ret = enable_forced_qdel_if_unknown;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_forced_qdel_if_unknown;
 }
 
 bool mconf_get_ignore_ngroups_max_limit() {
-   bool ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-   ret = ignore_ngroups_max_limit;
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->ignore_ngroups_max_limit;
 }
 
 bool mconf_get_enable_submit_lib_path() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_submit_lib_path;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_submit_lib_path;
 }
 
 bool mconf_get_enable_submit_ld_preload() {
-   int ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = enable_submit_ld_preload;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->enable_submit_ld_preload;
 }
 
 int mconf_get_max_job_deletion_time() {
-   int deletion_time;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   deletion_time = max_job_deletion_time;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(deletion_time);
+   return mconf_thread_snapshot()->max_job_deletion_time;
 }
 
 void mconf_get_h_descriptors(char **pret) {
@@ -2778,38 +2436,18 @@ void mconf_get_s_locks(char **pret) {
 }
 
 int mconf_get_jsv_threshold() {
-   int threshold;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   threshold = jsv_threshold;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(threshold);
+   return mconf_thread_snapshot()->jsv_threshold;
 }
 
 int mconf_get_jsv_timeout() {
-   int timeout;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   timeout = jsv_timeout;
+   return mconf_thread_snapshot()->jsv_timeout;
+}
 
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(timeout);
+int mconf_get_jsv_pool_size() {
+   return mconf_thread_snapshot()->jsv_pool_size;
 }
 
 u_long32 mconf_get_script_timeout() {
-   u_long32 ret;
-
-   DENTER(BASIS_LAYER);
-   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
-
-   ret = script_timeout;
-
-   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
-   DRETURN(ret);
+   return mconf_thread_snapshot()->script_timeout;
 }
 
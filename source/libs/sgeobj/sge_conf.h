@@ -55,6 +55,93 @@ typedef enum {
    KEEP_ACTIVE_ERROR
 } keep_active_t;
 
+/**
+ * @brief Immutable copy of the scalar values of the cluster configuration.
+ *
+ * A new snapshot is published whenever the configuration changes. Threads
+ * needing several values which fit together (e.g. for one request or one
+ * scheduling run) fetch a copy once with mconf_get_snapshot() and read
+ * it without any locking.
+ */
+struct mconf_snapshot_t {
+   u_long64      version;
+   u_long32      min_uid;
+   u_long32      min_gid;
+   u_long32      load_report_time;
+   u_long32      max_unheard;
+   u_long32      loglevel;
+   u_long32      token_extend_time;
+   u_long32      zombie_jobs;
+   bool          is_new_config;
+   u_long32      reschedule_unknown;
+   u_long32      max_aj_instances;
+   u_long32      max_aj_tasks;
+   u_long32      max_u_jobs;
+   u_long32      max_jobs;
+   u_long32      max_advance_reservations;
+   u_long32      reprioritize;
+   u_long32      auto_user_fshare;
+   u_long32      auto_user_oticket;
+   u_long32      auto_user_delete_time;
+   bool          is_monitor_message;
+   bool          use_qidle;
+   bool          forbid_reschedule;
+   bool          forbid_apperror;
+   bool          do_credentials;
+   bool          do_authentication;
+   bool          acct_reserved_usage;
+   bool          sharetree_reserved_usage;
+   keep_active_t keep_active;
+   bool          enable_binding;
+   bool          enable_addgrp_kill;
+   u_long64      pdc_interval;
+   bool          enable_reschedule_kill;
+   bool          enable_reschedule_slave;
+   bool          old_reschedule_behavior;
+   bool          old_reschedule_behavior_array_job;
+   bool          simulate_execds;
+   bool          simulate_jobs;
+   long          ptf_max_priority;
+   long          ptf_min_priority;
+   bool          use_qsub_gid;
+   int           notify_susp_type;
+   int           notify_kill_type;
+   bool          disable_reschedule;
+   bool          disable_secondary_ds;
+   bool          disable_secondary_ds_reader;
+   bool          disable_secondary_ds_execd;
+   bool          disable_automatic_session;
+   int           scheduler_timeout;
+   int           max_dynamic_event_clients;
+   bool          set_lib_path;
+   bool          inherit_env;
+   int           spool_time;
+   int           max_ds_deviation;
+   u_long32      monitor_time;
+   bool          do_accounting;
+   bool          do_reporting;
+   bool          do_joblog;
+   int           reporting_flush_time;
+   int           accounting_flush_time;
+   bool          old_accounting;
+   bool          old_reporting;
+   int           sharelog_time;
+   int           log_consumables;
+   bool          enable_forced_qdel;
+   bool          enable_sup_grp_eval;
+   bool          enable_enforce_master_limit;
+   bool          enable_test_sleep_after_request;
+   bool          enable_forced_qdel_if_unknown;
+   bool          ignore_ngroups_max_limit;
+   bool          enable_submit_lib_path;
+   bool          enable_submit_ld_preload;
+   int           max_job_deletion_time;
+   int           jsv_threshold;
+   int           jsv_timeout;
+   int           jsv_pool_size;
+   u_long32      script_timeout;
+};
+
 typedef int (*tDaemonizeFunc)(void *ctx);
 
 /* This list is *ONLY* used by the execd and should be moved eventually */
@@ -64,6 +151,8 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
 void sge_show_conf();
 void conf_update_thread_profiling(const char *thread_name);
 
+mconf_snapshot_t mconf_get_snapshot();
+
 char* mconf_get_execd_spool_dir();
 char* mconf_get_mailer();
 char* mconf_get_xterm();
@@ -183,6 +272,7 @@ void mconf_get_h_locks(char **pret);
 void mconf_get_s_locks(char **pret);
 int mconf_get_jsv_timeout();
 int mconf_get_jsv_threshold();
+int mconf_get_jsv_pool_size();
 bool mconf_get_ignore_ngroups_max_limit();
 bool mconf_get_enable_submit_lib_path();
 bool mconf_get_enable_submit_ld_preload();
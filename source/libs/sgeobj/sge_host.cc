@@ -35,12 +35,15 @@
 
 #include "comm/commlib.h"
 
+#include "sgeobj/ocs_TopologyMask.h"
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_centry.h"
 #include "sgeobj/sge_conf.h"
 #include "sgeobj/sge_cqueue.h"
+#include "sgeobj/sge_grantedres.h"
 #include "sgeobj/sge_hgroup.h"
 #include "sgeobj/sge_href.h"
+#include "sgeobj/sge_job.h"
 #include "sgeobj/sge_object.h"
 #include "sgeobj/sge_qinstance.h"
 #include "sgeobj/sge_resource_utilization.h"
@@ -536,6 +539,85 @@ host_debit_rsmap(lListElem *host, const char *ce_name, const lListElem *resl, in
    return mods;
 }
 
+/**
+ * @brief debit the cores selected for the core binding of a job from a host
+ *
+ * The cores are booked in the m_topology_inuse load value of the host, this way they
+ * are known to be in use before the execution daemon reports its next load report.
+ * Hosts which do not report a topology are not touched.
+ *
+ * @param host             the host to do debiting on
+ * @param granted_resource granted resource of type GRU_BINDING_TYPE
+ * @param slots            debit for slots > 0, undebit for slots < 0
+ * @param just_check       when != nullptr we just check if the cores are still free and return the result here
+ * @return the number of modifications done (0 or 1)
+ */
+int
+host_debit_binding(lListElem *host, const lListElem *granted_resource, int slots, bool *just_check) {
+   lListElem *topology_inuse = lGetSubStrRW(host, HL_name, LOAD_ATTR_TOPOLOGY_INUSE, EH_load_list);
+   ocs::TopologyMask mask;
+
+   if (topology_inuse == nullptr || !mask.parse(lGetString(topology_inuse, HL_value))) {
+      return 0;
+   }
+
+   std::vector<std::string> ids;
+   const lListElem *resl;
+   for_each_ep(resl, lGetList(granted_resource, GRU_resource_map_list)) {
+      ids.emplace_back(lGetString(resl, RESL_value));
+   }
+
+   ocs::TopologyMask::CoreList cores;
+   if (!mask.parse_ids(ids, cores)) {
+      // topology of the host changed in the meantime
+      return 0;
+   }
+
+   if (just_check != nullptr) {
+      if (slots > 0 && !mask.is_free(cores)) {
+         *just_check = false;
+      }
+      return 0;
+   }
+
+   if (slots == 0 || !mask.book(cores, slots > 0)) {
+      return 0;
+   }
+   lSetString(topology_inuse, HL_value, mask.get_topology().c_str());
+   return 1;
+}
+
+/**
+ * @brief select the cores for the core binding request of a job on a host
+ *
+ * The cores are selected from the m_topology_inuse load value of the host following
+ * the strategy of the binding request.
+ *
+ * @param host the host (EH_Type)
+ * @param job  the job (JB_Type) requesting core binding
+ * @param ids  if != nullptr the "<socket>,<core>" ids of the selected cores are returned here,
+ *             it stays empty when the host does not report a topology
+ * @return false if the host reports a topology and the request can not be fulfilled, else true
+ */
+bool
+host_select_binding(const lListElem *host, const lListElem *job, std::vector<std::string> *ids) {
+   const lListElem *topology_inuse = lGetSubStr(host, HL_name, LOAD_ATTR_TOPOLOGY_INUSE, EH_load_list);
+   ocs::TopologyMask mask;
+
+   if (topology_inuse == nullptr || !mask.parse(lGetString(topology_inuse, HL_value))) {
+      return true;
+   }
+
+   ocs::TopologyMask::CoreList cores;
+   if (!mask.select(lFirst(lGetList(job, JB_binding)), cores)) {
+      return false;
+   }
+   if (ids != nullptr) {
+      mask.get_ids(*ids, cores);
+   }
+   return true;
+}
+
 bool
 host_do_per_host_booking(const char **last_hostname, const char *hostname)
 {
@@ -35,6 +35,9 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <string>
+#include <vector>
+
 #include "sgeobj/cull/sge_host_EH_L.h"
 #include "sgeobj/cull/sge_host_RU_L.h"
 #include "sgeobj/cull/sge_host_AH_L.h"
@@ -82,6 +85,9 @@
 #define LOAD_ATTR_THREADS        "m_thread"
 #define LOAD_ATTR_TOPOLOGY_INUSE "m_topology_inuse"
 
+/* values for EH_capabilities */
+#define EH_CAP_JOB_DELIVERY_BATCH 0x00000001 /* execd starts all jobs of a TAG_JOB_EXECUTION message */
+
 bool host_is_referenced(const lListElem *host, lList **answer_list,
                         const lList *queue_list, const lList *hgrp_list);
 
@@ -110,6 +116,12 @@ host_merge(lListElem *host, const lListElem *global_host);
 int
 host_debit_rsmap(lListElem *host, const char *ce_name, const lListElem *resl, int slots, bool *just_check);
 
+int
+host_debit_binding(lListElem *host, const lListElem *granted_resource, int slots, bool *just_check);
+
+bool
+host_select_binding(const lListElem *host, const lListElem *job, std::vector<std::string> *ids);
+
 bool host_do_per_host_booking(const char **last_hostname, const char *hostname);
 
 bool
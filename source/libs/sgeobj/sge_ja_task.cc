@@ -747,6 +747,9 @@ int ja_task_debit_host_rsmaps(const lListElem *ja_task, lListElem *host, int slo
    for (granted_resource = lGetElemHostFirst(granted_resources, GRU_host, host_name, &iterator);
         granted_resource != nullptr;
         granted_resource = lGetElemHostNext(granted_resources, GRU_host, host_name, &iterator)) {
+      if (lGetUlong(granted_resource, GRU_type) == GRU_BINDING_TYPE) {
+         continue;
+      }
       mods += ja_task_debit_host_rsmap(granted_resource, host, slots, just_check);
       if (just_check != nullptr && !*just_check) {
          break;
@@ -755,3 +758,32 @@ int ja_task_debit_host_rsmaps(const lListElem *ja_task, lListElem *host, int slo
 
    return mods;
 }
+
+/**
+ * @brief debit / undebit the cores selected for the core binding of a ja_task
+ *
+ * Has to be called once per host the ja_task is running on.
+ *
+ * @param ja_task debit this ja_task
+ * @param host  from this host
+ * @param slots > 0 to debit, < 0 to undebit
+ * @param just_check if != nullptr then do not do booking but just check if the cores are still free
+ * @return the number of modifications done
+ */
+int ja_task_debit_host_binding(const lListElem *ja_task, lListElem *host, int slots, bool *just_check) {
+   int mods = 0;
+   const char *host_name = lGetHost(host, EH_name);
+   const lList *granted_resources = lGetList(ja_task, JAT_granted_resources_list);
+   const lListElem *granted_resource;
+   const void *iterator;
+
+   for (granted_resource = lGetElemHostFirst(granted_resources, GRU_host, host_name, &iterator);
+        granted_resource != nullptr;
+        granted_resource = lGetElemHostNext(granted_resources, GRU_host, host_name, &iterator)) {
+      if (lGetUlong(granted_resource, GRU_type) == GRU_BINDING_TYPE) {
+         mods += host_debit_binding(host, granted_resource, slots, just_check);
+      }
+   }
+
+   return mods;
+}
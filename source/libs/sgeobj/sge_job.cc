@@ -3978,8 +3978,8 @@ bool job_request_set_remove_duplicates(lListElem *job) {
 
 bool job_request_set_has_queue_requests(const lListElem *job) {
    bool ret = false;
-   lListElem *jrs;
-   for_each_rw (jrs, lGetListRW(job, JB_request_set_list)) {
+   const lListElem *jrs;
+   for_each_ep (jrs, lGetList(job, JB_request_set_list)) {
       if (lGetList(jrs, JRS_hard_queue_list) != nullptr || lGetList(jrs, JRS_soft_queue_list) != nullptr) {
          ret = true;
          break;
@@ -38,6 +38,8 @@
 #include <ctime>
 #include <unistd.h>
 #include <sys/poll.h>
+#include <atomic>
+#include <vector>
 
 #include "uti/sge_dstring.h"
 #include "uti/sge_lock.h"
@@ -74,6 +76,26 @@ static pthread_mutex_t jsv_mutex = PTHREAD_MUTEX_INITIALIZER;
  */
 static lList *jsv_list = nullptr;   /* JSV_Type */
 
+/*
+ * If qmaster_params jsv_pool_size is set then worker threads do not use
+ * an own server JSV instance but one of a pool of instances. The
+ * context of a pool instance is JSV_CONTEXT_POOL followed by the slot
+ * number. A slot is used by one thread at a time, jsv_pool_busy
+ * and jsv_pool_cond are secured by jsv_mutex.
+ */
+static std::vector<bool> jsv_pool_busy;
+static pthread_cond_t jsv_pool_cond = PTHREAD_COND_INITIALIZER;
+
+/*
+ * pool size which has been applied by jsv_pool_resize(), -1 as long as
+ * obsolete instances are left. Compared without jsv_mutex for each
+ * verification, so resizing only happens when the configuration changes.
+ */
+static std::atomic<int> jsv_pool_applied_size{0};
+
+/* pool size the calling worker thread did see with its last verification */
+static thread_local int jsv_thread_pool_size = 0;
+
 /****** sgeobj/jsv/jsv_create() ***************************************************
 *  NAME
 *     jsv_create() -- creates a new JSV object and initializes its attributes 
@@ -715,11 +737,17 @@ jsv_is_enabled(const char *context) {
    DENTER(TOP_LAYER);
 
    jsv_url = mconf_get_jsv_url();
-   jsv_list_update("jsv", context, nullptr, jsv_url);
-   sge_free(&jsv_url);
-   sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
-   ret = (lGetNumberOfElem(jsv_list) > 0) ? true : false;
-   sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   if (mconf_get_jsv_pool_size() > 0) {
+      /* pooled instances are created by jsv_do_verify() */
+      ret = (jsv_url != nullptr && strcasecmp(jsv_url, "none") != 0) ? true : false;
+      sge_free(&jsv_url);
+   } else {
+      jsv_list_update("jsv", context, nullptr, jsv_url);
+      sge_free(&jsv_url);
+      sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+      ret = (lGetNumberOfElem(jsv_list) > 0) ? true : false;
+      sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   }
    DRETURN(ret);
 }
 
@@ -915,6 +943,210 @@ jsv_list_update(const char *name, const char *context,
    DRETURN(ret);
 }
 
+/****** sgeobj/jsv/jsv_pool_acquire() ******************************************
+*  NAME
+*     jsv_pool_acquire() -- get exclusive access to a pooled server JSV
+*
+*  SYNOPSIS
+*     int jsv_pool_acquire(int pool_size)
+*
+*  FUNCTION
+*     Returns the number of a free slot in the JSV pool and marks it as
+*     used. If all 'pool_size' slots are in use then the function waits
+*     until one of them gets released with jsv_pool_release().
+*
+*     The caller must not hold the global lock because other threads
+*     need it before they can release their slot.
+*
+*  INPUTS
+*     int pool_size - current size of the pool (> 0)
+*
+*  RESULT
+*     int - slot number
+*
+*  NOTES
+*     MT-NOTE: jsv_pool_acquire() is MT safe
+*
+*  SEE ALSO
+*     sgeobj/jsv/jsv_pool_release()
+*******************************************************************************/
+int
+jsv_pool_acquire(int pool_size)
+{
+   int slot = -1;
+
+   DENTER(TOP_LAYER);
+   sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   while (slot == -1) {
+      if ((int)jsv_pool_busy.size() < pool_size) {
+         jsv_pool_busy.resize(pool_size, false);
+      }
+      for (int i = 0; i < pool_size; i++) {
+         if (!jsv_pool_busy[i]) {
+            jsv_pool_busy[i] = true;
+            slot = i;
+            break;
+         }
+      }
+      if (slot == -1) {
+         DPRINTF("JSV pool - waiting for a free instance\n");
+         pthread_cond_wait(&jsv_pool_cond, &jsv_mutex);
+      }
+   }
+   sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   DPRINTF("JSV pool - using instance %d\n", slot);
+   DRETURN(slot);
+}
+
+/****** sgeobj/jsv/jsv_pool_release() ******************************************
+*  NAME
+*     jsv_pool_release() -- release a slot of the JSV pool
+*
+*  SYNOPSIS
+*     void jsv_pool_release(int slot)
+*
+*  FUNCTION
+*     Marks the 'slot' as free and wakes up threads waiting for a slot.
+*
+*  INPUTS
+*     int slot - slot number returned by jsv_pool_acquire()
+*
+*  NOTES
+*     MT-NOTE: jsv_pool_release() is MT safe
+*******************************************************************************/
+void
+jsv_pool_release(int slot)
+{
+   DENTER(TOP_LAYER);
+   sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   jsv_pool_busy[slot] = false;
+   pthread_cond_broadcast(&jsv_pool_cond);
+   sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   DRETURN_VOID;
+}
+
+/****** sgeobj/jsv/jsv_pool_shrink() *******************************************
+*  NAME
+*     jsv_pool_shrink() -- stop pooled server JSVs which are not needed anymore
+*
+*  SYNOPSIS
+*     static bool jsv_pool_shrink(int pool_size)
+*
+*  FUNCTION
+*     Stops and removes the JSV instances of all unused slots with a slot
+*     number >= 'pool_size'. This is the case when jsv_pool_size was
+*     decreased or when the pool was disabled. Slots still in use are
+*     handled with one of the next calls.
+*
+*  INPUTS
+*     int pool_size - current size of the pool
+*
+*  RESULT
+*     bool - true if no slot >= 'pool_size' is left
+*
+*  NOTES
+*     MT-NOTE: jsv_pool_shrink() is MT safe
+*******************************************************************************/
+static bool
+jsv_pool_shrink(int pool_size)
+{
+   std::vector<int> obsolete;
+   bool done;
+
+   DENTER(TOP_LAYER);
+   sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   for (int i = pool_size; i < (int)jsv_pool_busy.size(); i++) {
+      if (!jsv_pool_busy[i]) {
+         jsv_pool_busy[i] = true;
+         obsolete.push_back(i);
+      }
+   }
+   sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+
+   if (!obsolete.empty()) {
+      for (int slot : obsolete) {
+         char context[256];
+
+         snprintf(context, sizeof(context), JSV_CONTEXT_POOL "%d", slot);
+         jsv_list_update("jsv", context, nullptr, "none");
+      }
+
+      sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+      for (int slot : obsolete) {
+         jsv_pool_busy[slot] = false;
+      }
+      while ((int)jsv_pool_busy.size() > pool_size && !jsv_pool_busy.back()) {
+         jsv_pool_busy.pop_back();
+      }
+      pthread_cond_broadcast(&jsv_pool_cond);
+      sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   }
+
+   sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   done = (int)jsv_pool_busy.size() <= pool_size;
+   sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   DRETURN(done);
+}
+
+/****** sgeobj/jsv/jsv_pool_resize() *******************************************
+*  NAME
+*     jsv_pool_resize() -- apply a changed jsv_pool_size
+*
+*  SYNOPSIS
+*     void jsv_pool_resize(int pool_size)
+*
+*  FUNCTION
+*     Called with the configured pool size before each server side
+*     verification. As long as the size is the one applied before the
+*     function returns immediately. Otherwise the instances of slots
+*     which are not part of the pool anymore are stopped. Slots being in
+*     use at that time are stopped with one of the following calls.
+*
+*  INPUTS
+*     int pool_size - configured size of the pool
+*
+*  NOTES
+*     MT-NOTE: jsv_pool_resize() is MT safe
+*******************************************************************************/
+void
+jsv_pool_resize(int pool_size)
+{
+   DENTER(TOP_LAYER);
+   if (jsv_pool_applied_size.load() != pool_size) {
+      jsv_pool_applied_size.store(-1);
+      if (jsv_pool_shrink(pool_size)) {
+         DPRINTF("JSV pool - size %d applied\n", pool_size);
+         jsv_pool_applied_size.store(pool_size);
+      }
+   }
+   DRETURN_VOID;
+}
+
+/****** sgeobj/jsv/jsv_pool_get_slots() ****************************************
+*  NAME
+*     jsv_pool_get_slots() -- number of slots of the JSV pool
+*
+*  SYNOPSIS
+*     int jsv_pool_get_slots()
+*
+*  RESULT
+*     int - number of slots which are in use or have an instance which
+*           was not stopped by jsv_pool_resize() yet
+*
+*  NOTES
+*     MT-NOTE: jsv_pool_get_slots() is MT safe
+*******************************************************************************/
+int
+jsv_pool_get_slots()
+{
+   int ret;
+
+   sge_mutex_lock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   ret = (int)jsv_pool_busy.size();
+   sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
+   return ret;
+}
+
 /****** sgeobj/jsv/jsv_do_verify() *********************************************
 *  NAME
 *     jsv_do_verify() -- verify a job using JSV's 
@@ -931,7 +1163,9 @@ jsv_list_update(const char *name, const char *context,
 *
 *     In commandline clients the string "JSV_CONTEXT_CLIENT" has to be 
 *     passed to this function. In qmaster context the name of the thread 
-*     which calls this function has to be provided.
+*     which calls this function has to be provided. If qmaster_params
+*     jsv_pool_size is set then the thread does not use an own JSV instance
+*     but waits for a free instance of the JSV pool.
 *
 *     If multiple JSVs should be executed then the job specification
 *     of 'job' will be passed to the first JSV. This specification might
@@ -966,8 +1200,8 @@ jsv_list_update(const char *name, const char *context,
 *     const char *context      - JSV_CONTEXT_CLIENT or thread name
 *     lListElem **job          - pointer or a job (JB_Type) 
 *     lList **answer_list      - answer_list for messages 
-*     bool holding_lock        - is the calling thread holding the
-*                                global lock 
+*     bool holding_lock        - is the calling thread holding a lock
+*                                set of the main DS (see sge_lock_set_acquire())
 *
 *  RESULT
 *     bool - error state
@@ -993,6 +1227,8 @@ jsv_do_verify(const char *context, lListElem **job,
    if (context != nullptr && job != nullptr) {
       const char *jsv_url = nullptr;
       bool holding_mutex = false;
+      int pool_slot = -1;
+      char pool_context[256];
 
       /*
        * Depending on the context either provide a nullptr pointer to
@@ -1006,8 +1242,37 @@ jsv_do_verify(const char *context, lListElem **job,
          jsv_url = nullptr;
          DPRINTF("JSV client context\n");
       } else {
+         int pool_size = mconf_get_jsv_pool_size();
+
          jsv_url = mconf_get_jsv_url();
          DPRINTF("JSV server context\n");
+
+         /*
+          * With a JSV pool the thread uses one of the pooled instances
+          * instead of an own one. The global lock has to be released while
+          * waiting for a free instance because the threads using the
+          * instances need it before they can return them.
+          */
+         jsv_pool_resize(pool_size);
+         if (pool_size > 0) {
+            /* the own instance of the thread is not needed anymore */
+            if (jsv_thread_pool_size == 0) {
+               jsv_list_update("jsv", context, answer_list, "none");
+            }
+            sge_lock_set_t lock_set;
+            sge_lock_set_init(&lock_set, true);
+            if (holding_lock) {
+               sge_lock_set_held(&lock_set);
+               SGE_UNLOCK_SET();
+            }
+            pool_slot = jsv_pool_acquire(pool_size);
+            if (holding_lock) {
+               SGE_LOCK_SET(&lock_set);
+            }
+            snprintf(pool_context, sizeof(pool_context), JSV_CONTEXT_POOL "%d", pool_slot);
+            context = pool_context;
+         }
+         jsv_thread_pool_size = pool_size;
       }
 
       /*
@@ -1073,17 +1338,23 @@ jsv_do_verify(const char *context, lListElem **job,
              *    - unlock the global lock. So some other thread can have it. 
              *    - do the verify (communication with JSV instance)
              *    - acquire the global lock again to finish the GDI JOB ADD request when
-             *      this function returns.
+             *      this function returns. The JSV might have changed any job attribute,
+             *      e.g. requested a verification of the schedulability, so the lock is
+             *      acquired exclusively even if the thread held a lock set of some
+             *      domains before.
              */
             if (holding_lock) {
+               sge_lock_set_t lock_set;
+
                DPRINTF("JSV releases global lock for verification process\n");
                sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
                holding_mutex = false;
-               SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+               SGE_UNLOCK_SET();
                DPRINTF("Client/master will start communication with JSV\n");
                ret &= jsv_do_communication(jsv, answer_list);
                DPRINTF("JSV acquires global lock which was hold before communication with JSV\n");
-               SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE);
+               sge_lock_set_init(&lock_set, true);
+               SGE_LOCK_SET(&lock_set);
             } else {
                DPRINTF("Client/master will start communication with JSV\n");
                ret &= jsv_do_communication(jsv, answer_list);
@@ -1125,6 +1396,9 @@ jsv_do_verify(const char *context, lListElem **job,
       if (holding_mutex) {
          sge_mutex_unlock("jsv_list", __func__, __LINE__, &jsv_mutex);
       }
+      if (pool_slot != -1) {
+         jsv_pool_release(pool_slot);
+      }
       sge_free(&jsv_url);
    }
    DRETURN(ret);
@@ -41,6 +41,7 @@
 #include "sgeobj/cull/sge_jsv_JSV_L.h"
 
 #define JSV_CONTEXT_CLIENT "client"
+#define JSV_CONTEXT_POOL "jsv_pool."
 
 bool        
 jsv_url_parse(dstring *jsv_url_str, lList **answer_list, dstring *type, 
@@ -75,3 +76,15 @@ jsv_is_enabled(const char *context);
 bool
 jsv_list_update(const char *name, const char *context,
                 lList **answer_list, const char *jsv_url);
+
+int
+jsv_pool_acquire(int pool_size);
+
+void
+jsv_pool_release(int slot);
+
+void
+jsv_pool_resize(int pool_size);
+
+int
+jsv_pool_get_slots();
@@ -36,6 +36,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <iterator>
+#include <map>
 
 #include "uti/sge_dstring.h"
 #include "uti/sge_log.h"
@@ -45,6 +47,7 @@
 #include "sgeobj/sge_range.h"
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/msg_sgeobjlib.h"
+#include "sgeobj/ocs_TaskIdSet.h"
 
 #define RANGE_SEPARATOR_CHARS ","
 #define RANGE_LAYER BASIS_LAYER
@@ -1242,6 +1245,195 @@ void range_set_all_ids(lListElem *range, u_long32 min, u_long32 max,
    DRETURN_VOID;
 }
 
+/****** sgeobj/range/range_list_insert_range_list() ***************************
+*  NAME
+*     range_list_insert_range_list() -- insert all ids of a range list 
+*
+*  SYNOPSIS
+*     static void range_list_insert_range_list(lList *range_list, 
+*                                              const lList *range_list2) 
+*
+*  FUNCTION
+*     All ids of 'range_list2' will be inserted into 'range_list' in 
+*     the order they appear in 'range_list2'. Each id is inserted 
+*     following the rules of range_list_insert_id() so that the ranges 
+*     look the same as if range_list_insert_id() would have been called 
+*     for each id. 
+*
+*     The ranges are kept in a map by their first id. So finding the 
+*     position of an id does not need to walk through the whole list 
+*     which is slow for lists with many holes.
+*
+*  INPUTS
+*     lList *range_list        - sorted RN_Type list without 
+*                                overlapping ranges 
+*     const lList *range_list2 - RN_Type list 
+*
+*  RESULT
+*     'range_list' will be modified 
+*
+*  SEE ALSO
+*     sgeobj/range/range_list_insert_id()
+*
+*  NOTES
+*     MT-NOTE: range_list_insert_range_list() is MT safe
+******************************************************************************/
+static void range_list_insert_range_list(lList *range_list, const lList *range_list2) {
+   struct Range {
+      u_long32 end;
+      u_long32 step;
+   };
+   std::map<u_long32, Range> ranges;
+   const lListElem *range;
+
+   DENTER(RANGE_LAYER);
+
+   auto set_range = [&ranges](u_long32 start, u_long32 end, u_long32 step) {
+      // like range_set_all_ids()
+      ranges[start] = {end, start != end ? step : 1};
+   };
+
+   for_each_ep(range, range_list) {
+      u_long32 start, end, step;
+
+      range_get_all_ids(range, &start, &end, &step);
+      ranges[start] = {end, step};
+   }
+
+   for_each_ep(range, range_list2) {
+      u_long32 id, end2, step2;
+
+      range_get_all_ids(range, &id, &end2, &step2);
+      for (; id <= end2; id += step2) {
+         // 'prev' is the last range ending at or before id, 'next' the range behind it
+         auto next = ranges.upper_bound(id);
+         auto prev = ranges.end();
+
+         if (next != ranges.begin()) {
+            auto last = std::prev(next);
+
+            if (last->second.end <= id) {
+               prev = last;
+            } else {
+               next = last;
+               if (last != ranges.begin()) {
+                  prev = std::prev(last);
+               }
+            }
+         }
+
+         if (next != ranges.end() && id > next->first) {
+            u_long32 next_start = next->first;
+            Range next_range = next->second;
+
+            if ((id - next_start) % next_range.step != 0) {
+               u_long32 factor = (id - next_start) / next_range.step;
+
+               set_range(next_start, next_start + factor * next_range.step, next_range.step);
+               set_range(id, id, 1);
+               set_range(next_start + (factor + 1) * next_range.step, next_range.end, next_range.step);
+            }
+         } else if ((prev != ranges.end() && prev->second.end == id) ||
+                    (next != ranges.end() && next->first == id)) {
+            // id is already part of the range
+         } else if (prev != ranges.end() && prev->second.end + prev->second.step == id) {
+            set_range(prev->first, id, prev->second.step);
+         } else if (next != ranges.end() && next->first - next->second.step == id) {
+            Range next_range = next->second;
+
+            ranges.erase(next);
+            set_range(id, next_range.end, next_range.step);
+         } else {
+            set_range(id, id, 1);
+         }
+      }
+   }
+
+   range_list_initialize(&range_list, nullptr);
+   for (const auto &[start, r] : ranges) {
+      lListElem *new_range = lCreateElem(RN_Type);
+
+      range_set_all_ids(new_range, start, r.end, r.step);
+      lAppendElem(range_list, new_range);
+   }
+   DRETURN_VOID;
+}
+
+/****** sgeobj/range/range_list_remove_range_list() ***************************
+*  NAME
+*     range_list_remove_range_list() -- remove all ids of a range list 
+*
+*  SYNOPSIS
+*     static void range_list_remove_range_list(lList **range_list, 
+*                                              const lList *range_list2) 
+*
+*  FUNCTION
+*     All ids of 'range_list2' will be removed from 'range_list'. 
+*     The ranges look the same as if range_list_remove_id() would have 
+*     been called for each id: A range is split into the parts which 
+*     remain, each part keeps the step size of the range. 
+*
+*  INPUTS
+*     lList **range_list       - sorted RN_Type list without 
+*                                overlapping ranges 
+*     const lList *range_list2 - RN_Type list 
+*
+*  RESULT
+*     'range_list' will be modified, it is freed if no id remains 
+*
+*  SEE ALSO
+*     sgeobj/range/range_list_remove_id()
+*
+*  NOTES
+*     MT-NOTE: range_list_remove_range_list() is MT safe
+******************************************************************************/
+static void range_list_remove_range_list(lList **range_list, const lList *range_list2) {
+   DENTER(RANGE_LAYER);
+   if (*range_list != nullptr && lGetNumberOfElem(range_list2) > 0) {
+      ocs::TaskIdSet removed(range_list2);
+      lList *result = lCreateList(lGetListName(*range_list), RN_Type);
+      const lListElem *range;
+
+      auto add_part = [result](u_long32 start, u_long32 end, u_long32 step) {
+         lListElem *new_range = lCreateElem(RN_Type);
+
+         range_set_all_ids(new_range, start, end, step);
+         lAppendElem(result, new_range);
+      };
+
+      for_each_ep(range, *range_list) {
+         u_long32 start, end, step;
+         u_long32 part_start = 0;
+         bool in_part = false;
+
+         range_get_all_ids(range, &start, &end, &step);
+         for (u_long32 id = start; id <= end; id += step) {
+            if (!removed.contains(id)) {
+               if (!in_part) {
+                  part_start = id;
+                  in_part = true;
+               }
+            } else if (in_part) {
+               add_part(part_start, id - step, step);
+               in_part = false;
+            }
+         }
+         if (in_part) {
+            add_part(part_start, end, step);
+         }
+      }
+
+      lFreeList(range_list);
+      // removing the last id frees the list
+      if (lGetNumberOfElem(result) > 0) {
+         *range_list = result;
+      } else {
+         lFreeList(&result);
+      }
+   }
+   DRETURN_VOID;
+}
+
 /****** sgeobj/range/range_list_calculate_union_set() *************************
 *  NAME
 *     range_list_calculate_union_set() -- Union set of two range lists 
@@ -1275,45 +1467,18 @@ void range_list_calculate_union_set(lList **range_list,
                                     const lList *range_list2) {
    DENTER(RANGE_LAYER);
    if (range_list != nullptr && (range_list1 != nullptr || range_list2 != nullptr)) {
-      lFreeList(range_list);
-
-      if (range_list1 != nullptr) {
-         *range_list = lCopyList("", range_list1);
-      } else {
-         *range_list = lCopyList("", range_list2);
-      }
-      if (*range_list == nullptr) {
-         DTRACE;
-         goto error;
-      }
-
-      range_list_sort_uniq_compress(*range_list, answer_list, true);
-      if (answer_list_has_error(answer_list)) {
-         DTRACE;
-         goto error;
-      }
-
-      if (range_list1 != nullptr && range_list2 != nullptr) {
-         const lListElem *range2 = nullptr;
-
-         for_each_ep(range2, range_list2) {
-            u_long32 start2, end2, step2;
+      // the result list might be one of the source lists
+      lList *result = lCopyList("", range_list1 != nullptr ? range_list1 : range_list2);
 
-            range_get_all_ids(range2, &start2, &end2, &step2);
-            for (; start2 <= end2; start2 += step2) {
-               range_list_insert_id(range_list, answer_list, start2);
-            }
-         }
-         range_list_compress(*range_list);
+      range_list_sort_uniq_compress(result, answer_list, true);
+      if (result != nullptr && range_list1 != nullptr && range_list2 != nullptr) {
+         range_list_insert_range_list(result, range_list2);
+         range_list_compress(result);
       }
+      lFreeList(range_list);
+      *range_list = result;
    }
    DRETURN_VOID;
-
-   error:
-   lFreeList(range_list);
-   answer_list_add(answer_list, "unable to calculate union set",
-                   STATUS_ERROR1, ANSWER_QUALITY_ERROR);
-   DRETURN_VOID;
 }
 
 /****** sgeobj/range/range_list_calculate_difference_set() ********************
@@ -1345,41 +1510,18 @@ void range_list_calculate_difference_set(lList **range_list,
                                          const lList *range_list2) {
    DENTER(RANGE_LAYER);
    if (range_list != nullptr && range_list1 != nullptr) {
-      lFreeList(range_list);
-      *range_list = lCopyList("difference_set range list", range_list1);
-      if (*range_list == nullptr) {
-         goto error;
-      }
-
-      range_list_sort_uniq_compress(*range_list, answer_list, true);
-      if (answer_list_has_error(answer_list)) {
-         goto error;
-      }
+      // the result list might be one of the source lists
+      lList *result = lCopyList("difference_set range list", range_list1);
 
+      range_list_sort_uniq_compress(result, answer_list, true);
       if (range_list2 != nullptr) {
-         const lListElem *range2 = nullptr;
-
-         for_each_ep(range2, range_list2) {
-            u_long32 start2, end2, step2;
-
-            range_get_all_ids(range2, &start2, &end2, &step2);
-            for (; start2 <= end2; start2 += step2) {
-               range_list_remove_id(range_list, answer_list, start2);
-               if (answer_list_has_error(answer_list)) {
-                  goto error;
-               }
-            }
-         }
-         range_list_compress(*range_list);
+         range_list_remove_range_list(&result, range_list2);
+         range_list_compress(result);
       }
+      lFreeList(range_list);
+      *range_list = result;
    }
    DRETURN_VOID;
-
-   error:
-   lFreeList(range_list);
-   answer_list_add(answer_list, "unable to calculate union set",
-                   STATUS_ERROR1, ANSWER_QUALITY_ERROR);
-   DRETURN_VOID;
 }
 
 /****** sgeobj/range/range_list_calculate_intersection_set() ******************
@@ -1411,41 +1553,15 @@ void range_list_calculate_intersection_set(lList **range_list,
                                            const lList *range_list2) {
    DENTER(RANGE_LAYER);
    lFreeList(range_list);
-   if (range_list1 && range_list2) {
-      const lListElem *range;
-
-      for_each_ep(range, range_list1) {
-         u_long32 start, end, step;
+   if (range_list1 != nullptr && range_list2 != nullptr) {
+      ocs::TaskIdSet ids(range_list1);
 
-         range_get_all_ids(range, &start, &end, &step);
-         for (; start <= end; start += step) {
-            if (range_list_is_id_within(range_list2, start)) {
-               lListElem *new_range;
-
-               if (*range_list == nullptr) {
-                  *range_list = lCreateList("", RN_Type);
-                  if (*range_list == nullptr) {
-                     goto error;
-                  }
-               }
-               new_range = lCreateElem(RN_Type);
-               if (new_range == nullptr) {
-                  goto error;
-               }
-               range_set_all_ids(new_range, start, start, 1);
-               lAppendElem(*range_list, new_range);
-            }
-         }
+      ids.intersect(ocs::TaskIdSet(range_list2));
+      if (!ids.empty()) {
+         *range_list = ids.to_range_list("");
       }
-      range_list_compress(*range_list);
    }
    DRETURN_VOID;
-
-   error:
-   lFreeList(range_list);
-   answer_list_add(answer_list, "unable to calculate intersection set",
-                   STATUS_ERROR1, ANSWER_QUALITY_ERROR);
-   DRETURN_VOID;
 }
 
 /****** sgeobj/range/range_to_dstring() **************************************
@@ -32,7 +32,10 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <string>
 #include <pthread.h>
 
 #include "cull/cull.h"
@@ -123,6 +126,8 @@
 #define DEFAULT_DURATION                    "INFINITY"     // the default_duration and default_duration_I have to be
 #define DEFAULT_DURATION_I                  600            // in sync. On is the string version of the other (based on seconds)
 #define DEFAULT_DURATION_OFFSET             60
+#define DEFAULT_TICKET_THREADS              1
+#define MAX_TICKET_THREADS                  64
 
 /**
  * multithreading support, thread local
@@ -306,6 +311,52 @@ typedef struct{
 static bool schedd_profiling = false;
 static bool current_serf_do_monitoring = false;
 static schedd_pe_algorithm  pe_algorithm = SCHEDD_PE_AUTO;
+static u_long32 ticket_threads = DEFAULT_TICKET_THREADS;
+
+static u_long32 sconf_read_load_adjustment_decay_time();
+static u_long32 sconf_read_queue_sort_method();
+static u_long32 sconf_read_maxujobs();
+static u_long32 sconf_read_schedule_interval();
+static u_long32 sconf_read_reprioritize_interval();
+static double sconf_read_weight_user();
+static double sconf_read_weight_department();
+static double sconf_read_weight_project();
+static double sconf_read_weight_job();
+static u_long32 sconf_read_weight_tickets_share();
+static u_long32 sconf_read_weight_tickets_functional();
+static u_long32 sconf_read_halftime();
+static u_long32 sconf_read_weight_tickets_override();
+static double sconf_read_compensation_factor();
+static double sconf_read_weight_ticket();
+static double sconf_read_weight_waiting_time();
+static double sconf_read_weight_deadline();
+static double sconf_read_weight_urgency();
+static u_long32 sconf_read_max_reservations();
+static double sconf_read_weight_priority();
+static bool sconf_read_share_override_tickets();
+static bool sconf_read_share_functional_shares();
+static bool sconf_read_report_pjob_tickets();
+static u_long32 sconf_read_flush_submit_sec();
+static u_long32 sconf_read_flush_finish_sec();
+static u_long32 sconf_read_max_functional_jobs_to_schedule();
+static u_long32 sconf_read_max_pending_tasks_per_job();
+static u_long32 sconf_read_default_duration();
+static u_long32 sconf_read_duration_offset();
+static u_long32 sconf_read_ticket_threads();
+static bool sconf_read_profiling();
+static std::string sconf_read_load_formula();
+
+/*
+ * Snapshots of the scheduler configuration (RCU like), one per data store.
+ *
+ * A new snapshot is built and the pointer is swapped whenever the configuration
+ * of a data store changes. Readers cache the snapshot per thread and only fetch
+ * the current one if the version of their data store has changed.
+ */
+static pthread_mutex_t Sched_Config_Snapshot_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static std::atomic<u_long64> Sched_Config_Version[ocs::DataStore::MAX_ID];
+static std::shared_ptr<const sconf_snapshot_t> Sched_Config_Snapshot[ocs::DataStore::MAX_ID];
+static thread_local std::shared_ptr<const sconf_snapshot_t> Thread_Sched_Config_Snapshot;
 
 static bool calc_pos();
 
@@ -334,6 +385,9 @@ sconf_eval_set_duration_offset(lList *param_list, lList **answer_list, const cha
 static bool 
 sconf_eval_set_pe_range_alg(lList *param_list, lList **answer_list, const char* param); 
 
+static bool
+sconf_eval_set_ticket_threads(lList *param_list, lList **answer_list, const char* param);
+
 static char policy_hierarchy_enum2char(policy_type_t value);
 
 static policy_type_t policy_hierarchy_char2enum(char character);
@@ -364,6 +418,7 @@ const parameters_t params[] = {
    {"MONITOR",         sconf_eval_set_monitoring},
    {"DURATION_OFFSET", sconf_eval_set_duration_offset},
    {"PE_RANGE_ALG",    sconf_eval_set_pe_range_alg},
+   {"TICKET_THREADS",  sconf_eval_set_ticket_threads},
    {"NONE",            nullptr},
    {nullptr,           nullptr}
 };
@@ -517,6 +572,136 @@ static bool calc_pos()
    DRETURN(ret);
 }
 
+/*
+ * Builds a new snapshot of the configuration in the active data store of
+ * the calling thread and makes it visible to all threads.
+ *
+ * MT-NOTE: sconf_publish_snapshot() is MT safe, the caller must not hold LOCK_SCHED_CONF
+ */
+static void
+sconf_publish_snapshot() {
+   ocs::DataStore::Id ds_id = ocs::DataStore::get_active_ds();
+
+   sge_mutex_lock("Sched_Conf_Snapshot_Lock", "", __LINE__, &Sched_Config_Snapshot_Mutex);
+
+   auto snapshot = std::make_shared<sconf_snapshot_t>();
+   snapshot->version = Sched_Config_Version[ds_id].load() + 1;
+   snapshot->ds_id = ds_id;
+
+   if (sconf_is()) {
+      snapshot->load_adjustment_decay_time = sconf_read_load_adjustment_decay_time();
+      snapshot->queue_sort_method = sconf_read_queue_sort_method();
+      snapshot->maxujobs = sconf_read_maxujobs();
+      snapshot->schedule_interval = sconf_read_schedule_interval();
+      snapshot->reprioritize_interval = sconf_read_reprioritize_interval();
+      snapshot->weight_user = sconf_read_weight_user();
+      snapshot->weight_department = sconf_read_weight_department();
+      snapshot->weight_project = sconf_read_weight_project();
+      snapshot->weight_job = sconf_read_weight_job();
+      snapshot->weight_tickets_share = sconf_read_weight_tickets_share();
+      snapshot->weight_tickets_functional = sconf_read_weight_tickets_functional();
+      snapshot->halftime = sconf_read_halftime();
+      snapshot->weight_tickets_override = sconf_read_weight_tickets_override();
+      snapshot->compensation_factor = sconf_read_compensation_factor();
+      snapshot->weight_ticket = sconf_read_weight_ticket();
+      snapshot->weight_waiting_time = sconf_read_weight_waiting_time();
+      snapshot->weight_deadline = sconf_read_weight_deadline();
+      snapshot->weight_urgency = sconf_read_weight_urgency();
+      snapshot->max_reservations = sconf_read_max_reservations();
+      snapshot->weight_priority = sconf_read_weight_priority();
+      snapshot->share_override_tickets = sconf_read_share_override_tickets();
+      snapshot->share_functional_shares = sconf_read_share_functional_shares();
+      snapshot->report_pjob_tickets = sconf_read_report_pjob_tickets();
+      snapshot->flush_submit_sec = sconf_read_flush_submit_sec();
+      snapshot->flush_finish_sec = sconf_read_flush_finish_sec();
+      snapshot->max_functional_jobs_to_schedule = sconf_read_max_functional_jobs_to_schedule();
+      snapshot->max_pending_tasks_per_job = sconf_read_max_pending_tasks_per_job();
+      snapshot->default_duration = sconf_read_default_duration();
+      snapshot->load_formula = sconf_read_load_formula();
+   } else {
+      // no configuration in this data store, use the same defaults as for unset attributes
+      snapshot->load_adjustment_decay_time = _DEFAULT_LOAD_ADJUSTMENTS_DECAY_TIME;
+      snapshot->queue_sort_method = 0;
+      snapshot->maxujobs = MAXUJOBS;
+      snapshot->schedule_interval = _SCHEDULE_TIME;
+      snapshot->reprioritize_interval = REPRIORITIZE_INTERVAL_I;
+      snapshot->weight_user = 0;
+      snapshot->weight_department = 0;
+      snapshot->weight_project = 0;
+      snapshot->weight_job = 0;
+      snapshot->weight_tickets_share = 0;
+      snapshot->weight_tickets_functional = 0;
+      snapshot->halftime = 0;
+      snapshot->weight_tickets_override = 0;
+      snapshot->compensation_factor = 1;
+      snapshot->weight_ticket = 0;
+      snapshot->weight_waiting_time = 0;
+      snapshot->weight_deadline = 0;
+      snapshot->weight_urgency = 0;
+      snapshot->max_reservations = 0;
+      snapshot->weight_priority = 0;
+      snapshot->share_override_tickets = false;
+      snapshot->share_functional_shares = true;
+      snapshot->report_pjob_tickets = true;
+      snapshot->flush_submit_sec = 0;
+      snapshot->flush_finish_sec = 0;
+      snapshot->max_functional_jobs_to_schedule = 200;
+      snapshot->max_pending_tasks_per_job = 50;
+      snapshot->default_duration = DEFAULT_DURATION_I;
+      snapshot->load_formula = DEFAULT_LOAD_FORMULA;
+   }
+   snapshot->duration_offset = sconf_read_duration_offset();
+   snapshot->ticket_threads = sconf_read_ticket_threads();
+   snapshot->profiling = sconf_read_profiling();
+
+   std::atomic_store(&Sched_Config_Snapshot[ds_id], std::shared_ptr<const sconf_snapshot_t>(snapshot));
+   Sched_Config_Version[ds_id].store(snapshot->version, std::memory_order_release);
+
+   sge_mutex_unlock("Sched_Conf_Snapshot_Lock", "", __LINE__, &Sched_Config_Snapshot_Mutex);
+}
+
+/* MT-NOTE: sconf_thread_snapshot() is MT safe, the returned pointer is valid until the next call in the same thread */
+static const sconf_snapshot_t *
+sconf_thread_snapshot() {
+   ocs::DataStore::Id ds_id = ocs::DataStore::get_active_ds();
+   const sconf_snapshot_t *snapshot = Thread_Sched_Config_Snapshot.get();
+
+   if (snapshot == nullptr || snapshot->ds_id != ds_id ||
+       snapshot->version != Sched_Config_Version[ds_id].load(std::memory_order_acquire)) {
+      Thread_Sched_Config_Snapshot = std::atomic_load(&Sched_Config_Snapshot[ds_id]);
+      if (Thread_Sched_Config_Snapshot == nullptr) {
+         // nothing published for this data store so far
+         sconf_publish_snapshot();
+         Thread_Sched_Config_Snapshot = std::atomic_load(&Sched_Config_Snapshot[ds_id]);
+      }
+      snapshot = Thread_Sched_Config_Snapshot.get();
+   }
+   return snapshot;
+}
+
+/****** sge_schedd_conf/sconf_get_snapshot() ***********************************
+*  NAME
+*     sconf_get_snapshot() -- returns the current configuration snapshot
+*
+*  SYNOPSIS
+*     std::shared_ptr<const sconf_snapshot_t> sconf_get_snapshot()
+*
+*  FUNCTION
+*     Returns the snapshot of the scheduler configuration of the active
+*     data store. The snapshot does not change while it is referenced.
+*     Fetch it once per scheduling run to work with consistent values.
+*
+*  RESULT
+*     std::shared_ptr<const sconf_snapshot_t> - the configuration snapshot
+*
+*  NOTES
+*     MT-NOTE: sconf_get_snapshot() is MT safe, no lock is taken
+*******************************************************************************/
+std::shared_ptr<const sconf_snapshot_t> sconf_get_snapshot() {
+   sconf_thread_snapshot();
+   return Thread_Sched_Config_Snapshot;
+}
+
 /****** sge_schedd_conf/schedd_conf_set_config() *******************************
 *  NAME
 *     schedd_conf_set_config() -- overwrites the existing configuration 
@@ -596,6 +781,7 @@ bool sconf_set_config(lList **config, lList **answer_list)
    }
 
    sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+   sconf_publish_snapshot();
    DRETURN(ret);
 }
 
@@ -809,11 +995,16 @@ static const char * get_load_adjustment_decay_time_str()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_load_adjustment_decay_time()
 {
+   return sconf_thread_snapshot()->load_adjustment_decay_time;
+}
+
+static u_long32
+sconf_read_load_adjustment_decay_time() {
    u_long32 uval;
    const char *time = nullptr;
 
@@ -906,17 +1097,33 @@ static const lList *get_job_load_adjustments()
 *  RESULT
 *     const char* - this is a copy of the load formula, the caller has to free it
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  NOTES
+*     Use sconf_get_snapshot() in loops to access the formula without copying it.
+*
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 char* sconf_get_load_formula() {
-   char *formula = nullptr;
-  
+   const sconf_snapshot_t *snapshot = sconf_thread_snapshot();
+
+   if (snapshot->load_formula.empty()) {
+      return nullptr;
+   }
+   return sge_strdup(nullptr, snapshot->load_formula.c_str());
+}
+
+static std::string
+sconf_read_load_formula() {
+   std::string formula;
+
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
 
-   formula = sge_strdup(formula, get_load_formula());  
-  
-   sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex); 
+   const char *value = get_load_formula();
+   if (value != nullptr) {
+      formula = value;
+   }
+
+   sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
    return formula;
 }
 
@@ -967,11 +1174,16 @@ static const char* get_load_formula()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_queue_sort_method() 
 {
+   return sconf_thread_snapshot()->queue_sort_method;
+}
+
+static u_long32
+sconf_read_queue_sort_method() {
    const lListElem *sc_ep =  nullptr;
    u_long32 sort_method = 0;
   
@@ -1002,11 +1214,16 @@ u_long32 sconf_get_queue_sort_method()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_maxujobs() 
 {
+   return sconf_thread_snapshot()->maxujobs;
+}
+
+static u_long32
+sconf_read_maxujobs() {
    u_long32 jobs = MAXUJOBS;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1070,10 +1287,15 @@ static const char *get_schedule_interval_str()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_schedule_interval() {
+   return sconf_thread_snapshot()->schedule_interval;
+}
+
+static u_long32
+sconf_read_schedule_interval() {
    u_long32 uval = _SCHEDULE_TIME;   
    const char *time = nullptr;
    
@@ -1135,10 +1357,15 @@ static const char *reprioritize_interval_str()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_reprioritize_interval() {
+   return sconf_thread_snapshot()->reprioritize_interval;
+}
+
+static u_long32
+sconf_read_reprioritize_interval() {
    u_long32 uval = REPRIORITIZE_INTERVAL_I;
    const char *time = nullptr;
 
@@ -1547,11 +1774,16 @@ static const lList *get_usage_weight_list()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_user() 
 {
+   return sconf_thread_snapshot()->weight_user;
+}
+
+static double
+sconf_read_weight_user() {
    double weight = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1581,11 +1813,16 @@ double sconf_get_weight_user()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_department() 
 {
+   return sconf_thread_snapshot()->weight_department;
+}
+
+static double
+sconf_read_weight_department() {
    double weight = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1615,11 +1852,16 @@ double sconf_get_weight_department()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_project() 
 {
+   return sconf_thread_snapshot()->weight_project;
+}
+
+static double
+sconf_read_weight_project() {
    double weight = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1649,11 +1891,16 @@ double sconf_get_weight_project()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_job() 
 {
+   return sconf_thread_snapshot()->weight_job;
+}
+
+static double
+sconf_read_weight_job() {
    double weight = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1683,11 +1930,16 @@ double sconf_get_weight_job()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_weight_tickets_share() 
 {
+   return sconf_thread_snapshot()->weight_tickets_share;
+}
+
+static u_long32
+sconf_read_weight_tickets_share() {
    double weight = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1717,11 +1969,16 @@ u_long32 sconf_get_weight_tickets_share()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_weight_tickets_functional() 
 {
+   return sconf_thread_snapshot()->weight_tickets_functional;
+}
+
+static u_long32
+sconf_read_weight_tickets_functional() {
    double weight = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1751,11 +2008,16 @@ u_long32 sconf_get_weight_tickets_functional()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_halftime() 
 {
+   return sconf_thread_snapshot()->halftime;
+}
+
+static u_long32
+sconf_read_halftime() {
    const lListElem *sc_ep = nullptr;
    u_long32 halftime = 0;
   
@@ -1803,6 +2065,7 @@ void sconf_set_weight_tickets_override(u_long32 active)
    }
 
    sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+   sconf_publish_snapshot();
    return;
 }
 
@@ -1819,11 +2082,16 @@ void sconf_set_weight_tickets_override(u_long32 active)
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_weight_tickets_override() 
 {
+   return sconf_thread_snapshot()->weight_tickets_override;
+}
+
+static u_long32
+sconf_read_weight_tickets_override() {
    u_long32 tickets = 0;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);   
@@ -1854,11 +2122,16 @@ u_long32 sconf_get_weight_tickets_override()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_compensation_factor() 
 {
+   return sconf_thread_snapshot()->compensation_factor;
+}
+
+static double
+sconf_read_compensation_factor() {
    double factor = 1;
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1888,11 +2161,16 @@ double sconf_get_compensation_factor()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_ticket() 
 {
+   return sconf_thread_snapshot()->weight_ticket;
+}
+
+static double
+sconf_read_weight_ticket() {
    double  weight = 0;   
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1936,11 +2214,16 @@ void sconf_get_weight_ticket_urgency_priority(double *ticket, double *urgency, d
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_waiting_time() 
 {
+   return sconf_thread_snapshot()->weight_waiting_time;
+}
+
+static double
+sconf_read_weight_waiting_time() {
    double weight = 0;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -1970,11 +2253,16 @@ double sconf_get_weight_waiting_time()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_deadline() 
 {
+   return sconf_thread_snapshot()->weight_deadline;
+}
+
+static double
+sconf_read_weight_deadline() {
    double weight = 0;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2004,11 +2292,16 @@ double sconf_get_weight_deadline()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_urgency() 
 {
+   return sconf_thread_snapshot()->weight_urgency;
+}
+
+static double
+sconf_read_weight_urgency() {
    double weight = 0;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2038,10 +2331,15 @@ double sconf_get_weight_urgency()
 *  RESULT
 *     int - Max. number of reservations
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_max_reservations() {
+   return sconf_thread_snapshot()->max_reservations;
+}
+
+static u_long32
+sconf_read_max_reservations() {
    u_long32 max_res = 0;
  
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2098,11 +2396,16 @@ static const char *get_default_duration_str()
 *  RESULT
 *     double - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 double sconf_get_weight_priority() 
 {
+   return sconf_thread_snapshot()->weight_priority;
+}
+
+static double
+sconf_read_weight_priority() {
    double weight = 0;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2133,11 +2436,16 @@ double sconf_get_weight_priority()
 *  RESULT
 *     bool - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 bool sconf_get_share_override_tickets() 
 {
+   return sconf_thread_snapshot()->share_override_tickets;
+}
+
+static bool
+sconf_read_share_override_tickets() {
    bool is_share = false;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2168,6 +2476,11 @@ bool sconf_get_share_override_tickets()
 *******************************************************************************/
 bool sconf_get_share_functional_shares()
 {
+   return sconf_thread_snapshot()->share_functional_shares;
+}
+
+static bool
+sconf_read_share_functional_shares() {
    bool is_share = true;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2197,11 +2510,16 @@ bool sconf_get_share_functional_shares()
 *  RESULT
 *     bool - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 bool sconf_get_report_pjob_tickets()
 {
+   return sconf_thread_snapshot()->report_pjob_tickets;
+}
+
+static bool
+sconf_read_report_pjob_tickets() {
    bool is_report = true;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2231,11 +2549,16 @@ bool sconf_get_report_pjob_tickets()
 *  RESULT
 *     int - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_flush_submit_sec()
 {
+   return sconf_thread_snapshot()->flush_submit_sec;
+}
+
+static u_long32
+sconf_read_flush_submit_sec() {
    const lListElem *sc_ep = nullptr;
    u_long32 flush_sec = 0;
   
@@ -2268,11 +2591,16 @@ u_long32 sconf_get_flush_submit_sec()
 *  RESULT
 *     int - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_flush_finish_sec()
 {
+   return sconf_thread_snapshot()->flush_finish_sec;
+}
+
+static u_long32
+sconf_read_flush_finish_sec() {
    const lListElem *sc_ep = nullptr;
    u_long32 flush_sec = 0;
   
@@ -2306,11 +2634,16 @@ u_long32 sconf_get_flush_finish_sec()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE: is thread save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_max_functional_jobs_to_schedule()
 {
+   return sconf_thread_snapshot()->max_functional_jobs_to_schedule;
+}
+
+static u_long32
+sconf_read_max_functional_jobs_to_schedule() {
    u_long32 amount = 200;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2340,11 +2673,16 @@ u_long32 sconf_get_max_functional_jobs_to_schedule()
 *  RESULT
 *     u_long32 - 
 *
-*  MT-NOTE:   is MT save, uses LOCK_SCHED_CONF(read)
+*  MT-NOTE: is MT safe, reads the configuration snapshot without locking
 *
 *******************************************************************************/
 u_long32 sconf_get_max_pending_tasks_per_job()
 {
+   return sconf_thread_snapshot()->max_pending_tasks_per_job;
+}
+
+static u_long32
+sconf_read_max_pending_tasks_per_job() {
    u_long32 max_pending = 50;
  
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -2612,95 +2950,95 @@ void sconf_print_config(){
    sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
 
    /* --- SC_maxujobs */
-   uval = sconf_get_maxujobs();
+   uval = sconf_read_maxujobs();
    INFO(MSG_ATTRIB_USINGXFORY_US, sge_u32c( uval), "maxujobs");
 
    /* --- SC_queue_sort_method (was: SC_sort_seq_no) */
-   uval = sconf_get_queue_sort_method();
+   uval = sconf_read_queue_sort_method();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "queue_sort_method");
 
    /* --- SC_flush_submit_sec */
-   uval = sconf_get_flush_submit_sec();
+   uval = sconf_read_flush_submit_sec();
    INFO(MSG_ATTRIB_USINGXFORY_US, sge_u32c (uval), "flush_submit_sec");
 
    /* --- SC_flush_finish_sec */
-   uval = sconf_get_flush_finish_sec();
+   uval = sconf_read_flush_finish_sec();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval) , "flush_finish_sec");
    
    /* --- SC_halftime */
-   uval = sconf_get_halftime();
+   uval = sconf_read_halftime();
    INFO(MSG_ATTRIB_USINGXFORY_US ,  sge_u32c (uval), "halftime");
 
    /* --- SC_compensation_factor */
-   dval = sconf_get_compensation_factor();
+   dval = sconf_read_compensation_factor();
    INFO(MSG_ATTRIB_USINGXFORY_6FS, dval, "compensation_factor");
 
    /* --- SC_weight_user */
-   dval = sconf_get_weight_user();
+   dval = sconf_read_weight_user();
    INFO(MSG_ATTRIB_USINGXFORY_6FS, dval, "weight_user");
 
    /* --- SC_weight_project */
-   dval = sconf_get_weight_project();
+   dval = sconf_read_weight_project();
    INFO(MSG_ATTRIB_USINGXFORY_6FS, dval, "weight_project");
 
    /* --- SC_weight_department */
-   dval = sconf_get_weight_department();
+   dval = sconf_read_weight_department();
    INFO(MSG_ATTRIB_USINGXFORY_6FS, dval, "weight_department");
 
    /* --- SC_weight_job */
-   dval = sconf_get_weight_job();
+   dval = sconf_read_weight_job();
    INFO(MSG_ATTRIB_USINGXFORY_6FS, dval, "weight_job");
 
    /* --- SC_weight_tickets_functional */
-   uval = sconf_get_weight_tickets_functional();
+   uval = sconf_read_weight_tickets_functional();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "weight_tickets_functional");
 
    /* --- SC_weight_tickets_share */
-   uval = sconf_get_weight_tickets_share();
+   uval = sconf_read_weight_tickets_share();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "weight_tickets_share");
 
    /* --- SC_share_override_tickets */
-   uval = sconf_get_share_override_tickets();
+   uval = sconf_read_share_override_tickets();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "share_override_tickets");
 
    /* --- SC_share_functional_shares */
-   uval = sconf_get_share_functional_shares();
+   uval = sconf_read_share_functional_shares();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "share_functional_shares");
 
    /* --- SC_max_functional_jobs_to_schedule */
-   uval = sconf_get_max_functional_jobs_to_schedule();
+   uval = sconf_read_max_functional_jobs_to_schedule();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "max_functional_jobs_to_schedule");
    
    /* --- SC_report_job_tickets */
-   uval = sconf_get_report_pjob_tickets();
+   uval = sconf_read_report_pjob_tickets();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "report_pjob_tickets");
    
    /* --- SC_max_pending_tasks_per_job */
-   uval = sconf_get_max_pending_tasks_per_job();
+   uval = sconf_read_max_pending_tasks_per_job();
    INFO(MSG_ATTRIB_USINGXFORY_US,  sge_u32c (uval), "max_pending_tasks_per_job");
 
    /* --- SC_weight_ticket */
-   dval = sconf_get_weight_ticket();
+   dval = sconf_read_weight_ticket();
    INFO(MSG_ATTRIB_USINGXFORY_6FS,  dval, "weight_ticket");
 
    /* --- SC_weight_waiting_time */
-   dval = sconf_get_weight_waiting_time();
+   dval = sconf_read_weight_waiting_time();
    INFO(MSG_ATTRIB_USINGXFORY_6FS,  dval, "weight_waiting_time");
 
    /* --- SC_weight_deadline */
-   dval = sconf_get_weight_deadline();
+   dval = sconf_read_weight_deadline();
    INFO(MSG_ATTRIB_USINGXFORY_6FS,  dval, "weight_deadline");
 
    /* --- SC_weight_urgency */
-   dval = sconf_get_weight_urgency();
+   dval = sconf_read_weight_urgency();
    INFO(MSG_ATTRIB_USINGXFORY_6FS,  dval, "weight_urgency");
 
    /* --- SC_weight_priority */
-   dval = sconf_get_weight_priority();
+   dval = sconf_read_weight_priority();
    INFO(MSG_ATTRIB_USINGXFORY_6FS,  dval, "weight_priority");
 
    /* --- SC_max_reservation */
-   dval = sconf_get_max_reservations();
+   dval = sconf_read_max_reservations();
    INFO(MSG_ATTRIB_USINGXFORY_6FS,  dval, "max_reservation");
 
    DRETURN_VOID;
@@ -2785,6 +3123,7 @@ bool sconf_validate_config_(lList **answer_list)
 
    if (!sconf_is()){
       DPRINTF("sconf_validate: no config to validate\n");
+      sconf_publish_snapshot();
       DRETURN(true);
    }
    
@@ -2811,6 +3150,7 @@ bool sconf_validate_config_(lList **answer_list)
       current_serf_do_monitoring = false;
       pos.s_duration_offset = DEFAULT_DURATION_OFFSET; 
       pe_algorithm = SCHEDD_PE_AUTO;
+      ticket_threads = DEFAULT_TICKET_THREADS;
 
       if (sparams) {
          struct saved_vars_s *context = nullptr;
@@ -2843,7 +3183,7 @@ bool sconf_validate_config_(lList **answer_list)
    
    sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
 
-   max_reservation = sconf_get_max_reservations();
+   max_reservation = sconf_read_max_reservations();
    
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
    
@@ -3056,12 +3396,13 @@ bool sconf_validate_config_(lList **answer_list)
    }
 
    /* --- max_pending_tasks_per_job */
-   if (sconf_get_max_pending_tasks_per_job() == 0) {
+   if (sconf_read_max_pending_tasks_per_job() == 0) {
       snprintf(SGE_EVENT, SGE_EVENT_SIZE, MSG_ATTRIB_WRONG_SETTING_SS, "max_pending_tasks_per_job", ">0");
       answer_list_add(answer_list, SGE_EVENT, STATUS_ESYNTAX, ANSWER_QUALITY_ERROR);
       ret = false;
    }
-   
+
+   sconf_publish_snapshot();
    DRETURN(ret);
 }
 
@@ -3543,6 +3884,44 @@ static bool sconf_eval_set_pe_range_alg(lList *param_list, lList **answer_list,
    DRETURN(false);
 }
 
+/****** sge_schedd_conf/sconf_eval_set_ticket_threads() ************************
+*  NAME
+*     sconf_eval_set_ticket_threads() -- parses the sched. param
+*
+*  SYNOPSIS
+*     static bool sconf_eval_set_ticket_threads(lList *param_list, lList 
+*     **answer_list, const char* param) 
+*
+*  FUNCTION
+*     TICKET_THREADS=<n> sets the number of threads used for the per job
+*     passes of the ticket calculation. Valid are values from 1 to 
+*     MAX_TICKET_THREADS.
+*
+*  RESULT
+*     static bool - true, if successful
+*
+*  NOTES
+*     MT-NOTE: sconf_eval_set_ticket_threads() is not MT safe, caller needs LOCK_SCHED_CONF(write)
+*
+*******************************************************************************/
+static bool sconf_eval_set_ticket_threads(lList *param_list, lList **answer_list, const char* param)
+{
+   u_long32 uval;
+   char *s;
+
+   if (!(s=strchr((char *)param, '=')) ||
+       !extended_parse_ulong_val(nullptr, &uval, TYPE_INT, ++s, nullptr, 0, 0, true) ||
+       uval < 1 || uval > MAX_TICKET_THREADS) {
+      ticket_threads = DEFAULT_TICKET_THREADS;
+      snprintf(SGE_EVENT, SGE_EVENT_SIZE, MSG_INVALID_PARAM_SETTING_S, param);
+      answer_list_add(answer_list, SGE_EVENT, STATUS_ESYNTAX, ANSWER_QUALITY_ERROR);
+      return false;
+   }
+   ticket_threads = uval;
+
+   return true;
+}
+
 /* 
    QS_STATE_FULL
       All debitations caused by running jobs are in effect.
@@ -3574,6 +3953,11 @@ bool sconf_get_global_load_correction()
 
 u_long32 sconf_get_default_duration()
 {
+   return sconf_thread_snapshot()->default_duration;
+}
+
+static u_long32
+sconf_read_default_duration() {
    return pos.c_default_duration;
 }
 
@@ -3663,6 +4047,11 @@ void sconf_set_tmp_sme(lListElem *sme) {
 
 u_long32 sconf_get_duration_offset()
 {
+   return sconf_thread_snapshot()->duration_offset;
+}
+
+static u_long32
+sconf_read_duration_offset() {
    u_long32 offset = 0;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
@@ -3673,6 +4062,35 @@ u_long32 sconf_get_duration_offset()
    return offset;
 }
 
+/****** sge_schedd_conf/sconf_get_ticket_threads() *****************************
+*  NAME
+*     sconf_get_ticket_threads() -- number of threads for ticket calculation
+*
+*  SYNOPSIS
+*     u_long32 sconf_get_ticket_threads() 
+*
+*  RESULT
+*     u_long32 - number of threads as set with the TICKET_THREADS param
+*
+*  NOTES
+*     MT-NOTE: is MT safe, reads the configuration snapshot without locking
+*******************************************************************************/
+u_long32 sconf_get_ticket_threads()
+{
+   return sconf_thread_snapshot()->ticket_threads;
+}
+
+static u_long32
+sconf_read_ticket_threads() {
+   u_long32 threads;
+
+   sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+   threads = ticket_threads;
+   sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+
+   return threads;
+}
+
 /****** sge_resource_utilization/serf_control() ********************************
 *  NAME
 *     serf_get_active() -- Retrieve whether SERF is active or not
@@ -3707,6 +4125,11 @@ bool serf_get_active()
 
 bool sconf_get_profiling()
 {
+   return sconf_thread_snapshot()->profiling;
+}
+
+static bool
+sconf_read_profiling() {
    bool profiling = false;
 
    sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
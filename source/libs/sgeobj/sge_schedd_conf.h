@@ -33,6 +33,9 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <memory>
+#include <string>
+
 #include "cull/cull.h"
 
 #include "sgeobj/cull/sge_schedd_conf_PARA_L.h"
@@ -91,6 +94,52 @@ typedef struct {
    int dependent;
 } policy_hierarchy_t;
 
+/**
+ * @brief Immutable copy of the scheduler configuration values.
+ *
+ * A snapshot is published per data store whenever the scheduler configuration
+ * of this data store is set or validated. It is used by the sconf_get_*()
+ * functions and can be fetched once per scheduling run with sconf_get_snapshot().
+ */
+struct sconf_snapshot_t {
+   u_long64    version;
+   int         ds_id;
+   u_long32    load_adjustment_decay_time;
+   u_long32    queue_sort_method;
+   u_long32    maxujobs;
+   u_long32    schedule_interval;
+   u_long32    reprioritize_interval;
+   double      weight_user;
+   double      weight_department;
+   double      weight_project;
+   double      weight_job;
+   u_long32    weight_tickets_share;
+   u_long32    weight_tickets_functional;
+   u_long32    halftime;
+   u_long32    weight_tickets_override;
+   double      compensation_factor;
+   double      weight_ticket;
+   double      weight_waiting_time;
+   double      weight_deadline;
+   double      weight_urgency;
+   u_long32    max_reservations;
+   double      weight_priority;
+   bool        share_override_tickets;
+   bool        share_functional_shares;
+   bool        report_pjob_tickets;
+   u_long32    flush_submit_sec;
+   u_long32    flush_finish_sec;
+   u_long32    max_functional_jobs_to_schedule;
+   u_long32    max_pending_tasks_per_job;
+   u_long32    default_duration;
+   u_long32    duration_offset;
+   u_long32    ticket_threads;
+   bool        profiling;
+   std::string load_formula;
+};
+
+std::shared_ptr<const sconf_snapshot_t> sconf_get_snapshot();
+
 void sconf_ph_fill_array(policy_hierarchy_t array[]);
 
 void sconf_ph_print_array(policy_hierarchy_t array[]);
@@ -212,6 +261,8 @@ void sconf_set_last_dispatch_type(int changed);
 
 u_long32  sconf_get_duration_offset();
 
+u_long32  sconf_get_ticket_threads();
+
 bool serf_get_active();
 
 schedd_pe_algorithm sconf_best_pe_alg();
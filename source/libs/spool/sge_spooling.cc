@@ -32,6 +32,7 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_profiling.h"
 #include "uti/sge_rmon_macros.h"
 
@@ -499,6 +500,8 @@ bool spool_transaction(lList **answer_list, const lListElem *context,
 
    DENTER(TOP_LAYER);
    PROF_START_MEASUREMENT(SGE_PROF_SPOOLING);
+   SPAN_TRACE_START(spool_span, "spooling", "transaction",
+                    cmd == STC_begin ? "begin" : (cmd == STC_commit ? "commit" : "rollback"));
 
    if (context == nullptr) {
       answer_list_add_sprintf(answer_list, STATUS_EUNKNOWN, 
@@ -1197,6 +1200,7 @@ spool_write_object(lList **answer_list, const lListElem *context,
    bool ret = false;
  
    DENTER(TOP_LAYER);
+   SPAN_TRACE_START(spool_span, "spooling", "write", object_type_get_name(object_type));
 
    switch (object_type) {
 
@@ -1313,6 +1317,7 @@ spool_delete_object(lList **answer_list, const lListElem *context,
    bool ret = false;
    
    DENTER(TOP_LAYER);
+   SPAN_TRACE_START(spool_span, "spooling", "delete", object_type_get_name(object_type));
 
    switch (object_type) {
 
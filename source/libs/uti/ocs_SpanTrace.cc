@@ -0,0 +1,222 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "uti/ocs_SpanTrace.h"
+#include "uti/sge_component.h"
+
+#include "msg_common.h"
+
+namespace {
+   struct SpanRecord {
+      const char *category;
+      const char *name;
+      const char *detail;
+      u_long64 start;
+      u_long64 end;
+   };
+
+   // ring buffer of one thread, the mutex is only contended while the spans are dumped
+   struct ThreadSpans {
+      std::mutex mutex;
+      u_long32 tid{0};
+      std::string thread_name;
+      std::vector<SpanRecord> spans;
+      size_t next{0};
+   };
+
+   // buffers of all threads, buffers of terminated threads are kept for the next dump
+   std::mutex Registry_Mutex;
+   std::vector<std::shared_ptr<ThreadSpans>> Registry;
+   thread_local std::shared_ptr<ThreadSpans> Thread_Spans;
+
+   ThreadSpans *
+   thread_spans() {
+      if (Thread_Spans == nullptr) {
+         auto spans = std::make_shared<ThreadSpans>();
+         const char *thread_name = component_get_thread_name();
+
+         spans->spans.reserve(ocs::SpanTrace::BUFFER_SIZE);
+         std::lock_guard<std::mutex> guard(Registry_Mutex);
+         spans->tid = (u_long32) Registry.size() + 1;
+         if (thread_name != nullptr) {
+            spans->thread_name = thread_name;
+         } else {
+            spans->thread_name = "thread " + std::to_string(spans->tid);
+         }
+         Registry.push_back(spans);
+         Thread_Spans = spans;
+      }
+      return Thread_Spans.get();
+   }
+
+   void
+   write_json_string(FILE *fp, const char *str) {
+      fputc('"', fp);
+      for (const char *c = str; *c != '\0'; c++) {
+         if (*c == '"' || *c == '\\') {
+            fputc('\\', fp);
+            fputc(*c, fp);
+         } else if ((unsigned char) *c < 0x20) {
+            fprintf(fp, "\\u%04x", (unsigned char) *c);
+         } else {
+            fputc(*c, fp);
+         }
+      }
+      fputc('"', fp);
+   }
+}
+
+std::atomic<bool> ocs::SpanTrace::Enabled{false};
+
+/** @brief Switches recording of spans on or off
+ *
+ * Spans which are already recorded are kept.
+ *
+ * @param enabled true to record spans
+ */
+void
+ocs::SpanTrace::set_enabled(bool enabled) {
+   Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/** @brief Adds a span to the buffer of the calling thread
+ *
+ * Usually called by Span::stop().
+ *
+ * @param category category of the span, e.g. "gdi" or "lock"
+ * @param name name of the span
+ * @param detail optional detail shown as argument of the span or nullptr
+ * @param start start time of the span, see now()
+ * @param end end time of the span, see now()
+ */
+void
+ocs::SpanTrace::record(const char *category, const char *name, const char *detail, u_long64 start, u_long64 end) {
+   ThreadSpans *spans = thread_spans();
+   SpanRecord span{category, name, detail, start, end};
+
+   std::lock_guard<std::mutex> guard(spans->mutex);
+   if (spans->spans.size() < BUFFER_SIZE) {
+      spans->spans.push_back(span);
+   } else {
+      spans->spans[spans->next] = span;
+   }
+   spans->next = (spans->next + 1) % BUFFER_SIZE;
+}
+
+/** @brief Writes all recorded spans to a file in the Chrome trace event format
+ *
+ * The spans stay in the buffers, recording continues while the file is written.
+ *
+ * @param filename file to be written, an existing file is overwritten
+ * @param error error message in case of an error
+ * @param written if not nullptr the number of written spans is returned here
+ * @return true on success
+ */
+bool
+ocs::SpanTrace::dump(const char *filename, dstring *error, u_long32 *written) {
+   std::vector<std::shared_ptr<ThreadSpans>> threads;
+   {
+      std::lock_guard<std::mutex> guard(Registry_Mutex);
+      threads = Registry;
+   }
+
+   FILE *fp = fopen(filename, "w");
+   if (fp == nullptr) {
+      sge_dstring_sprintf(error, MSG_ERROROPENINGFILEFORWRITING_SS, filename, strerror(errno));
+      return false;
+   }
+
+   u_long32 count = 0;
+   int pid = (int) getpid();
+   const char *component_name = component_get_component_name();
+   fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+   fprintf(fp, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"args\":{\"name\":", pid);
+   write_json_string(fp, component_name != nullptr ? component_name : "sge");
+   fprintf(fp, "}}");
+   for (const auto &thread : threads) {
+      std::vector<SpanRecord> spans;
+      size_t next;
+      {
+         std::lock_guard<std::mutex> guard(thread->mutex);
+         spans = thread->spans;
+         next = thread->next;
+      }
+
+      fprintf(fp, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":" sge_u32 ",\"args\":{\"name\":",
+              pid, thread->tid);
+      write_json_string(fp, thread->thread_name.c_str());
+      fprintf(fp, "}}");
+
+      // oldest span first, the buffer might have wrapped around
+      size_t size = spans.size();
+      for (size_t i = 0; i < size; i++) {
+         const SpanRecord &span = spans[(size < BUFFER_SIZE ? i : (next + i) % size)];
+
+         fprintf(fp, ",\n{\"ph\":\"X\",\"cat\":");
+         write_json_string(fp, span.category);
+         fprintf(fp, ",\"name\":");
+         write_json_string(fp, span.name);
+         fprintf(fp, ",\"pid\":%d,\"tid\":" sge_u32 ",\"ts\":%.3f,\"dur\":%.3f", pid, thread->tid,
+                 span.start / 1000.0, (span.end - span.start) / 1000.0);
+         if (span.detail != nullptr) {
+            fprintf(fp, ",\"args\":{\"detail\":");
+            write_json_string(fp, span.detail);
+            fprintf(fp, "}");
+         }
+         fprintf(fp, "}");
+         count++;
+      }
+   }
+   fprintf(fp, "\n]}\n");
+
+   bool ret = true;
+   if (ferror(fp) != 0) {
+      sge_dstring_sprintf(error, MSG_ERRORWRITINGFILE_SS, filename, strerror(errno));
+      ret = false;
+   }
+   if (fclose(fp) != 0 && ret) {
+      sge_dstring_sprintf(error, MSG_ERRORWRITINGFILE_SS, filename, strerror(errno));
+      ret = false;
+   }
+   if (written != nullptr) {
+      *written = count;
+   }
+   return ret;
+}
+
+/** @brief Removes all recorded spans */
+void
+ocs::SpanTrace::clear() {
+   std::lock_guard<std::mutex> guard(Registry_Mutex);
+   for (const auto &thread : Registry) {
+      std::lock_guard<std::mutex> thread_guard(thread->mutex);
+      thread->spans.clear();
+      thread->next = 0;
+   }
+}
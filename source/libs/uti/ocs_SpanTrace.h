@@ -0,0 +1,106 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <atomic>
+#include <ctime>
+
+#include "basis_types.h"
+
+#include "uti/sge_dstring.h"
+
+namespace ocs {
+   /** @brief Span tracer for offline analysis of where time was spent
+    *
+    * Spans are kept in a ring buffer per thread, the oldest spans of a thread are
+    * overwritten once its buffer is full. Recording is switched on and off at runtime,
+    * the spans recorded so far can be written at any time to a file in the
+    * Chrome trace event format which can be loaded in Perfetto or chrome://tracing.
+    *
+    * Names, categories and details of spans are stored as pointers, they have to be
+    * string constants or strings which are never freed.
+    *
+    * Spans are only compiled in if the build option WITH_SPAN_TRACE is enabled,
+    * see SPAN_TRACE_START() and SPAN_TRACE_STOP().
+    */
+   class SpanTrace {
+   public:
+      static constexpr size_t BUFFER_SIZE = 16384; ///< number of spans kept per thread
+
+      static void set_enabled(bool enabled);
+
+      /** @brief true if spans are currently recorded */
+      static bool is_enabled() {
+         return Enabled.load(std::memory_order_relaxed);
+      }
+
+      /** @brief timestamp for spans in nanoseconds, monotonic clock */
+      static u_long64 now() {
+         struct timespec ts;
+
+         clock_gettime(CLOCK_MONOTONIC, &ts);
+         return (u_long64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+      }
+
+      static void record(const char *category, const char *name, const char *detail, u_long64 start, u_long64 end);
+
+      static bool dump(const char *filename, dstring *error, u_long32 *written = nullptr);
+
+      static void clear();
+
+   private:
+      static std::atomic<bool> Enabled;
+   };
+
+   /** @brief A span which is recorded when it is stopped or goes out of scope */
+   class Span {
+      const char *category;
+      const char *name;
+      const char *detail;
+      u_long64 start;
+
+   public:
+      Span(const char *category, const char *name, const char *detail = nullptr) :
+         category(category), name(name), detail(detail), start(SpanTrace::is_enabled() ? SpanTrace::now() : 0) {
+      }
+
+      ~Span() {
+         stop();
+      }
+
+      Span(const Span &) = delete;
+      Span &operator=(const Span &) = delete;
+
+      void stop() {
+         if (start != 0) {
+            SpanTrace::record(category, name, detail, start, SpanTrace::now());
+            start = 0;
+         }
+      }
+   };
+}
+
+#ifdef WITH_SPAN_TRACE
+#  define SPAN_TRACE_START(span, category, name, detail) ocs::Span span(category, name, detail)
+#  define SPAN_TRACE_STOP(span) span.stop()
+#else
+#  define SPAN_TRACE_START(span, category, name, detail)
+#  define SPAN_TRACE_STOP(span)
+#endif
@@ -86,6 +86,7 @@ const char *prognames[] = {
         "qquota",        /* 31 */
         "sge_share_mon", /* 32 */
         "python_client", /* 33 */
+        "drmaa_relay",   /* 34 */
         nullptr,
 };
 
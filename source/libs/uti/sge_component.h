@@ -65,7 +65,8 @@ enum {
    QPING,         // 30
    QQUOTA,        // 31
    SGE_SHARE_MON, // 32
-   PYTHON_CLIENT  // 33
+   PYTHON_CLIENT, // 33
+   DRMAA_RELAY    // 34
 };
 
 enum thread_type_t {
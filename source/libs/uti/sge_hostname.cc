@@ -40,6 +40,8 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#include <string_view>
+#include <unordered_map>
 
 
 #if defined(SGE_MT)
@@ -68,6 +70,16 @@ extern void trace(char *);
 static pthread_mutex_t get_qmaster_port_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t get_execd_port_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// interned hostnames, see sge_host_intern(), entries are never freed
+// the spellings which are remembered per thread and process wide are limited,
+// further spellings are normalized on every lookup
+#define HOST_INTERN_MAX_SPELLINGS 10000
+typedef std::unordered_map<std::string_view, const sge_host_id_t *> sge_host_intern_map_t;
+static pthread_mutex_t host_intern_mutex = PTHREAD_MUTEX_INITIALIZER;
+static sge_host_intern_map_t host_intern_by_raw;
+static sge_host_intern_map_t host_intern_by_name;
+static thread_local sge_host_intern_map_t host_intern_cache;
+
 static struct servent *sge_getservbyname_r(struct servent *se_result, const char *service, char *buffer, size_t size) {
    struct servent *se;
 
@@ -826,6 +838,132 @@ void sge_hostcpy(char *dst, const char *raw) {
    }
 }
 
+static void
+host_intern_normalize(char *name, const char *raw) {
+   sge_hostcpy(name, raw);
+   for (char *c = name; *c != '\0'; c++) {
+      *c = (char) tolower((unsigned char) *c);
+   }
+}
+
+static const sge_host_id_t *
+host_intern(const char *raw, bool create) {
+   if (raw == nullptr) {
+      return nullptr;
+   }
+
+   auto cached = host_intern_cache.find(raw);
+   if (cached != host_intern_cache.end()) {
+      return cached->second;
+   }
+
+   // normalize outside of the lock, this might read the bootstrap file
+   char name[CL_MAXHOSTNAMELEN + 1];
+   host_intern_normalize(name, raw);
+
+   sge_mutex_lock("host_intern_mutex", __func__, __LINE__, &host_intern_mutex);
+   std::string_view raw_key;
+   const sge_host_id_t *host_id = nullptr;
+   auto by_raw = host_intern_by_raw.find(raw);
+   if (by_raw != host_intern_by_raw.end()) {
+      raw_key = by_raw->first;
+      host_id = by_raw->second;
+   } else {
+      auto by_name = host_intern_by_name.find(name);
+      if (by_name != host_intern_by_name.end()) {
+         host_id = by_name->second;
+      } else if (create) {
+         auto *new_id = new sge_host_id_t;
+         new_id->id = (u_long32) host_intern_by_name.size() + 1;
+         new_id->name = strdup(name);
+         host_intern_by_name.emplace(new_id->name, new_id);
+         host_id = new_id;
+      }
+      if (host_id != nullptr && host_intern_by_raw.size() < HOST_INTERN_MAX_SPELLINGS) {
+         raw_key = strdup(raw);
+         host_intern_by_raw.emplace(raw_key, host_id);
+      }
+   }
+   sge_mutex_unlock("host_intern_mutex", __func__, __LINE__, &host_intern_mutex);
+
+   if (!raw_key.empty() && host_intern_cache.size() < HOST_INTERN_MAX_SPELLINGS) {
+      host_intern_cache.emplace(raw_key, host_id);
+   }
+   return host_id;
+}
+
+/****** uti/hostname/sge_host_intern() ****************************************
+*  NAME
+*     sge_host_intern() -- get the interned id of a hostname
+*
+*  SYNOPSIS
+*     const sge_host_id_t *sge_host_intern(const char *raw)
+*
+*  FUNCTION
+*     Returns the process wide unique entry for the hostname. The hostname
+*     is normalized with sge_hostcpy() and converted to lower case only the
+*     first time a spelling is seen. All spellings which sge_hostcmp() treats
+*     as equal return the same entry, so they can be compared by pointer or
+*     by id and the id can be used as hash key.
+*
+*     Spellings seen by a thread are cached thread local, the global table
+*     is only locked for spellings which are new to the calling thread.
+*     The number of cached spellings is limited, spellings above the limit
+*     are normalized again with every call.
+*
+*     Entries are never freed. Only hostnames of objects stored in hashed
+*     host fields are interned, so their number is limited by the hosts
+*     of the cluster. Hostnames which are only searched or compared are
+*     looked up with sge_host_intern_lookup().
+*
+*  INPUTS
+*     const char *raw - hostname
+*
+*  RESULT
+*     const sge_host_id_t * - interned hostname or nullptr if raw is nullptr
+*
+*  SEE ALSO
+*     uti/hostname/sge_host_intern_lookup()
+*     uti/hostname/sge_hostcpy()
+*     uti/hostname/sge_hostcmp()
+*
+*  NOTES:
+*     MT-NOTE: sge_host_intern() is MT safe
+******************************************************************************/
+const sge_host_id_t *
+sge_host_intern(const char *raw) {
+   return host_intern(raw, true);
+}
+
+/****** uti/hostname/sge_host_intern_lookup() *********************************
+*  NAME
+*     sge_host_intern_lookup() -- find the interned id of a hostname
+*
+*  SYNOPSIS
+*     const sge_host_id_t *sge_host_intern_lookup(const char *raw)
+*
+*  FUNCTION
+*     Like sge_host_intern() but a hostname which was not interned before
+*     is not added.
+*
+*  INPUTS
+*     const char *raw - hostname
+*
+*  RESULT
+*     const sge_host_id_t * - interned hostname or nullptr if raw is nullptr
+*                             or was not interned
+*
+*  SEE ALSO
+*     uti/hostname/sge_host_intern()
+*
+*  NOTES:
+*     MT-NOTE: sge_host_intern_lookup() is MT safe
+******************************************************************************/
+const sge_host_id_t *
+sge_host_intern_lookup(const char *raw) {
+   return host_intern(raw, false);
+}
+
 /****** uti/hostname/sge_hostcmp() ********************************************
 *  NAME
 *     sge_hostcmp() -- strcmp() for hostnames
@@ -839,6 +977,10 @@ void sge_hostcpy(char *dst, const char *raw) {
 *        - Domain name may be replaced by a 'default domain'
 *        - Hostnames may be used as they are.
 *
+*     Interned hostnames are compared by their ids, the normalized
+*     names are only compared if the hosts differ. Hostnames which are
+*     not interned are normalized for the comparison.
+*
 *  INPUTS
 *     const char *h1 - 1st hostname
 *     const char *h2 - 2nd hostname
@@ -855,21 +997,34 @@ void sge_hostcpy(char *dst, const char *raw) {
 ******************************************************************************/
 int sge_hostcmp(const char *h1, const char *h2) {
    int cmp = -1;
-   char h1_cpy[CL_MAXHOSTNAMELEN + 1], h2_cpy[CL_MAXHOSTNAMELEN + 1];
-
-
-   DENTER(BASIS_LAYER);
 
    if (h1 != nullptr && h2 != nullptr) {
-      sge_hostcpy(h1_cpy, h1);
-      sge_hostcpy(h2_cpy, h2);
+      const sge_host_id_t *h1_id = sge_host_intern_lookup(h1);
+      const sge_host_id_t *h2_id = sge_host_intern_lookup(h2);
 
-      cmp = SGE_STRCASECMP(h1_cpy, h2_cpy);
+      if (h1_id != nullptr && h2_id != nullptr) {
+         cmp = (h1_id == h2_id) ? 0 : strcmp(h1_id->name, h2_id->name);
+      } else {
+         char h1_buffer[CL_MAXHOSTNAMELEN + 1];
+         char h2_buffer[CL_MAXHOSTNAMELEN + 1];
+         const char *h1_name = h1_buffer;
+         const char *h2_name = h2_buffer;
 
-      DPRINTF("sge_hostcmp(%s, %s) = %d\n", h1_cpy, h2_cpy);
+         if (h1_id != nullptr) {
+            h1_name = h1_id->name;
+         } else {
+            host_intern_normalize(h1_buffer, h1);
+         }
+         if (h2_id != nullptr) {
+            h2_name = h2_id->name;
+         } else {
+            host_intern_normalize(h2_buffer, h2);
+         }
+         cmp = strcmp(h1_name, h2_name);
+      }
    }
 
-   DRETURN(cmp);
+   return cmp;
 }
 
 /****** uti/hostname/sge_hostmatch() ********************************************
@@ -70,6 +70,16 @@ int sge_hostmatch(const char *h1, const char *h2);
 
 void sge_hostcpy(char *dst, const char *raw);
 
+/* interned hostname, see sge_host_intern() */
+typedef struct {
+   u_long32 id;         /* equal for all spellings of the same host */
+   const char *name;    /* normalized like sge_hostcpy() does, lower case */
+} sge_host_id_t;
+
+const sge_host_id_t *sge_host_intern(const char *raw);
+
+const sge_host_id_t *sge_host_intern_lookup(const char *raw);
+
 bool is_hgroup_name(const char *name);
 
 /* resolver library wrappers */
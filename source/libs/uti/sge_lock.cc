@@ -37,6 +37,7 @@
 #include <cstring>
 
 #include "uti/msg_utilib.h"
+#include "uti/ocs_SpanTrace.h"
 #include "uti/sge_lock.h"
 #include "uti/sge_lock_fifo.h"
 #include "uti/sge_rmon_macros.h"
@@ -91,6 +92,19 @@ static double writer_count[NUM_OF_LOCK_TYPES] = {0.0, 0.0};
 *
 *     2. Add a description to 'locktype_names'.
 *
+*     The main data store of qmaster is secured by LOCK_GLOBAL and the lock
+*     domains LOCK_DOMAIN_JOB, LOCK_DOMAIN_HOST and LOCK_DOMAIN_CONFIG.
+*     A thread which changes objects of some domains only acquires a lock set
+*     (see sge_lock_set_acquire()). It holds LOCK_GLOBAL as read lock and the
+*     domains it changes as write lock so that requests changing different
+*     domains can be handled in parallel. Holding LOCK_GLOBAL as write lock
+*     excludes all other lock holders. Holding it as read lock with
+*     SGE_LOCK() only keeps out the write lock holders, it gives no access
+*     to the objects of a domain. Threads reading them also have to use a
+*     lock set read locking these domains. The locks are always acquired in
+*     the order LOCK_GLOBAL, LOCK_DOMAIN_JOB, LOCK_DOMAIN_HOST,
+*     LOCK_DOMAIN_CONFIG.
+*
 *  SEE ALSO
 *     sge_lock/sge_lock.h
 *******************************************************************************/
@@ -100,6 +114,9 @@ static sge_fifo_rw_lock_t Scheduler_Lock;
 static sge_fifo_rw_lock_t Reader_All_Lock;
 static sge_fifo_rw_lock_t Reader_Auth_Lock;
 static sge_fifo_rw_lock_t Master_Conf_Lock;
+static sge_fifo_rw_lock_t Domain_Job_Lock;
+static sge_fifo_rw_lock_t Domain_Host_Lock;
+static sge_fifo_rw_lock_t Domain_Config_Lock;
 
 /* watch out. The order in this array has to be the same as in the sge_fifo_rw_lock_t type */
 static sge_fifo_rw_lock_t *SGE_RW_Locks[NUM_OF_LOCK_TYPES] = {
@@ -108,16 +125,25 @@ static sge_fifo_rw_lock_t *SGE_RW_Locks[NUM_OF_LOCK_TYPES] = {
         &Reader_All_Lock,
         &Reader_Auth_Lock,
         &Master_Conf_Lock,
+        &Domain_Job_Lock,
+        &Domain_Host_Lock,
+        &Domain_Config_Lock,
 };
 
 #else
 static pthread_rwlock_t Global_Lock;
 static pthread_rwlock_t Master_Conf_Lock;
+static pthread_rwlock_t Domain_Job_Lock;
+static pthread_rwlock_t Domain_Host_Lock;
+static pthread_rwlock_t Domain_Config_Lock;
 
 /* watch out. The order in this array has to be the same as in the sge_locktype_t type */
 static pthread_rwlock_t *SGE_RW_Locks[NUM_OF_LOCK_TYPES] = {
    &Global_Lock, 
    &Master_Conf_Lock,
+   &Domain_Job_Lock,
+   &Domain_Host_Lock,
+   &Domain_Config_Lock,
 };
 #endif
 
@@ -129,6 +155,9 @@ static const char *locktype_names[NUM_OF_LOCK_TYPES] = {
         "reader_all",      ///< LOCK_READ_ALL_DS
         "reader_auth",     ///< LOCK_READ_AUTH_DS
         "master_config",   ///< LOCK_MASTER_CONF
+        "domain_job",      ///< LOCK_DOMAIN_JOB
+        "domain_host",     ///< LOCK_DOMAIN_HOST
+        "domain_config",   ///< LOCK_DOMAIN_CONFIG
 };
 
 static pthread_once_t lock_once = PTHREAD_ONCE_INIT;
@@ -140,6 +169,10 @@ static sge_locker_t id_callback_impl();
 
 static sge_locker_t (*id_callback)() = id_callback_impl;
 
+/* lock set held by the calling thread, see sge_lock_set_acquire() */
+static thread_local sge_lock_set_t Held_Lock_Set;
+static thread_local bool Holds_Lock_Set = false;
+
 #ifdef SGE_LOCK_DEBUG
 void sge_try_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_locker_t anID)
 {
@@ -352,6 +385,7 @@ void sge_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_
    DENTER(BASIS_LAYER);
 
    pthread_once(&lock_once, lock_once_init);
+   SPAN_TRACE_START(lock_span, "lock", locktype_names[aType], aMode == LOCK_READ ? "read" : "write");
 
 #ifdef SGE_DEBUG_LOCK_TIME
    gettimeofday(&before, nullptr);
@@ -378,6 +412,8 @@ void sge_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_
       abort();
    }
 
+   SPAN_TRACE_STOP(lock_span);
+
 #ifdef SGE_DEBUG_LOCK_TIME
       gettimeofday(&after, nullptr);
       time = after.tv_usec - before.tv_usec;
@@ -518,6 +554,184 @@ sge_locker_t sge_locker_id() {
    return id;
 } /* sge_locker_id */
 
+/****** sge_lock/sge_lock_set_init() *******************************************
+*  NAME
+*     sge_lock_set_init() -- initialize a lock set
+*
+*  SYNOPSIS
+*     void sge_lock_set_init(sge_lock_set_t *set, bool exclusive)
+*
+*  FUNCTION
+*     Initializes a lock set without any domain. An exclusive lock set
+*     acquires LOCK_GLOBAL as write lock, otherwise LOCK_GLOBAL is held as
+*     read lock and the domains added with sge_lock_set_add() are locked.
+*
+*  INPUTS
+*     sge_lock_set_t *set - lock set
+*     bool exclusive      - exclusive access to the main DS
+*
+*  NOTES
+*     MT-NOTE: sge_lock_set_init() is MT safe
+*******************************************************************************/
+void sge_lock_set_init(sge_lock_set_t *set, bool exclusive) {
+   set->exclusive = exclusive;
+   for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+      set->domain[i] = LOCK_NONE;
+   }
+}
+
+/****** sge_lock/sge_lock_set_add() ********************************************
+*  NAME
+*     sge_lock_set_add() -- add a domain to a lock set
+*
+*  SYNOPSIS
+*     void sge_lock_set_add(sge_lock_set_t *set, sge_locktype_t domain,
+*                           sge_lockmode_t aMode)
+*
+*  FUNCTION
+*     Adds a domain to a lock set. If the domain is already part of the
+*     set it is locked with the stronger of both modes.
+*
+*  INPUTS
+*     sge_lock_set_t *set   - lock set
+*     sge_locktype_t domain - LOCK_DOMAIN_JOB, LOCK_DOMAIN_HOST or LOCK_DOMAIN_CONFIG
+*     sge_lockmode_t aMode  - LOCK_READ or LOCK_WRITE
+*
+*  NOTES
+*     MT-NOTE: sge_lock_set_add() is MT safe
+*******************************************************************************/
+void sge_lock_set_add(sge_lock_set_t *set, sge_locktype_t domain, sge_lockmode_t aMode) {
+   int i = domain - LOCK_FIRST_DOMAIN;
+
+   if (i >= 0 && i < NUM_OF_LOCK_DOMAINS && aMode > set->domain[i]) {
+      set->domain[i] = aMode;
+   }
+}
+
+/****** sge_lock/sge_lock_set_acquire() ****************************************
+*  NAME
+*     sge_lock_set_acquire() -- acquire the locks of a lock set
+*
+*  SYNOPSIS
+*     void sge_lock_set_acquire(const sge_lock_set_t *set, const char *func,
+*                               sge_locker_t anID)
+*
+*  FUNCTION
+*     Acquires LOCK_GLOBAL and the domains of a lock set in the fixed lock
+*     order. For a not exclusive set LOCK_GLOBAL is held as read lock.
+*     This keeps out threads holding LOCK_GLOBAL as write lock while
+*     threads with lock sets of different domains can work in parallel.
+*
+*     The set is remembered for the calling thread, it is released with
+*     sge_lock_set_release(). Instead of using this function directly the
+*     convenience macro 'SGE_LOCK_SET(set)' should be used.
+*
+*  INPUTS
+*     const sge_lock_set_t *set - lock set
+*     const char *func          - calling function
+*     sge_locker_t anID         - locker id
+*
+*  NOTES
+*     MT-NOTE: sge_lock_set_acquire() is MT safe
+*
+*  SEE ALSO
+*     sge_lock/sge_lock_set_release()
+*     sge_lock/sge_lock_set_held()
+*******************************************************************************/
+void sge_lock_set_acquire(const sge_lock_set_t *set, const char *func, sge_locker_t anID) {
+   DENTER(BASIS_LAYER);
+
+   pthread_once(&lock_once, lock_once_init);
+   SPAN_TRACE_START(lock_span, "lock", "lock_set", set->exclusive ? "exclusive" : "domains");
+
+   if (set->exclusive) {
+      sge_lock(LOCK_GLOBAL, LOCK_WRITE, func, anID);
+   } else {
+      sge_lock(LOCK_GLOBAL, LOCK_READ, func, anID);
+      for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+         if (set->domain[i] != LOCK_NONE) {
+            sge_lock((sge_locktype_t) (LOCK_FIRST_DOMAIN + i), set->domain[i], func, anID);
+         }
+      }
+   }
+
+   Held_Lock_Set = *set;
+   Holds_Lock_Set = true;
+
+   DRETURN_VOID;
+}
+
+/****** sge_lock/sge_lock_set_release() ****************************************
+*  NAME
+*     sge_lock_set_release() -- release the lock set of the calling thread
+*
+*  SYNOPSIS
+*     void sge_lock_set_release(const char *func, sge_locker_t anID)
+*
+*  FUNCTION
+*     Releases the locks of the set the calling thread acquired with
+*     sge_lock_set_acquire() in reverse lock order.
+*
+*     Instead of using this function directly the convenience macro
+*     'SGE_UNLOCK_SET()' should be used.
+*
+*  INPUTS
+*     const char *func  - calling function
+*     sge_locker_t anID - locker id
+*
+*  NOTES
+*     MT-NOTE: sge_lock_set_release() is MT safe
+*******************************************************************************/
+void sge_lock_set_release(const char *func, sge_locker_t anID) {
+   DENTER(BASIS_LAYER);
+
+   if (!Holds_Lock_Set) {
+      DPRINTF("%s() does not hold a lock set\n", func);
+      DRETURN_VOID;
+   }
+   Holds_Lock_Set = false;
+
+   if (Held_Lock_Set.exclusive) {
+      sge_unlock(LOCK_GLOBAL, LOCK_WRITE, func, anID);
+   } else {
+      for (int i = NUM_OF_LOCK_DOMAINS - 1; i >= 0; i--) {
+         if (Held_Lock_Set.domain[i] != LOCK_NONE) {
+            sge_unlock((sge_locktype_t) (LOCK_FIRST_DOMAIN + i), Held_Lock_Set.domain[i], func, anID);
+         }
+      }
+      sge_unlock(LOCK_GLOBAL, LOCK_READ, func, anID);
+   }
+
+   DRETURN_VOID;
+}
+
+/****** sge_lock/sge_lock_set_held() *******************************************
+*  NAME
+*     sge_lock_set_held() -- lock set held by the calling thread
+*
+*  SYNOPSIS
+*     bool sge_lock_set_held(sge_lock_set_t *set)
+*
+*  FUNCTION
+*     Returns the lock set the calling thread currently holds, e.g. to
+*     release and re-acquire it while waiting for something.
+*
+*  INPUTS
+*     sge_lock_set_t *set - out: the held lock set
+*
+*  RESULT
+*     bool - false if the thread does not hold a lock set
+*
+*  NOTES
+*     MT-NOTE: sge_lock_set_held() is MT safe
+*******************************************************************************/
+bool sge_lock_set_held(sge_lock_set_t *set) {
+   if (Holds_Lock_Set) {
+      *set = Held_Lock_Set;
+   }
+   return Holds_Lock_Set;
+}
+
 /****** libs/lck/lock_once_init() **************************
 *  NAME
 *     lock_once_init() -- setup lock service 
@@ -552,9 +766,15 @@ static void lock_once_init() {
    sge_fifo_lock_init(&Reader_All_Lock);
    sge_fifo_lock_init(&Reader_Auth_Lock);
    sge_fifo_lock_init(&Master_Conf_Lock);
+   sge_fifo_lock_init(&Domain_Job_Lock);
+   sge_fifo_lock_init(&Domain_Host_Lock);
+   sge_fifo_lock_init(&Domain_Config_Lock);
 #else
    pthread_rwlock_init(&Global_Lock, nullptr);
    pthread_rwlock_init(&Master_Conf_Lock, nullptr);
+   pthread_rwlock_init(&Domain_Job_Lock, nullptr);
+   pthread_rwlock_init(&Domain_Host_Lock, nullptr);
+   pthread_rwlock_init(&Domain_Config_Lock, nullptr);
 #endif
 } /* prog_once_init() */
 
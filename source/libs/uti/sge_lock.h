@@ -51,6 +51,7 @@
 #endif
 
 typedef enum {
+   LOCK_NONE = 0,  /* not locked, used in lock sets */
    LOCK_READ = 1, /* shared  */
    LOCK_WRITE = 2  /* exclusive */
 } sge_lockmode_t;
@@ -64,10 +65,22 @@ typedef enum {
    LOCK_LISTENER,       // lock for read only snapshot containing only auth data (listener-requests)
    LOCK_READER,         // lock for the full read only snapshot providing a full copy (ro-requests)
    LOCK_MASTER_CONF,    // TODO: we should get rid of this.
+   LOCK_DOMAIN_JOB,     // jobs, advance reservations, users and projects of the main DS
+   LOCK_DOMAIN_HOST,    // hosts, host groups and cluster queues of the main DS
+   LOCK_DOMAIN_CONFIG,  // configuration objects of the main DS (complexes, PEs, usersets, managers, ...)
 
    NUM_OF_LOCK_TYPES    // Total number of locks
 } sge_locktype_t;
 
+#define LOCK_FIRST_DOMAIN LOCK_DOMAIN_JOB
+#define NUM_OF_LOCK_DOMAINS (NUM_OF_LOCK_TYPES - LOCK_FIRST_DOMAIN)
+
+// locks a thread needs to work on the main DS, see sge_lock_set_acquire()
+typedef struct {
+   bool exclusive;                               // LOCK_GLOBAL as write lock, domains are not used
+   sge_lockmode_t domain[NUM_OF_LOCK_DOMAINS];   // mode for each domain starting with LOCK_FIRST_DOMAIN
+} sge_lock_set_t;
+
 void
 sge_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_locker_t anID);
 
@@ -80,6 +93,23 @@ sge_unlock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_loc
 sge_locker_t
 sge_locker_id();
 
+void
+sge_lock_set_init(sge_lock_set_t *set, bool exclusive);
+
+void
+sge_lock_set_add(sge_lock_set_t *set, sge_locktype_t domain, sge_lockmode_t aMode);
+
+void
+sge_lock_set_acquire(const sge_lock_set_t *set, const char *func, sge_locker_t anID);
+
+void
+sge_lock_set_release(const char *func, sge_locker_t anID);
+
+bool
+sge_lock_set_held(sge_lock_set_t *set);
+
 #define SGE_TRY_LOCK(type, mode) sge_try_lock(type, mode, __func__, sge_locker_id())
 #define SGE_LOCK(type, mode) sge_lock(type, mode, __func__, sge_locker_id())
 #define SGE_UNLOCK(type, mode) sge_unlock(type, mode, __func__, sge_locker_id())
+#define SGE_LOCK_SET(set) sge_lock_set_acquire(set, __func__, sge_locker_id())
+#define SGE_UNLOCK_SET() sge_lock_set_release(__func__, sge_locker_id())
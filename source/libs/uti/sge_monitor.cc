@@ -33,6 +33,7 @@
 /*___INFO__MARK_END__*/
 
 #include <cstdlib>
+#include <atomic>
 #include <cstring>
 #include <pthread.h>
 #include <dlfcn.h>
@@ -79,6 +80,23 @@ static pthread_mutex_t global_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* a static dstring used as a temporary buffer to build the commlib info string */
 static dstring Info_Line = DSTRING_INIT;
 
+/*
+ * latency histograms, updated lock-free by all threads
+ *
+ * Values below 4us have their own bucket, then each power of 2 is divided into
+ * 4 buckets, so a reported percentile is at most 25% above the exact value.
+ * The data is not reset, scripts can build the differences between two dumps.
+ */
+typedef struct {
+   const char *name;                                  /* name, set once during registration */
+   std::atomic<u_long64> count;                       /* number of measurements */
+   std::atomic<u_long64> max;                         /* longest duration in us */
+   std::atomic<u_long64> bucket[MONITOR_LAT_BUCKETS]; /* number of measurements per bucket */
+} Latency_t;
+
+static Latency_t Latency[MONITOR_LAT_MAX];
+static std::atomic<int> Latency_count{MONITOR_LAT_LOCK_WAIT + 1};
+
 /* mallinfo related data */
 #if defined(LINUX) || defined(SOLARIS)
 static bool mallinfo_initialized = false;
@@ -475,6 +493,7 @@ u_long32 sge_monitor_status(char **info_message, u_long32 monitor_time) {
          }
          sge_mutex_unlock("sge_monitor_status", __func__, __LINE__, &(Output[i].Output_Mutex));
       }
+      sge_monitor_latency_output(&Info_Line);
    } else {
       sge_dstring_append(&Info_Line, MSG_UTI_MONITOR_DISABLED);
       sge_dstring_append(&Info_Line, "\n");
@@ -697,6 +716,12 @@ static void ext_gdi_output(dstring *message, void *monitoring_extension, double
                               sge_u32c(gdi_ext->rqueue_length),
                               sge_u32c(gdi_ext->wrqueue_length)
                               );
+   if (gdi_ext->jsv_count > 0) {
+      sge_dstring_sprintf_append(message, MSG_UTI_MONITOR_GDIEXT_JSV_FFF,
+                                 gdi_ext->jsv_count / time,
+                                 gdi_ext->jsv_time / 1000.0 / gdi_ext->jsv_count,
+                                 gdi_ext->jsv_max / 1000.0);
+   }
 }
 
 /****** uti/monitor/ext_lis_output() *******************************************
@@ -801,3 +826,237 @@ static void ext_tet_output(dstring *message, void *monitoring_extension, double
    );
 }
 
+/****************************************
+ * implementation section for latencies
+ ****************************************/
+
+static int latency_bucket(u_long64 usec) {
+   if (usec < 4) {
+      return (int) usec;
+   }
+
+   int exp = 63 - __builtin_clzll(usec);
+   int bucket = 4 + (exp - 2) * 4 + (int) ((usec >> (exp - 2)) & 3);
+
+   return bucket < MONITOR_LAT_BUCKETS ? bucket : MONITOR_LAT_BUCKETS - 1;
+}
+
+/* biggest value stored in a bucket */
+static u_long64 latency_bucket_limit(int bucket) {
+   if (bucket < 4) {
+      return bucket;
+   }
+
+   int exp = (bucket - 4) / 4 + 2;
+   int sub = (bucket - 4) % 4;
+
+   return (((u_long64) (5 + sub)) << (exp - 2)) - 1;
+}
+
+static u_long64 latency_percentile(const u_long64 *bucket, u_long64 count, u_long64 max, double percentile) {
+   u_long64 limit = (u_long64) (count * percentile);
+   u_long64 sum = 0;
+
+   if (limit < count * percentile || limit == 0) {
+      limit++;
+   }
+   for (int i = 0; i < MONITOR_LAT_BUCKETS; i++) {
+      sum += bucket[i];
+      if (sum >= limit) {
+         // the last bucket also contains all longer durations
+         u_long64 value = i < MONITOR_LAT_BUCKETS - 1 ? latency_bucket_limit(i) : max;
+         return value < max ? value : max;
+      }
+   }
+   return max;
+}
+
+/****** uti/monitor/sge_monitor_latency_register() *****************************
+*  NAME
+*     sge_monitor_latency_register() -- get the id of a latency histogram
+*
+*  SYNOPSIS
+*     int sge_monitor_latency_register(const char *name)
+*
+*  FUNCTION
+*     Returns the id of the histogram with the given name. The histogram
+*     is created if it does not exist yet. Callers should store the id
+*     instead of registering the name for each measurement.
+*
+*  INPUTS
+*     const char *name - name shown in the monitoring output (e.g. "GDI GET job")
+*
+*  RESULT
+*     int - id of the histogram or -1 if all MONITOR_LAT_MAX histograms are in use
+*
+*  NOTES
+*     MT-NOTE: sge_monitor_latency_register() is MT safe
+*******************************************************************************/
+int sge_monitor_latency_register(const char *name) {
+   int id = -1;
+
+   sge_mutex_lock("sge_monitor_status", __func__, __LINE__, &global_mutex);
+
+   int count = Latency_count.load(std::memory_order_acquire);
+   for (int i = MONITOR_LAT_LOCK_WAIT + 1; i < count; i++) {
+      if (strcmp(Latency[i].name, name) == 0) {
+         id = i;
+         break;
+      }
+   }
+   if (id == -1 && count < MONITOR_LAT_MAX) {
+      id = count;
+      Latency[id].name = strdup(name);
+      Latency_count.store(count + 1, std::memory_order_release);
+   }
+
+   sge_mutex_unlock("sge_monitor_status", __func__, __LINE__, &global_mutex);
+
+   return id;
+}
+
+/****** uti/monitor/sge_monitor_latency_add() **********************************
+*  NAME
+*     sge_monitor_latency_add() -- store a duration in a latency histogram
+*
+*  SYNOPSIS
+*     void sge_monitor_latency_add(int id, u_long64 usec)
+*
+*  FUNCTION
+*     Counts the duration in the histogram 'id'. No locks are used, so it
+*     can be called for each request. Usually it is called via the
+*     MONITOR_LATENCY macro which only measures when monitoring is enabled.
+*
+*  INPUTS
+*     int id        - id returned by sge_monitor_latency_register()
+*                     or MONITOR_LAT_LOCK_WAIT
+*     u_long64 usec - duration in microseconds
+*
+*  NOTES
+*     MT-NOTE: sge_monitor_latency_add() is MT safe
+*******************************************************************************/
+void sge_monitor_latency_add(int id, u_long64 usec) {
+   if (id < 0 || id >= MONITOR_LAT_MAX) {
+      return;
+   }
+
+   Latency_t *latency = &Latency[id];
+   latency->bucket[latency_bucket(usec)].fetch_add(1, std::memory_order_relaxed);
+   latency->count.fetch_add(1, std::memory_order_relaxed);
+
+   u_long64 max = latency->max.load(std::memory_order_relaxed);
+   while (usec > max && !latency->max.compare_exchange_weak(max, usec, std::memory_order_relaxed)) {
+      ;
+   }
+}
+
+/****** uti/monitor/sge_monitor_latency_since() ********************************
+*  NAME
+*     sge_monitor_latency_since() -- duration since a start time
+*
+*  SYNOPSIS
+*     u_long64 sge_monitor_latency_since(u_long64 start)
+*
+*  FUNCTION
+*     Returns the microseconds passed since 'start' which has been taken
+*     from sge_get_monotonic_time64(). A start time in the future (e.g.
+*     taken from another clock) results in 0 instead of a wrapped
+*     around unsigned value.
+*
+*  INPUTS
+*     u_long64 start - start time in microseconds
+*
+*  RESULT
+*     u_long64 - duration in microseconds
+*
+*  NOTES
+*     MT-NOTE: sge_monitor_latency_since() is MT safe
+*******************************************************************************/
+u_long64 sge_monitor_latency_since(u_long64 start) {
+   u_long64 now = sge_get_monotonic_time64();
+
+   return now > start ? now - start : 0;
+}
+
+/****** uti/monitor/sge_monitor_latency_get() **********************************
+*  NAME
+*     sge_monitor_latency_get() -- returns the percentiles of a histogram
+*
+*  SYNOPSIS
+*     bool sge_monitor_latency_get(int id, u_long64 *count, u_long64 *p50,
+*                                  u_long64 *p99, u_long64 *max)
+*
+*  FUNCTION
+*     Returns the number of measurements, the median, the 99th percentile
+*     and the maximum of the histogram 'id' in microseconds.
+*     A percentile is the upper limit of the bucket containing it.
+*
+*  INPUTS
+*     int id         - histogram id
+*     u_long64 *count - number of measurements
+*     u_long64 *p50   - median
+*     u_long64 *p99   - 99th percentile
+*     u_long64 *max   - maximum
+*
+*  RESULT
+*     bool - false if the id is invalid
+*
+*  NOTES
+*     MT-NOTE: sge_monitor_latency_get() is MT safe
+*******************************************************************************/
+bool sge_monitor_latency_get(int id, u_long64 *count, u_long64 *p50, u_long64 *p99, u_long64 *max) {
+   u_long64 bucket[MONITOR_LAT_BUCKETS];
+   u_long64 sum = 0;
+
+   if (id < 0 || id >= Latency_count.load(std::memory_order_acquire)) {
+      return false;
+   }
+
+   /* the count is built from the snapshot of the buckets which are updated concurrently */
+   for (int i = 0; i < MONITOR_LAT_BUCKETS; i++) {
+      bucket[i] = Latency[id].bucket[i].load(std::memory_order_relaxed);
+      sum += bucket[i];
+   }
+   *count = sum;
+   *max = Latency[id].max.load(std::memory_order_relaxed);
+   *p50 = latency_percentile(bucket, sum, *max, 0.50);
+   *p99 = latency_percentile(bucket, sum, *max, 0.99);
+
+   return true;
+}
+
+/****** uti/monitor/sge_monitor_latency_output() *******************************
+*  NAME
+*     sge_monitor_latency_output() -- appends the latency histograms to a string
+*
+*  SYNOPSIS
+*     void sge_monitor_latency_output(dstring *message)
+*
+*  FUNCTION
+*     Appends one line per histogram containing measurements:
+*
+*        latency <name>: count=<n> p50=<ms>ms p99=<ms>ms max=<ms>ms
+*
+*     The lines are part of the qping -f/-info output and are printed
+*     by qping -latency.
+*
+*  INPUTS
+*     dstring *message - target string
+*
+*  NOTES
+*     MT-NOTE: sge_monitor_latency_output() is MT safe
+*******************************************************************************/
+void sge_monitor_latency_output(dstring *message) {
+   int count = Latency_count.load(std::memory_order_acquire);
+
+   for (int i = 0; i < count; i++) {
+      u_long64 n, p50, p99, max;
+
+      if (sge_monitor_latency_get(i, &n, &p50, &p99, &max) && n > 0) {
+         sge_dstring_sprintf_append(message, MSG_UTI_MONITOR_LATENCY_SUFFF,
+                                    i == MONITOR_LAT_LOCK_WAIT ? "lock wait" : Latency[i].name, n,
+                                    p50 / 1000.0, p99 / 1000.0, max / 1000.0);
+         sge_dstring_append(message, "\n");
+      }
+   }
+}
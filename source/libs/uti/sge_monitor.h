@@ -37,6 +37,7 @@
 
 #include "basis_types.h"
 #include "uti/sge_dstring.h"
+#include "uti/sge_time.h"
 
 /**
  * Monitoring functionality:
@@ -92,6 +93,19 @@
  * - MONITOR_GDI  : counts GDI requests
  * - MONITOR_ACK  : counts ACKs
  * - MONITOR_LOAD : counts reports
+ *
+ * Latency histograms:
+ * -------------------
+ *
+ * Averages hide the tail latency. Therefore durations of requests can be
+ * stored in process wide histograms which are shown with the monitoring
+ * output as p50/p99/max (see sge_monitor_latency_output()).
+ *
+ * - sge_monitor_latency_register : returns the id of a named histogram
+ * - MONITOR_LATENCY              : adds the time since a start time to a histogram
+ * - MONITOR_JSV                  : adds a server JSV round trip time (worker line and histogram)
+ *
+ * MONITOR_WAIT_TIME stores the lock wait times in the MONITOR_LAT_LOCK_WAIT histogram.
  */
 
 
@@ -183,6 +197,23 @@ void sge_monitor_output(monitoring_t *monitor);
 
 void sge_monitor_reset(monitoring_t *monitor);
 
+/**
+ * latency histograms
+ */
+#define MONITOR_LAT_MAX 256      /* max number of latency histograms */
+#define MONITOR_LAT_BUCKETS 128  /* 4 buckets per power of 2 microseconds */
+#define MONITOR_LAT_LOCK_WAIT 0  /* predefined histogram for lock wait times */
+
+int sge_monitor_latency_register(const char *name);
+
+void sge_monitor_latency_add(int id, u_long64 usec);
+
+u_long64 sge_monitor_latency_since(u_long64 start);
+
+bool sge_monitor_latency_get(int id, u_long64 *count, u_long64 *p50, u_long64 *p99, u_long64 *max);
+
+void sge_monitor_latency_output(dstring *message);
+
 
 /****************
  * MACRO section
@@ -231,11 +262,16 @@ void sge_monitor_reset(monitoring_t *monitor);
                                     time = after.tv_usec - before.tv_usec; \
                                     time = after.tv_sec - before.tv_sec + (time/1000000); \
                                     (monitor)->wait += time; \
+                                    sge_monitor_latency_add(MONITOR_LAT_LOCK_WAIT, time > 0 ? (u_long64) (time * 1000000) : 0); \
                                  } \
                                  else { \
                                     execute; \
                                  } \
 
+/* start has to be taken from sge_get_monotonic_time64() */
+#define MONITOR_LATENCY(monitor, id, start) if (((monitor) != nullptr) && ((monitor)->monitor_time > 0)) \
+                                    sge_monitor_latency_add((id), sge_monitor_latency_since(start))
+
 #define MONITOR_MESSAGES(monitor) if ((monitor != nullptr) && ((monitor)->monitor_time > 0)) (monitor)->message_in_count++
 
 #define MONITOR_MESSAGES_OUT(monitor) if (((monitor) != nullptr) && ((monitor)->monitor_time > 0)) (monitor)->message_out_count++
@@ -291,6 +327,10 @@ typedef struct {
    u_long32 queue_length;       //< main queue length (e.g. worker queue)
    u_long32 rqueue_length;      //< reader queue length (e.g. reader queue)
    u_long32 wrqueue_length;     //< waiting reader queue length (e.g. waiting reader queue)
+
+   u_long32 jsv_count;          //< number of server JSV verifications
+   u_long64 jsv_time;           //< sum of the JSV round trip times in microseconds
+   u_long64 jsv_max;            //< longest JSV round trip time in microseconds
 } m_gdi_t;
 
 #define MONITOR_GDI_ADD(monitor)    if ((monitor->monitor_time > 0) && (monitor->ext_type == GDI_EXT)) ((m_gdi_t*)(monitor->ext_data))->gdi_add_count++
@@ -314,6 +354,15 @@ typedef struct {
 #define MONITOR_SET_RQLEN(monitor, qlen)    if ((monitor) != nullptr && (monitor->monitor_time > 0) && (monitor->ext_type == GDI_EXT)) ((m_gdi_t*)(monitor->ext_data))->rqueue_length = (qlen)
 #define MONITOR_SET_WRQLEN(monitor, qlen)    if ((monitor) != nullptr && (monitor->monitor_time > 0) && (monitor->ext_type == GDI_EXT)) ((m_gdi_t*)(monitor->ext_data))->wrqueue_length = (qlen)
 
+#define MONITOR_JSV(monitor, usec) if ((monitor) != nullptr && (monitor->monitor_time > 0) && (monitor->ext_type == GDI_EXT)) { \
+                                      m_gdi_t *gdi_ext = (m_gdi_t *)(monitor->ext_data); \
+                                      gdi_ext->jsv_count++; \
+                                      gdi_ext->jsv_time += (usec); \
+                                      gdi_ext->jsv_max = MAX(gdi_ext->jsv_max, (usec)); \
+                                      static const int jsv_latency_id = sge_monitor_latency_register("JSV round trip"); \
+                                      sge_monitor_latency_add(jsv_latency_id, (usec)); \
+                                   }
+
 /* listener extension */
 typedef struct {
    u_long32 inc_gdi; /* incoming GDI requests */
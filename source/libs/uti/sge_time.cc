@@ -49,6 +49,14 @@ u_long64 sge_get_gmt64() {
    return us.count();
 }
 
+/* microseconds of a monotonic clock, only usable for measuring durations */
+u_long64 sge_get_monotonic_time64() {
+   const auto now = std::chrono::steady_clock::now();
+   const auto epoch = now.time_since_epoch();
+   const auto us = duration_cast<std::chrono::microseconds>(epoch);
+   return us.count();
+}
+
 u_long32 sge_gmt64_to_gmt32(u_long64 timestamp) {
    u_long64 ret = timestamp / 1000000;
    if (ret > U_LONG32_MAX) {
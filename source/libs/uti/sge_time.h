@@ -40,6 +40,7 @@
 #include "uti/sge_dstring.h"
 
 u_long64 sge_get_gmt64();
+u_long64 sge_get_monotonic_time64();
 
 constexpr u_long64 sge_gmt32_to_gmt64(u_long32 timestamp) {
    u_long64 ret = timestamp;
@@ -886,10 +886,11 @@ static void usage(int ret)
   }   
 
   fprintf(out, "%s %s\n", ocs::Version::get_short_product_name().c_str(), ocs::Version::get_version_string().c_str());
-  fprintf(out, "%s qping [-help] [-noalias] [-ssl|-tcp] [ [ [-i <interval>] [-info] [-f] ] | [ [-dump_tag tag [param] ] [-dump] [-nonewline] ] ] <host> <port> <name> <id>\n",MSG_UTILBIN_USAGE);
+  fprintf(out, "%s qping [-help] [-noalias] [-ssl|-tcp] [ [ [-i <interval>] [-info] [-f] [-latency] ] | [ [-dump_tag tag [param] ] [-dump] [-nonewline] ] ] <host> <port> <name> <id>\n",MSG_UTILBIN_USAGE);
   fprintf(out, "   -i         : set ping interval time\n");
   fprintf(out, "   -info      : show full status information and exit\n");
   fprintf(out, "   -f         : show full status information on each ping interval\n");
+  fprintf(out, "   -latency   : show only the latency histograms of the monitoring output and exit\n");
   fprintf(out, "   -noalias   : ignore $SGE_ROOT/SGE_CELL/common/host_aliases file\n");
   fprintf(out, "   -ssl       : use SSL framework\n");
   fprintf(out, "   -tcp       : use TCP framework\n");
@@ -977,6 +978,7 @@ int main(int argc, char *argv[]) {
    struct sigaction sa;
    int   option_f          = 0;
    int   option_info       = 0;
+   int   option_latency    = 0;
    int   option_noalias    = 0;
    int   option_ssl        = 0;
    int   option_tcp        = 0;
@@ -1022,6 +1024,11 @@ int main(int argc, char *argv[]) {
              parameter_count++;
              parameter_start++;
          }
+         if (strcmp( argv[i] , "-latency") == 0) {
+             option_latency = 1;
+             parameter_count++;
+             parameter_start++;
+         }
          if (strcmp( argv[i] , "-f") == 0) {
              option_f = 1;
              parameter_count++;
@@ -1298,6 +1305,25 @@ int main(int argc, char *argv[]) {
                char buffer[512];
                dstring ds;
                sge_dstring_init(&ds, buffer, sizeof(buffer));
+
+               if (option_latency != 0) {
+                  /* print the "latency <name>: ..." lines of the monitoring output */
+                  const char *line = status->info;
+                  while (line != nullptr && *line != '\0') {
+                     const char *end = strchr(line, '\n');
+                     size_t len = end != nullptr ? (size_t) (end - line) : strlen(line);
+                     while (len > 0 && (*line == ' ' || *line == '\t')) {
+                        line++;
+                        len--;
+                     }
+                     if (strncmp(line, "latency ", 8) == 0) {
+                        printf("%.*s\n", (int) len, line);
+                     }
+                     line = end != nullptr ? end + 1 : nullptr;
+                  }
+                  cl_com_free_sirm_message(&status);
+                  break;
+               }
    
                printf("%s", sge_ctime64(0, &ds));
    
@@ -0,0 +1,360 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "uti/sge_lock.h"
+#include "uti/sge_rmon_macros.h"
+
+#define STRESS_THREADS 8
+#define STRESS_LOOPS 10000
+
+// what the threads currently do with the objects of a domain
+struct domain_state_t {
+   std::atomic<int> readers{0};
+   std::atomic<int> writers{0};
+   long value{0};
+};
+
+static domain_state_t Domains[NUM_OF_LOCK_DOMAINS];
+static std::atomic<int> Set_Holders{0};
+static std::atomic<int> Exclusive_Holders{0};
+static std::atomic<int> Violations{0};
+static std::atomic<int> Parallel_Writers{0};
+
+static void
+violation(const char *what) {
+   printf("violation: %s\n", what);
+   Violations++;
+}
+
+static void
+enter_domain(int domain, sge_lockmode_t mode) {
+   domain_state_t &state = Domains[domain];
+
+   if (mode == LOCK_WRITE) {
+      if (state.writers++ != 0 || state.readers != 0) {
+         violation("domain written while it is used by another thread");
+      }
+      for (int i = NUM_OF_LOCK_DOMAINS - 1; i >= 0; i--) {
+         if (i != domain && Domains[i].writers > 0) {
+            Parallel_Writers++;
+            break;
+         }
+      }
+      // not atomic on purpose, lost updates show a missing lock
+      long value = state.value;
+      usleep(0);
+      state.value = value + 1;
+   } else if (mode == LOCK_READ) {
+      state.readers++;
+      if (state.writers != 0) {
+         violation("domain read while it is written");
+      }
+   }
+}
+
+static void
+leave_domain(int domain, sge_lockmode_t mode) {
+   if (mode == LOCK_WRITE) {
+      Domains[domain].writers--;
+   } else if (mode == LOCK_READ) {
+      Domains[domain].readers--;
+   }
+}
+
+// like a worker thread: handles requests working on some domains
+static void
+work_with_lock_set(const sge_lock_set_t *set) {
+   SGE_LOCK_SET(set);
+   Set_Holders++;
+   if (Exclusive_Holders != 0) {
+      violation("lock set acquired while the main DS is locked exclusively");
+   }
+   for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+      enter_domain(i, set->domain[i]);
+   }
+   for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+      leave_domain(i, set->domain[i]);
+   }
+   Set_Holders--;
+   SGE_UNLOCK_SET();
+}
+
+// like the reporting thread reading lists of all domains
+static void
+work_reading_all_domains() {
+   sge_lock_set_t set;
+
+   sge_lock_set_init(&set, false);
+   for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+      sge_lock_set_add(&set, (sge_locktype_t) (LOCK_FIRST_DOMAIN + i), LOCK_READ);
+   }
+   work_with_lock_set(&set);
+}
+
+// like the event master, a plain read lock of the main DS only keeps out exclusive lock holders
+static void
+work_with_global_read_lock() {
+   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   if (Exclusive_Holders != 0) {
+      violation("main DS read locked while it is locked exclusively");
+   }
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+}
+
+// like a report request changing everything
+static void
+work_exclusively() {
+   sge_lock_set_t set;
+
+   sge_lock_set_init(&set, true);
+   SGE_LOCK_SET(&set);
+   if (Exclusive_Holders++ != 0 || Set_Holders != 0) {
+      violation("main DS locked exclusively while it is used by another thread");
+   }
+   for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+      enter_domain(i, LOCK_WRITE);
+      leave_domain(i, LOCK_WRITE);
+   }
+   Exclusive_Holders--;
+   SGE_UNLOCK_SET();
+}
+
+static void
+stress_thread(unsigned int seed, long *writes) {
+   for (int loop = 0; loop < STRESS_LOOPS; loop++) {
+      int op = rand_r(&seed) % 20;
+
+      if (op == 0) {
+         work_exclusively();
+         for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+            writes[i]++;
+         }
+      } else if (op == 1) {
+         work_reading_all_domains();
+      } else if (op == 2) {
+         work_with_global_read_lock();
+      } else {
+         sge_lock_set_t set;
+
+         sge_lock_set_init(&set, false);
+         for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+            auto mode = (sge_lockmode_t) (rand_r(&seed) % 3);
+
+            sge_lock_set_add(&set, (sge_locktype_t) (LOCK_FIRST_DOMAIN + i), mode);
+            if (mode == LOCK_WRITE) {
+               writes[i]++;
+            }
+         }
+         work_with_lock_set(&set);
+      }
+   }
+}
+
+/*
+ * Threads changing different domains must work in parallel,
+ * a thread reading all domains must wait for a thread changing one,
+ * a plain read lock of the main DS does not wait for domain writers.
+ */
+static int
+test_parallel() {
+   std::atomic<bool> job_locked{false};
+   std::atomic<bool> other_done{false};
+   sge_lock_set_t job_set;
+   sge_lock_set_t host_set;
+   int failed = 0;
+
+   sge_lock_set_init(&job_set, false);
+   sge_lock_set_add(&job_set, LOCK_DOMAIN_JOB, LOCK_WRITE);
+   sge_lock_set_add(&job_set, LOCK_DOMAIN_CONFIG, LOCK_READ);
+   sge_lock_set_init(&host_set, false);
+   sge_lock_set_add(&host_set, LOCK_DOMAIN_HOST, LOCK_WRITE);
+   sge_lock_set_add(&host_set, LOCK_DOMAIN_CONFIG, LOCK_READ);
+
+   // another domain can be changed while the job domain is locked
+   std::thread holder([&]() {
+      SGE_LOCK_SET(&job_set);
+      job_locked = true;
+      for (int i = 0; i < 500 && !other_done; i++) {
+         usleep(10000);
+      }
+      SGE_UNLOCK_SET();
+   });
+   while (!job_locked) {
+      usleep(1000);
+   }
+   std::thread other([&]() {
+      SGE_LOCK_SET(&host_set);
+      other_done = true;
+      SGE_UNLOCK_SET();
+   });
+   other.join();
+   holder.join();
+   if (!other_done) {
+      printf("host domain could not be locked while the job domain was locked\n");
+      failed++;
+   }
+
+   // reading all domains waits for the writer of the job domain
+   job_locked = false;
+   other_done = false;
+   std::thread writer([&]() {
+      SGE_LOCK_SET(&job_set);
+      job_locked = true;
+      usleep(200000);
+      if (other_done) {
+         printf("all domains read locked while the job domain was locked for writing\n");
+         Violations++;
+      }
+      SGE_UNLOCK_SET();
+   });
+   while (!job_locked) {
+      usleep(1000);
+   }
+   sge_lock_set_t read_set;
+   sge_lock_set_init(&read_set, false);
+   sge_lock_set_add(&read_set, LOCK_DOMAIN_JOB, LOCK_READ);
+   sge_lock_set_add(&read_set, LOCK_DOMAIN_HOST, LOCK_READ);
+   sge_lock_set_add(&read_set, LOCK_DOMAIN_CONFIG, LOCK_READ);
+   SGE_LOCK_SET(&read_set);
+   other_done = true;
+   SGE_UNLOCK_SET();
+   writer.join();
+
+   // a plain read lock of the main DS does not lock any domain
+   std::atomic<bool> read_while_locked{false};
+   job_locked = false;
+   other_done = false;
+   std::thread domain_writer([&]() {
+      SGE_LOCK_SET(&job_set);
+      job_locked = true;
+      for (int i = 0; i < 500 && !other_done; i++) {
+         usleep(10000);
+      }
+      read_while_locked = other_done.load();
+      SGE_UNLOCK_SET();
+   });
+   while (!job_locked) {
+      usleep(1000);
+   }
+   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   other_done = true;
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+   domain_writer.join();
+   if (!read_while_locked) {
+      printf("global read lock waited for the writer of the job domain\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+static int
+test_held() {
+   sge_lock_set_t set;
+   sge_lock_set_t held;
+   int failed = 0;
+
+   if (sge_lock_set_held(&held)) {
+      printf("lock set held before it was acquired\n");
+      failed++;
+   }
+
+   sge_lock_set_init(&set, false);
+   sge_lock_set_add(&set, LOCK_DOMAIN_HOST, LOCK_READ);
+   sge_lock_set_add(&set, LOCK_DOMAIN_HOST, LOCK_WRITE);
+   sge_lock_set_add(&set, LOCK_DOMAIN_HOST, LOCK_READ);
+   SGE_LOCK_SET(&set);
+   if (!sge_lock_set_held(&held) || held.exclusive ||
+       held.domain[LOCK_DOMAIN_HOST - LOCK_FIRST_DOMAIN] != LOCK_WRITE ||
+       held.domain[LOCK_DOMAIN_JOB - LOCK_FIRST_DOMAIN] != LOCK_NONE) {
+      printf("wrong lock set held\n");
+      failed++;
+   }
+
+   // release and re-acquire exclusively like a JSV does
+   SGE_UNLOCK_SET();
+   sge_lock_set_init(&set, true);
+   SGE_LOCK_SET(&set);
+   if (!sge_lock_set_held(&held) || !held.exclusive) {
+      printf("exclusive lock set not held\n");
+      failed++;
+   }
+   SGE_UNLOCK_SET();
+
+   if (sge_lock_set_held(&held)) {
+      printf("lock set held after it was released\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+static int
+test_stress() {
+   std::vector<std::thread> threads;
+   long writes[STRESS_THREADS][NUM_OF_LOCK_DOMAINS] = {};
+   int failed = 0;
+
+   for (int t = 0; t < STRESS_THREADS; t++) {
+      threads.emplace_back(stress_thread, 4711 + t, writes[t]);
+   }
+   for (auto &thread : threads) {
+      thread.join();
+   }
+
+   for (int i = 0; i < NUM_OF_LOCK_DOMAINS; i++) {
+      long expected = 0;
+
+      for (int t = 0; t < STRESS_THREADS; t++) {
+         expected += writes[t][i];
+      }
+      if (Domains[i].value != expected) {
+         printf("domain %d: %ld changes, expected %ld\n", i, Domains[i].value, expected);
+         failed++;
+      }
+   }
+
+   printf("%d threads did %d requests, %d times different domains were changed in parallel\n",
+          STRESS_THREADS, STRESS_THREADS * STRESS_LOOPS, Parallel_Writers.load());
+
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_qmaster_lock_domains");
+
+   failed += test_held();
+   failed += test_parallel();
+   failed += test_stress();
+   failed += Violations;
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
@@ -0,0 +1,418 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+/*
+ * Replays a recorded cluster state through scheduler_method() without a
+ * running qmaster.
+ *
+ *    test_qmaster_sched_replay -dump <dir>
+ *       fetches the objects the scheduler works on from a running cluster
+ *       (GDI GET requests, answered from the reader data store) and writes
+ *       them packed to one file per object type into <dir>
+ *
+ *    test_qmaster_sched_replay [-runs <n>] [-orders] <dir>
+ *       loads the snapshot from <dir> into the scheduler data store and
+ *       does <n> scheduling runs on it. The orders are collected instead of
+ *       being sent, so every run starts from the same state. Prints the
+ *       timings of the scheduling phases per run and optionally the orders
+ *       of the last run.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+
+#include "uti/sge.h"
+#include "uti/sge_io.h"
+#include "uti/sge_profiling.h"
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_unistd.h"
+
+#include "cull/cull_pack.h"
+
+#include "gdi/ocs_gdi_client.h"
+#include "gdi/sge_gdi.h"
+
+#include "sgeobj/ocs_DataStore.h"
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_conf.h"
+#include "sgeobj/sge_schedd_conf.h"
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#include "sge_sched_job_category.h"
+#include "sge_sched_order.h"
+#include "sge_sched_prepare_data.h"
+#include "sge_sched_thread.h"
+
+typedef struct {
+   sge_object_type type;    /* master list in the scheduler data store */
+   u_long32 target;         /* GDI list used to fetch the objects */
+   const lDescr *descr;
+   const char *file;        /* file name within the snapshot directory */
+} snapshot_list_t;
+
+static const snapshot_list_t snapshot_lists[] = {
+   {SGE_TYPE_EXECHOST,    SGE_EH_LIST,   EH_Type,   "exechosts"},
+   {SGE_TYPE_CQUEUE,      SGE_CQ_LIST,   CQ_Type,   "cqueues"},
+   {SGE_TYPE_JOB,         SGE_JB_LIST,   JB_Type,   "jobs"},
+   {SGE_TYPE_CENTRY,      SGE_CE_LIST,   CE_Type,   "centries"},
+   {SGE_TYPE_PE,          SGE_PE_LIST,   PE_Type,   "pes"},
+   {SGE_TYPE_CKPT,        SGE_CK_LIST,   CK_Type,   "ckpts"},
+   {SGE_TYPE_USERSET,     SGE_US_LIST,   US_Type,   "usersets"},
+   {SGE_TYPE_USER,        SGE_UU_LIST,   UU_Type,   "users"},
+   {SGE_TYPE_PROJECT,     SGE_PR_LIST,   PR_Type,   "projects"},
+   {SGE_TYPE_HGROUP,      SGE_HGRP_LIST, HGRP_Type, "hostgroups"},
+   {SGE_TYPE_RQS,         SGE_RQS_LIST,  RQS_Type,  "rqs"},
+   {SGE_TYPE_AR,          SGE_AR_LIST,   AR_Type,   "ars"},
+   {SGE_TYPE_SHARETREE,   SGE_STN_LIST,  STN_Type,  "sharetree"},
+   {SGE_TYPE_SCHEDD_CONF, SGE_SC_LIST,   SC_Type,   "sched_configuration"},
+   {SGE_TYPE_CONFIG,      SGE_CONF_LIST, CONF_Type, "configuration"}
+};
+
+/* profiling levels of the scheduling phases, see scheduler_method() */
+typedef struct {
+   prof_level level;
+   const char *name;
+} phase_t;
+
+static const phase_t phases[] = {
+   {SGE_PROF_CUSTOM7, "copy"},
+   {SGE_PROF_CUSTOM8, "split"},
+   {SGE_PROF_CUSTOM1, "tickets"},
+   {SGE_PROF_CUSTOM3, "sort"},
+   {SGE_PROF_CUSTOM4, "dispatch"},
+   {SGE_PROF_CUSTOM9, "orders"},
+   {SGE_PROF_CUSTOM0, "total"}
+};
+
+static void
+usage() {
+   fprintf(stderr, "usage: test_qmaster_sched_replay -dump <dir>\n");
+   fprintf(stderr, "       test_qmaster_sched_replay [-runs <n>] [-orders] <dir>\n");
+}
+
+static bool
+write_list(const char *dir, const snapshot_list_t *sl, const lList *lp) {
+   sge_pack_buffer pb;
+   char filename[SGE_PATH_MAX];
+   bool ret = false;
+   int fd;
+
+   if (init_packbuffer(&pb, 8192, 0) != PACK_SUCCESS) {
+      return false;
+   }
+
+   snprintf(filename, sizeof(filename), "%s/%s", dir, sl->file);
+   if (cull_pack_list(&pb, lp) != PACK_SUCCESS) {
+      fprintf(stderr, "packing %s failed\n", sl->file);
+   } else if ((fd = SGE_OPEN3(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+      fprintf(stderr, "cannot open %s: %s\n", filename, strerror(errno));
+   } else {
+      ret = sge_writenbytes(fd, pb.head_ptr, pb_used(&pb)) == pb_used(&pb);
+      if (!ret) {
+         fprintf(stderr, "cannot write %s\n", filename);
+      }
+      close(fd);
+   }
+
+   clear_packbuffer(&pb);
+   return ret;
+}
+
+static bool
+read_list(const char *dir, const snapshot_list_t *sl, lList **lpp) {
+   sge_pack_buffer pb;
+   char filename[SGE_PATH_MAX];
+   char *buf;
+   int len = 0;
+   bool ret = false;
+
+   snprintf(filename, sizeof(filename), "%s/%s", dir, sl->file);
+   if ((buf = sge_file2string(filename, &len)) == nullptr) {
+      fprintf(stderr, "cannot read %s\n", filename);
+      return false;
+   }
+
+   // the packbuffer takes over buf
+   if (init_packbuffer_from_buffer(&pb, buf, len) == PACK_SUCCESS) {
+      ret = cull_unpack_list(&pb, lpp) == PACK_SUCCESS;
+   }
+   if (!ret) {
+      fprintf(stderr, "cannot unpack %s\n", filename);
+   }
+   clear_packbuffer(&pb);
+   return ret;
+}
+
+static int
+dump_snapshot(const char *dir) {
+   lList *alp = nullptr;
+   int ret = 0;
+
+   DENTER(TOP_LAYER);
+
+   if (gdi_client_setup_and_enroll(QEVENT, MAIN_THREAD, &alp) != AE_OK) {
+      answer_list_output(&alp);
+      DRETURN(1);
+   }
+
+   if (sge_mkdir(dir, 0755, false, false) != 0) {
+      fprintf(stderr, "cannot create %s\n", dir);
+      gdi_client_shutdown();
+      DRETURN(1);
+   }
+
+   for (const snapshot_list_t &sl : snapshot_lists) {
+      lList *lp = nullptr;
+      lEnumeration *what = lWhat("%T(ALL)", sl.descr);
+
+      alp = sge_gdi(sl.target, SGE_GDI_GET, &lp, nullptr, what);
+      lFreeWhat(&what);
+
+      if (answer_list_output(&alp) || !write_list(dir, &sl, lp)) {
+         ret = 1;
+      } else {
+         printf("%-20s %6d\n", sl.file, lGetNumberOfElem(lp));
+      }
+      lFreeList(&lp);
+   }
+
+   gdi_client_shutdown();
+   DRETURN(ret);
+}
+
+/*
+ * The scheduler mirror does not hold the full objects but the reduced ones
+ * it subscribed in subscribe_scheduler(). As the where/what conditions of
+ * the scheduler are bound to the reduced descriptors, the lists fetched
+ * via GDI have to be reduced the same way, including the sublists the
+ * event master reduces for the scheduler (see elem_select()).
+ */
+static lList *
+reduce_list(lList *lp, const lCondition *where, const lEnumeration *what,
+            int sub_nm, const lCondition *sub_where, const lEnumeration *sub_what) {
+   lList *reduced = lSelect(lGetListName(lp), lp, where, what);
+
+   if (sub_nm != NoName && reduced != nullptr && lGetPosInDescr(lGetListDescr(reduced), sub_nm) != -1) {
+      lListElem *ep;
+
+      for_each_rw(ep, reduced) {
+         const lList *sub_list = lGetList(ep, sub_nm);
+
+         if (sub_list != nullptr) {
+            lSetList(ep, sub_nm, lSelect(lGetListName(sub_list), sub_list, sub_where, sub_what));
+         }
+      }
+   }
+
+   lFreeList(&lp);
+   return reduced;
+}
+
+static lList *
+reduce_to_subscription(sge_object_type type, lList *lp, const sge_where_what_t *where_what) {
+   switch (type) {
+      case SGE_TYPE_CQUEUE:
+         return reduce_list(lp, where_what->where_cqueue, where_what->what_cqueue,
+                            CQ_qinstances, where_what->where_all_queue, where_what->what_queue);
+      case SGE_TYPE_EXECHOST:
+         return reduce_list(lp, where_what->where_host, where_what->what_host, NoName, nullptr, nullptr);
+      case SGE_TYPE_JOB:
+         return reduce_list(lp, where_what->where_job, where_what->what_job,
+                            JB_ja_tasks, where_what->where_jat, where_what->what_jat);
+      case SGE_TYPE_PE:
+         return reduce_list(lp, nullptr, where_what->what_pe, NoName, nullptr, nullptr);
+      default:
+         return lp;
+   }
+}
+
+static bool
+load_snapshot(const char *dir, const sge_where_what_t *where_what) {
+   lList *alp = nullptr;
+   bool ret = true;
+
+   DENTER(TOP_LAYER);
+
+   for (const snapshot_list_t &sl : snapshot_lists) {
+      lList *lp = nullptr;
+
+      if (!read_list(dir, &sl, &lp)) {
+         ret = false;
+         break;
+      }
+
+      if (sl.type == SGE_TYPE_SCHEDD_CONF) {
+         if (!sconf_set_config(&lp, &alp)) {
+            answer_list_output(&alp);
+            ret = false;
+         }
+         lFreeList(&lp);
+      } else if (sl.type == SGE_TYPE_CONFIG) {
+         lListElem *global = lGetElemHostRW(lp, CONF_name, SGE_GLOBAL_NAME);
+
+         merge_configuration(&alp, SCHEDD, dir, global, nullptr, nullptr);
+         answer_list_output(&alp);
+         lFreeList(&lp);
+      } else {
+         lList **master_list = ocs::DataStore::get_master_list_rw(sl.type);
+
+         lFreeList(master_list);
+         *master_list = reduce_to_subscription(sl.type, lp, where_what);
+      }
+   }
+
+   DRETURN(ret);
+}
+
+static void
+print_orders(const lList *order_list) {
+   const lListElem *order;
+
+   for_each_ep(order, order_list) {
+      const lListElem *oq;
+
+      printf("order %2d job " sge_u32 "." sge_u32 " tickets %.2f", (int) lGetUlong(order, OR_type),
+             lGetUlong(order, OR_job_number), lGetUlong(order, OR_ja_task_number), lGetDouble(order, OR_ticket));
+      for_each_ep(oq, lGetList(order, OR_queuelist)) {
+         printf(" %s=" sge_u32, lGetString(oq, OQ_dest_queue) != nullptr ? lGetString(oq, OQ_dest_queue) : "-",
+                lGetUlong(oq, OQ_slots));
+      }
+      printf("\n");
+   }
+}
+
+static int
+replay_snapshot(const char *dir, int runs, bool show_orders) {
+   sge_where_what_t where_what;
+   sge_evc_class_t evc;
+   lList *order_list = nullptr;
+
+   DENTER(TOP_LAYER);
+
+   memset(&where_what, 0, sizeof(where_what));
+   memset(&evc, 0, sizeof(evc));
+
+   ocs::DataStore::select_active_ds(ocs::DataStore::Id::SCHEDULER);
+   ensure_valid_what_and_where(&where_what);
+   if (!load_snapshot(dir, &where_what)) {
+      free_what_and_where(&where_what);
+      DRETURN(1);
+   }
+
+   sge_schedd_set_order_sink(&order_list);
+   set_thread_name(pthread_self(), "Scheduler Thread");
+   for (const phase_t &phase : phases) {
+      prof_start(phase.level, nullptr);
+   }
+
+   printf("%4s %8s", "run", "orders");
+   for (const phase_t &phase : phases) {
+      printf(" %9s", phase.name);
+   }
+   printf("\n");
+
+   for (int run = 1; run <= runs; run++) {
+      lList *answer_list = nullptr;
+      lList *orders = nullptr;
+      scheduler_all_data_t copy;
+
+      lFreeList(&order_list);
+      for (const phase_t &phase : phases) {
+         prof_reset(phase.level, nullptr);
+      }
+
+      // as the scheduler thread does it, see sge_before_dispatch()
+      sge_rebuild_job_category(*ocs::DataStore::get_master_list(SGE_TYPE_JOB),
+                               *ocs::DataStore::get_master_list(SGE_TYPE_USERSET),
+                               *ocs::DataStore::get_master_list(SGE_TYPE_PROJECT),
+                               *ocs::DataStore::get_master_list(SGE_TYPE_RQS));
+      sge_reset_job_category();
+
+      PROF_START_MEASUREMENT(SGE_PROF_CUSTOM7);
+      scheduler_copy_data(&copy, &where_what);
+      PROF_STOP_MEASUREMENT(SGE_PROF_CUSTOM7);
+
+      scheduler_method(&evc, &answer_list, &copy, &orders);
+      answer_list_output(&answer_list);
+      lFreeList(&orders);
+      schedd_order_destroy();
+      scheduler_free_data(&copy);
+
+      printf("%4d %8d", run, lGetNumberOfElem(order_list));
+      for (const phase_t &phase : phases) {
+         printf(" %9.3f", prof_get_measurement_wallclock(phase.level, false, nullptr));
+      }
+      printf("\n");
+   }
+
+   if (show_orders) {
+      print_orders(order_list);
+   }
+
+   sge_schedd_set_order_sink(nullptr);
+   lFreeList(&order_list);
+   free_what_and_where(&where_what);
+   for (const phase_t &phase : phases) {
+      prof_stop(phase.level, nullptr);
+   }
+
+   DRETURN(0);
+}
+
+int main(int argc, char *argv[]) {
+   const char *dump_dir = nullptr;
+   const char *dir = nullptr;
+   bool show_orders = false;
+   int runs = 1;
+   int ret;
+
+   DENTER_MAIN(TOP_LAYER, "test_qmaster_sched_replay");
+
+   lInit(nmv);
+
+   for (int i = 1; i < argc; i++) {
+      if (strcmp(argv[i], "-dump") == 0 && i + 1 < argc) {
+         dump_dir = argv[++i];
+      } else if (strcmp(argv[i], "-runs") == 0 && i + 1 < argc) {
+         runs = atoi(argv[++i]);
+      } else if (strcmp(argv[i], "-orders") == 0) {
+         show_orders = true;
+      } else if (argv[i][0] != '-' && dir == nullptr) {
+         dir = argv[i];
+      } else {
+         usage();
+         DRETURN(1);
+      }
+   }
+
+   if (dump_dir != nullptr) {
+      ret = dump_snapshot(dump_dir);
+   } else if (dir != nullptr && runs > 0) {
+      ret = replay_snapshot(dir, runs, show_orders);
+   } else {
+      usage();
+      ret = 1;
+   }
+
+   DRETURN(ret);
+}
@@ -0,0 +1,159 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#define __SGE_GDI_LIBRARY_HOME_OBJECT_FILE__
+
+#include "cull/cull.h"
+
+enum {
+   TEST_id = 1,
+   TEST_string,
+   TEST_double
+};
+
+LISTDEF(TEST_Type)
+                SGE_ULONG (TEST_id, CULL_DEFAULT)
+                SGE_STRING (TEST_string, CULL_DEFAULT)
+                SGE_DOUBLE (TEST_double, CULL_DEFAULT)
+LISTEND
+
+NAMEDEF(TEST_Name)
+                NAME("TEST_id")
+                NAME("TEST_string")
+                NAME("TEST_double")
+NAMEEND
+
+#define TEST_Size sizeof(TEST_Name) / sizeof(char *)
+
+lNameSpace nmv[] = {
+        {1, TEST_Size, TEST_Name, TEST_Type},
+        {0, 0, nullptr, nullptr}
+};
+
+/* reads a list in pages and checks that each element fulfilling the condition is returned once in key order */
+static bool test_pages(const lList *lp, const lCondition *cp, const lEnumeration *enp, u_long32 limit,
+                       u_long32 expected_elems) {
+   u_long32 cursor = 0;
+   u_long32 n = 0;
+   bool ret = true;
+
+   printf("testing lSelectPage() with page size " sge_u32 " %s condition and %s enumeration\n", limit,
+          cp != nullptr ? "with" : "without", enp != nullptr ? "with" : "without");
+
+   while (ret) {
+      lList *page = lSelectPage("page", lp, cp, enp, TEST_id, cursor, limit);
+      const lListElem *ep;
+      u_long32 size = lGetNumberOfElem(page);
+
+      if (page == nullptr) {
+         printf("lSelectPage() failed\n");
+         ret = false;
+         break;
+      }
+      if (size > limit) {
+         printf("page contains " sge_u32 " elements\n", size);
+         ret = false;
+      }
+      if (enp != nullptr && lGetPosInDescr(lGetListDescr(page), TEST_double) >= 0) {
+         printf("enumeration was not applied\n");
+         ret = false;
+      }
+      for_each_ep(ep, page) {
+         if (lGetUlong(ep, TEST_id) <= cursor) {
+            printf("key " sge_u32 " is not greater than " sge_u32 "\n", lGetUlong(ep, TEST_id), cursor);
+            ret = false;
+         }
+         if (cp != nullptr && !lCompare(ep, cp)) {
+            printf("element " sge_u32 " does not fulfill the condition\n", lGetUlong(ep, TEST_id));
+            ret = false;
+         }
+         cursor = lGetUlong(ep, TEST_id);
+         n++;
+      }
+      lFreeList(&page);
+      if (size < limit) {
+         break;
+      }
+   }
+
+   if (ret && n != expected_elems) {
+      printf("expected " sge_u32 " elements, found " sge_u32 "\n", expected_elems, n);
+      ret = false;
+   }
+
+   return ret;
+}
+
+int main(int argc, char *argv[]) {
+   const u_long32 num_elems = 1000;
+   lList *lp = lCreateList("page test", TEST_Type);
+   lCondition *cp;
+   lEnumeration *enp;
+   u_long32 num_even = 0;
+   bool ret = true;
+
+   lInit(nmv);
+
+   /* unique keys in random order */
+   srand(0);
+   for (u_long32 i = 1; i <= num_elems; i++) {
+      lListElem *ep = lCreateElem(TEST_Type);
+      lSetUlong(ep, TEST_id, i);
+      lSetString(ep, TEST_string, (i % 2) == 0 ? "even" : "odd");
+      lSetDouble(ep, TEST_double, i);
+      lInsertElem(lp, (rand() % 2) == 0 ? nullptr : lLastRW(lp), ep);
+      if ((i % 2) == 0) {
+         num_even++;
+      }
+   }
+
+   cp = lWhere("%T(%I == %s)", TEST_Type, TEST_string, "even");
+   enp = lWhat("%T(%I %I)", TEST_Type, TEST_id, TEST_string);
+
+   ret = ret && test_pages(lp, nullptr, nullptr, 1, num_elems);
+   ret = ret && test_pages(lp, nullptr, nullptr, 7, num_elems);
+   ret = ret && test_pages(lp, nullptr, nullptr, num_elems, num_elems);
+   ret = ret && test_pages(lp, cp, nullptr, 33, num_even);
+   ret = ret && test_pages(lp, cp, enp, 100, num_even);
+   ret = ret && test_pages(lp, nullptr, enp, 2 * num_elems, num_elems);
+
+   /* keys which are not part of the descriptor or not ulong are rejected */
+   if (ret && lSelectPage("page", lp, nullptr, nullptr, TEST_double + 1, 0, 10) != nullptr) {
+      printf("lSelectPage() accepted an unknown key\n");
+      ret = false;
+   }
+   if (ret && lSelectPage("page", lp, nullptr, nullptr, TEST_double, 0, 10) != nullptr) {
+      printf("lSelectPage() accepted a double key\n");
+      ret = false;
+   }
+
+   lFreeWhere(&cp);
+   lFreeWhat(&enp);
+   lFreeList(&lp);
+
+   if (ret) {
+      printf("OK\n");
+   }
+
+   return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#define __SGE_GDI_LIBRARY_HOME_OBJECT_FILE__
+
+#include "cull/cull.h"
+
+enum {
+   TEST_id = 1,
+   TEST_string,
+   TEST_list,
+   TEST_other_list
+};
+
+LISTDEF(TEST_Type)
+                SGE_ULONG (TEST_id, CULL_DEFAULT)
+                SGE_STRING (TEST_string, CULL_DEFAULT)
+                SGE_LIST (TEST_list, TEST_Type, CULL_DEFAULT)
+                SGE_LIST (TEST_other_list, TEST_Type, CULL_DEFAULT)
+LISTEND
+
+NAMEDEF(TEST_Name)
+                NAME("TEST_id")
+                NAME("TEST_string")
+                NAME("TEST_list")
+                NAME("TEST_other_list")
+NAMEEND
+
+#define TEST_Size sizeof(TEST_Name) / sizeof(char *)
+
+lNameSpace nmv[] = {
+        {1, TEST_Size, TEST_Name, TEST_Type},
+        {0, 0, nullptr, nullptr}
+};
+
+static const int shared_nm[] = {TEST_list, TEST_string, NoName};
+
+static lList *create_list(u_long32 n) {
+   lList *lp = lCreateList("source", TEST_Type);
+
+   for (u_long32 i = 1; i <= n; i++) {
+      lListElem *ep = lAddElemUlong(&lp, TEST_id, i, TEST_Type);
+      lSetString(ep, TEST_string, "job");
+      lAddSubStr(ep, TEST_string, "a", TEST_list, TEST_Type);
+      lAddSubStr(ep, TEST_string, "b", TEST_list, TEST_Type);
+      lAddSubStr(ep, TEST_string, "x", TEST_other_list, TEST_Type);
+   }
+   return lp;
+}
+
+static bool check(bool condition, const char *what) {
+   if (!condition) {
+      printf("failed: %s\n", what);
+   }
+   return condition;
+}
+
+static bool test_sharing() {
+   bool ret = true;
+   lList *src = create_list(3);
+   lList *snap = lSnapshotList(nullptr, src, shared_nm);
+
+   printf("testing shared and copied sublists\n");
+
+   ret &= check(lGetNumberOfElem(snap) == 3, "snapshot contains all elements");
+   ret &= check(lGetElemUlong(snap, TEST_id, 2) != nullptr, "hash table of snapshot");
+
+   const lListElem *sep = lFirst(src);
+   const lListElem *dep = lFirst(snap);
+   ret &= check(lGetList(sep, TEST_list) == lGetList(dep, TEST_list), "TEST_list is shared");
+   ret &= check(lGetList(sep, TEST_other_list) != lGetList(dep, TEST_other_list), "TEST_other_list is copied");
+   ret &= check(lGetString(sep, TEST_string) != lGetString(dep, TEST_string), "strings are copied");
+
+   /* read access must not copy the list */
+   ret &= check(lGetSubStr(dep, TEST_string, "a", TEST_list) != nullptr, "lGetSubStr() finds element");
+   ret &= check(lGetSubStrRW(dep, TEST_string, "c", TEST_list) == nullptr, "lGetSubStrRW() does not find element");
+   ret &= check(lGetPosList(dep, lGetPosViaElem(dep, TEST_list, SGE_DO_ABORT)) == lGetList(sep, TEST_list),
+                "lGetPosList() returns the shared list");
+   ret &= check(lGetList(sep, TEST_list) == lGetList(dep, TEST_list), "read access keeps list shared");
+
+   /* modifications of the snapshot are not visible in the source */
+   lSetString(lGetSubStrRW(dep, TEST_string, "a", TEST_list), TEST_string, "modified");
+   ret &= check(lGetList(sep, TEST_list) != lGetList(dep, TEST_list), "lGetSubStrRW() copies the list");
+   ret &= check(lGetSubStr(sep, TEST_string, "a", TEST_list) != nullptr, "source list is unchanged");
+   ret &= check(lGetSubStr(dep, TEST_string, "modified", TEST_list) != nullptr, "snapshot list is modified");
+
+   dep = lNext(dep);
+   sep = lNext(sep);
+   lAddSubStr((lListElem *) dep, TEST_string, "c", TEST_list, TEST_Type);
+   ret &= check(lGetNumberOfElem(lGetList(sep, TEST_list)) == 2, "lAddSubStr() does not modify the source");
+   ret &= check(lGetNumberOfElem(lGetList(dep, TEST_list)) == 3, "lAddSubStr() modifies the snapshot");
+
+   /* modifications of the source are not visible in the snapshot */
+   dep = lNext(dep);
+   sep = lNext(sep);
+   lList *lp = lGetListRW(sep, TEST_list);
+   lDelElemStr(&lp, TEST_string, "a");
+   ret &= check(lGetNumberOfElem(lGetList(sep, TEST_list)) == 1, "source list is modified");
+   ret &= check(lGetNumberOfElem(lGetList(dep, TEST_list)) == 2, "snapshot list is unchanged");
+
+   /* sublists exchanged out of the element are private */
+   lp = nullptr;
+   lXchgList((lListElem *) dep, TEST_list, &lp);
+   ret &= check(lp != nullptr && lp != lGetList(sep, TEST_list), "lXchgList() returns private list");
+   lFreeList(&lp);
+
+   lFreeList(&snap);
+   ret &= check(lGetNumberOfElem(lGetList(lFirst(src), TEST_list)) == 2, "source survives freeing the snapshot");
+   lFreeList(&src);
+
+   return ret;
+}
+
+static bool test_free_order() {
+   bool ret = true;
+   lList *src = create_list(10);
+   lList *snap1 = lSnapshotList("snap1", src, shared_nm);
+   lList *snap2 = lSnapshotList("snap2", snap1, shared_nm);
+
+   printf("testing release of shared lists\n");
+
+   /* the source goes away first, the last owner frees the sublists */
+   lFreeList(&src);
+   ret &= check(lGetNumberOfElem(lGetList(lFirst(snap1), TEST_list)) == 2, "snap1 survives freeing the source");
+   lFreeList(&snap1);
+   ret &= check(lGetNumberOfElem(lGetList(lLast(snap2), TEST_list)) == 2, "snap2 survives freeing snap1");
+
+   /* copies of snapshot elements are independent */
+   lListElem *copy = lCopyElem(lFirst(snap2));
+   lFreeList(&snap2);
+   ret &= check(lGetNumberOfElem(lGetList(copy, TEST_list)) == 2, "copy of a snapshot element");
+   lFreeElem(&copy);
+
+   return ret;
+}
+
+static bool test_threads() {
+   bool ret = true;
+   const int n_threads = 8;
+   lList *src = create_list(1000);
+   lList *snap[n_threads];
+   std::thread threads[n_threads];
+
+   printf("testing concurrent release of shared lists\n");
+
+   for (int i = 0; i < n_threads; i++) {
+      snap[i] = lSnapshotList(nullptr, src, shared_nm);
+   }
+
+   /* each thread reads, unshares half of its sublists and frees its snapshot */
+   for (int i = 0; i < n_threads; i++) {
+      threads[i] = std::thread([&snap, i]() {
+         lListElem *ep;
+         for_each_rw(ep, snap[i]) {
+            if (lGetUlong(ep, TEST_id) % 2 == 0) {
+               lAddSubStr(ep, TEST_string, "c", TEST_list, TEST_Type);
+            }
+         }
+         lFreeList(&snap[i]);
+      });
+   }
+   for (int i = 0; i < n_threads; i++) {
+      threads[i].join();
+   }
+
+   const lListElem *ep;
+   bool unchanged = true;
+   for_each_ep(ep, src) {
+      unchanged &= lGetNumberOfElem(lGetList(ep, TEST_list)) == 2;
+      unchanged &= !cull_list_is_shared(lGetList(ep, TEST_list));
+   }
+   ret &= check(unchanged, "source is unchanged and the only owner after all snapshots are freed");
+   lFreeList(&src);
+
+   return ret;
+}
+
+int main(int argc, char *argv[]) {
+   bool ret = true;
+
+   lInit(nmv);
+
+   ret &= test_sharing();
+   ret &= test_free_order();
+   ret &= test_threads();
+
+   return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,173 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#define __SGE_GDI_LIBRARY_HOME_OBJECT_FILE__
+
+#include "cull/cull.h"
+
+enum {
+   TEST_ulong = 1,
+   TEST_double
+};
+
+LISTDEF(TEST_Type)
+                SGE_ULONG (TEST_ulong, CULL_DEFAULT)
+                SGE_DOUBLE (TEST_double, CULL_DEFAULT)
+LISTEND
+
+NAMEDEF(TEST_Name)
+                NAME("TEST_ulong")
+                NAME("TEST_double")
+NAMEEND
+
+#define TEST_Size sizeof(TEST_Name) / sizeof(char *)
+
+lNameSpace nmv[] = {
+        {1, TEST_Size, TEST_Name, TEST_Type},
+        {0, 0, nullptr, nullptr}
+};
+
+static bool check_sorted(const lList *lp, u_long32 expected_elems, bool check_insert_order) {
+   const lListElem *ep;
+   const lListElem *prev = nullptr;
+   u_long32 n = 0;
+
+   for_each_ep(ep, lp) {
+      if (prev != nullptr) {
+         if (lGetDouble(prev, TEST_double) > lGetDouble(ep, TEST_double)) {
+            printf("list is not sorted at position " sge_u32 "\n", n);
+            return false;
+         }
+         /* equal keys must keep the insert order (newer ones first) */
+         if (check_insert_order && lGetDouble(prev, TEST_double) == lGetDouble(ep, TEST_double) &&
+             lGetUlong(prev, TEST_ulong) < lGetUlong(ep, TEST_ulong)) {
+            printf("elements with equal keys are in wrong order at position " sge_u32 "\n", n);
+            return false;
+         }
+      }
+      prev = ep;
+      n++;
+   }
+
+   if (n != expected_elems || lGetNumberOfElem(lp) != expected_elems) {
+      printf("expected " sge_u32 " elements, found " sge_u32 "\n", expected_elems, n);
+      return false;
+   }
+
+   return true;
+}
+
+static bool test_insert_and_resort(bool with_index) {
+   const int num_elems = 2000;
+   lList *lp = lCreateList("sort test", TEST_Type);
+   lSortOrder *so = lParseSortOrderVarArg(TEST_Type, "%I+", TEST_double);
+   lListElem *ep;
+   bool ret = true;
+
+   printf("testing lInsertSorted() and lResortElem() %s sort index\n", with_index ? "with" : "without");
+
+   if (with_index) {
+      if (lSortIndexCreate(lp, so) != 0 || !lHasSortIndex(lp, so)) {
+         printf("lSortIndexCreate() failed\n");
+         ret = false;
+      }
+   }
+
+   /* insert with many duplicate keys */
+   for (int i = 0; ret && i < num_elems; i++) {
+      ep = lCreateElem(TEST_Type);
+      lSetUlong(ep, TEST_ulong, i);
+      lSetDouble(ep, TEST_double, rand() % 100);
+      if (lInsertSorted(so, ep, lp) != 0) {
+         printf("lInsertSorted() failed\n");
+         ret = false;
+      }
+   }
+   ret = ret && check_sorted(lp, num_elems, true);
+
+   /* change the key of random elements and resort them */
+   for (int i = 0; ret && i < num_elems; i++) {
+      int pos = rand() % num_elems;
+
+      for (ep = lFirstRW(lp); pos > 0; pos--) {
+         ep = lNextRW(ep);
+      }
+      lSetUlong(ep, TEST_ulong, num_elems + i);
+      lSetDouble(ep, TEST_double, rand() % 100);
+      lResortElem(so, ep, lp);
+   }
+   ret = ret && check_sorted(lp, num_elems, true);
+
+   /* remove elements from the front and the back, then insert again */
+   for (int i = 0; ret && i < num_elems / 4; i++) {
+      ep = lFirstRW(lp);
+      lRemoveElem(lp, &ep);
+      ep = lDechainElem(lp, lLastRW(lp));
+      lSetUlong(ep, TEST_ulong, 2 * num_elems + i);
+      lInsertSorted(so, ep, lp);
+      ep = lDechainElem(lp, lLastRW(lp));
+      lFreeElem(&ep);
+   }
+   ret = ret && check_sorted(lp, num_elems / 2, true);
+
+   /* sorting by a different order and back rebuilds the index, qsort() does not keep the insert order */
+   if (ret) {
+      lPSortList(lp, "%I+", TEST_ulong);
+      lSortList(lp, so);
+      ep = lCreateElem(TEST_Type);
+      lSetUlong(ep, TEST_ulong, 3 * num_elems);
+      lSetDouble(ep, TEST_double, 50);
+      lInsertSorted(so, ep, lp);
+      ret = check_sorted(lp, num_elems / 2 + 1, false);
+   }
+
+   if (with_index && ret) {
+      lSortIndexFree(lp);
+      if (lHasSortIndex(lp, nullptr)) {
+         printf("lSortIndexFree() did not remove the sort index\n");
+         ret = false;
+      }
+   }
+
+   lFreeList(&lp);
+   lFreeSortOrder(&so);
+
+   return ret;
+}
+
+int main(int argc, char *argv[]) {
+   bool ret = true;
+
+   lInit(nmv);
+
+   srand(0);
+   ret = ret && test_insert_and_resort(false);
+   srand(0);
+   ret = ret && test_insert_and_resort(true);
+
+   if (ret) {
+      printf("OK\n");
+   }
+
+   return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,158 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#define __SGE_GDI_LIBRARY_HOME_OBJECT_FILE__
+
+#include "cull/cull.h"
+
+enum {
+   TEST_ulong = 1,
+   TEST_string,
+   TEST_host,
+   TEST_list
+};
+
+LISTDEF(TEST_Type)
+                SGE_ULONG (TEST_ulong, CULL_DEFAULT)
+                SGE_STRING (TEST_string, CULL_DEFAULT)
+                SGE_HOST (TEST_host, CULL_DEFAULT)
+                SGE_LIST (TEST_list, TEST_Type, CULL_DEFAULT)
+LISTEND
+
+NAMEDEF(TEST_Name)
+                NAME("TEST_ulong")
+                NAME("TEST_string")
+                NAME("TEST_host")
+                NAME("TEST_list")
+NAMEEND
+
+#define TEST_Size sizeof(TEST_Name) / sizeof(char *)
+
+lNameSpace nmv[] = {
+        {1, TEST_Size, TEST_Name, TEST_Type},
+        {0, 0, nullptr, nullptr}
+};
+
+static const char *strings[] = {"", "a", "abc", "abd", "b*c", "job.1", "job.12", "JOB.1", "x[1]", nullptr};
+
+static lList *create_list() {
+   lList *lp = lCreateList("where test", TEST_Type);
+
+   for (u_long32 i = 0; i < 200; i++) {
+      lListElem *ep = lCreateElem(TEST_Type);
+      int n = sizeof(strings) / sizeof(char *) - 1;
+
+      lSetUlong(ep, TEST_ulong, i % 13);
+      if ((i % 17) != 0) {
+         lSetString(ep, TEST_string, strings[i % n]);
+      }
+      lSetHost(ep, TEST_host, strings[(i / 3) % n]);
+      if ((i % 5) == 0) {
+         lListElem *sub = lAddSubUlong(ep, TEST_ulong, i % 7, TEST_list, TEST_Type);
+         lSetString(sub, TEST_string, strings[i % n]);
+      }
+      lAppendElem(lp, ep);
+   }
+
+   return lp;
+}
+
+/* a compiled condition has to give the same result as the condition tree for each element */
+static bool test_condition(const lList *lp, const char *text, lCondition *cp) {
+   lCondition *compiled = lCopyWhere(cp);
+   const lListElem *ep;
+   int matches = 0;
+   bool ret = true;
+
+   if (cp == nullptr || compiled == nullptr) {
+      printf("cannot create condition %s\n", text);
+      lFreeWhere(&cp);
+      lFreeWhere(&compiled);
+      return false;
+   }
+
+   if (!lCompileWhere(compiled)) {
+      printf("cannot compile condition %s\n", text);
+      ret = false;
+   }
+
+   for_each_ep(ep, lp) {
+      int expected = lCompare(ep, cp);
+
+      if (lCompare(ep, compiled) != expected) {
+         printf("condition %s gives different results for element " sge_u32 "\n", text, lGetUlong(ep, TEST_ulong));
+         ret = false;
+         break;
+      }
+      matches += expected;
+   }
+   printf("condition %s matches %d elements\n", text, matches);
+
+   lFreeWhere(&cp);
+   lFreeWhere(&compiled);
+   return ret;
+}
+
+int main(int argc, char *argv[]) {
+   lList *lp;
+   bool ret = true;
+
+   lInit(nmv);
+   lp = create_list();
+
+   ret = ret && test_condition(lp, "ulong ==", lWhere("%T(%I == %u)", TEST_Type, TEST_ulong, 3));
+   ret = ret && test_condition(lp, "ulong <=", lWhere("%T(%I <= %u)", TEST_Type, TEST_ulong, 7));
+   ret = ret && test_condition(lp, "bitmask", lWhere("%T(%I m= %u)", TEST_Type, TEST_ulong, 5));
+   ret = ret && test_condition(lp, "string ==", lWhere("%T(%I == %s)", TEST_Type, TEST_string, "abc"));
+   ret = ret && test_condition(lp, "string c=", lWhere("%T(%I c= %s)", TEST_Type, TEST_string, "job.1"));
+   ret = ret && test_condition(lp, "literal pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "job.1"));
+   ret = ret && test_condition(lp, "prefix pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "job*"));
+   ret = ret && test_condition(lp, "match all pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "*"));
+   ret = ret && test_condition(lp, "empty pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, ""));
+   ret = ret && test_condition(lp, "glob pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "a?*"));
+   ret = ret && test_condition(lp, "bracket pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "[aj]*"));
+   ret = ret && test_condition(lp, "escaped pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "b\\*c"));
+   ret = ret && test_condition(lp, "host pattern", lWhere("%T(%I p= %s)", TEST_Type, TEST_host, "job*"));
+   ret = ret && test_condition(lp, "and", lWhere("%T(%I > %u && %I p= %s)", TEST_Type,
+                                                 TEST_ulong, 4, TEST_string, "a*"));
+   ret = ret && test_condition(lp, "or", lWhere("%T(%I < %u || %I p= %s || %I == %s)", TEST_Type,
+                                                TEST_ulong, 2, TEST_string, "job*", TEST_string, "abd"));
+   ret = ret && test_condition(lp, "negation", lWhere("%T(!(%I == %u || %I p= %s))", TEST_Type,
+                                                      TEST_ulong, 2, TEST_string, "job*"));
+   ret = ret && test_condition(lp, "nested", lWhere("%T((%I == %u || !(%I p= %s)) && (%I != %u || %I p= %s))",
+                                                    TEST_Type, TEST_ulong, 3, TEST_string, "a*",
+                                                    TEST_ulong, 5, TEST_string, "*.1"));
+   ret = ret && test_condition(lp, "sub list", lWhere("%T(%I -> %T(%I == %u && %I p= %s))", TEST_Type,
+                                                      TEST_list, TEST_Type, TEST_ulong, 0, TEST_string, "*"));
+   ret = ret && test_condition(lp, "and of combined conditions",
+                               lAndWhere(lWhere("%T(%I p= %s)", TEST_Type, TEST_string, "job*"),
+                                         lWhere("%T(%I != %u)", TEST_Type, TEST_ulong, 0)));
+
+   lFreeList(&lp);
+
+   if (ret) {
+      printf("OK\n");
+   }
+
+   return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -51,6 +51,7 @@
 int njobs    = 100;
 int nthreads = 1;
 int dowait   = 1;
+int dosync   = 0;
 int quiet   = 0;
 const char *native_spec = "-w n";
 char *job_path = nullptr;
@@ -74,6 +75,7 @@ static void usage()
    fprintf(stderr, "   -native     <nativespec>                                  native specification passed (default \"-w n\")\n");
    fprintf(stderr, "   -threads    <nthreads>                                    number of submission thread (default 1)\n");
    fprintf(stderr, "   -wait       [yes|no]                                      wait for job completion (default yes)\n");
+   fprintf(stderr, "   -sync       [yes|no]                                      wait with drmaa_synchronize() instead of drmaa_wait() (default no)\n");
    fprintf(stderr, "   -quiet      [yes|no]                                      wait for job completion (default no)\n");
    fprintf(stderr, "   -scenario   [queue|type|number|pe].[none|resource|hostgroup|softresource|softhostgroup] options -jobs/-threads be ignored\n");
 
@@ -167,6 +169,22 @@ int main(int argc, char *argv[])
          }
          i++; 
 
+      } else if (!strcmp("-sync", argv[i])) {
+         i++; 
+         if (argc < i+1) {
+            usage();
+            return 1;
+         }
+         if (!strcmp("yes", argv[i]) || !strcmp("y", argv[i])) 
+            dosync = 1;
+         else if (!strcmp("no", argv[i]) || !strcmp("n", argv[i])) 
+            dosync = 0;
+         else {
+            usage();
+            return 1;
+         }
+         i++; 
+
       } else if (!strcmp("-scenario", argv[i])) {
          i++; 
          if (argc < i+1) {
@@ -217,6 +235,7 @@ int main(int argc, char *argv[])
    printf("nthreads: %d\n", nthreads);
    printf("native:   %s\n", native_spec);
    printf("dowait:   %s\n", dowait?"yes":"no");
+   printf("dosync:   %s\n", dosync?"yes":"no");
    printf("quiet:    %s\n", quiet?"yes":"no");
    printf("scenario: %s\n", scenario?scenario:"<no such>");
    printf("site_b:   %s\n", site_b?site_b:"<no such>");
@@ -266,7 +285,20 @@ int main(int argc, char *argv[])
    get_gmt(&finish_s);
    printf("submission took %8.3f seconds\n", DELTA_SECONDS(start_s, finish_s)); 
 
-   if (dowait) {
+   if (dowait && dosync) {
+      const char *all_jobids[] = { DRMAA_JOB_IDS_SESSION_ALL, nullptr };
+
+      drmaa_errno = drmaa_synchronize(all_jobids, DRMAA_TIMEOUT_WAIT_FOREVER, 1,
+         diagnosis, sizeof(diagnosis)-1);
+      if (drmaa_errno != DRMAA_ERRNO_SUCCESS) {
+         fprintf(stderr, "drmaa_synchronize() failed: %s\n", diagnosis);
+         return 1;
+      }
+
+      get_gmt(&wait_s);
+      printf("synchronize took %8.3f seconds\n", DELTA_SECONDS(finish_s, wait_s)); 
+      printf("jobs took %8.3f seconds\n", DELTA_SECONDS(start_s, wait_s)); 
+   } else if (dowait) {
       int success = 1;
 
       for (i=0; i<njobs * nthreads; i++) {
@@ -0,0 +1,306 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_event.h"
+
+#include "japi/ocs_DrmaaRelay.h"
+#include "japi/ocs_DrmaaRelaySessions.h"
+
+static lList *
+create_events(int count) {
+   lList *event_list = lCreateList("events", ET_Type);
+
+   for (int i = 1; i <= count; i++) {
+      lListElem *event = lAddElemUlong(&event_list, ET_type, sgeE_JOB_FINISH, ET_Type);
+      lSetUlong(event, ET_intkey, i);
+      lSetUlong(event, ET_intkey2, 1);
+   }
+   return event_list;
+}
+
+/*
+ * Events sent by one side of a connection arrive unchanged at the other side.
+ */
+static int
+test_events() {
+   lList *sent = create_events(100);
+   lList *received = nullptr;
+   int fds[2];
+   std::atomic<int> failed{0};
+
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+      printf("socketpair failed: %s\n", strerror(errno));
+      return 1;
+   }
+
+   // larger than the socket buffer, the reader has to run in parallel
+   std::thread reader([&]() {
+      if (!ocs::DrmaaRelay::receive_events(fds[1], &received)) {
+         printf("receiving events failed\n");
+         failed++;
+      }
+   });
+   if (!ocs::DrmaaRelay::send_events(fds[0], sent)) {
+      printf("sending events failed\n");
+      failed++;
+   }
+   reader.join();
+
+   if (lGetNumberOfElem(received) != 100 ||
+       lGetUlong(lLast(received), ET_intkey) != 100 || lGetUlong(lFirst(received), ET_type) != sgeE_JOB_FINISH) {
+      printf("wrong events received\n");
+      failed++;
+   }
+
+   // a closed connection is detected
+   close(fds[0]);
+   lFreeList(&received);
+   if (ocs::DrmaaRelay::receive_events(fds[1], &received)) {
+      printf("events received from a closed connection\n");
+      failed++;
+   }
+   close(fds[1]);
+
+   lFreeList(&sent);
+   lFreeList(&received);
+   return failed;
+}
+
+/*
+ * A session connects with its session key and gets events through the relay socket.
+ */
+static int
+test_register() {
+   char path[256];
+   lList *alp = nullptr;
+   std::atomic<int> failed{0};
+
+   snprintf(path, sizeof(path), "/tmp/test_drmaa_relay.%d", (int) getpid());
+
+   int listen_fd = ocs::DrmaaRelay::listen(path, &alp);
+   if (listen_fd < 0) {
+      printf("listen on %s failed\n", path);
+      lFreeList(&alp);
+      return 1;
+   }
+
+   // like sge_drmaa_relay: register the session and send its events
+   std::string session;
+   std::thread relay([&]() {
+      int fd = accept(listen_fd, nullptr, nullptr);
+      lList *events = create_events(2);
+
+      if (fd < 0 || !ocs::DrmaaRelay::receive_session(fd, session) ||
+          !ocs::DrmaaRelay::send_events(fd, nullptr) || !ocs::DrmaaRelay::send_events(fd, events)) {
+         printf("relay could not register the session\n");
+         failed++;
+      }
+      lFreeList(&events);
+      if (fd >= 0) {
+         close(fd);
+      }
+   });
+
+   int fd = ocs::DrmaaRelay::connect(path, "4711", &alp);
+   lList *events = nullptr;
+   if (fd < 0 || !ocs::DrmaaRelay::receive_events(fd, &events) || lGetNumberOfElem(events) != 2) {
+      printf("session did not get its events\n");
+      failed++;
+   }
+   relay.join();
+   if (session != "4711") {
+      printf("relay got the wrong session key \"%s\"\n", session.c_str());
+      failed++;
+   }
+
+   // the socket of a running relay is not taken over
+   if (ocs::DrmaaRelay::listen(path, &alp) >= 0) {
+      printf("socket of a running relay was replaced\n");
+      failed++;
+   }
+
+   if (fd >= 0) {
+      close(fd);
+   }
+   close(listen_fd);
+   unlink(path);
+   lFreeList(&events);
+   lFreeList(&alp);
+   return failed;
+}
+
+static void
+add_event(lList **event_list, u_long32 type, u_long32 job_id, lList *jobs = nullptr) {
+   lListElem *event = lAddElemUlong(event_list, ET_type, type, ET_Type);
+   lSetUlong(event, ET_intkey, job_id);
+   lSetList(event, ET_new_version, jobs);
+}
+
+static lList *
+create_jobs(u_long32 job_id, const char *session) {
+   lList *jobs = nullptr;
+   lListElem *job = lAddElemUlong(&jobs, JB_job_number, job_id, JB_Type);
+   lSetString(job, JB_session, session);
+   return jobs;
+}
+
+/*
+ * Receives the next message of a session and compares the event types and job ids.
+ */
+static int
+expect_events(int fd, const char *session, const u_long32 expected[][2], int count) {
+   lList *events = nullptr;
+   const lListElem *event;
+   int failed = 0;
+   int i = 0;
+
+   if (!ocs::DrmaaRelay::receive_events(fd, &events)) {
+      printf("session %s got no events\n", session);
+      return 1;
+   }
+   for_each_ep(event, events) {
+      if (i >= count || lGetUlong(event, ET_type) != expected[i][0] || lGetUlong(event, ET_intkey) != expected[i][1]) {
+         printf("session %s got the wrong event %d\n", session, i);
+         failed++;
+         break;
+      }
+      if (lGetUlong(event, ET_type) == sgeE_JOB_LIST && lGetList(event, ET_new_version) != nullptr) {
+         printf("session %s got the job list of other sessions\n", session);
+         failed++;
+      }
+      i++;
+   }
+   if (failed == 0 && i != count) {
+      printf("session %s got %d events instead of %d\n", session, i, count);
+      failed++;
+   }
+   lFreeList(&events);
+   return failed;
+}
+
+/*
+ * The relay sends the events of a job only to the session which submitted it
+ * and events concerning all sessions to every session.
+ */
+static int
+test_routing() {
+   ocs::DrmaaRelaySessions sessions;
+   lList *events = nullptr;
+   int fds_a[2];
+   int fds_b[2];
+   int failed = 0;
+
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds_a) != 0 || socketpair(AF_UNIX, SOCK_STREAM, 0, fds_b) != 0) {
+      printf("socketpair failed: %s\n", strerror(errno));
+      return 1;
+   }
+   sessions.add("a", fds_a[0]);
+   sessions.add("b", fds_b[0]);
+
+   // the job list tells which session a job belongs to
+   lList *jobs = create_jobs(1, "a");
+   lList *jobs_b = create_jobs(2, "b");
+   lAddList(jobs, &jobs_b);
+   add_event(&events, sgeE_JOB_LIST, 0, jobs);
+   add_event(&events, sgeE_JOB_FINISH, 1);
+   add_event(&events, sgeE_JATASK_MOD, 2);
+   add_event(&events, sgeE_JOB_FINISH, 2);
+   add_event(&events, sgeE_JOB_FINISH, 3);
+   if (sessions.relay_events(events)) {
+      printf("relay shuts down without sgeE_SHUTDOWN\n");
+      failed++;
+   }
+   lFreeList(&events);
+
+   const u_long32 resync[][2] = {{sgeE_JOB_LIST, 0}};
+   const u_long32 events_a[][2] = {{sgeE_JOB_FINISH, 1}};
+   const u_long32 events_b[][2] = {{sgeE_JATASK_MOD, 2}, {sgeE_JOB_FINISH, 2}};
+   failed += expect_events(fds_a[1], "a", resync, 1);
+   failed += expect_events(fds_a[1], "a", events_a, 1);
+   failed += expect_events(fds_b[1], "b", resync, 1);
+   failed += expect_events(fds_b[1], "b", events_b, 2);
+
+   // new jobs are added, deleted jobs are forgotten
+   add_event(&events, sgeE_JOB_ADD, 4, create_jobs(4, "b"));
+   add_event(&events, sgeE_JOB_DEL, 1);
+   add_event(&events, sgeE_JOB_FINISH, 1);
+   add_event(&events, sgeE_JOB_FINISH, 4);
+   sessions.relay_events(events);
+   lFreeList(&events);
+
+   const u_long32 events_b2[][2] = {{sgeE_JOB_FINISH, 4}};
+   failed += expect_events(fds_b[1], "b", events_b2, 1);
+
+   // a session which went away is removed, the others get the shutdown
+   close(fds_b[1]);
+   add_event(&events, sgeE_SHUTDOWN, 0);
+   if (!sessions.relay_events(events)) {
+      printf("relay does not shut down with sgeE_SHUTDOWN\n");
+      failed++;
+   }
+   lFreeList(&events);
+
+   const u_long32 shutdown[][2] = {{sgeE_SHUTDOWN, 0}};
+   failed += expect_events(fds_a[1], "a", shutdown, 1);
+
+   std::vector<int> fds;
+   sessions.get_sockets(fds);
+   if (fds.size() != 1 || fds[0] != fds_a[0]) {
+      printf("closed session was not removed\n");
+      failed++;
+   }
+
+   sessions.close_all();
+   close(fds_a[1]);
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_drmaa_relay");
+   lInit(nmv);
+
+   // like sge_drmaa_relay: writing to a closed session must not terminate the process
+   signal(SIGPIPE, SIG_IGN);
+
+   failed += test_events();
+   failed += test_register();
+   failed += test_routing();
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
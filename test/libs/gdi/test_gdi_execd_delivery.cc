@@ -0,0 +1,247 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_stdlib.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_host.h"
+
+#include "gdi/ocs_gdi_execd_delivery.h"
+
+// a job with one ja_task granted on one queue, like qmaster sends it to execd
+static lListElem *
+create_job(u_long32 job_id, u_long32 task_id, const char *qname) {
+   lListElem *job = lCreateElem(JB_Type);
+   lListElem *ja_task = lAddSubUlong(job, JAT_task_number, task_id, JB_ja_tasks, JAT_Type);
+   lListElem *gdil_ep = lAddSubStr(ja_task, JG_qname, qname, JAT_granted_destin_identifier_list, JG_Type);
+
+   lSetUlong(job, JB_job_number, job_id);
+   lSetString(job, JB_job_name, "sleeper");
+   lSetHost(gdil_ep, JG_qhostname, "host1");
+
+   return job;
+}
+
+// unpacks all deliveries of a message the way execd does, see do_job_exec(),
+// returns the started job.task ids or an empty vector if the message is broken
+static std::vector<std::string>
+unpack_message(sge_pack_buffer *pb) {
+   std::vector<std::string> started;
+   std::map<std::string, lListElem *> templates;
+   bool ok = true;
+
+   while (ok) {
+      u_long32 feature_set;
+      lListElem *job = nullptr;
+
+      if (unpackint(pb, &feature_set) != PACK_SUCCESS || cull_unpack_elem(pb, &job, nullptr) != PACK_SUCCESS) {
+         ok = false;
+         break;
+      }
+
+      if (job_delivery_is_task(job)) {
+         auto it = templates.find(job_delivery_get_template_key(job));
+         lList *ja_tasks = nullptr;
+
+         if (it == templates.end()) {
+            printf("got a task record of job " sge_u32 " without the job\n", lGetUlong(job, JB_job_number));
+            lFreeElem(&job);
+            ok = false;
+            break;
+         }
+         lXchgList(job, JB_ja_tasks, &ja_tasks);
+         lFreeElem(&job);
+         job = lCopyElem(it->second);
+         lSetList(job, JB_ja_tasks, ja_tasks);
+      } else {
+         std::string key = job_delivery_get_template_key(job);
+
+         if (templates.find(key) == templates.end()) {
+            lList *ja_tasks = nullptr;
+
+            lXchgList(job, JB_ja_tasks, &ja_tasks);
+            templates[key] = lCopyElem(job);
+            lXchgList(job, JB_ja_tasks, &ja_tasks);
+         }
+      }
+
+      // the rebuilt job must be complete
+      const char *name = lGetString(job, JB_job_name);
+      if (name == nullptr || strcmp(name, "sleeper") != 0) {
+         printf("job " sge_u32 " was not rebuilt completely\n", lGetUlong(job, JB_job_number));
+         ok = false;
+      }
+      started.push_back(std::to_string(lGetUlong(job, JB_job_number)) + "." +
+                        std::to_string(lGetUlong(lFirst(lGetList(job, JB_ja_tasks)), JAT_task_number)));
+      lFreeElem(&job);
+
+      if (pb_unused(pb) <= 0) {
+         break;
+      }
+   }
+
+   for (auto &[key, template_job] : templates) {
+      lFreeElem(&template_job);
+   }
+   if (!ok) {
+      started.clear();
+   }
+   return started;
+}
+
+static std::vector<std::string>
+send_and_receive(sge_pack_buffer *pb) {
+   sge_pack_buffer received;
+   std::vector<std::string> started;
+   char *buf = sge_malloc(pb->bytes_used);
+
+   memcpy(buf, pb->head_ptr, pb->bytes_used);
+   if (init_packbuffer_from_buffer(&received, buf, pb->bytes_used) == PACK_SUCCESS) {
+      started = unpack_message(&received);
+      clear_packbuffer(&received);
+   } else {
+      sge_free(&buf);
+   }
+   return started;
+}
+
+static int
+test_batch_supported() {
+   int failed = 0;
+   lListElem *hep = lCreateElem(EH_Type);
+
+   lSetHost(hep, EH_name, "host1");
+   if (job_delivery_is_batch_supported(nullptr)) {
+      printf("batching is supported for an unknown host\n");
+      failed++;
+   }
+   // an execd which did not announce the capability, e.g. an older one, gets one message per job
+   if (job_delivery_is_batch_supported(hep)) {
+      printf("batching is supported for an execd without capabilities\n");
+      failed++;
+   }
+   lSetUlong(hep, EH_capabilities, EH_CAP_JOB_DELIVERY_BATCH);
+   if (!job_delivery_is_batch_supported(hep)) {
+      printf("batching is not supported for an execd having the capability\n");
+      failed++;
+   }
+
+   lFreeElem(&hep);
+   return failed;
+}
+
+static int
+test_single_delivery() {
+   int failed = 0;
+   sge_pack_buffer pb;
+   lListElem *job = create_job(1, 1, "all.q@host1");
+
+   // the message sent to execds without batching capability
+   init_packbuffer(&pb, 0, 0);
+   pack_job_delivery(&pb, job);
+
+   std::vector<std::string> started = send_and_receive(&pb);
+   if (started != std::vector<std::string>{"1.1"}) {
+      printf("single delivery: unexpected jobs started\n");
+      failed++;
+   }
+
+   clear_packbuffer(&pb);
+   lFreeElem(&job);
+   return failed;
+}
+
+static int
+test_batched_delivery() {
+   int failed = 0;
+   sge_pack_buffer pb;
+   std::vector<lListElem *> jobs = {
+      create_job(1, 1, "all.q@host1"),
+      create_job(1, 2, "all.q@host1"),
+      create_job(2, 1, "all.q@host1"),
+      create_job(1, 3, "big.q@host1"),
+      create_job(1, 4, "all.q@host1")
+   };
+   std::map<std::string, bool> known;
+
+   // pack the deliveries like sge_give_jobs.cc:send_job() does while a batch is active
+   init_packbuffer(&pb, 0, 0);
+   for (lListElem *job : jobs) {
+      std::string key = job_delivery_get_template_key(job);
+
+      if (known.count(key) > 0) {
+         pack_job_delivery_task(&pb, job);
+      } else {
+         pack_job_delivery(&pb, job);
+         known[key] = true;
+      }
+   }
+
+   // all tasks are started in the order they were sent,
+   // tasks having a different queue get the complete job again
+   std::vector<std::string> started = send_and_receive(&pb);
+   std::vector<std::string> expected = {"1.1", "1.2", "2.1", "1.3", "1.4"};
+   if (started != expected) {
+      printf("batched delivery: unexpected jobs started:");
+      for (const std::string &id : started) {
+         printf(" %s", id.c_str());
+      }
+      printf("\n");
+      failed++;
+   }
+
+   // job 1 in all.q, job 2 and job 1 in big.q are sent completely, the other tasks as task records
+   if (known.size() != 3) {
+      printf("batched delivery: expected 3 templates, got %zu\n", known.size());
+      failed++;
+   }
+
+   clear_packbuffer(&pb);
+   for (lListElem *job : jobs) {
+      lFreeElem(&job);
+   }
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_gdi_execd_delivery");
+   lInit(nmv);
+
+   failed += test_batch_supported();
+   failed += test_single_delivery();
+   failed += test_batched_delivery();
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
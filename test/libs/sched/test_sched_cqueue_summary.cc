@@ -0,0 +1,249 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_centry.h"
+#include "sgeobj/sge_host.h"
+#include "sgeobj/sge_qinstance_state.h"
+
+#include "load_correction.h"
+#include "sge_cqueue_summary.h"
+#include "sge_select_queue.h"
+
+static lListElem *
+add_qinstance(lListElem *cqueue, const char *host, u_long32 slots, double used) {
+   lListElem *qinstance = lAddSubHost(cqueue, QU_qhostname, host, CQ_qinstances, QU_Type);
+   lListElem *rue = lAddSubStr(qinstance, RUE_name, "slots", QU_resource_utilization, RUE_Type);
+
+   lSetString(qinstance, QU_qname, lGetString(cqueue, CQ_name));
+   lSetUlong(qinstance, QU_job_slots, slots);
+   lSetString(qinstance, QU_suspend_interval, "00:05:00");
+   lSetDouble(rue, RUE_utilized_now, used);
+   return qinstance;
+}
+
+static int
+check(const lListElem *summary, int nm, u_long32 expected) {
+   if (lGetUlong(summary, nm) != expected) {
+      printf("%s: %s is " sge_u32 ", expected " sge_u32 "\n", lGetString(summary, CQS_name), lNm2Str(nm),
+             lGetUlong(summary, nm), expected);
+      return 1;
+   }
+   return 0;
+}
+
+static lListElem *
+add_host(lList **exechost_list, const char *name, const char *np_load_avg, double scaling) {
+   lListElem *host = lAddElemHost(exechost_list, EH_name, name, EH_Type);
+
+   lSetString(lAddSubStr(host, HL_name, LOAD_ATTR_NP_LOAD_AVG, EH_load_list, HL_Type), HL_value, np_load_avg);
+   if (scaling != 1.0) {
+      lSetDouble(lAddSubStr(host, HS_name, LOAD_ATTR_NP_LOAD_AVG, EH_scaling_list, HS_Type), HS_value, scaling);
+   }
+   return host;
+}
+
+/*
+ * With load_scaling the load thresholds are compared with the scaled load values. sge_qmaster does this
+ * without modifying its host list, the client side calculation after correct_capacities().
+ */
+static int
+test_load_scaling() {
+   lList *cqueue_list = nullptr;
+   lList *exechost_list = nullptr;
+   lList *centry_list = nullptr;
+   int failed = 0;
+
+   lListElem *centry = lAddElemStr(&centry_list, CE_name, LOAD_ATTR_NP_LOAD_AVG, CE_Type);
+   lSetString(centry, CE_shortcut, "nla");
+   lSetUlong(centry, CE_valtype, TYPE_DOUBLE);
+   lSetUlong(centry, CE_relop, CMPLXGE_OP);
+   lSetUlong(centry, CE_consumable, CONSUMABLE_NO);
+
+   // both hosts report 0.6, only the scaled one exceeds the threshold of 1.0
+   add_host(&exechost_list, "scaled", "0.6", 2.0);
+   add_host(&exechost_list, "unscaled", "0.6", 1.0);
+   for (const char *host : {"scaled", "unscaled"}) {
+      lListElem *cqueue = lAddElemStr(&cqueue_list, CQ_name, (std::string(host) + ".q").c_str(), CQ_Type);
+      lListElem *qinstance = add_qinstance(cqueue, host, 4, 0);
+
+      lSetString(lAddSubStr(qinstance, CE_name, LOAD_ATTR_NP_LOAD_AVG, QU_load_thresholds, CE_Type),
+                 CE_stringval, "1.0");
+   }
+
+   lList *summary_list = cqueue_list_calculate_summary(cqueue_list, exechost_list, centry_list);
+   const lListElem *summary = lGetElemStr(summary_list, CQS_name, "scaled.q");
+   if (summary == nullptr) {
+      printf("no summary for scaled.q\n");
+      failed++;
+   } else {
+      failed += check(summary, CQS_load_alarm, 4);
+      failed += check(summary, CQS_temp_disabled, 4);
+      failed += check(summary, CQS_available, 0);
+      if (lGetDouble(summary, CQS_load) < 1.19 || lGetDouble(summary, CQS_load) > 1.21) {
+         printf("scaled.q: load is %f, expected 1.2\n", lGetDouble(summary, CQS_load));
+         failed++;
+      }
+   }
+   summary = lGetElemStr(summary_list, CQS_name, "unscaled.q");
+   if (summary == nullptr) {
+      printf("no summary for unscaled.q\n");
+      failed++;
+   } else {
+      failed += check(summary, CQS_load_alarm, 0);
+      failed += check(summary, CQS_available, 4);
+   }
+
+   // the master host list is not modified
+   const lListElem *load = lGetSubStr(host_list_locate(exechost_list, "scaled"), HL_name, LOAD_ATTR_NP_LOAD_AVG,
+                                      EH_load_list);
+   if (strcmp(lGetString(load, HL_value), "0.6") != 0) {
+      printf("load value of the host list was changed to %s\n", lGetString(load, HL_value));
+      failed++;
+   }
+
+   // client side: scale the copied hosts, then set the alarm states like select_by_queue_state()
+   lList *client_exechost_list = lCopyList("client hosts", exechost_list);
+   lList *client_cqueue_list = lCopyList("client queues", cqueue_list);
+   correct_capacities(client_exechost_list, centry_list);
+   const lListElem *cqueue;
+   for_each_ep(cqueue, client_cqueue_list) {
+      lListElem *qinstance;
+
+      for_each_rw(qinstance, lGetList(cqueue, CQ_qinstances)) {
+         if (sge_load_alarm(nullptr, 0, qinstance, lGetList(qinstance, QU_load_thresholds), client_exechost_list,
+                            centry_list, nullptr, true)) {
+            qinstance_state_set_alarm(qinstance, true);
+         }
+      }
+
+      double client_load;
+      bool is_load_available;
+      u_long32 used, resv, total, suspend_manual, suspend_threshold, suspend_on_subordinate, suspend_calendar;
+      u_long32 unknown, load_alarm, disabled_manual, disabled_calendar, ambiguous, orphaned, error;
+      u_long32 available, temp_disabled, manual_intervention;
+      cqueue_calculate_summary(cqueue, client_exechost_list, centry_list, &client_load, &is_load_available, &used,
+                               &resv, &total, &suspend_manual, &suspend_threshold, &suspend_on_subordinate,
+                               &suspend_calendar, &unknown, &load_alarm, &disabled_manual, &disabled_calendar,
+                               &ambiguous, &orphaned, &error, &available, &temp_disabled, &manual_intervention);
+      summary = lGetElemStr(summary_list, CQS_name, lGetString(cqueue, CQ_name));
+      if (summary == nullptr || load_alarm != lGetUlong(summary, CQS_load_alarm) ||
+          available != lGetUlong(summary, CQS_available) ||
+          temp_disabled != lGetUlong(summary, CQS_temp_disabled) ||
+          client_load != lGetDouble(summary, CQS_load)) {
+         printf("%s: client side summary with load scaling differs\n", lGetString(cqueue, CQ_name));
+         failed++;
+      }
+   }
+
+   lFreeList(&client_cqueue_list);
+   lFreeList(&client_exechost_list);
+   lFreeList(&summary_list);
+   lFreeList(&cqueue_list);
+   lFreeList(&exechost_list);
+   lFreeList(&centry_list);
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   lList *cqueue_list = nullptr;
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sched_cqueue_summary");
+   lInit(nmv);
+
+   lListElem *all = lAddElemStr(&cqueue_list, CQ_name, "all.q", CQ_Type);
+   add_qinstance(all, "normal", 4, 2);
+   qinstance_state_set_manual_disabled(add_qinstance(all, "disabled", 2, 0), true);
+   qinstance_state_set_cal_suspended(add_qinstance(all, "calendar", 8, 0), true);
+   lListElem *broken = add_qinstance(all, "broken", 1, 0);
+   qinstance_state_set_unknown(broken, true);
+   qinstance_state_set_error(broken, true);
+   lAddElemStr(&cqueue_list, CQ_name, "empty.q", CQ_Type);
+
+   lList *summary_list = cqueue_list_calculate_summary(cqueue_list, nullptr, nullptr);
+   if (lGetNumberOfElem(summary_list) != 2) {
+      printf("summary has %d rows, expected 2\n", lGetNumberOfElem(summary_list));
+      failed++;
+   }
+
+   const lListElem *summary = lGetElemStr(summary_list, CQS_name, "all.q");
+   if (summary == nullptr) {
+      printf("no summary for all.q\n");
+      failed++;
+   } else {
+      failed += check(summary, CQS_used, 2);
+      failed += check(summary, CQS_resv, 0);
+      failed += check(summary, CQS_total, 15);
+      failed += check(summary, CQS_available, 2);
+      failed += check(summary, CQS_temp_disabled, 8);
+      failed += check(summary, CQS_manual_intervention, 3);
+      failed += check(summary, CQS_disabled_manual, 2);
+      failed += check(summary, CQS_suspend_calendar, 8);
+      failed += check(summary, CQS_unknown, 1);
+      failed += check(summary, CQS_error, 1);
+      failed += check(summary, CQS_load_alarm, 0);
+      failed += check(summary, CQS_suspend_manual, 0);
+      if (lGetBool(summary, CQS_is_load_available)) {
+         printf("all.q: load is available without hosts\n");
+         failed++;
+      }
+
+      // the client side calculation returns the same values
+      double load;
+      bool is_load_available;
+      u_long32 used, resv, total, suspend_manual, suspend_threshold, suspend_on_subordinate, suspend_calendar;
+      u_long32 unknown, load_alarm, disabled_manual, disabled_calendar, ambiguous, orphaned, error;
+      u_long32 available, temp_disabled, manual_intervention;
+      cqueue_calculate_summary(all, nullptr, nullptr, &load, &is_load_available, &used, &resv, &total,
+                               &suspend_manual, &suspend_threshold, &suspend_on_subordinate, &suspend_calendar,
+                               &unknown, &load_alarm, &disabled_manual, &disabled_calendar, &ambiguous, &orphaned,
+                               &error, &available, &temp_disabled, &manual_intervention);
+      if (used != 2 || total != 15 || available != 2 || temp_disabled != 8 || manual_intervention != 3) {
+         printf("client side summary differs\n");
+         failed++;
+      }
+   }
+
+   summary = lGetElemStr(summary_list, CQS_name, "empty.q");
+   if (summary == nullptr) {
+      printf("no summary for empty.q\n");
+      failed++;
+   } else {
+      failed += check(summary, CQS_total, 0);
+      failed += check(summary, CQS_available, 0);
+   }
+
+   lFreeList(&summary_list);
+   lFreeList(&cqueue_list);
+
+   failed += test_load_scaling();
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
@@ -0,0 +1,145 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <vector>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/sge_centry.h"
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#include "ocs_ResourceMatrix.h"
+
+static void
+add_centry(lList **centry_list, const char *name, u_long32 valtype, u_long32 relop, u_long32 consumable)
+{
+   lListElem *ep = lAddElemStr(centry_list, CE_name, name, CE_Type);
+   lSetUlong(ep, CE_valtype, valtype);
+   lSetUlong(ep, CE_relop, relop);
+   lSetUlong(ep, CE_consumable, consumable);
+}
+
+static lListElem *
+add_host(lList **host_list, const char *name, const char *consumable, double capacity, bool utilization)
+{
+   lListElem *hep = lAddElemHost(host_list, EH_name, name, EH_Type);
+
+   if (consumable != nullptr) {
+      lListElem *cep = lAddSubStr(hep, CE_name, consumable, EH_consumable_config_list, CE_Type);
+      lSetDouble(cep, CE_doubleval, capacity);
+      if (utilization) {
+         lAddSubStr(hep, RUE_name, consumable, EH_resource_utilization, RUE_Type);
+      }
+   }
+   return hep;
+}
+
+static void
+add_request(lList **request_list, const char *name, const char *value)
+{
+   lListElem *ep = lAddElemStr(request_list, CE_name, name, CE_Type);
+   lSetString(ep, CE_stringval, value);
+}
+
+int main(int argc, char *argv[])
+{
+   lList *centry_list = nullptr;
+   lList *host_list = nullptr;
+   lList *request_list = nullptr;
+   std::vector<unsigned char> rejected;
+   ocs::ResourceMatrix matrix;
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sched_resource_matrix");
+
+   lInit(nmv);
+
+   add_centry(&centry_list, "mem", TYPE_MEM, CMPLXLE_OP, CONSUMABLE_YES);
+   add_centry(&centry_list, "gpu", TYPE_INT, CMPLXLE_OP, CONSUMABLE_JOB);
+   add_centry(&centry_list, "lic", TYPE_INT, CMPLXEXCL_OP, CONSUMABLE_YES);
+   add_centry(&centry_list, "arch", TYPE_STR, CMPLXEQ_OP, CONSUMABLE_NO);
+
+   const lListElem *small = add_host(&host_list, "small", "mem", 1024 * 1024 * 1024, true);
+   const lListElem *big = add_host(&host_list, "big", "mem", 64.0 * 1024 * 1024 * 1024, true);
+   const lListElem *gpu = add_host(&host_list, "gpu", "gpu", 2, true);
+   const lListElem *unused = add_host(&host_list, "unused", "gpu", 0, false);
+   const lListElem *excl = add_host(&host_list, "excl", "lic", 0, true);
+   const lListElem *plain = add_host(&host_list, "plain", nullptr, 0, false);
+
+   matrix.build(host_list, centry_list);
+   if (matrix.num_hosts() != 6 || matrix.num_columns() != 2) {
+      printf("matrix has %zu hosts and %zu columns, expected 6 and 2\n", matrix.num_hosts(), matrix.num_columns());
+      failed++;
+   }
+
+   // requests to attributes without column cannot reject hosts
+   add_request(&request_list, "arch", "lx-amd64");
+   add_request(&request_list, "lic", "true");
+   if (matrix.reject_hosts(request_list, centry_list, 1, rejected)) {
+      printf("requests without column were checked\n");
+      failed++;
+   }
+
+   // memory request exceeding the small host, hosts not limiting mem are never rejected
+   add_request(&request_list, "mem", "2G");
+   if (!matrix.reject_hosts(request_list, centry_list, 1, rejected)) {
+      printf("mem request was not checked\n");
+      failed++;
+   }
+   if (!matrix.is_rejected(rejected, small) || matrix.is_rejected(rejected, big) ||
+       matrix.is_rejected(rejected, gpu) || matrix.is_rejected(rejected, excl) ||
+       matrix.is_rejected(rejected, plain)) {
+      printf("wrong hosts rejected for mem=2G\n");
+      failed++;
+   }
+
+   // the amount is multiplied with the slots
+   if (!matrix.reject_hosts(request_list, centry_list, 64, rejected) || !matrix.is_rejected(rejected, big)) {
+      printf("big host not rejected for 64 slots of mem=2G\n");
+      failed++;
+   }
+
+   // without utilization entry the capacity is not checked on host level
+   lFreeList(&request_list);
+   add_request(&request_list, "gpu", "3");
+   matrix.reject_hosts(request_list, centry_list, 1, rejected);
+   if (!matrix.is_rejected(rejected, gpu) || matrix.is_rejected(rejected, unused) ||
+       matrix.is_rejected(rejected, small)) {
+      printf("wrong hosts rejected for gpu=3\n");
+      failed++;
+   }
+
+   // hosts unknown to the matrix are never rejected
+   lListElem *other = lCreateElem(EH_Type);
+   if (matrix.is_rejected(rejected, other)) {
+      printf("unknown host rejected\n");
+      failed++;
+   }
+   lFreeElem(&other);
+
+   lFreeList(&request_list);
+   lFreeList(&host_list);
+   lFreeList(&centry_list);
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
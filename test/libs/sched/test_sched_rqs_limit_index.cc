@@ -0,0 +1,143 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstring>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_dstring.h"
+
+#include "sgeobj/sge_resource_quota.h"
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#include "ocs_RqsLimitIndex.h"
+
+static lListElem *
+create_rule(bool expand_users, bool expand_queues, bool expand_hosts)
+{
+   lListElem *rule = lCreateElem(RQR_Type);
+   lListElem *filter;
+
+   filter = lCreateElem(RQRF_Type);
+   lSetBool(filter, RQRF_expand, expand_users);
+   lSetObject(rule, RQR_filter_users, filter);
+
+   filter = lCreateElem(RQRF_Type);
+   lSetBool(filter, RQRF_expand, expand_queues);
+   lSetObject(rule, RQR_filter_queues, filter);
+
+   filter = lCreateElem(RQRF_Type);
+   lSetBool(filter, RQRF_expand, expand_hosts);
+   lSetObject(rule, RQR_filter_hosts, filter);
+
+   return rule;
+}
+
+/* keys have to be equal exactly when the rue strings are equal */
+static int
+test_rule(ocs::RqsLimitIndex &index, const lListElem *rule)
+{
+   const char *users[] = {"user1", "user2"};
+   const char *queues[] = {"all.q", "big.q"};
+   const char *hosts[] = {"host1", "host2"};
+   dstring rue1 = DSTRING_INIT;
+   dstring rue2 = DSTRING_INIT;
+   int failed = 0;
+
+   for (int i = 0; i < 8; i++) {
+      for (int j = 0; j < 8; j++) {
+         rqs_get_rue_string(&rue1, rule, users[i & 1], "project", hosts[(i >> 2) & 1], queues[(i >> 1) & 1], nullptr);
+         rqs_get_rue_string(&rue2, rule, users[j & 1], "project", hosts[(j >> 2) & 1], queues[(j >> 1) & 1], nullptr);
+         ocs::RqsLimitIndex::Key key1 = index.make_key(rule, users[i & 1], "project", hosts[(i >> 2) & 1], queues[(i >> 1) & 1], nullptr);
+         ocs::RqsLimitIndex::Key key2 = index.make_key(rule, users[j & 1], "project", hosts[(j >> 2) & 1], queues[(j >> 1) & 1], nullptr);
+
+         bool same_string = strcmp(sge_dstring_get_string(&rue1), sge_dstring_get_string(&rue2)) == 0;
+         if (same_string != (key1 == key2)) {
+            printf("key mismatch for %s and %s\n", sge_dstring_get_string(&rue1), sge_dstring_get_string(&rue2));
+            failed++;
+         }
+      }
+   }
+
+   sge_dstring_free(&rue1);
+   sge_dstring_free(&rue2);
+   return failed;
+}
+
+static int
+test_find(ocs::RqsLimitIndex &index, const lListElem *rule1, const lListElem *rule2)
+{
+   lList *limit_list = nullptr;
+   lListElem *rql;
+   int failed = 0;
+
+   ocs::RqsLimitIndex::Key key = index.make_key(rule1, "user1", "project", "host1", "all.q", nullptr);
+   if (index.find(key) != nullptr) {
+      printf("found limit in empty index\n");
+      failed++;
+   }
+
+   rql = lAddElemStr(&limit_list, RQL_name, "rqs/1=user1//all.q/host1/", RQL_Type);
+   index.add(key, rql);
+   if (index.find(index.make_key(rule1, "user1", "project", "host1", "all.q", nullptr)) != rql) {
+      printf("did not find registered limit\n");
+      failed++;
+   }
+   if (index.find(index.make_key(rule2, "user1", "project", "host1", "all.q", nullptr)) != nullptr) {
+      printf("found limit of another rule\n");
+      failed++;
+   }
+
+   lFreeList(&limit_list);
+   return failed;
+}
+
+int main(int argc, char *argv[])
+{
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sched_rqs_limit_index");
+
+   lInit(nmv);
+
+   {
+      ocs::RqsLimitIndex index;
+      lListElem *rules[] = {
+         create_rule(false, false, false),
+         create_rule(true, false, false),
+         create_rule(true, true, false),
+         create_rule(false, true, true),
+         create_rule(true, true, true)
+      };
+
+      for (lListElem *rule : rules) {
+         failed += test_rule(index, rule);
+      }
+      failed += test_find(index, rules[4], rules[3]);
+
+      for (lListElem *rule : rules) {
+         lFreeElem(&rule);
+      }
+   }
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
@@ -0,0 +1,108 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <climits>
+#include <cstdio>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "sge_pe_schedd.h"
+
+#include "ocs_SlotCapacityIndex.h"
+
+static int
+check(const ocs::SlotCapacityIndex &capacity, int slots, int allocation_rule, bool expected)
+{
+   if (capacity.is_possible(slots, allocation_rule) != expected) {
+      printf("%d slots with allocation rule %d: expected %s\n", slots, allocation_rule,
+             expected ? "possible" : "impossible");
+      return 1;
+   }
+   return 0;
+}
+
+int main(int argc, char *argv[])
+{
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sched_slot_capacity_index");
+
+   {
+      ocs::SlotCapacityIndex capacity;
+
+      // 4 hosts offering 16, 8, 8 and 0 slots, negative values are stored as 0
+      capacity.add_host(8);
+      capacity.add_host(16);
+      capacity.add_host(-2);
+      capacity.add_host(8);
+      capacity.finish();
+
+      if (capacity.num_hosts() != 4 || capacity.total_slots() != 32) {
+         printf("expected 4 hosts with 32 slots, got %zu hosts with %lld slots\n", capacity.num_hosts(),
+                capacity.total_slots());
+         failed++;
+      }
+      if (capacity.hosts_offering(1) != 3 || capacity.hosts_offering(8) != 3 ||
+          capacity.hosts_offering(9) != 1 || capacity.hosts_offering(17) != 0) {
+         printf("wrong number of hosts offering slots\n");
+         failed++;
+      }
+
+      // $fill_up and $round_robin can use all slots
+      failed += check(capacity, 32, ALLOC_RULE_FILLUP, true);
+      failed += check(capacity, 33, ALLOC_RULE_FILLUP, false);
+      failed += check(capacity, 32, ALLOC_RULE_ROUNDROBIN, true);
+      failed += check(capacity, 4096, ALLOC_RULE_ROUNDROBIN, false);
+
+      // $pe_slots needs all slots on one host
+      failed += check(capacity, 16, 16, true);
+      failed += check(capacity, 17, 17, false);
+
+      // a fixed allocation rule of 8 slots per host
+      failed += check(capacity, 24, 8, true);
+      failed += check(capacity, 32, 8, false);
+
+      // a slot count the allocation rule cannot be applied to is left to the assignment
+      failed += check(capacity, 4096, 0, true);
+   }
+
+   {
+      ocs::SlotCapacityIndex capacity;
+
+      // no hosts
+      capacity.finish();
+      failed += check(capacity, 1, ALLOC_RULE_FILLUP, false);
+      failed += check(capacity, 1, 1, false);
+
+      // unlimited hosts do not overflow
+      capacity.add_host(INT_MAX);
+      capacity.add_host(static_cast<long long>(INT_MAX) * 4);
+      capacity.finish();
+      if (capacity.total_slots() != static_cast<long long>(INT_MAX) * 2) {
+         printf("unlimited hosts were not limited to INT_MAX\n");
+         failed++;
+      }
+      failed += check(capacity, INT_MAX, ALLOC_RULE_FILLUP, true);
+   }
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
@@ -0,0 +1,225 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_time.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_job.h"
+#include "sgeobj/sge_schedd_conf.h"
+#include "sgeobj/sge_sharetree.h"
+#include "sgeobj/sge_userset.h"
+
+#include "sge_orders.h"
+#include "sgeee.h"
+
+#define USERS 50
+#define PROJECTS 5
+#define JOBS 4000
+
+static bool
+set_config(u_long32 ticket_threads) {
+   lList *config_list = lCreateList("config_list", SC_Type);
+   lListElem *config = sconf_create_default();
+   lList *answer_list = nullptr;
+   char params[64];
+
+   snprintf(params, sizeof(params), "TICKET_THREADS=" sge_u32, ticket_threads);
+   lSetString(config, SC_params, params);
+   lSetUlong(config, SC_weight_tickets_functional, 100000);
+   lSetUlong(config, SC_weight_tickets_share, 100000);
+   lSetDouble(config, SC_weight_user, 0.25);
+   lSetDouble(config, SC_weight_project, 0.25);
+   lSetDouble(config, SC_weight_department, 0.25);
+   lSetDouble(config, SC_weight_job, 0.25);
+   lSetBool(config, SC_share_override_tickets, true);
+   lSetBool(config, SC_share_functional_shares, true);
+   lAppendElem(config_list, config);
+
+   bool ret = sconf_set_config(&config_list, &answer_list);
+   if (!ret || sconf_get_ticket_threads() != ticket_threads) {
+      printf("setting the scheduler configuration failed\n");
+      answer_list_output(&answer_list);
+      ret = false;
+   }
+   lFreeList(&config_list);
+   lFreeList(&answer_list);
+   return ret;
+}
+
+static void
+create_lists(scheduler_all_data_t *lists) {
+   char name[64];
+   lList *user_nodes = nullptr;
+
+   for (int i = 0; i < USERS; i++) {
+      snprintf(name, sizeof(name), "user%d", i);
+      lListElem *user = lAddElemStr(&lists->user_list, UU_name, name, UU_Type);
+      lSetUlong(user, UU_fshare, 100 + 10 * i);
+      lSetUlong(user, UU_oticket, i % 3 == 0 ? 1000 : 0);
+
+      lListElem *node = lAddElemStr(&user_nodes, STN_name, name, STN_Type);
+      lSetUlong(node, STN_shares, 10 + i);
+   }
+   for (int i = 0; i < PROJECTS; i++) {
+      snprintf(name, sizeof(name), "project%d", i);
+      lListElem *project = lAddElemStr(&lists->project_list, PR_name, name, PR_Type);
+      lSetUlong(project, PR_fshare, 100 * (i + 1));
+      lSetUlong(project, PR_oticket, 500);
+   }
+   lListElem *dept = lAddElemStr(&lists->dept_list, US_name, "defaultdepartment", US_Type);
+   lSetUlong(dept, US_type, US_DEPT);
+   lSetUlong(dept, US_fshare, 1000);
+
+   lListElem *root = lAddElemStr(&lists->share_tree, STN_name, "Root", STN_Type);
+   lSetUlong(root, STN_type, STT_USER);
+   lSetUlong(root, STN_shares, 1);
+   lSetList(root, STN_children, user_nodes);
+}
+
+static lList *
+create_running_jobs() {
+   lList *job_list = nullptr;
+   u_long64 now = sge_get_gmt64();
+
+   for (u_long32 job_id = 1; job_id <= JOBS; job_id++) {
+      char name[64];
+      lListElem *job = lAddElemUlong(&job_list, JB_job_number, job_id, JB_Type);
+
+      snprintf(name, sizeof(name), "user%d", (int)(job_id % USERS));
+      lSetString(job, JB_owner, name);
+      // jobs with a project do not get share tree tickets from the user share tree
+      if (job_id % 2 == 0) {
+         snprintf(name, sizeof(name), "project%d", (int)(job_id % PROJECTS));
+         lSetString(job, JB_project, name);
+      }
+      lSetString(job, JB_department, "defaultdepartment");
+      lSetUlong(job, JB_jobshare, job_id % 7);
+      lSetUlong(job, JB_override_tickets, job_id % 11 == 0 ? 100 : 0);
+      lSetUlong(job, JB_priority, BASE_PRIORITY);
+      lSetUlong64(job, JB_submission_time, now - 60 * 1000000);
+
+      lListElem *ja_task = lAddSubUlong(job, JAT_task_number, 1, JB_ja_tasks, JAT_Type);
+      lSetUlong(ja_task, JAT_status, JRUNNING);
+      lSetUlong(ja_task, JAT_state, JRUNNING);
+      lSetUlong64(ja_task, JAT_start_time, now - 30 * 1000000);
+   }
+   return job_list;
+}
+
+static void
+free_lists(scheduler_all_data_t *lists) {
+   lFreeList(&lists->user_list);
+   lFreeList(&lists->project_list);
+   lFreeList(&lists->dept_list);
+   lFreeList(&lists->share_tree);
+}
+
+/* tickets of all running jobs calculated with the given number of threads */
+static lList *
+calculate_tickets(u_long32 ticket_threads) {
+   scheduler_all_data_t lists{};
+   order_t orders = ORDER_INIT;
+   lList *pending_jobs = lCreateList("pending", JB_Type);
+   lList *running_jobs = create_running_jobs();
+
+   if (!set_config(ticket_threads)) {
+      lFreeList(&running_jobs);
+   } else {
+      create_lists(&lists);
+      sgeee_scheduler(&lists, running_jobs, nullptr, pending_jobs, &orders);
+      free_lists(&lists);
+   }
+
+   lFreeList(&orders.configOrderList);
+   lFreeList(&orders.pendingOrderList);
+   lFreeList(&orders.jobStartOrderList);
+   lFreeList(&orders.sentOrderList);
+   lFreeList(&pending_jobs);
+   return running_jobs;
+}
+
+static bool
+equal(double a, double b) {
+   return fabs(a - b) <= 1e-9 * MAX(1.0, MAX(fabs(a), fabs(b)));
+}
+
+int
+main(int argc, char *argv[]) {
+   bool ret = true;
+   static const int attr[] = {JAT_tix, JAT_fticket, JAT_sticket, JAT_oticket, JAT_prio, NoName};
+
+   DENTER_MAIN(TOP_LAYER, "test_sched_ticket_threads");
+
+   lInit(nmv);
+
+   // the serial calculation is the reference for the threaded one
+   lList *serial = calculate_tickets(1);
+   lList *parallel = calculate_tickets(4);
+
+   if (serial == nullptr || parallel == nullptr || lGetNumberOfElem(serial) != lGetNumberOfElem(parallel)) {
+      printf("ticket calculation failed\n");
+      ret = false;
+   } else {
+      const lListElem *serial_job = lFirst(serial);
+      const lListElem *parallel_job = lFirst(parallel);
+      double sum = 0.0;
+      double share_sum = 0.0;
+
+      while (serial_job != nullptr && parallel_job != nullptr) {
+         const lListElem *serial_task = lFirst(lGetList(serial_job, JB_ja_tasks));
+         const lListElem *parallel_task = lFirst(lGetList(parallel_job, JB_ja_tasks));
+
+         for (int i = 0; attr[i] != NoName; i++) {
+            double expected = lGetDouble(serial_task, attr[i]);
+            double value = lGetDouble(parallel_task, attr[i]);
+
+            if (!equal(expected, value)) {
+               printf("job " sge_u32 ": %s is %f, expected %f\n", lGetUlong(serial_job, JB_job_number),
+                      lNm2Str(attr[i]), value, expected);
+               ret = false;
+            }
+         }
+         sum += lGetDouble(serial_task, JAT_tix);
+         share_sum += lGetDouble(serial_task, JAT_sticket);
+         serial_job = lNext(serial_job);
+         parallel_job = lNext(parallel_job);
+      }
+
+      // make sure that tickets have been calculated at all, including the share tree pass
+      if (sum <= 0.0 || share_sum <= 0.0) {
+         printf("no tickets have been calculated\n");
+         ret = false;
+      }
+   }
+
+   lFreeList(&serial);
+   lFreeList(&parallel);
+
+   DRETURN(ret ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,271 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "uti/sge_binding_parse.h"
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/ocs_TopologyMask.h"
+#include "sgeobj/sge_grantedres.h"
+#include "sgeobj/sge_host.h"
+#include "sgeobj/sge_job.h"
+#include "sgeobj/cull/sge_all_listsL.h"
+
+static lListElem *
+create_binding(const char *strategy, u_long32 amount, u_long32 step, u_long32 socket, u_long32 core,
+               const char *explicit_request) {
+   lListElem *binding = lCreateElem(BN_Type);
+
+   lSetString(binding, BN_strategy, strategy);
+   lSetUlong(binding, BN_type, BINDING_TYPE_SET);
+   lSetUlong(binding, BN_parameter_n, amount);
+   lSetUlong(binding, BN_parameter_striding_step_size, step);
+   lSetUlong(binding, BN_parameter_socket_offset, socket);
+   lSetUlong(binding, BN_parameter_core_offset, core);
+   lSetString(binding, BN_parameter_explicit, explicit_request);
+
+   return binding;
+}
+
+static std::string
+ids_to_string(const ocs::TopologyMask &mask, const ocs::TopologyMask::CoreList &cores) {
+   std::vector<std::string> ids;
+   std::string str;
+
+   mask.get_ids(ids, cores);
+   for (const std::string &id : ids) {
+      if (!str.empty()) {
+         str += ":";
+      }
+      str += id;
+   }
+   return str;
+}
+
+static int
+check_select(const char *topology, lListElem *binding, const char *expected) {
+   ocs::TopologyMask mask;
+   ocs::TopologyMask::CoreList cores;
+   int failed = 0;
+
+   if (!mask.parse(topology)) {
+      printf("failed parsing topology %s\n", topology);
+      failed++;
+   } else {
+      bool possible = mask.select(binding, cores);
+      std::string selected = possible ? ids_to_string(mask, cores) : "NONE";
+
+      if (selected != expected) {
+         printf("%s on %s: expected %s, got %s\n", lGetString(binding, BN_strategy), topology, expected,
+                selected.c_str());
+         failed++;
+      }
+   }
+
+   lFreeElem(&binding);
+   return failed;
+}
+
+static int
+test_parse() {
+   ocs::TopologyMask mask;
+   int failed = 0;
+
+   if (mask.parse("NONE") || mask.parse("") || mask.parse("CS") || mask.parse("STC")) {
+      printf("parsed invalid topology\n");
+      failed++;
+   }
+
+   if (!mask.parse("SCTTcttSCCcc")) {
+      printf("failed parsing topology\n");
+      failed++;
+   } else if (mask.get_sockets() != 2 || mask.get_cores() != 6 || mask.get_free_cores() != 3 ||
+              mask.get_free_cores(0) != 1 || mask.get_free_cores(1) != 2) {
+      printf("wrong core counts: %zu sockets, %zu cores, %zu free\n", mask.get_sockets(), mask.get_cores(),
+             mask.get_free_cores());
+      failed++;
+   }
+
+   // a used thread makes the core used
+   if (!mask.parse("SCTtCTT") || !mask.is_used(0) || mask.is_used(1)) {
+      printf("thread usage not detected\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+static int
+test_select() {
+   int failed = 0;
+
+   // free sockets are filled first
+   failed += check_select("SCcCCSCCCC", create_binding("linear_automatic", 3, 0, 0, 0, nullptr), "1,0:1,1:1,2");
+   // then the socket with the most free cores
+   failed += check_select("SCcCCSCCCC", create_binding("linear_automatic", 6, 0, 0, 0, nullptr),
+                          "1,0:1,1:1,2:1,3:0,0:0,2");
+   failed += check_select("SCcCCSCCCC", create_binding("linear_automatic", 8, 0, 0, 0, nullptr), "NONE");
+   failed += check_select("SCCSCC", create_binding("linear", 2, 0, 0, 1, nullptr), "0,1:1,0");
+   failed += check_select("SCcCCSCCCC", create_binding("linear", 2, 0, 0, 0, nullptr), "0,2:0,3");
+   failed += check_select("SCCCCSCCCC", create_binding("striding_automatic", 2, 4, 0, 0, nullptr), "0,0:1,0");
+   failed += check_select("ScCCCSCCCC", create_binding("striding_automatic", 2, 4, 0, 0, nullptr), "0,1:1,1");
+   failed += check_select("SCCCCSCCCC", create_binding("striding", 2, 2, 1, 0, nullptr), "1,0:1,2");
+   failed += check_select("SCCCCSCCCC", create_binding("striding", 2, 2, 2, 0, nullptr), "NONE");
+   failed += check_select("SCCCCSCCCC", create_binding("explicit", 0, 0, 0, 0, "explicit:0,3:1,1"), "0,3:1,1");
+   failed += check_select("SCCCcSCCCC", create_binding("explicit", 0, 0, 0, 0, "explicit:0,3:1,1"), "NONE");
+   failed += check_select("SCCCCSCCCC", create_binding("explicit", 0, 0, 0, 0, "explicit:0,4"), "NONE");
+   failed += check_select("SCCCCSCCCC", create_binding("no_job_binding", 0, 0, 0, 0, nullptr), "NONE");
+
+   return failed;
+}
+
+static int
+test_book() {
+   ocs::TopologyMask mask;
+   ocs::TopologyMask::CoreList cores;
+   std::vector<std::string> ids{"0,1", "1,0"};
+   int failed = 0;
+
+   mask.parse("SCTTCTTSCTTCTT");
+   if (!mask.parse_ids(ids, cores) || !mask.is_free(cores)) {
+      printf("cores are not free\n");
+      failed++;
+   }
+
+   mask.book(cores, true);
+   if (mask.get_topology() != "SCTTcttScttCTT" || mask.is_free(cores)) {
+      printf("wrong topology after booking: %s\n", mask.get_topology().c_str());
+      failed++;
+   }
+
+   // booking the remaining core of socket 1 shows the socket as used
+   ocs::TopologyMask::CoreList last{3};
+   mask.book(last, true);
+   if (mask.get_topology() != "SCTTcttscttctt") {
+      printf("wrong topology after booking socket: %s\n", mask.get_topology().c_str());
+      failed++;
+   }
+
+   if (mask.book(last, true)) {
+      printf("booking used cores changed the mask\n");
+      failed++;
+   }
+
+   mask.book(cores, false);
+   mask.book(last, false);
+   if (mask.get_topology() != "SCTTCTTSCTTCTT" || mask.get_free_cores() != 4) {
+      printf("wrong topology after unbooking: %s\n", mask.get_topology().c_str());
+      failed++;
+   }
+
+   ids.emplace_back("2,0");
+   cores.clear();
+   if (mask.parse_ids(ids, cores)) {
+      printf("parsed id of not existing socket\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+static int
+test_host_binding() {
+   lListElem *job = lCreateElem(JB_Type);
+   lList *binding_list = lCreateList("", BN_Type);
+   lListElem *host = lCreateElem(EH_Type);
+   lListElem *topology_inuse;
+   std::vector<std::string> ids;
+   int failed = 0;
+
+   lAppendElem(binding_list, create_binding("linear_automatic", 2, 0, 0, 0, nullptr));
+   lSetList(job, JB_binding, binding_list);
+   lSetHost(host, EH_name, "host1");
+
+   // hosts without topology are not restricted
+   if (!host_select_binding(host, job, &ids) || !ids.empty()) {
+      printf("host without topology rejected binding\n");
+      failed++;
+   }
+
+   topology_inuse = lAddSubStr(host, HL_name, LOAD_ATTR_TOPOLOGY_INUSE, EH_load_list, HL_Type);
+   lSetString(topology_inuse, HL_value, "ScCScc");
+   if (host_select_binding(host, job, &ids)) {
+      printf("binding possible with only one free core\n");
+      failed++;
+   }
+
+   lSetString(topology_inuse, HL_value, "SCCSCc");
+   if (!host_select_binding(host, job, &ids) || ids.size() != 2) {
+      printf("binding not possible on free socket\n");
+      failed++;
+   }
+
+   lListElem *gru = lCreateElem(GRU_Type);
+   lSetUlong(gru, GRU_type, GRU_BINDING_TYPE);
+   lSetHost(gru, GRU_host, "host1");
+   for (const std::string &id : ids) {
+      lAddSubStr(gru, RESL_value, id.c_str(), GRU_resource_map_list, RESL_Type);
+   }
+
+   bool just_check = true;
+   host_debit_binding(host, gru, 1, &just_check);
+   if (!just_check || host_debit_binding(host, gru, 1, nullptr) != 1 ||
+       strcmp(lGetString(topology_inuse, HL_value), "sccSCc") != 0) {
+      printf("debiting binding failed: %s\n", lGetString(topology_inuse, HL_value));
+      failed++;
+   }
+
+   host_debit_binding(host, gru, 1, &just_check);
+   if (just_check) {
+      printf("check of used cores succeeded\n");
+      failed++;
+   }
+
+   if (host_debit_binding(host, gru, -1, nullptr) != 1 || strcmp(lGetString(topology_inuse, HL_value), "SCCSCc") != 0) {
+      printf("undebiting binding failed: %s\n", lGetString(topology_inuse, HL_value));
+      failed++;
+   }
+
+   lFreeElem(&gru);
+   lFreeElem(&host);
+   lFreeElem(&job);
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_TopologyMask");
+
+   lInit(nmv);
+
+   failed += test_parse();
+   failed += test_select();
+   failed += test_book();
+   failed += test_host_binding();
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
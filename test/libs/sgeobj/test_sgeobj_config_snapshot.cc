@@ -0,0 +1,176 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_stdlib.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_conf.h"
+#include "sgeobj/sge_schedd_conf.h"
+
+#define READER_THREADS 4
+#define CONFIG_CHANGES 2000
+
+static bool
+set_schedd_config(u_long32 maxujobs, const char *load_formula) {
+   lList *config = lCreateList("schedd_conf", SC_Type);
+   lListElem *ep = sconf_create_default();
+   lList *answer_list = nullptr;
+
+   lSetUlong(ep, SC_maxujobs, maxujobs);
+   lSetString(ep, SC_load_formula, load_formula);
+   lAppendElem(config, ep);
+
+   bool ret = sconf_set_config(&config, &answer_list);
+   lFreeList(&config);
+   lFreeList(&answer_list);
+   return ret;
+}
+
+/*
+ * A snapshot keeps its values when a new configuration is published,
+ * the getters return the new values.
+ */
+static int
+test_mconf_snapshot() {
+   int failed = 0;
+
+   mconf_set_max_dynamic_event_clients(100);
+   auto before = mconf_get_snapshot();
+   mconf_set_max_dynamic_event_clients(42);
+   auto after = mconf_get_snapshot();
+
+   if (mconf_get_max_dynamic_event_clients() != 42 || after.max_dynamic_event_clients != 42) {
+      printf("mconf: new value is not visible\n");
+      failed++;
+   }
+   if (before.max_dynamic_event_clients != 100) {
+      printf("mconf: old snapshot was modified\n");
+      failed++;
+   }
+   if (after.version <= before.version) {
+      printf("mconf: version was not increased\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+static int
+test_sconf_snapshot() {
+   int failed = 0;
+
+   if (!set_schedd_config(5, "np_load_avg")) {
+      printf("sconf: setting the configuration failed\n");
+      return 1;
+   }
+   auto before = sconf_get_snapshot();
+   if (sconf_get_maxujobs() != 5 || before->load_formula != "np_load_avg") {
+      printf("sconf: configuration values are not visible\n");
+      failed++;
+   }
+
+   if (!set_schedd_config(7, "load_avg")) {
+      printf("sconf: setting the configuration failed\n");
+      return failed + 1;
+   }
+   char *load_formula = sconf_get_load_formula();
+   if (sconf_get_maxujobs() != 7 || load_formula == nullptr || strcmp(load_formula, "load_avg") != 0) {
+      printf("sconf: new configuration values are not visible\n");
+      failed++;
+   }
+   sge_free(&load_formula);
+   if (before->maxujobs != 5 || before->load_formula != "np_load_avg") {
+      printf("sconf: old snapshot was modified\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+/*
+ * Readers must always see one of the written values and finally the last one
+ * while a writer publishes new configurations.
+ */
+static int
+test_parallel() {
+   std::vector<std::thread> readers;
+   std::atomic<bool> done{false};
+   std::atomic<int> violations{0};
+   int failed = 0;
+
+   mconf_set_max_dynamic_event_clients(0);
+   for (int i = 0; i < READER_THREADS; i++) {
+      readers.emplace_back([&]() {
+         int last = 0;
+
+         while (!done) {
+            int value = mconf_get_max_dynamic_event_clients();
+            auto snapshot = mconf_get_snapshot();
+
+            // values are only increased, a thread must never see an older one
+            if (value < last || value > CONFIG_CHANGES || snapshot.max_dynamic_event_clients < value) {
+               violations++;
+            }
+            last = value;
+         }
+         if (mconf_get_max_dynamic_event_clients() != CONFIG_CHANGES) {
+            violations++;
+         }
+      });
+   }
+
+   for (int value = 1; value <= CONFIG_CHANGES; value++) {
+      mconf_set_max_dynamic_event_clients(value);
+   }
+   done = true;
+   for (auto &reader : readers) {
+      reader.join();
+   }
+
+   if (violations > 0) {
+      printf("parallel: %d wrong values were read\n", violations.load());
+      failed++;
+   }
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_config_snapshot");
+   lInit(nmv);
+
+   failed += test_mconf_snapshot();
+   failed += test_sconf_snapshot();
+   failed += test_parallel();
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
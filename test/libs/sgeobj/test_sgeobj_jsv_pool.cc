@@ -0,0 +1,122 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_time.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_jsv.h"
+
+static bool
+check(bool condition, const char *what) {
+   if (!condition) {
+      printf("failed: %s\n", what);
+   }
+   return condition;
+}
+
+static bool
+test_reuse() {
+   bool ret = true;
+
+   printf("testing reuse of pool slots\n");
+
+   int slot0 = jsv_pool_acquire(3);
+   int slot1 = jsv_pool_acquire(3);
+   int slot2 = jsv_pool_acquire(3);
+   ret &= check(slot0 == 0 && slot1 == 1 && slot2 == 2, "three slots are handed out");
+
+   // a released slot is used by the next verification
+   jsv_pool_release(slot1);
+   ret &= check(jsv_pool_acquire(3) == slot1, "released slot is reused");
+
+   // with all slots busy a thread waits until one of them is released
+   std::atomic<int> waiting_slot{-1};
+   std::thread waiter([&waiting_slot]() {
+      waiting_slot = jsv_pool_acquire(3);
+   });
+   sge_usleep(50000);
+   ret &= check(waiting_slot == -1, "thread waits for a free slot");
+   jsv_pool_release(slot2);
+   waiter.join();
+   ret &= check(waiting_slot == slot2, "waiting thread gets the released slot");
+   ret &= check(jsv_pool_get_slots() == 3, "pool has three slots");
+
+   jsv_pool_release(slot0);
+   jsv_pool_release(slot1);
+   jsv_pool_release(slot2);
+
+   return ret;
+}
+
+static bool
+test_shrink() {
+   bool ret = true;
+
+   printf("testing shrinking of the pool\n");
+
+   jsv_pool_resize(3);
+   ret &= check(jsv_pool_get_slots() == 3, "resize to the same size keeps the slots");
+
+   // slot 2 is in use while the pool is shrinked, it is removed with the next call
+   int slot0 = jsv_pool_acquire(3);
+   int slot1 = jsv_pool_acquire(3);
+   int slot2 = jsv_pool_acquire(3);
+   jsv_pool_release(slot1);
+   jsv_pool_resize(1);
+   ret &= check(jsv_pool_get_slots() == 3, "busy slot is not removed");
+
+   jsv_pool_release(slot2);
+   jsv_pool_resize(1);
+   ret &= check(jsv_pool_get_slots() == 1, "obsolete slots are removed once they are free");
+
+   // the remaining slot is reused
+   jsv_pool_release(slot0);
+   ret &= check(jsv_pool_acquire(1) == 0, "remaining slot is reused");
+   jsv_pool_release(0);
+
+   // disabling the pool removes all slots
+   jsv_pool_resize(0);
+   ret &= check(jsv_pool_get_slots() == 0, "disabled pool has no slots");
+
+   return ret;
+}
+
+int
+main(int argc, char *argv[]) {
+   bool ret = true;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_jsv_pool");
+
+   lInit(nmv);
+
+   ret &= test_reuse();
+   ret &= test_shrink();
+
+   DRETURN(ret ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,134 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_jsv.h"
+
+/*
+ * a JSV which rejects jobs with the name "reject" and accepts all others
+ */
+static const char *jsv_script =
+   "#!/bin/sh\n"
+   "name=\"\"\n"
+   "while read cmd sub arg rest; do\n"
+   "   case \"$cmd\" in\n"
+   "   START) echo \"STARTED\";;\n"
+   "   PARAM) if [ \"$sub\" = \"N\" ]; then name=\"$arg\"; fi;;\n"
+   "   BEGIN) if [ \"$name\" = \"reject\" ]; then\n"
+   "             echo \"RESULT STATE REJECT job name is not allowed\"\n"
+   "          else\n"
+   "             echo \"RESULT STATE ACCEPT\"\n"
+   "          fi\n"
+   "          name=\"\";;\n"
+   "   QUIT) exit 0;;\n"
+   "   esac\n"
+   "done\n";
+
+static bool
+check(bool condition, const char *what) {
+   if (!condition) {
+      printf("failed: %s\n", what);
+   }
+   return condition;
+}
+
+static lListElem *
+create_job(const char *name) {
+   lListElem *job = lCreateElem(JB_Type);
+   lSetString(job, JB_job_name, name);
+   return job;
+}
+
+/*
+ * the jobs of a bulk submission are all verified by the JSV before the
+ * first one is registered, only the rejected ones are dropped
+ */
+static bool
+test_reject(const char *script_file) {
+   bool ret = true;
+   const char *names[] = {"first", "reject", "last", nullptr};
+   bool accepted[3];
+   lList *answer_list = nullptr;
+
+   printf("testing JSV verification of a job list\n");
+
+   ret &= check(jsv_list_add("jsv", JSV_CONTEXT_CLIENT, &answer_list, script_file), "JSV is registered");
+   ret &= check(jsv_is_enabled(JSV_CONTEXT_CLIENT), "JSV is enabled");
+   lFreeList(&answer_list);
+
+   for (int i = 0; names[i] != nullptr; i++) {
+      lListElem *job = create_job(names[i]);
+
+      accepted[i] = jsv_do_verify(JSV_CONTEXT_CLIENT, &job, &answer_list, false);
+      if (!accepted[i]) {
+         ret &= check(answer_list_has_error(&answer_list), "rejection is reported in the answer list");
+         answer_list_output(&answer_list);
+      } else {
+         ret &= check(job != nullptr && strcmp(lGetString(job, JB_job_name), names[i]) == 0,
+                      "accepted job is unchanged");
+      }
+      lFreeList(&answer_list);
+      lFreeElem(&job);
+   }
+
+   ret &= check(accepted[0], "first job is accepted");
+   ret &= check(!accepted[1], "job named reject is rejected");
+   ret &= check(accepted[2], "job after a rejected one is accepted");
+
+   jsv_list_remove_all();
+
+   return ret;
+}
+
+int
+main(int argc, char *argv[]) {
+   bool ret = true;
+   char script_file[] = "/tmp/test_sgeobj_jsv_reject.XXXXXX";
+   int fd;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_jsv_reject");
+
+   lInit(nmv);
+
+   fd = mkstemp(script_file);
+   if (fd == -1 || write(fd, jsv_script, strlen(jsv_script)) != (ssize_t)strlen(jsv_script)) {
+      printf("failed: cannot write JSV script %s\n", script_file);
+      DRETURN(EXIT_FAILURE);
+   }
+   close(fd);
+   chmod(script_file, 0755);
+
+   ret &= test_reject(script_file);
+
+   unlink(script_file);
+
+   DRETURN(ret ? EXIT_SUCCESS : EXIT_FAILURE);
+}
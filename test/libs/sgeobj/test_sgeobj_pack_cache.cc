@@ -0,0 +1,206 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "cull/cull.h"
+#include "cull/pack.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/ocs_PackCache.h"
+
+#define NUM_OBJECTS 100
+
+static lList *
+create_centry_list() {
+   lList *list = lCreateList("complex entries", CE_Type);
+
+   for (int i = 0; i < NUM_OBJECTS; i++) {
+      std::string name = "complex" + std::to_string(i);
+      lListElem *ep = lAddElemStr(&list, CE_name, name.c_str(), CE_Type);
+      lSetString(ep, CE_shortcut, ("c" + std::to_string(i)).c_str());
+      lSetUlong(ep, CE_valtype, TYPE_INT);
+      lSetString(ep, CE_stringval, std::to_string(i).c_str());
+   }
+   return list;
+}
+
+static lList *
+create_exechost_list() {
+   lList *list = lCreateList("exec hosts", EH_Type);
+
+   for (int i = 0; i < NUM_OBJECTS; i++) {
+      std::string name = "host" + std::to_string(i) + ".example.com";
+      lListElem *ep = lAddElemHost(&list, EH_name, name.c_str(), EH_Type);
+      lSetUlong(ep, EH_load_correction_factor, i);
+   }
+   return list;
+}
+
+/*
+ * The list is packed with and without the cache, the pack buffers must be equal
+ */
+static bool
+pack_equal(const char *test, const lList *list, sge_object_type type) {
+   sge_pack_buffer expected;
+   sge_pack_buffer packed;
+   lEnumeration *what = lWhatAll();
+   bool ret = true;
+
+   init_packbuffer(&expected, 0, 0);
+   init_packbuffer(&packed, 0, 0);
+   lSelectHashPack("", list, nullptr, what, false, &expected);
+   if (ocs::PackCache::pack_list(&packed, list, type, what) != PACK_SUCCESS) {
+      printf("%s: packing with the cache failed\n", test);
+      ret = false;
+   } else if (expected.bytes_used != packed.bytes_used ||
+              memcmp(expected.head_ptr, packed.head_ptr, expected.bytes_used) != 0) {
+      printf("%s: pack buffers differ\n", test);
+      ret = false;
+   }
+
+   // the answer can be unpacked like the original one
+   if (ret) {
+      sge_pack_buffer unpack;
+      lList *copy = nullptr;
+
+      init_packbuffer_from_buffer(&unpack, packed.head_ptr, packed.bytes_used);
+      if (cull_unpack_list(&unpack, &copy) != PACK_SUCCESS || lGetNumberOfElem(copy) != lGetNumberOfElem(list)) {
+         printf("%s: unpacking failed\n", test);
+         ret = false;
+      }
+      lFreeList(&copy);
+   }
+
+   clear_packbuffer(&expected);
+   clear_packbuffer(&packed);
+   lFreeWhat(&what);
+   return ret;
+}
+
+static int
+test_pack(sge_object_type type, lList *list, int key_nm) {
+   const char *name = object_type_get_name(type);
+   int failed = 0;
+
+   ocs::PackCache::clear();
+
+   // first request packs and fills the cache, the second one takes everything from the cache
+   if (!pack_equal(name, list, type) || ocs::PackCache::size(type) != NUM_OBJECTS) {
+      printf("%s: cache was not filled\n", name);
+      failed++;
+   }
+   if (!pack_equal(name, list, type)) {
+      failed++;
+   }
+
+   // a modified object is not taken from the cache after it was invalidated
+   lListElem *ep = lFirstRW(list);
+   bool is_host = lGetType(lGetListDescr(list), key_nm) == lHostT;
+   const char *key = is_host ? lGetHost(ep, key_nm) : lGetString(ep, key_nm);
+   if (type == SGE_TYPE_CENTRY) {
+      lSetString(ep, CE_stringval, "changed");
+   } else {
+      lSetUlong(ep, EH_load_correction_factor, 4711);
+   }
+   ocs::PackCache::invalidate(type, key);
+   if (ocs::PackCache::size(type) != NUM_OBJECTS - 1) {
+      printf("%s: object was not invalidated\n", name);
+      failed++;
+   }
+   if (!pack_equal(name, list, type)) {
+      failed++;
+   }
+
+   // an object replaced by a new element is packed again
+   lListElem *last = lLastRW(list);
+   lListElem *copy = lCopyElem(last);
+   lRemoveElem(list, &last);
+   if (type == SGE_TYPE_CENTRY) {
+      lSetString(copy, CE_stringval, "replaced");
+   } else {
+      lSetUlong(copy, EH_load_correction_factor, 815);
+   }
+   lAppendElem(list, copy);
+   if (!pack_equal(name, list, type)) {
+      failed++;
+   }
+
+   // after a new list the cache of the type is empty
+   ocs::PackCache::invalidate(type);
+   if (ocs::PackCache::size(type) != 0) {
+      printf("%s: type was not invalidated\n", name);
+      failed++;
+   }
+
+   return failed;
+}
+
+static int
+test_request() {
+   lEnumeration *what_all = lWhatAll();
+   lEnumeration *what_name = lWhat("%T(%I)", CE_Type, CE_name);
+   lCondition *where = lWhere("%T(%I==%s)", CE_Type, CE_name, "complex1");
+   int failed = 0;
+
+   if (!ocs::PackCache::is_cacheable_request(SGE_TYPE_CENTRY, nullptr, what_all)) {
+      printf("request: unfiltered request is not cacheable\n");
+      failed++;
+   }
+   if (ocs::PackCache::is_cacheable_request(SGE_TYPE_CENTRY, where, what_all) ||
+       ocs::PackCache::is_cacheable_request(SGE_TYPE_CENTRY, nullptr, what_name) ||
+       ocs::PackCache::is_cacheable_request(SGE_TYPE_JOB, nullptr, what_all)) {
+      printf("request: filtered request is cacheable\n");
+      failed++;
+   }
+   if (!pack_equal("empty list", nullptr, SGE_TYPE_CENTRY)) {
+      failed++;
+   }
+
+   lFreeWhat(&what_all);
+   lFreeWhat(&what_name);
+   lFreeWhere(&where);
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_pack_cache");
+   lInit(nmv);
+
+   lList *centry_list = create_centry_list();
+   lList *exechost_list = create_exechost_list();
+
+   failed += test_pack(SGE_TYPE_CENTRY, centry_list, CE_name);
+   failed += test_pack(SGE_TYPE_EXECHOST, exechost_list, EH_name);
+   failed += test_request();
+
+   lFreeList(&centry_list);
+   lFreeList(&exechost_list);
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
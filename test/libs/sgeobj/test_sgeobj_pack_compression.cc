@@ -0,0 +1,310 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_stdlib.h"
+
+#include "cull/cull.h"
+#include "cull/pack.h"
+
+#include "basis_types.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#define DEFAULT_JOBS 5000
+#define ENV_VARIABLES 20
+
+// job list like the one sent to a new event client, jobs of a user have similar attributes
+static lList *
+create_job_list(int num_jobs) {
+   lList *job_list = lCreateList("jobs", JB_Type);
+
+   for (int i = 0; i < num_jobs; i++) {
+      lListElem *job = lCreateElem(JB_Type);
+      std::string user = "user" + std::to_string(i % 50);
+
+      lSetUlong(job, JB_job_number, 1000 + i);
+      lSetString(job, JB_job_name, ("simulation_" + std::to_string(i % 200) + ".sh").c_str());
+      lSetString(job, JB_owner, user.c_str());
+      lSetString(job, JB_group, "users");
+      lSetString(job, JB_account, "sge");
+      lSetString(job, JB_project, ("project" + std::to_string(i % 10)).c_str());
+      lSetString(job, JB_cwd, ("/home/" + user + "/work").c_str());
+      lSetString(job, JB_script_file, ("/home/" + user + "/bin/simulation.sh").c_str());
+      lSetUlong64(job, JB_submission_time, 1700000000000000ULL + i * 1000ULL);
+      for (int v = 0; v < ENV_VARIABLES; v++) {
+         lListElem *var = lAddSubStr(job, VA_variable, ("ENV_VARIABLE_" + std::to_string(v)).c_str(),
+                                     JB_env_list, VA_Type);
+         lSetString(var, VA_value, ("/opt/software/" + std::to_string(v) + "/" + user).c_str());
+      }
+      lAppendElem(job_list, job);
+   }
+   return job_list;
+}
+
+static bool
+pack_job_list(sge_pack_buffer *pb, const lList *job_list) {
+   return init_packbuffer(pb, 0, 0) == PACK_SUCCESS && cull_pack_list(pb, job_list) == PACK_SUCCESS;
+}
+
+// buffer handed to commlib, commlib passes it to the receiver
+static char *
+copy_buffer(const sge_pack_buffer *pb) {
+   char *buf = sge_malloc(pb->bytes_used);
+
+   memcpy(buf, pb->head_ptr, pb->bytes_used);
+   return buf;
+}
+
+static int
+test_disabled(const lList *job_list) {
+   sge_pack_buffer pb;
+   int failed = 0;
+
+   pb_set_compression(0, 0);
+   pack_job_list(&pb, job_list);
+   if (pb_compress(&pb)) {
+      printf("disabled: packbuffer was compressed\n");
+      failed++;
+   }
+   clear_packbuffer(&pb);
+
+   pb_set_compression(1, 1024 * 1024 * 1024);
+   pack_job_list(&pb, job_list);
+   if (pb_compress(&pb)) {
+      printf("threshold: packbuffer was compressed\n");
+      failed++;
+   }
+   clear_packbuffer(&pb);
+
+   return failed;
+}
+
+static int
+test_round_trip(const lList *job_list) {
+   sge_pack_buffer pb;
+   sge_pack_buffer original;
+   sge_pack_buffer received;
+   lList *received_list = nullptr;
+   int failed = 0;
+
+   pb_set_compression(1, 1024);
+   pack_job_list(&pb, job_list);
+   pack_job_list(&original, job_list);
+   if (!pb_compress(&pb) || pb.bytes_used >= original.bytes_used) {
+      printf("round trip: packbuffer was not compressed\n");
+      clear_packbuffer(&pb);
+      clear_packbuffer(&original);
+      return 1;
+   }
+
+   char *buf = copy_buffer(&pb);
+   u_long32 buflen = pb.bytes_used;
+   if (pb_uncompress_buffer(&buf, &buflen) != PACK_SUCCESS ||
+       init_packbuffer_from_buffer(&received, buf, buflen) != PACK_SUCCESS) {
+      printf("round trip: uncompressing failed\n");
+      failed++;
+   } else {
+      if (buflen != original.bytes_used || memcmp(buf, original.head_ptr, buflen) != 0) {
+         printf("round trip: uncompressed packbuffer differs\n");
+         failed++;
+      }
+      if (cull_unpack_list(&received, &received_list) != PACK_SUCCESS ||
+          lGetNumberOfElem(received_list) != lGetNumberOfElem(job_list)) {
+         printf("round trip: unpacking failed\n");
+         failed++;
+      }
+      clear_packbuffer(&received);
+   }
+
+   // uncompressed buffers are not touched
+   buf = copy_buffer(&original);
+   buflen = original.bytes_used;
+   char *before = buf;
+   if (pb_uncompress_buffer(&buf, &buflen) != PACK_SUCCESS || buf != before || buflen != original.bytes_used) {
+      printf("round trip: uncompressed buffer was changed\n");
+      failed++;
+   }
+   sge_free(&buf);
+
+   // corrupted data is detected
+   buf = copy_buffer(&pb);
+   buflen = pb.bytes_used;
+   memset(buf + buflen / 2, 0x55, 16);
+   if (pb_uncompress_buffer(&buf, &buflen) != PACK_FORMAT) {
+      printf("round trip: corrupted data was not detected\n");
+      failed++;
+   }
+   sge_free(&buf);
+
+   lFreeList(&received_list);
+   clear_packbuffer(&pb);
+   clear_packbuffer(&original);
+   return failed;
+}
+
+// received buffer of buflen bytes announcing a compressed packbuffer with the given uncompressed size
+static char *
+create_compressed_header(u_long32 buflen, u_long32 size) {
+   sge_pack_buffer header;
+   char *buf = sge_malloc(buflen);
+
+   memset(buf, 0x55, buflen);
+   memset(&header, 0, sizeof(sge_pack_buffer));
+   header.head_ptr = header.cur_ptr = buf;
+   header.mem_size = buflen;
+   packint(&header, 0);
+   packint(&header, CULL_VERSION_COMPRESSED);
+   packint(&header, size);
+   return buf;
+}
+
+// the uncompressed size is sent by the peer, implausible sizes are rejected before memory is allocated
+static int
+test_corrupt_size(const lList *job_list) {
+   struct {
+      u_long32 buflen;
+      u_long32 size;
+      const char *description;
+   } tests[] = {
+      {3 * INTSIZE, 0xffffffff, "4 GB announced by a header without data"},
+      {3 * INTSIZE + 16, 1024 * 1024, "1 MB announced by 16 bytes of data"},
+      {3 * INTSIZE + 2 * 1024 * 1024, 1024 * 1024 * 1024 + 1, "more than 1 GB"},
+      {3 * INTSIZE, 2 * INTSIZE, "size of an empty packbuffer"}
+   };
+   int failed = 0;
+
+   for (const auto &test : tests) {
+      char *buf = create_compressed_header(test.buflen, test.size);
+      char *before = buf;
+      u_long32 buflen = test.buflen;
+
+      if (pb_uncompress_buffer(&buf, &buflen) != PACK_FORMAT || buf != before || buflen != test.buflen) {
+         printf("corrupt size: %s was not rejected\n", test.description);
+         failed++;
+      }
+      sge_free(&buf);
+   }
+
+   // a size not matching the compressed data
+   sge_pack_buffer pb;
+   pb_set_compression(1, 1024);
+   pack_job_list(&pb, job_list);
+   u_long32 size = pb.bytes_used;
+   if (!pb_compress(&pb)) {
+      printf("corrupt size: packbuffer was not compressed\n");
+      failed++;
+   } else {
+      for (u_long32 wrong_size : {size - 1, size + 1}) {
+         char *buf = copy_buffer(&pb);
+         u_long32 buflen = pb.bytes_used;
+         sge_pack_buffer header;
+
+         memset(&header, 0, sizeof(sge_pack_buffer));
+         header.head_ptr = header.cur_ptr = buf + 2 * INTSIZE;
+         header.mem_size = INTSIZE;
+         packint(&header, wrong_size);
+         if (pb_uncompress_buffer(&buf, &buflen) != PACK_FORMAT) {
+            printf("corrupt size: wrong size %u was not rejected\n", (unsigned) wrong_size);
+            failed++;
+         }
+         sge_free(&buf);
+      }
+   }
+   clear_packbuffer(&pb);
+
+   return failed;
+}
+
+/*
+ * Sender and receiver side of a message in one process: pack, compress, uncompress and unpack.
+ * Prints the size on the wire and the time to transfer it with 1 Gbit/s.
+ */
+static void
+benchmark(const lList *job_list) {
+   const double bytes_per_second = 1000.0 * 1000.0 * 1000.0 / 8.0;
+
+   for (int level : {0, 1, 6, 9}) {
+      sge_pack_buffer pb;
+      sge_pack_buffer received;
+      lList *received_list = nullptr;
+
+      pb_set_compression(level, 0);
+      auto start = std::chrono::steady_clock::now();
+      pack_job_list(&pb, job_list);
+      size_t packed_size = pb.bytes_used;
+      auto packed = std::chrono::steady_clock::now();
+      pb_compress(&pb);
+      auto compressed = std::chrono::steady_clock::now();
+
+      char *buf = copy_buffer(&pb);
+      u_long32 buflen = pb.bytes_used;
+      pb_uncompress_buffer(&buf, &buflen);
+      auto uncompressed = std::chrono::steady_clock::now();
+      init_packbuffer_from_buffer(&received, buf, buflen);
+      cull_unpack_list(&received, &received_list);
+      auto unpacked = std::chrono::steady_clock::now();
+
+      auto ms = [](auto from, auto to) {
+         return std::chrono::duration<double, std::milli>(to - from).count();
+      };
+      printf("level %d: %zu -> %zu bytes (%.1f%%), pack %.1f ms, compress %.1f ms, uncompress %.1f ms, "
+             "unpack %.1f ms, 1 Gbit/s transfer %.1f ms\n",
+             level, packed_size, pb.bytes_used, 100.0 * pb.bytes_used / packed_size,
+             ms(start, packed), ms(packed, compressed), ms(compressed, uncompressed), ms(uncompressed, unpacked),
+             1000.0 * pb.bytes_used / bytes_per_second);
+
+      lFreeList(&received_list);
+      clear_packbuffer(&received);
+      clear_packbuffer(&pb);
+   }
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_pack_compression");
+   lInit(nmv);
+
+#ifdef WITH_ZLIB
+   int num_jobs = argc > 1 ? atoi(argv[1]) : DEFAULT_JOBS;
+   lList *job_list = create_job_list(num_jobs);
+
+   failed += test_disabled(job_list);
+   failed += test_round_trip(job_list);
+   failed += test_corrupt_size(job_list);
+   benchmark(job_list);
+
+   lFreeList(&job_list);
+#else
+   printf("built without zlib, messages are not compressed\n");
+#endif
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
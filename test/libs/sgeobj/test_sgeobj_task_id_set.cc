@@ -0,0 +1,372 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "uti/sge_dstring.h"
+#include "uti/sge_rmon_macros.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_range.h"
+#include "sgeobj/ocs_TaskIdSet.h"
+
+static lList *
+parse(const char *string) {
+   lList *range_list = nullptr;
+   lList *answer_list = nullptr;
+
+   if (string != nullptr) {
+      range_list_parse_from_string(&range_list, &answer_list, string, false, true, false);
+      lFreeList(&answer_list);
+   }
+   return range_list;
+}
+
+static void
+print(const lList *range_list, dstring *string) {
+   sge_dstring_clear(string);
+   if (range_list == nullptr) {
+      sge_dstring_copy_string(string, "NONE");
+   } else {
+      range_list_print_to_string(range_list, string, false, false, false);
+   }
+}
+
+// range list created id by id like range_list_calculate_intersection_set() did before
+static lList *
+reference_list(const std::set<u_long32> &ids) {
+   lList *range_list = lCreateList("", RN_Type);
+
+   for (u_long32 id : ids) {
+      lListElem *range = lCreateElem(RN_Type);
+
+      range_set_all_ids(range, id, id, 1);
+      lAppendElem(range_list, range);
+   }
+   range_list_compress(range_list);
+   return range_list;
+}
+
+// union set calculated id by id like range_list_calculate_union_set() did before
+static lList *
+reference_union_set(const lList *range_list1, const lList *range_list2) {
+   lList *range_list = lCopyList("", range_list1 != nullptr ? range_list1 : range_list2);
+   const lListElem *range;
+
+   range_list_sort_uniq_compress(range_list, nullptr, true);
+   if (range_list1 != nullptr && range_list2 != nullptr) {
+      for_each_ep(range, range_list2) {
+         u_long32 start, end, step;
+
+         range_get_all_ids(range, &start, &end, &step);
+         for (; start <= end; start += step) {
+            range_list_insert_id(&range_list, nullptr, start);
+         }
+      }
+      range_list_compress(range_list);
+   }
+   return range_list;
+}
+
+// difference set calculated id by id like range_list_calculate_difference_set() did before
+static lList *
+reference_difference_set(const lList *range_list1, const lList *range_list2) {
+   lList *range_list = lCopyList("", range_list1);
+   const lListElem *range;
+
+   range_list_sort_uniq_compress(range_list, nullptr, true);
+   if (range_list2 != nullptr) {
+      for_each_ep(range, range_list2) {
+         u_long32 start, end, step;
+
+         range_get_all_ids(range, &start, &end, &step);
+         for (; start <= end; start += step) {
+            range_list_remove_id(&range_list, nullptr, start);
+         }
+      }
+      range_list_compress(range_list);
+   }
+   return range_list;
+}
+
+static bool
+equal_lists(const lList *range_list1, const lList *range_list2) {
+   const lListElem *range1 = lFirst(range_list1);
+   const lListElem *range2 = lFirst(range_list2);
+
+   while (range1 != nullptr && range2 != nullptr) {
+      u_long32 start1, end1, step1;
+      u_long32 start2, end2, step2;
+
+      range_get_all_ids(range1, &start1, &end1, &step1);
+      range_get_all_ids(range2, &start2, &end2, &step2);
+      if (start1 != start2 || end1 != end2 || step1 != step2) {
+         return false;
+      }
+      range1 = lNext(range1);
+      range2 = lNext(range2);
+   }
+   return range1 == nullptr && range2 == nullptr;
+}
+
+static int
+check_list(const char *what, const lList *range_list, const char *expected) {
+   DSTRING_STATIC(result, 1024);
+
+   print(range_list, &result);
+   if (strcmp(sge_dstring_get_string(&result), expected) != 0) {
+      printf("%s: got %s, expected %s\n", what, sge_dstring_get_string(&result), expected);
+      return 1;
+   }
+   return 0;
+}
+
+static int
+test_set_operations() {
+   struct {
+      const char *list1;
+      const char *list2;
+      const char *union_set;
+      const char *difference_set;
+      const char *intersection_set;
+   } tests[] = {
+      {"1-10", "5-15", "1-15:1", "1-4:1", "5-10:1"},
+      {"1-10:2", "2-10:2", "1-10:1", "1-9:2", "NONE"},
+      {"1-100", "1-100:2", "1-100:1", "2-100:2", "1-99:2"},
+      {"1-10", "1-10", "1-10:1", "NONE", "1-10:1"},
+      {"1,3,5-7", "4", "1,3,4-7:1", "1,3,5-7:1", "NONE"},
+      {"1-5", nullptr, "1-5:1", "1-5:1", "NONE"},
+      {nullptr, "2-6:2", "2-6:2", "NONE", "NONE"},
+      {"1-9:2", nullptr, "1-9:2", "1-9:2", "NONE"},
+      {"70000-140000", "65536-131071", "65536-140000:1", "131072-140000:1", "70000-131071:1"},
+   };
+   int failed = 0;
+
+   for (const auto &test : tests) {
+      lList *list1 = parse(test.list1);
+      lList *list2 = parse(test.list2);
+      lList *result = nullptr;
+
+      range_list_calculate_union_set(&result, nullptr, list1, list2);
+      failed += check_list("union", result, test.union_set);
+      lFreeList(&result);
+      range_list_calculate_difference_set(&result, nullptr, list1, list2);
+      failed += check_list("difference", result, test.difference_set);
+      range_list_calculate_intersection_set(&result, nullptr, list1, list2);
+      failed += check_list("intersection", result, test.intersection_set);
+
+      lFreeList(&result);
+      lFreeList(&list1);
+      lFreeList(&list2);
+   }
+
+   return failed;
+}
+
+/*
+ * Random ids across several containers, partly dense enough for the bitmap representation,
+ * compared with a std::set and with range lists created id by id.
+ */
+static int
+test_random() {
+   unsigned int seed = 4711;
+   int failed = 0;
+
+   for (int loop = 0; loop < 10; loop++) {
+      std::set<u_long32> ids1;
+      std::set<u_long32> ids2;
+      ocs::TaskIdSet set1;
+      ocs::TaskIdSet set2;
+      int density = 1 + rand_r(&seed) % 20;
+
+      for (u_long32 id = 1; id < 200000; id++) {
+         if (rand_r(&seed) % density == 0) {
+            ids1.insert(id);
+            set1.add(id);
+         }
+         if (rand_r(&seed) % (density + 3) == 0) {
+            ids2.insert(id);
+            set2.add(id);
+         }
+      }
+      for (int i = 0; i < 500; i++) {
+         u_long32 id = rand_r(&seed) % 200000;
+
+         ids1.erase(id);
+         set1.remove(id);
+      }
+
+      std::set<u_long32> union_ids = ids1;
+      std::set<u_long32> difference_ids;
+      std::set<u_long32> intersection_ids;
+      union_ids.insert(ids2.begin(), ids2.end());
+      for (u_long32 id : ids1) {
+         (ids2.contains(id) ? intersection_ids : difference_ids).insert(id);
+      }
+
+      struct {
+         const char *name;
+         ocs::TaskIdSet set;
+         const std::set<u_long32> &ids;
+      } results[] = {
+         {"union", set1, union_ids},
+         {"difference", set1, difference_ids},
+         {"intersection", set1, intersection_ids},
+      };
+      results[0].set.unite(set2);
+      results[1].set.subtract(set2);
+      results[2].set.intersect(set2);
+
+      for (const auto &r : results) {
+         lList *range_list = r.set.to_range_list("");
+         lList *reference = reference_list(r.ids);
+
+         if (r.set.size() != r.ids.size()) {
+            printf("%s: %u ids, expected %zu\n", r.name, r.set.size(), r.ids.size());
+            failed++;
+         }
+         for (u_long32 id = 0; id < 200000; id += 7) {
+            if (r.set.contains(id) != r.ids.contains(id)) {
+               printf("%s: wrong result for id " sge_u32 "\n", r.name, id);
+               failed++;
+               break;
+            }
+         }
+         if (!equal_lists(range_list, reference)) {
+            printf("%s: range list differs from the one created id by id\n", r.name);
+            failed++;
+         }
+         lFreeList(&range_list);
+         lFreeList(&reference);
+      }
+   }
+
+   return failed;
+}
+
+/*
+ * Random range lists, not sorted and partly overlapping, compared with the union and difference
+ * sets calculated id by id. The resulting ranges have to be the same, not only the ids.
+ */
+static int
+test_reference() {
+   unsigned int seed = 815;
+   int failed = 0;
+
+   for (int loop = 0; loop < 2000; loop++) {
+      lList *lists[2] = {nullptr, nullptr};
+
+      for (auto &list : lists) {
+         int ranges = rand_r(&seed) % 8;
+
+         // sometimes NULL, sometimes an empty list
+         if (ranges > 0 || rand_r(&seed) % 2 == 0) {
+            list = lCreateList("", RN_Type);
+         }
+         for (int i = 0; i < ranges; i++) {
+            lListElem *range = lCreateElem(RN_Type);
+            u_long32 start = 1 + rand_r(&seed) % 60;
+            u_long32 step = 1 + rand_r(&seed) % 4;
+            u_long32 end = start + step * (rand_r(&seed) % 8);
+
+            range_set_all_ids(range, start, end, step);
+            lAppendElem(list, range);
+         }
+      }
+
+      lList *result = nullptr;
+      lList *reference = reference_union_set(lists[0], lists[1]);
+      range_list_calculate_union_set(&result, nullptr, lists[0], lists[1]);
+      if (!equal_lists(result, reference) || (result == nullptr) != (reference == nullptr)) {
+         DSTRING_STATIC(expected, 1024);
+
+         print(reference, &expected);
+         check_list("reference union", result, sge_dstring_get_string(&expected));
+         failed++;
+      }
+      lFreeList(&result);
+      lFreeList(&reference);
+
+      reference = reference_difference_set(lists[0], lists[1]);
+      range_list_calculate_difference_set(&result, nullptr, lists[0], lists[1]);
+      if (!equal_lists(result, reference) || (result == nullptr) != (reference == nullptr)) {
+         DSTRING_STATIC(expected, 1024);
+
+         print(reference, &expected);
+         check_list("reference difference", result, sge_dstring_get_string(&expected));
+         failed++;
+      }
+      lFreeList(&result);
+      lFreeList(&reference);
+
+      lFreeList(&lists[0]);
+      lFreeList(&lists[1]);
+   }
+
+   return failed;
+}
+
+// a huge array with regularly finished tasks
+static int
+test_huge_array() {
+   lList *all = parse("1-2000000");
+   lList *finished = parse("1-2000000:3");
+   lList *result = nullptr;
+   int failed = 0;
+
+   range_list_calculate_difference_set(&result, nullptr, all, finished);
+   if (range_list_get_number_of_ids(result) != 1333333 ||
+       range_list_is_id_within(result, 1) || !range_list_is_id_within(result, 2) ||
+       !range_list_is_id_within(result, 2000000) || range_list_is_id_within(result, 1999999)) {
+      printf("huge array: wrong difference set\n");
+      failed++;
+   }
+
+   range_list_calculate_union_set(&result, nullptr, result, finished);
+   failed += check_list("huge array union", result, "1-2000000:1");
+
+   lFreeList(&result);
+   lFreeList(&all);
+   lFreeList(&finished);
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_task_id_set");
+   lInit(nmv);
+
+   failed += test_set_operations();
+   failed += test_random();
+   failed += test_reference();
+   failed += test_huge_array();
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
@@ -0,0 +1,216 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "uti/sge_hostname.h"
+#include "uti/sge_rmon_macros.h"
+
+#define INTERN_THREADS 4
+
+static const char *Hostnames[] = {
+   "nodea", "NodeA", "NODEA.example.com", "nodea.other.org", "nodeb", "nodeb.example.com",
+   "node", "nodeaa", "@allhosts", "@AllHosts", "localhost", "LocalHost.localdomain", nullptr
+};
+
+static int
+sign(int value) {
+   return value < 0 ? -1 : value > 0 ? 1 : 0;
+}
+
+/*
+ * Interned hostnames must give the same results as comparing
+ * the normalized names.
+ */
+static int
+test_compare() {
+   int failed = 0;
+
+   for (int i = 0; Hostnames[i] != nullptr; i++) {
+      for (int j = 0; Hostnames[j] != nullptr; j++) {
+         char h1[CL_MAXHOSTNAMELEN + 1];
+         char h2[CL_MAXHOSTNAMELEN + 1];
+
+         sge_hostcpy(h1, Hostnames[i]);
+         sge_hostcpy(h2, Hostnames[j]);
+         int expected = sign(strcasecmp(h1, h2));
+         bool same_id = sge_host_intern(Hostnames[i]) == sge_host_intern(Hostnames[j]);
+
+         if (sign(sge_hostcmp(Hostnames[i], Hostnames[j])) != expected || same_id != (expected == 0)) {
+            printf("compare: %s and %s give different results\n", Hostnames[i], Hostnames[j]);
+            failed++;
+         }
+      }
+   }
+
+   if (sge_host_intern(nullptr) != nullptr) {
+      printf("compare: nullptr was interned\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+/*
+ * Hostnames which are only compared or searched are not interned,
+ * spellings above the cache limit still get the right entry.
+ */
+static int
+test_lookup() {
+   int failed = 0;
+
+   if (sge_hostcmp("lookupa", "LookupA.example.com") != 0 || sge_hostcmp("lookupa", "lookupb") >= 0) {
+      printf("lookup: hostnames which are not interned are compared wrong\n");
+      failed++;
+   }
+   if (sge_host_intern_lookup("lookupa") != nullptr || sge_host_intern_lookup("lookupb") != nullptr) {
+      printf("lookup: compared hostnames were interned\n");
+      failed++;
+   }
+
+   const sge_host_id_t *host_id = sge_host_intern("lookupa");
+   if (sge_host_intern_lookup("LOOKUPA") != host_id || sge_hostcmp("LookupA.example.com", "lookupa") != 0) {
+      printf("lookup: interned hostname is not found\n");
+      failed++;
+   }
+
+   for (int i = 0; i < 20000; i++) {
+      char name[CL_MAXHOSTNAMELEN];
+
+      snprintf(name, sizeof(name), "lookupa.domain%d", i);
+      if (sge_host_intern_lookup(name) != host_id) {
+         printf("lookup: spelling %s has a different id\n", name);
+         failed++;
+         break;
+      }
+   }
+
+   return failed;
+}
+
+/*
+ * All threads must get the same entry for a hostname.
+ */
+static int
+test_parallel() {
+   std::vector<std::thread> threads;
+   const sge_host_id_t *ids[INTERN_THREADS][100];
+   int failed = 0;
+
+   for (int t = 0; t < INTERN_THREADS; t++) {
+      threads.emplace_back([&ids, t]() {
+         for (int i = 0; i < 100; i++) {
+            char name[CL_MAXHOSTNAMELEN];
+
+            snprintf(name, sizeof(name), (i + t) % 2 == 0 ? "Host%d" : "host%d.example.com", i);
+            ids[t][i] = sge_host_intern(name);
+         }
+      });
+   }
+   for (auto &thread : threads) {
+      thread.join();
+   }
+
+   for (int i = 0; i < 100; i++) {
+      for (int t = 1; t < INTERN_THREADS; t++) {
+         if (ids[t][i] != ids[0][i]) {
+            printf("parallel: host%d has different ids\n", i);
+            failed++;
+         }
+      }
+      if (i > 0 && ids[0][i] == ids[0][i - 1]) {
+         printf("parallel: host%d has the id of another host\n", i);
+         failed++;
+      }
+   }
+
+   return failed;
+}
+
+/*
+ * The hostname functions read ignore_fqdn and default_domain from the
+ * bootstrap file, create one which ignores the domain.
+ */
+static bool
+create_bootstrap(char *sge_root, char *common_dir, char *bootstrap_file) {
+   FILE *fp;
+
+   if (mkdtemp(sge_root) == nullptr) {
+      return false;
+   }
+   snprintf(common_dir, PATH_MAX, "%s/default", sge_root);
+   mkdir(common_dir, 0755);
+   snprintf(common_dir, PATH_MAX, "%s/default/common", sge_root);
+   mkdir(common_dir, 0755);
+   snprintf(bootstrap_file, PATH_MAX, "%s/bootstrap", common_dir);
+   if ((fp = fopen(bootstrap_file, "w")) == nullptr) {
+      return false;
+   }
+   fprintf(fp, "admin_user none\n"
+               "default_domain none\n"
+               "ignore_fqdn true\n"
+               "spooling_method classic\n"
+               "spooling_lib libspoolc\n"
+               "spooling_params none\n"
+               "binary_path none\n"
+               "qmaster_spool_dir none\n"
+               "security_mode none\n");
+   fclose(fp);
+
+   setenv("SGE_ROOT", sge_root, 1);
+   setenv("SGE_CELL", "default", 1);
+   return true;
+}
+
+int main(int argc, char *argv[]) {
+   int failed = 0;
+   char sge_root[] = "/tmp/test_uti_hostname.XXXXXX";
+   char common_dir[PATH_MAX];
+   char bootstrap_file[PATH_MAX];
+
+   DENTER_MAIN(TOP_LAYER, "test_uti_hostname");
+
+   if (!create_bootstrap(sge_root, common_dir, bootstrap_file)) {
+      printf("cannot create bootstrap file in %s\n", sge_root);
+      DRETURN(1);
+   }
+
+   failed += test_compare();
+   failed += test_lookup();
+   failed += test_parallel();
+
+   unlink(bootstrap_file);
+   rmdir(common_dir);
+   *strrchr(common_dir, '/') = '\0';
+   rmdir(common_dir);
+   rmdir(sge_root);
+
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}
@@ -0,0 +1,174 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "uti/sge_dstring.h"
+#include "uti/sge_monitor.h"
+#include "uti/sge_time.h"
+
+static bool
+check_value(const char *name, u_long64 value, u_long64 min, u_long64 max) {
+   if (value < min || value > max) {
+      printf("%s is " sge_u64 ", expected " sge_u64 " - " sge_u64 "\n", name, value, min, max);
+      return false;
+   }
+   return true;
+}
+
+static bool
+test_register() {
+   bool ret = true;
+
+   int id1 = sge_monitor_latency_register("GDI GET job");
+   int id2 = sge_monitor_latency_register("GDI ADD job");
+   int id3 = sge_monitor_latency_register("GDI GET job");
+
+   if (id1 < 0 || id2 < 0 || id1 == id2 || id1 == MONITOR_LAT_LOCK_WAIT) {
+      printf("got invalid ids %d and %d\n", id1, id2);
+      ret = false;
+   }
+   if (id1 != id3) {
+      printf("registering the same name twice returned %d and %d\n", id1, id3);
+      ret = false;
+   }
+
+   return ret;
+}
+
+static bool
+test_percentiles() {
+   bool ret = true;
+   u_long64 count, p50, p99, max;
+
+   int id = sge_monitor_latency_register("test percentiles");
+
+   // 98 fast requests (100us), 2 slow ones (1s and 2s)
+   for (int i = 0; i < 98; i++) {
+      sge_monitor_latency_add(id, 100);
+   }
+   sge_monitor_latency_add(id, 1000000);
+   sge_monitor_latency_add(id, 2000000);
+
+   if (!sge_monitor_latency_get(id, &count, &p50, &p99, &max)) {
+      printf("sge_monitor_latency_get() failed\n");
+      return false;
+   }
+
+   // buckets have a resolution of 25%
+   ret &= check_value("count", count, 100, 100);
+   ret &= check_value("p50", p50, 100, 125);
+   ret &= check_value("p99", p99, 1000000, 1250000);
+   ret &= check_value("max", max, 2000000, 2000000);
+
+   return ret;
+}
+
+static bool
+test_small_and_huge() {
+   bool ret = true;
+   u_long64 count, p50, p99, max;
+
+   int id = sge_monitor_latency_register("test small and huge");
+
+   for (u_long64 usec = 0; usec < 4; usec++) {
+      sge_monitor_latency_add(id, usec);
+   }
+   sge_monitor_latency_get(id, &count, &p50, &p99, &max);
+   ret &= check_value("small count", count, 4, 4);
+   ret &= check_value("small p50", p50, 1, 1);
+   ret &= check_value("small max", max, 3, 3);
+
+   // values beyond the last bucket (about 71 minutes) are reported as max
+   const u_long64 two_hours = 7200 * 1000000ULL;
+   sge_monitor_latency_add(id, two_hours);
+   sge_monitor_latency_get(id, &count, &p50, &p99, &max);
+   ret &= check_value("huge p99", p99, two_hours, two_hours);
+
+   if (sge_monitor_latency_get(MONITOR_LAT_MAX, &count, &p50, &p99, &max)) {
+      printf("sge_monitor_latency_get() accepted an invalid id\n");
+      ret = false;
+   }
+
+   return ret;
+}
+
+static bool
+test_since() {
+   bool ret = true;
+   u_long64 start = sge_get_monotonic_time64();
+
+   sge_usleep(10000);
+   u_long64 duration = sge_monitor_latency_since(start);
+   ret &= check_value("duration", duration, 10000, 10000000);
+
+   // a start time in the future must not wrap around
+   ret &= check_value("negative duration", sge_monitor_latency_since(start + 3600 * 1000000ULL), 0, 0);
+
+   return ret;
+}
+
+static bool
+test_output() {
+   bool ret = true;
+   dstring output = DSTRING_INIT;
+   u_long64 count = 0;
+   double p50 = 0.0;
+   double p99 = 0.0;
+   double max = 0.0;
+
+   sge_monitor_latency_output(&output);
+   const char *str = sge_dstring_get_string(&output);
+   const char *line = str != nullptr ? strstr(str, "latency test percentiles: ") : nullptr;
+
+   if (line == nullptr ||
+       sscanf(line, "latency test percentiles: count=" sge_u64 " p50=%lfms p99=%lfms max=%lfms",
+              &count, &p50, &p99, &max) != 4) {
+      printf("missing output of latency histogram\n");
+      ret = false;
+   } else {
+      // output is in milliseconds
+      ret &= check_value("output count", count, 100, 100);
+      ret &= check_value("output p50", (u_long64) (p50 * 1000), 100, 125);
+      ret &= check_value("output p99", (u_long64) (p99 * 1000), 1000000, 1250000);
+      ret &= check_value("output max", (u_long64) (max * 1000), 2000000, 2000000);
+   }
+   if (strstr(str, "GDI ADD job") != nullptr) {
+      printf("empty latency histogram should not be shown\n");
+      ret = false;
+   }
+
+   sge_dstring_free(&output);
+   return ret;
+}
+
+int main(int argc, char *argv[]) {
+   bool ret = true;
+
+   ret &= test_register();
+   ret &= test_percentiles();
+   ret &= test_small_and_huge();
+   ret &= test_since();
+   ret &= test_output();
+
+   return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
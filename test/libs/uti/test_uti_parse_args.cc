@@ -0,0 +1,96 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "uti/sge_parse_args.h"
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_sl.h"
+#include "uti/sge_string.h"
+
+/*
+ * splits a line like qsub -batch-file does it and compares the arguments
+ * with the expected ones, expected is nullptr terminated
+ */
+static bool
+test_line(const char *line, int expected_ret, const char *expected[]) {
+   bool ret = true;
+   sge_sl_list_t *sl_args = nullptr;
+   char **args = nullptr;
+   char *copy = strdup(line);
+   int i;
+
+   sge_sl_create(&sl_args);
+   int parse_ret = parse_quoted_command_line(copy, sl_args);
+   convert_arg_list_to_vector(sl_args, &args);
+
+   if (parse_ret != expected_ret) {
+      printf("failed: %s: return value %d, expected %d\n", line, parse_ret, expected_ret);
+      ret = false;
+   }
+   for (i = 0; ret && expected[i] != nullptr; i++) {
+      if (args[i] == nullptr || strcmp(args[i], expected[i]) != 0) {
+         printf("failed: %s: argument %d is \"%s\", expected \"%s\"\n", line, i,
+                args[i] != nullptr ? args[i] : "(null)", expected[i]);
+         ret = false;
+      }
+   }
+   if (ret && args[i] != nullptr) {
+      printf("failed: %s: unexpected argument \"%s\"\n", line, args[i]);
+      ret = false;
+   }
+
+   sge_free(&args);
+   sge_sl_destroy(&sl_args, nullptr);
+   sge_free(&copy);
+   return ret;
+}
+
+int
+main(int argc, char *argv[]) {
+   bool ret = true;
+
+   DENTER_MAIN(TOP_LAYER, "test_uti_parse_args");
+
+   printf("testing splitting of batch file lines\n");
+
+   const char *simple[] = {"-N", "job", "script.sh", "arg", nullptr};
+   ret &= test_line("-N job script.sh arg\n", 0, simple);
+
+   const char *spaces[] = {"-N", "job", "script.sh", nullptr};
+   ret &= test_line("  -N \t job  script.sh  \r\n", 0, spaces);
+
+   const char *quoted[] = {"-N", "my job", "-v", "A=x y", "script.sh", "two words", "", nullptr};
+   ret &= test_line("-N \"my job\" -v 'A=x y' script.sh \"two words\" ''\n", 0, quoted);
+
+   const char *nested[] = {"script.sh", "say 'hello'", nullptr};
+   ret &= test_line("script.sh \"say 'hello'\"\n", 0, nested);
+
+   const char *empty[] = {nullptr};
+   ret &= test_line(" \t\n", 0, empty);
+
+   const char *unmatched[] = {"script.sh", nullptr};
+   ret &= test_line("script.sh \"open\n", 1, unmatched);
+   ret &= test_line("script.sh 'open\n", 2, unmatched);
+
+   DRETURN(ret ? EXIT_SUCCESS : EXIT_FAILURE);
+}
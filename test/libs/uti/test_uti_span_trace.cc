@@ -0,0 +1,162 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "uti/ocs_SpanTrace.h"
+#include "uti/sge_rmon_macros.h"
+
+#define TRACE_THREADS 4
+
+// counts the lines of the trace file containing pattern
+static int
+count_lines(const char *filename, const char *pattern) {
+   FILE *fp = fopen(filename, "r");
+   char line[1024];
+   int count = 0;
+
+   if (fp == nullptr) {
+      return -1;
+   }
+   while (fgets(line, sizeof(line), fp) != nullptr) {
+      if (strstr(line, pattern) != nullptr) {
+         count++;
+      }
+   }
+   fclose(fp);
+   return count;
+}
+
+static bool
+dump(const char *filename, u_long32 *written) {
+   DSTRING_STATIC(error, 1024);
+
+   if (!ocs::SpanTrace::dump(filename, &error, written)) {
+      printf("dump failed: %s\n", sge_dstring_get_string(&error));
+      return false;
+   }
+   return true;
+}
+
+/*
+ * Spans are only recorded while tracing is enabled.
+ */
+static int
+test_enable(const char *filename) {
+   u_long32 written = 0;
+   int failed = 0;
+
+   ocs::SpanTrace::clear();
+   ocs::SpanTrace::set_enabled(false);
+   {
+      ocs::Span span("test", "disabled");
+   }
+   ocs::SpanTrace::set_enabled(true);
+   {
+      ocs::Span span("test", "enabled", "with \"detail\"");
+   }
+   ocs::Span stopped("test", "stopped");
+   stopped.stop();
+   stopped.stop();
+
+   if (!dump(filename, &written)) {
+      return 1;
+   }
+   if (written != 2 || count_lines(filename, "\"name\":\"enabled\"") != 1 ||
+       count_lines(filename, "\"name\":\"disabled\"") != 0 ||
+       count_lines(filename, "\"detail\":\"with \\\"detail\\\"\"") != 1) {
+      printf("enable: wrong spans were written\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+/*
+ * Each thread keeps its newest spans, all threads are written.
+ */
+static int
+test_threads(const char *filename) {
+   std::vector<std::thread> threads;
+   u_long32 written = 0;
+   int failed = 0;
+
+   ocs::SpanTrace::clear();
+   ocs::SpanTrace::set_enabled(true);
+   for (int t = 0; t < TRACE_THREADS; t++) {
+      threads.emplace_back([t]() {
+         int spans = t == 0 ? ocs::SpanTrace::BUFFER_SIZE + 100 : 10;
+
+         for (int i = 0; i < spans; i++) {
+            ocs::Span span("test", i < spans - 1 ? "thread" : "last");
+         }
+      });
+   }
+   for (auto &thread : threads) {
+      thread.join();
+   }
+
+   if (!dump(filename, &written)) {
+      return 1;
+   }
+   u_long32 expected = ocs::SpanTrace::BUFFER_SIZE + 10 * (TRACE_THREADS - 1);
+   if (written != expected || count_lines(filename, "\"ph\":\"X\"") != (int) written) {
+      printf("threads: " sge_u32 " spans were written, expected " sge_u32 "\n", written, expected);
+      failed++;
+   }
+   // the buffers of the terminated threads are still there
+   if (count_lines(filename, "\"name\":\"last\"") != TRACE_THREADS) {
+      printf("threads: newest spans are missing\n");
+      failed++;
+   }
+   if (count_lines(filename, "\"name\":\"thread_name\"") < TRACE_THREADS + 1) {
+      printf("threads: thread names are missing\n");
+      failed++;
+   }
+
+   return failed;
+}
+
+int main(int argc, char *argv[]) {
+   char filename[] = "/tmp/test_uti_span_trace.XXXXXX";
+   int failed = 0;
+
+   DENTER_MAIN(TOP_LAYER, "test_uti_span_trace");
+
+   int fd = mkstemp(filename);
+   if (fd < 0) {
+      printf("cannot create trace file\n");
+      DRETURN(1);
+   }
+   close(fd);
+
+   failed += test_enable(filename);
+   failed += test_threads(filename);
+
+   unlink(filename);
+   printf("%d test(s) failed\n", failed);
+
+   DRETURN(failed);
+}